@@ -22,6 +22,7 @@
 #include <memory> // Used std::unique_ptr
 
 #include "runnable.h" // Thread implementation
+#include "runtime.hh" // Event loop, sampling timer
 
 #include "mqMgr.h" // Shared memory manager
 #include "ipcCommon.h" // IPC constants 
@@ -36,6 +37,7 @@ namespace aggreg {
     std::string & _storageType;
     std::string & _storageDevice;
     float _samplePeriod;
+    runtime _sampler; // Sampling timer of the application thread
 
   public:
     mainApp(std::string & p_storageType, std::string & p_storageDevice);
@@ -7,7 +7,9 @@
 
 // beagleboneUtils includes
 #include "getOpt.h"
-#include "keyboard.h"
+
+// embedded helper includes
+#include "runtime.hh" // Event loop: signals, key strokes
 
 // wifimapping includes
 #include "mainApp.h"
@@ -16,35 +18,11 @@
 
 static mainApp *g_app = NULL;
 
-// Define the function to be called when ctrl-c (SIGINT) signal is sent to process
-void signal_callback_handler(const int signum) { // FIXME Use one callback per signal
-  std::cout << "aggreg: Caught signal: " << signum << std::endl;
-  
-  if (g_app != NULL) {
-    g_app->stop();
-    // Unitialization done by destructor
-    delete g_app;
-  }
-
-  // Terminate program
-  exit(signum);
-} // End of function signal_callback_handler
-
 /***********************************************************************
   Main application part
 ***********************************************************************/
 
 int main(const int argc, const char * argv[]) {
-   // Register signal and signal handler
-  if (signal (SIGINT, signal_callback_handler) == SIG_ERR) {
-    std::cerr << "aggreg: Cannot handle SIGINT" << std::endl;
-    exit (EXIT_FAILURE);
-  }
-  if (signal (SIGTERM, signal_callback_handler) == SIG_ERR) {
-    std::cerr << "aggreg: Cannot handle SIGTERM" << std::endl;
-    exit (EXIT_FAILURE);
-  }
-  
   // Parse command line arguments
   bool isDebugSet, daemonMode;
   std::string storageType, storageDevice;
@@ -65,21 +43,24 @@ int main(const int argc, const char * argv[]) {
   unlink(storageDevice.c_str());
 
   if (!daemonMode) {
+    // SIGINT/SIGTERM are blocked here and received by the event loop, so it shall be created before the application thread
+    runtime rt;
+    rt.on_signal([](const int32_t p_signal) { std::cout << "aggreg: Caught signal: " << p_signal << std::endl; });
+    rt.on_key([&rt](const char p_key) {
+	std::cout << "aggreg: key pressed was: '" << p_key << "'" << std::endl;
+	rt.stop();
+      });
+    if (!rt.is_open()) {
+      std::cerr << "aggreg: Cannot create the event loop" << std::endl;
+      exit (EXIT_FAILURE);
+    }
     // Create the real application
     // Unitialization done by destructor
     g_app = new mainApp(storageType, storageDevice);
     // Start application
     g_app->start();
-    while (true) {
-      
-      usleep(50);
-      
-      if (keyboard::keyboard::kbhit() != 0) {
-	std::cout << "aggreg: key pressed was: '" << (char)getchar() << "'" << std::endl;
-	break; // Exit from 'while' statement
-      }
-      
-    } // End of 'while' statement
+    // Sleep until a key is pressed or SIGINT/SIGTERM is received
+    rt.run();
     g_app->stop();
     delete g_app;
     g_app = NULL;
@@ -90,13 +71,22 @@ int main(const int argc, const char * argv[]) {
       exit(-1);
     } else if (forkId == 0) { // Chid side
       setsid(); // Obtain a new process group
+      runtime rt;
+      rt.on_signal([](const int32_t p_signal) { std::cout << "aggreg: Caught signal: " << p_signal << std::endl; });
+      if (!rt.is_open()) {
+        std::cerr << "aggreg: Cannot create the event loop" << std::endl;
+        exit (EXIT_FAILURE);
+      }
       // Create the real application
       // Unitialization done by destructor
       g_app = new mainApp(storageType, storageDevice);
       // Start application
       g_app->start();
-      while (true) sleep(10);
-      // The child will terminate on kill signal
+      // The child terminates cleanly on SIGINT/SIGTERM (kill)
+      rt.run();
+      g_app->stop();
+      delete g_app;
+      g_app = NULL;
     } else { // Parent side
       std::cout << "aggreg: Parent exiting..." << std::endl;
       exit(EXIT_SUCCESS);
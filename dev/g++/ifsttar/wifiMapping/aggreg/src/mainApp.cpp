@@ -35,7 +35,7 @@
 
 namespace aggreg {
 
-  mainApp::mainApp(std::string & p_storageType, std::string & p_storageDevice) : _mqMgr(), _storing(nullptr), _storageType(p_storageType), _storageDevice(p_storageDevice), _samplePeriod(1.0/*1 seconds*/) {
+  mainApp::mainApp(std::string & p_storageType, std::string & p_storageDevice) : _mqMgr(), _storing(nullptr), _storageType(p_storageType), _storageDevice(p_storageDevice), _samplePeriod(1.0/*1 seconds*/), _sampler(false/*Signals are handled by the main thread*/) {
     std::clog << ">>> aggreg::mainApp::mainApp: " <<  _storageType << " - " << _storageDevice << std::endl;
 
     // Create the shared memory
@@ -65,6 +65,7 @@ namespace aggreg {
 
   void mainApp::stop() {
     std::clog << ">>> aggreg::mainApp::stop" << std::endl;
+    _sampler.stop();
     runnable::stop();
   }
 
@@ -75,18 +76,19 @@ namespace aggreg {
 
     _storing->open();
     std::vector<unsigned char> buffer;
-    while(_running == true) {
-      //      std::clog << "aggreg::mainApp::run: Call read" << std::endl;
-      int result = _mqMgr.read(buffer, DS_MQ_SIZE);
-      //      std::clog << "aggreg::mainApp::run: read returns " << result << std::endl;
-      if (result > 0) { 
-	//	dump::hexaDump(buffer);
-	_storing->store(buffer);
-      }
-      buffer.clear();
-
-      sleep(_samplePeriod);
-    } // End of 'while' statement
+    // Drift-free sampling period, the thread sleeps in between
+    const int32_t timer = _sampler.add_timer(std::chrono::nanoseconds(static_cast<int64_t>(_samplePeriod * 1e9)), [this, &buffer](const uint64_t p_expirations) {
+	//      std::clog << "aggreg::mainApp::run: Call read" << std::endl;
+	int result = _mqMgr.read(buffer, DS_MQ_SIZE);
+	//      std::clog << "aggreg::mainApp::run: read returns " << result << std::endl;
+	if (result > 0) { 
+	  //	dump::hexaDump(buffer);
+	  _storing->store(buffer);
+	}
+	buffer.clear();
+      });
+    _sampler.run(); // Until stop()
+    _sampler.remove_timer(timer);
     _storing->close();
 
     std::clog << "<<< aggreg::mainApp::run" << std::endl;
@@ -0,0 +1,115 @@
+/*!
+ * \file      bench_converter.cpp
+ * \brief     Micro-benchmarks of the converter library.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <vector>
+#include <string>
+
+#include "micro_benchmark.hh"
+
+#include "converter.hh"
+#include "endianness.hh"
+#include "numeric.hh"
+#include "text_codec.hh"
+
+static const std::vector<uint8_t> g_payload(1024, 0xa5);
+
+static benchmark_registrar swap_32("converter.swap_32", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(converter::get_instance().swap(static_cast<int32_t>(i)));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar load_be_64("converter.load_be_64", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(load_be<uint64_t>(g_payload.data() + (i & 0x3ff & ~7)));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar int_to_bytes("converter.int_to_bytes", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(converter::get_instance().int_to_bytes(static_cast<int32_t>(i)));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar format_integer_32("converter.format_integer", [](const uint64_t p_iterations) {
+    char buffer[16];
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(format_integer(buffer, buffer + sizeof(buffer), static_cast<int32_t>(i * 7919)));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar parse_integer_32("converter.parse_integer", [](const uint64_t p_iterations) {
+    static const char text[] = "-1234567";
+    int32_t value = 0;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(parse_integer(text, text + sizeof(text) - 1, value));
+      do_not_optimize(value);
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar format_float_3("converter.format_float", [](const uint64_t p_iterations) {
+    char buffer[32];
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(format_float(buffer, buffer + sizeof(buffer), 48.8566 + i * 1e-6, 6));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar hexa_encode_1k("converter.hexa_encode_1k", [](const uint64_t p_iterations) {
+    std::vector<char> output(hexa::encoded_size(g_payload.size()));
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(hexa::encode(g_payload.data(), g_payload.size(), output.data()));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar base64_encode_1k("converter.base64_encode_1k", [](const uint64_t p_iterations) {
+    std::vector<char> output(base64::encoded_size(g_payload.size()));
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(base64::encode(g_payload.data(), g_payload.size(), output.data()));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar time_to_string("converter.time_to_string", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(converter::get_instance().time_to_string(static_cast<time_t>(1489755780 + i)));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar hexa_decode_1k("converter.hexa_decode_1k", [](const uint64_t p_iterations) {
+    std::vector<char> text(hexa::encoded_size(g_payload.size()));
+    hexa::encode(g_payload.data(), g_payload.size(), text.data());
+    std::vector<uint8_t> output(g_payload.size());
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(hexa::decode(text.data(), text.size(), output.data()));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar base64_decode_1k("converter.base64_decode_1k", [](const uint64_t p_iterations) {
+    std::vector<char> text(base64::encoded_size(g_payload.size()));
+    base64::encode(g_payload.data(), g_payload.size(), text.data());
+    std::vector<uint8_t> output(base64::decoded_size(text.size()));
+    size_t length;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(base64::decode(text.data(), text.size(), output.data(), length));
+      clobber_memory();
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar base64_encode_1k_scalar("converter.base64_encode_1k_scalar", [](const uint64_t p_iterations) {
+    std::vector<char> output(base64::encoded_size(g_payload.size()));
+    text_codec::set_simd_level(text_codec::simd_none); // Baseline of the SIMD code paths
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(base64::encode(g_payload.data(), g_payload.size(), output.data()));
+      clobber_memory();
+    } // End of 'for' statement
+    text_codec::set_simd_level(text_codec::supported_simd_level());
+  });
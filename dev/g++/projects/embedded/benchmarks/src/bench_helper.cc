@@ -0,0 +1,345 @@
+/*!
+ * \file      bench_helper.cpp
+ * \brief     Micro-benchmarks of the helper library.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <vector>
+#include <string>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+#include <sys/time.h>
+
+#include "micro_benchmark.hh"
+
+#include "tokenizer.hh"
+#include "thread_pool.hh"
+#include "ring_buffer.hh"
+#include "date_time.hh"
+#include "byte_buffer.hh"
+#include "checksum.hh"
+#include "object_pool.hh"
+#include "histogram.hh"
+
+static const std::string g_sensor_line("2017-05-15T04:36:00.123456Z,gyromon,0.0123,-0.0456,9.8071,21.50,1013.25,48.858093,2.294694,35.2,OK");
+
+static benchmark_registrar split_substr("helper.split_substr", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      std::vector<std::string> fields;
+      size_t position = 0;
+      size_t next;
+      while ((next = g_sensor_line.find(',', position)) != std::string::npos) {
+        fields.push_back(g_sensor_line.substr(position, next - position));
+        position = next + 1;
+      } // End of 'while' statement
+      fields.push_back(g_sensor_line.substr(position));
+      do_not_optimize(fields.data());
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar tokenizer_split("helper.tokenizer_split", [](const uint64_t p_iterations) {
+    string_ref fields[16];
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(tokenizer(g_sensor_line, ",").split(fields, 16));
+    } // End of 'for' statement
+  });
+
+/**
+ * \brief Naive thread pool used as reference: a single queue protected by a mutex
+ */
+class mutex_queue_pool {
+  std::vector<std::thread> _threads;
+  std::queue<std::function<void()> > _tasks;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _stopping;
+public:
+  mutex_queue_pool(const uint32_t p_workers) : _stopping(false) {
+    for (uint32_t i = 0; i < p_workers; i++) {
+      _threads.push_back(std::thread([this]() {
+            while (true) {
+              std::function<void()> task;
+              {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty()) {
+                  return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop();
+              }
+              task();
+            }
+          }));
+    }
+  };
+  ~mutex_queue_pool() {
+    { std::lock_guard<std::mutex> lock(_mutex); _stopping = true; }
+    _condition.notify_all();
+    for (size_t i = 0; i < _threads.size(); i++) {
+      _threads[i].join();
+    }
+  };
+  void post(const std::function<void()> & p_task) {
+    { std::lock_guard<std::mutex> lock(_mutex); _tasks.push(p_task); }
+    _condition.notify_one();
+  };
+}; // End of class mutex_queue_pool
+
+/**
+ * \brief Fork-join load: a binary tree of 2^p_depth tasks, each task spawning its children
+ */
+template<typename P> static void spawn_tree(P & p_pool, const uint32_t p_depth) {
+  std::atomic<uint32_t> leaves(0);
+  std::function<void(uint32_t)> node = [&](const uint32_t p_level) {
+    if (p_level == 0) {
+      leaves += 1;
+      return;
+    }
+    p_pool.post([&node, p_level]() { node(p_level - 1); });
+    p_pool.post([&node, p_level]() { node(p_level - 1); });
+  };
+  node(p_depth);
+  while (leaves.load() != (1U << p_depth)) {
+    std::this_thread::yield();
+  } // End of 'while' statement
+}
+
+static const uint32_t g_workers = (std::thread::hardware_concurrency() == 0) ? 2 : std::thread::hardware_concurrency();
+
+static benchmark_registrar thread_pool_spawn_tree("helper.thread_pool_spawn_tree_4k", [](const uint64_t p_iterations) {
+    helpers::thread::thread_pool pool(g_workers);
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      spawn_tree(pool, 12);
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar mutex_queue_spawn_tree("helper.mutex_queue_spawn_tree_4k", [](const uint64_t p_iterations) {
+    mutex_queue_pool pool(g_workers);
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      spawn_tree(pool, 12);
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar thread_pool_parallel_for("helper.thread_pool_parallel_for_64k", [](const uint64_t p_iterations) {
+    static std::vector<double> samples(1 << 16, 1.0);
+    helpers::thread::thread_pool pool(g_workers);
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      pool.parallel_for(0, samples.size(), [](const size_t p_index) { samples[p_index] = std::sqrt(samples[p_index] * p_index); });
+      do_not_optimize(samples[4]);
+    } // End of 'for' statement
+  });
+
+/**
+ * \brief Hand-off of values from a producer thread to the calling thread through a ring
+ */
+template<typename R> static void hand_off(R & p_ring, const uint64_t p_count) {
+  std::thread producer([&p_ring, p_count]() {
+      for (uint64_t i = 0; i < p_count; i++) {
+        while (!p_ring.try_push(i)) {
+          std::this_thread::yield();
+        } // End of 'while' statement
+      } // End of 'for' statement
+    });
+  uint64_t value;
+  for (uint64_t i = 0; i < p_count; i++) {
+    while (!p_ring.try_pop(value)) {
+      std::this_thread::yield();
+    } // End of 'while' statement
+  } // End of 'for' statement
+  producer.join();
+}
+
+static benchmark_registrar spsc_ring_hand_off("helper.spsc_ring_hand_off", [](const uint64_t p_iterations) {
+    helpers::spsc_ring<uint64_t> ring(1024);
+    hand_off(ring, p_iterations);
+  });
+
+static benchmark_registrar mpmc_ring_hand_off("helper.mpmc_ring_hand_off", [](const uint64_t p_iterations) {
+    helpers::mpmc_ring<uint64_t> ring(1024);
+    hand_off(ring, p_iterations);
+  });
+
+static benchmark_registrar mutex_queue_hand_off("helper.mutex_queue_hand_off", [](const uint64_t p_iterations) {
+    std::queue<uint64_t> queue;
+    std::mutex mutex;
+    std::thread producer([&queue, &mutex, p_iterations]() {
+        for (uint64_t i = 0; i < p_iterations; i++) {
+          std::lock_guard<std::mutex> lock(mutex);
+          queue.push(i);
+        } // End of 'for' statement
+      });
+    for (uint64_t i = 0; i < p_iterations; ) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!queue.empty()) {
+        queue.pop();
+        i += 1;
+      }
+    } // End of 'for' statement
+    producer.join();
+  });
+
+static benchmark_registrar timestamp_format("helper.timestamp_format_iso8601", [](const uint64_t p_iterations) {
+    char buffer[64];
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(timestamp::format(buffer, sizeof(buffer), timestamp::realtime(), iso8601));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar localtime_sprintf("helper.localtime_sprintf", [](const uint64_t p_iterations) {
+    char buffer[64];
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      struct timeval tv;
+      ::gettimeofday(&tv, NULL);
+      time_t now = tv.tv_sec;
+      struct tm * tm = ::localtime(&now);
+      do_not_optimize(::sprintf(buffer, "%4d/%02d/%02d %02d:%02d:%02d.%06ld", tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, tv.tv_usec));
+    } // End of 'for' statement
+  });
+
+/**
+ * \brief A packet passed through three processing stages, by value as std::vector and as byte_buffer
+ */
+struct pipeline_stages {
+  static uint32_t sign(const std::vector<uint8_t> p_data) { return p_data[p_data.size() - 1]; };
+  static uint32_t decode(const std::vector<uint8_t> p_data) { return sign(std::vector<uint8_t>(p_data.begin() + 14, p_data.end())); };
+  static uint32_t receive(const std::vector<uint8_t> p_data) { return decode(p_data); };
+  static uint32_t sign(const byte_span & p_data) { return p_data[p_data.size() - 1]; };
+  static uint32_t decode(const helpers::byte_buffer p_data) { return sign(p_data.slice(14)); };
+  static uint32_t receive(const helpers::byte_buffer p_data) { return decode(p_data); };
+}; // End of struct pipeline_stages
+
+static const std::vector<uint8_t> g_packet(1500, 0xa5);
+
+static benchmark_registrar pipeline_vector("helper.pipeline_vector_1500", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(pipeline_stages::receive(g_packet));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar pipeline_byte_buffer("helper.pipeline_byte_buffer_1500", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(pipeline_stages::receive(helpers::byte_buffer(std::vector<uint8_t>(g_packet))));
+    } // End of 'for' statement
+  });
+
+static const std::vector<uint8_t> g_block(64 * 1024, 0x5a);
+
+static benchmark_registrar crc32c("helper.crc32c_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::crc32c::compute(g_block));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar crc32c_software("helper.crc32c_64k_software", [](const uint64_t p_iterations) {
+    checksum::use_hardware(false);
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::crc32c::compute(g_block));
+    } // End of 'for' statement
+    checksum::use_hardware(true);
+  });
+
+static benchmark_registrar crc32("helper.crc32_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::crc32::compute(g_block));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar crc16_ccitt("helper.crc16_ccitt_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::crc16_ccitt::compute(g_block));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar crc8("helper.crc8_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::crc8::compute(g_block));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar xor8("helper.xor8_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::xor8(g_block.data(), g_block.size()));
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar sum8("helper.sum8_64k", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      do_not_optimize(checksum::sum8(g_block.data(), g_block.size()));
+    } // End of 'for' statement
+  });
+
+/**
+ * \brief Short-lived object created and destroyed by the allocation benchmarks
+ */
+struct message_ {
+  uint64_t _id;
+  std::string _name;
+  message_(const uint64_t p_id, const std::string & p_name) : _id(p_id), _name(p_name) { };
+}; // End of struct message_
+
+/**
+ * \brief 4 threads creating and destroying objects, each keeping the last 8 alive; one iteration per thread
+ * \param[in] p_pool The pool, nullptr for new/delete
+ */
+static void create_destroy(object_pool<message_> * p_pool, const uint64_t p_iterations) {
+  std::vector<std::thread> workers;
+  for (uint32_t t = 0; t < 4; t++) {
+    workers.push_back(std::thread([p_pool, p_iterations]() {
+          message_ * window[8] = { nullptr };
+          for (uint64_t i = 0; i < p_iterations; i++) {
+            message_ *& slot = window[i % 8];
+            if (p_pool == nullptr) {
+              delete slot;
+              slot = new message_(i, "");
+            } else {
+              p_pool->release(slot);
+              slot = p_pool->acquire(i, "");
+            }
+          } // End of 'for' statement
+          for (uint32_t i = 0; i < 8; i++) {
+            if (p_pool == nullptr) {
+              delete window[i];
+            } else {
+              p_pool->release(window[i]);
+            }
+          } // End of 'for' statement
+        }));
+  } // End of 'for' statement
+  for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it) {
+    it->join();
+  } // End of 'for' statement
+}
+
+static benchmark_registrar new_delete("helper.new_delete_4_threads", [](const uint64_t p_iterations) {
+    create_destroy(nullptr, p_iterations);
+  });
+
+static benchmark_registrar object_pool_acquire("helper.object_pool_4_threads", [](const uint64_t p_iterations) {
+    static object_pool<message_> pool(256);
+    create_destroy(&pool, p_iterations);
+  });
+
+static benchmark_registrar histogram_record("helper.histogram_record", [](const uint64_t p_iterations) {
+    static histogram h;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      h.record(i & 0xfffff);
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar histogram_scope_timer("helper.histogram_scope_timer", [](const uint64_t p_iterations) {
+    static histogram h;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      scope_timer t(h);
+    } // End of 'for' statement
+  });
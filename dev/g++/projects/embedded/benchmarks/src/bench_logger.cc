@@ -0,0 +1,36 @@
+/*!
+ * \file      bench_logger.cpp
+ * \brief     Micro-benchmarks of the logger library.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <string>
+
+#include "micro_benchmark.hh"
+
+#include "logger.hh"
+
+/**
+ * @brief Returns the logger of the benchmarks, writing into /tmp
+ */
+static logger::logger & bench_logger() {
+  static logger::logger l("bench", "/tmp/bench_logger.log", logger::logger_levels_t::info | logger::logger_levels_t::warning | logger::logger_levels_t::error);
+  return l;
+}
+
+static benchmark_registrar logger_info("logger.info_formatted", [](const uint64_t p_iterations) {
+    logger::logger & l = bench_logger();
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      l.info("bench: frame %u, rssi %d, %s", static_cast<uint32_t>(i), -67, "ok");
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar logger_filtered("logger.debug_filtered", [](const uint64_t p_iterations) {
+    logger::logger & l = bench_logger();
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      l.debug("bench: frame %u", static_cast<uint32_t>(i)); // Below the level filter
+      clobber_memory();
+    } // End of 'for' statement
+  });
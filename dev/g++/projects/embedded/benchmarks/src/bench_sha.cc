@@ -0,0 +1,43 @@
+/*!
+ * \file      bench_sha.cpp
+ * \brief     Micro-benchmarks of the sha digests of the security library.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <vector>
+
+#include "micro_benchmark.hh"
+
+#include "sha.hh"
+
+static const std::vector<uint8_t> g_message(1024, 0x3c);
+
+static benchmark_registrar sha1_1k("sha.sha1_1k", [](const uint64_t p_iterations) {
+    security::sha digest(security::sha_algorithms_t::sha1);
+    std::vector<uint8_t> hash;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      digest.hash(g_message, hash);
+      do_not_optimize(hash.data());
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar sha256_1k("sha.sha256_1k", [](const uint64_t p_iterations) {
+    security::sha digest(security::sha_algorithms_t::sha256);
+    std::vector<uint8_t> hash;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      digest.hash(g_message, hash);
+      do_not_optimize(hash.data());
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar sha256_64("sha.sha256_64", [](const uint64_t p_iterations) {
+    static const std::vector<uint8_t> message(64, 0x3c);
+    security::sha digest(security::sha_algorithms_t::sha256);
+    std::vector<uint8_t> hash;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      digest.hash(message, hash);
+      do_not_optimize(hash.data());
+    } // End of 'for' statement
+  });
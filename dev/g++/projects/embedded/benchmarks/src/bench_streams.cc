@@ -0,0 +1,50 @@
+/*!
+ * \file      bench_streams.cpp
+ * \brief     Micro-benchmarks of the ibstream and obstream bit streams.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <vector>
+
+#include "micro_benchmark.hh"
+
+#include "ibstream.hh"
+#include "obstream.hh"
+
+static const uint32_t g_fields = 256; /*!< Fields per stream, 12 bits each */
+
+static benchmark_registrar obstream_write_12("obstream.write_12bits_x256", [](const uint64_t p_iterations) {
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      obstream obs(g_fields * 12 / 8);
+      for (uint32_t f = 0; f < g_fields; f++) {
+        obs.write(static_cast<uint16_t>(f), 12);
+      } // End of 'for' statement
+      do_not_optimize(obs.rdbuf()[0]);
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar ibstream_read_12("ibstream.read_12bits_x256", [](const uint64_t p_iterations) {
+    static const std::vector<uint8_t> buffer(g_fields * 12 / 8, 0x5a);
+    ibstream ibs(buffer, buffer.size() * 8);
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      ibs.seekg(0);
+      uint16_t value = 0;
+      for (uint32_t f = 0; f < g_fields; f++) {
+        ibs.read(value, 12);
+        do_not_optimize(value);
+      } // End of 'for' statement
+    } // End of 'for' statement
+  });
+
+static benchmark_registrar ibstream_read_bytes("ibstream.read_bits_1k", [](const uint64_t p_iterations) {
+    static const std::vector<uint8_t> buffer(1024, 0x5a);
+    ibstream ibs(buffer, buffer.size() * 8);
+    std::vector<uint8_t> output;
+    for (uint64_t i = 0; i < p_iterations; i++) {
+      ibs.seekg(0);
+      ibs.read_bits(output, buffer.size() * 8);
+      do_not_optimize(output.data());
+    } // End of 'for' statement
+  });
@@ -0,0 +1,16 @@
+/*!
+ * \file      main.cpp
+ * \brief     Micro-benchmarks of the embedded libraries.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include "micro_benchmark.hh"
+
+/**
+ * @brief Run the benchmarks registered by the bench_*.cc files, see micro_benchmark::main for the options
+ */
+int main(int argc, char **argv) {
+  return micro_benchmark::main(argc, argv);
+}
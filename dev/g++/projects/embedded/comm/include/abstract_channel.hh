@@ -11,14 +11,27 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <cerrno>
 
 #include "socket.hh"
+#include "multicast_group.hh"
+#include "datagram_batch.hh"
+#include "token_bucket.hh"
+#include "pcapng_writer.hh"
+#include "stream_reader.hh"
+#include "byte_buffer.hh"
 
 /** Define POLLRDHUP for MAC OS X and CYGWYN */
 #if !defined(POLLRDHUP)
 #define POLLRDHUP 0x2000
 #endif
 
+/** Define SO_MAX_PACING_RATE for old libc headers */
+#if !defined(SO_MAX_PACING_RATE)
+#define SO_MAX_PACING_RATE 47
+#endif
+
 namespace comm {
   
   /**
@@ -30,17 +43,22 @@ namespace comm {
   class abstract_channel {
   protected:
     std::unique_ptr<comm::network::socket> _socket; /** Socket instance */
+    std::shared_ptr<comm::network::token_bucket> _pacer; /** User space pacer, NULL if the outbound traffic is not paced */
+    bool _shared_pacer; /** Set when _pacer was attached by set_pacer, set_pacing_rate does not change it */
+    mutable std::unique_ptr<comm::network::stream_reader> _reader; /** Buffered reader, created on first use */
 
   public:
     /**
      * \brief Default constructor
      */
-    abstract_channel() : _socket() { }
+    abstract_channel() : _socket(), _pacer(), _shared_pacer(false), _reader() { }
     /**
      * \brief Default destructor
      */
     virtual ~abstract_channel() { 
+      _reader.reset();
       _socket.reset();
+      _pacer.reset();
     }
 
     /**
@@ -76,6 +94,20 @@ namespace comm {
      * \return 0 on success, -1 otherwise
      */
     virtual const int32_t read(std::vector<uint8_t> & p_buffer) const = 0;
+    /**
+     * \brief Retrieve data sent by peer into a shareable buffer
+     * \param p_buffer The data to read. The size of p_buffer indicates the number of bytes to read.
+     * \return 0 on success, -1 otherwise
+     * \remark The received bytes are handed over to p_buffer without copy, it can then be passed to the decoders and sliced freely
+     */
+    inline const int32_t read(byte_buffer & p_buffer) const {
+      std::vector<uint8_t> buffer(p_buffer.size());
+      if (read(buffer) == -1) {
+        return -1;
+      }
+      p_buffer = byte_buffer(std::move(buffer));
+      return 0;
+    };
     /**
      * \brief Retrieve the first byte available
      * \return 0 on success, -1 otherwise
@@ -93,11 +125,160 @@ namespace comm {
      */
     virtual const int32_t set_nic_name(const std::string & p_nic_name) const { return (_socket.get() != NULL) ? _socket->set_nic_name(p_nic_name) : -1; };
     
+    /**
+     * \brief Read a line terminated by '\n', the trailing "\n" or "\r\n" is removed
+     * \param p_line[out] The line
+     * \return The number of bytes consumed on success, 0 if incomplete on a non-blocking channel, -1 otherwise
+     * \see stream_reader
+     */
+    inline const int32_t read_line(std::string & p_line) const { return reader().read_line(p_line); };
+    /**
+     * \brief Read up to and including the specified delimiter
+     * \param p_delimiter[in] The delimiter
+     * \param p_buffer[out] The data read, including the delimiter
+     * \return The number of bytes consumed on success, 0 if incomplete on a non-blocking channel, -1 otherwise
+     * \see stream_reader
+     */
+    inline const int32_t read_until(const uint8_t p_delimiter, std::vector<uint8_t> & p_buffer) const { return reader().read_until(p_delimiter, p_buffer); };
+    /**
+     * \brief Read exactly the specified number of bytes
+     * \param p_length[in] The number of bytes to read
+     * \param p_buffer[out] The data read
+     * \return The number of bytes consumed on success, 0 if incomplete on a non-blocking channel, -1 otherwise
+     * \see stream_reader
+     */
+    inline const int32_t read_exact(const size_t p_length, std::vector<uint8_t> & p_buffer) const { return reader().read_exact(p_length, p_buffer); };
+    /**
+     * \brief Retrieve the next byte without consuming it
+     * \param p_byte[out] The next byte
+     * \return 1 on success, 0 if no data is available on a non-blocking channel, -1 otherwise
+     * \see stream_reader
+     */
+    inline const int32_t peek(uint8_t & p_byte) const { return reader().peek(p_byte); };
+
+    /**
+     * \brief Retrieve several datagrams with a single system call, in case of UDP socket only
+     * \param p_batch[inout] The preallocated reception slots
+     * \return The number of datagrams received on success (0 if none is pending), -1 otherwise
+     */
+    virtual const int32_t read(datagram_batch & p_batch) const { return -1; };
+
+    /**
+     * \brief Join a multicast group (Any-Source Multicast), in case of UDP socket only
+     * \param p_group[in] The multicast group address
+     * \param p_nic_name[in] The NIC name, empty for the default interface
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t join_group(const comm::network::socket_address & p_group, const std::string & p_nic_name = "") const { return -1; };
+    /**
+     * \brief Join a multicast group for the specified source only (Source-Specific Multicast), in case of UDP socket only
+     * \param p_group[in] The multicast group address
+     * \param p_source[in] The source address
+     * \param p_nic_name[in] The NIC name, empty for the default interface
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t join_source_group(const comm::network::socket_address & p_group, const comm::network::socket_address & p_source, const std::string & p_nic_name = "") const { return -1; };
+    /**
+     * \brief Leave a multicast group, in case of UDP socket only
+     * \param p_group[in] The multicast group address
+     * \param p_nic_name[in] The NIC name, empty for the default interface
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t leave_group(const comm::network::socket_address & p_group, const std::string & p_nic_name = "") const { return -1; };
+    /**
+     * \brief Stop receiving the specified source of a multicast group, in case of UDP socket only
+     * \param p_group[in] The multicast group address
+     * \param p_source[in] The source address
+     * \param p_nic_name[in] The NIC name, empty for the default interface
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t leave_source_group(const comm::network::socket_address & p_group, const comm::network::socket_address & p_source, const std::string & p_nic_name = "") const { return -1; };
+    /**
+     * \brief Set the interface used to send multicast datagrams, in case of UDP socket only
+     * \param p_nic_name[in] The NIC name
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t set_multicast_interface(const std::string & p_nic_name) const { return -1; };
+    /**
+     * \brief Enable/disable the local delivery of the multicast datagrams sent, in case of UDP socket only
+     * \param p_loop[in] Set to true to receive our own datagrams
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t set_multicast_loop(const bool p_loop) const { return -1; };
+    /**
+     * \brief Set the TTL (IPv4) or hop limit (IPv6) of the multicast datagrams sent, in case of UDP socket only
+     * \param p_ttl[in] The TTL value
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t set_multicast_ttl(const uint8_t p_ttl) const { return -1; };
+    /**
+     * \brief Retrieve the reception counters of a joined multicast group, in case of UDP socket only
+     * \param p_group[in] The multicast group address
+     * \param p_statistics[out] The reception counters
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t get_group_statistics(const comm::network::socket_address & p_group, comm::network::multicast_statistics & p_statistics) const { return -1; };
+
+    /**
+     * \brief Limit the outbound rate of this channel
+     * With pacing_mode::kernel, SO_MAX_PACING_RATE is used on TCP sockets, and on the other sockets only when fq is the
+     * default qdisc (/proc/sys/net/core/default_qdisc): without the fq qdisc the kernel accepts the option but does not pace
+     * the datagrams. Use pacing_mode::kernel_fq when fq is configured on the NIC with tc. In the other cases the user space
+     * pacer is used and SO_MAX_PACING_RATE is cleared. The user space pacer never blocks: write() returns -1 with errno set
+     * to EAGAIN when the rate is exceeded, the caller retries after pacing_delay(), e.g. from a helpers::runtime timer
+     * \param p_rate[in] The rate in bytes per second, 0 to disable pacing
+     * \param p_burst[in] The burst size in bytes (user space pacer only)
+     * \param p_mode[in] The pacing mode
+     * \return 0 on success, -1 otherwise (e.g. user space pacing requested while a pacer is attached with set_pacer)
+     * \remark A pacer attached with set_pacer is kept, whatever the mode
+     */
+    virtual const int32_t set_pacing_rate(const uint64_t p_rate, const uint64_t p_burst, const comm::network::pacing_mode p_mode = comm::network::pacing_mode::kernel);
+    /**
+     * \brief Attach a user space pacer, it can be shared between several channels to enforce an aggregate rate (e.g. per link)
+     * \param p_pacer[in] The pacer, NULL to disable pacing
+     */
+    virtual void set_pacer(const std::shared_ptr<comm::network::token_bucket> & p_pacer) { _pacer = p_pacer; _shared_pacer = (p_pacer.get() != NULL); };
+    /**
+     * \brief Retrieve the user space pacer
+     * \return The pacer, NULL if the outbound traffic is not paced in user space
+     */
+    inline const std::shared_ptr<comm::network::token_bucket> & get_pacer() const { return _pacer; };
+    /**
+     * \brief Retrieve the time to wait before the user space pacer allows the next write()
+     * \return The delay, 0 if data can be sent now or if the outbound traffic is not paced in user space
+     */
+    inline std::chrono::nanoseconds pacing_delay() const { return (_pacer.get() != NULL) ? _pacer->delay() : std::chrono::nanoseconds(0); };
+
+    /**
+     * \brief Record the frames sent and received into a capture file, in case of RAW socket only
+     * \param p_capture[in] The capture writer, it can be shared between several channels. NULL to stop the capture
+     * \return 0 on success, -1 otherwise
+     */
+    virtual const int32_t set_capture(const std::shared_ptr<comm::network::pcapng_writer> & p_capture) { return -1; };
+
     /**
      * \brief Retrieve the socket file descriptor
      * \return The socket file descriptor on success, -1 otherwise
      */
     inline virtual const int32_t get_fd() const { return (_socket.get() != NULL) ?  _socket->get_fd() : -1; };
+
+  protected:
+    /**
+     * \brief Retrieve the buffered reader, created on first use
+     */
+    inline comm::network::stream_reader & reader() const { if (_reader.get() == NULL) _reader.reset(new comm::network::stream_reader(*this)); return *_reader; };
+    /**
+     * \brief Check that the user space pacer allows to send p_size bytes now
+     * \param p_size[in] The number of bytes to send
+     * \return true if the bytes can be sent, false otherwise with errno set to EAGAIN
+     */
+    inline bool pace(const uint64_t p_size) const {
+      if ((_pacer.get() != NULL) && !_pacer->try_consume(p_size)) {
+        errno = EAGAIN;
+        return false;
+      }
+      return true;
+    };
     
   }; // End of class abstract_channel
 
@@ -0,0 +1,151 @@
+/**
+ * \file      can_channel.h
+ * \brief     Header file for communication with SocketCAN raw socket.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+#include "abstract_channel.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \class can_channel
+     * \brief This class implements CAN networking over SocketCAN (AF_CAN/CAN_RAW), for classic and FD frames
+     *
+     * The buffers exchanged with write(std::vector<uint8_t>) and read(std::vector<uint8_t>) hold one raw struct can_frame (CAN_MTU bytes)
+     * or one struct canfd_frame (CANFD_MTU bytes, FD mode only). Use a datagram_batch with CANFD_MTU slots to receive several frames with
+     * a single recvmmsg() call, with their kernel timestamps.
+     *
+     * \see abstract_channel
+     * \remark Use the commands below to create a virtual CAN interface for testing:
+     *         sudo modprobe vcan && sudo ip link add dev vcan0 type vcan && sudo ip link set vcan0 mtu 72 up
+     */
+    class can_channel : public abstract_channel {
+      mutable int32_t _fd;      /** CAN_RAW socket */
+      int32_t _if_index;        /** Interface index, 0 for all CAN interfaces */
+      bool _fd_frames;          /** Set to true when CAN FD frames are enabled */
+
+    public:
+      /**
+       * \brief Constructor, the socket is bound to the interface
+       * \param p_nic_name The CAN interface name (e.g. can0, vcan0), "any" for all CAN interfaces
+       * \param p_fd_frames Set to true to enable CAN FD frames
+       */
+      can_channel(const std::string & p_nic_name, const bool p_fd_frames = false);
+      /**
+       * \brief Default destructor
+       */
+      virtual ~can_channel();
+
+      /**
+       * \brief Nothing to do, the socket is bound at construction time
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t connect() const;
+      /**
+       * \brief Not applicable for CAN
+       * \return -1
+       */
+      const int32_t accept_connection() const;
+      /**
+       * \brief Close the socket
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t disconnect() const;
+      /**
+       * \brief Send one raw frame
+       * \param p_string The raw frame
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const std::string & p_string) const;
+      /**
+       * \brief Send one raw frame
+       * \param p_buffer The raw frame (struct can_frame or struct canfd_frame)
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const std::vector<uint8_t> & p_buffer) const;
+      /**
+       * \brief Send one classic frame
+       * \param p_frame The frame
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const struct can_frame & p_frame) const;
+      /**
+       * \brief Send one FD frame
+       * \param p_frame The frame
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const struct canfd_frame & p_frame) const;
+      /**
+       * \brief Retrieve one raw frame
+       * \param p_buffer The raw frame, resized to CAN_MTU or CANFD_MTU
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t read(std::vector<uint8_t> & p_buffer) const;
+      /**
+       * \brief Not applicable for CAN
+       */
+      inline const uint8_t read() const { throw std::runtime_error("can_channel::read: Not applicable"); };
+      /**
+       * \brief Retrieve the size of the next pending frame
+       * \return The size of the next frame on success, -1 otherwise
+       */
+      const int32_t data_available() const;
+      /**
+       * \brief Retrieve several frames with a single recvmmsg() call
+       * \param p_batch The reception slots, the slot size shall be at least CANFD_MTU in FD mode
+       * \return The number of frames received on success (0 if none is pending), -1 otherwise
+       * \see datagram_batch::timestamp
+       */
+      const int32_t read(datagram_batch & p_batch) const;
+
+      /**
+       * \brief Set the kernel acceptance filters (CAN_RAW_FILTER), a frame is received if (received_id & mask) == (id & mask) for one filter
+       * \param p_filters The filter list, empty to receive nothing
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_filters(const std::vector<struct can_filter> & p_filters) const;
+      /**
+       * \brief Set the error frames to receive (CAN_RAW_ERR_FILTER)
+       * \param p_mask The CAN_ERR_* classes mask
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_error_filter(const can_err_mask_t p_mask) const;
+      /**
+       * \brief Enable the reception of the frames sent by this socket (CAN_RAW_RECV_OWN_MSGS)
+       * \param p_flag Set to true to receive our own frames
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_receive_own(const bool p_flag) const;
+
+      /**
+       * \brief Retrieve the socket file descriptor
+       */
+      inline const int32_t get_fd() const { return _fd; };
+      /**
+       * \brief Indicate if CAN FD frames are enabled
+       */
+      inline const bool fd_frames() const { return _fd_frames; };
+
+    private:
+      const int32_t send_frame(const void * p_frame, const size_t p_length) const;
+    }; // End of class can_channel
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
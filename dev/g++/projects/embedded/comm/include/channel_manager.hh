@@ -44,6 +44,7 @@ namespace comm {
     const int32_t create_channel(const channel_type p_channel_type, const comm::network::socket_address & p_host);
     const int32_t create_channel(const channel_type p_channel_type, const comm::network::socket_address & p_host, const comm::network::socket_address & p_remote);
     const int32_t create_channel(const int32_t p_socket, const comm::network::socket_address & p_host, const comm::network::socket_address & p_remote);
+    const int32_t create_channel(const channel_type p_channel_type, const std::string & p_nic_name, const bool p_fd_frames = false);
 
     const int32_t remove_channel(const uint32_t p_channel);
     const int32_t poll_channels(const uint32_t p_timeout, std::vector<uint32_t> & p_channels);
@@ -0,0 +1,122 @@
+/**
+ * \file      channel_relay.h
+ * \brief     Header file for the zero-copy relay between two channels.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "abstract_channel.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \class channel_relay
+     * \brief This class forwards the data received on one file descriptor to another one, and optionally the other way round
+     *
+     * When both ends allow it (e.g. TCP sockets, regular files), the data is moved with splice() through a pipe and never reaches the user space.
+     * Otherwise (e.g. UDP socket as source), each direction falls back to a fixed ring buffer with readv()/writev().
+     * The file descriptors are not owned by the relay, and they are expected to be non-blocking.
+     */
+    class channel_relay {
+    public:
+      /**
+       * \enum direction
+       * \brief Relay direction
+       */
+      enum direction : uint8_t {
+        a_to_b = 0x00, /** From the first file descriptor to the second one */
+        b_to_a = 0x01  /** From the second file descriptor to the first one */
+      };
+
+    private:
+      /**
+       * \struct path
+       * \brief One relay direction
+       */
+      struct path {
+        int32_t in;                     /** Source file descriptor */
+        int32_t out;                    /** Destination file descriptor */
+        bool active;                    /** Set to false when this direction is not relayed or is terminated */
+        bool eof;                       /** Set to true when the source reached end of file */
+        bool use_splice;                /** Set to true while splice() is usable */
+        bool datagram;                  /** Set to true if the source is a datagram socket (a 0 byte read is not an end of file) */
+        int32_t pipe[2];                /** Pipe used by splice() */
+        size_t pending;                 /** Number of bytes waiting in the pipe or in the ring buffer */
+        std::vector<uint8_t> ring;      /** Fallback ring buffer */
+        size_t head;                    /** Offset of the first byte to write in the ring buffer */
+        uint64_t bytes;                 /** Number of bytes relayed */
+        path() : in(-1), out(-1), active(false), eof(false), use_splice(false), datagram(false), pending(0), ring(), head(0), bytes(0) { pipe[0] = pipe[1] = -1; };
+      }; // End of struct path
+
+      path _paths[2];                   /** The two relay directions */
+      size_t _buffer_size;              /** Pipe and ring buffer size */
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_fd_a The first file descriptor
+       * \param[in] p_fd_b The second file descriptor
+       * \param[in] p_bidirectional Set to false to relay from p_fd_a to p_fd_b only (e.g. UDP to file)
+       * \param[in] p_buffer_size The pipe and ring buffer size
+       */
+      channel_relay(const int32_t p_fd_a, const int32_t p_fd_b, const bool p_bidirectional = true, const size_t p_buffer_size = 64 * 1024);
+      /**
+       * \brief Constructor
+       * \param[in] p_channel_a The first channel
+       * \param[in] p_channel_b The second channel
+       * \param[in] p_bidirectional Set to false to relay from p_channel_a to p_channel_b only
+       * \param[in] p_buffer_size The pipe and ring buffer size
+       */
+      channel_relay(const abstract_channel & p_channel_a, const abstract_channel & p_channel_b, const bool p_bidirectional = true, const size_t p_buffer_size = 64 * 1024);
+      /**
+       * \brief Destructor, the pipes are closed
+       */
+      virtual ~channel_relay();
+
+      /**
+       * \brief Wait for the file descriptors to be ready and move the data available
+       * \param[in] p_timeout The poll timeout in milliseconds, -1 to wait forever
+       * \return The number of bytes moved on success, -1 on error
+       */
+      const int32_t step(const int32_t p_timeout);
+      /**
+       * \brief Relay the data until all directions reached end of file
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t run();
+
+      /**
+       * \brief Indicate if at least one direction is still relayed
+       */
+      inline const bool active() const { return _paths[a_to_b].active || _paths[b_to_a].active; };
+      /**
+       * \brief Retrieve the number of bytes relayed in the specified direction
+       */
+      inline const uint64_t bytes(const direction p_direction) const { return _paths[p_direction].bytes; };
+      /**
+       * \brief Indicate if the specified direction uses splice()
+       */
+      inline const bool zero_copy(const direction p_direction) const { return _paths[p_direction].use_splice; };
+
+    private:
+      void initialise(path & p_path, const int32_t p_in, const int32_t p_out);
+      const int32_t transfer(path & p_path);
+      const int32_t transfer_splice(path & p_path);
+      const int32_t transfer_ring(path & p_path);
+      const int32_t fallback(path & p_path);
+      void terminate(path & p_path);
+    }; // End of class channel_relay
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
@@ -18,7 +18,8 @@ namespace comm {
     udp = 0x00,     /** UDP protocol */
     tcp = 0x01,     /** TCP protocol */
     sctp = 0x02,    /** SCTP protocol */
-    raw = 0x03      /** Undefined protocol */
+    raw = 0x03,     /** Undefined protocol */
+    can = 0x04      /** SocketCAN raw protocol */
   }; // End of enum class protocol_t
 
 } // End of namespace comm
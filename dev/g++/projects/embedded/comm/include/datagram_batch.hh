@@ -0,0 +1,126 @@
+/**
+ * \file      datagram_batch.h
+ * \brief     Header file for batched datagram reception buffers.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include "byte_buffer.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \class datagram_batch
+     * \brief This class provides the preallocated slots used to receive several datagrams with a single recvmmsg() call
+     *
+     * All the slots are carved out of one contiguous buffer allocated once at construction time, so a batch can be
+     * reused for each reception without any further memory allocation.
+     *
+     * \see udp_channel::read(datagram_batch &)
+     */
+    class datagram_batch {
+      uint32_t _slot_size;                                /** Maximum size of a datagram */
+      uint32_t _count;                                    /** Number of datagrams received during the last reception */
+      std::vector<uint8_t> _buffer;                       /** Contiguous storage for all the slots */
+      std::vector<uint8_t> _controls;                     /** Contiguous storage for the ancillary data of all the slots */
+      std::vector<struct iovec> _iovecs;                  /** One iovec per slot */
+      std::vector<struct mmsghdr> _headers;               /** One message header per slot */
+      std::vector<struct sockaddr_storage> _sources;      /** Source address of each datagram */
+      std::vector<struct sockaddr_storage> _destinations; /** Destination address of each datagram (e.g. the multicast group) */
+      std::vector<uint64_t> _timestamps;                  /** Kernel reception timestamp of each datagram, in nanoseconds */
+
+    public:
+      /**
+       * \brief Size of the ancillary data buffer of one slot
+       */
+      static const uint32_t control_size = 128;
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_slots     The maximum number of datagrams received at once
+       * \param[in] p_slot_size The maximum size of one datagram
+       */
+      datagram_batch(const uint32_t p_slots = 64, const uint32_t p_slot_size = 2048);
+      /**
+       * \brief Default destructor
+       */
+      virtual ~datagram_batch() { };
+
+      /**
+       * \brief Reset the message headers before a new reception
+       * \return The message header array to provide to recvmmsg()
+       */
+      struct mmsghdr * prepare();
+      /**
+       * \brief Record the number of datagrams received and extract their destination addresses and timestamps from the ancillary data
+       * \param[in] p_count The value returned by recvmmsg()
+       */
+      void complete(const uint32_t p_count);
+
+      /**
+       * \brief Retrieve the maximum number of datagrams received at once
+       */
+      inline const uint32_t capacity() const { return static_cast<uint32_t>(_headers.size()); };
+      /**
+       * \brief Retrieve the number of datagrams received during the last reception
+       */
+      inline const uint32_t size() const { return _count; };
+      /**
+       * \brief Retrieve the payload of the datagram p_index
+       */
+      inline const uint8_t * data(const uint32_t p_index) const { return _buffer.data() + p_index * _slot_size; };
+      /**
+       * \brief Retrieve the payload length of the datagram p_index
+       */
+      inline const uint32_t length(const uint32_t p_index) const { return _headers[p_index].msg_len; };
+      /**
+       * \brief Indicate if the datagram p_index was larger than the slot size
+       */
+      inline const bool truncated(const uint32_t p_index) const { return (_headers[p_index].msg_hdr.msg_flags & MSG_TRUNC) != 0; };
+      /**
+       * \brief Retrieve the source address of the datagram p_index
+       */
+      inline const struct sockaddr_storage & source(const uint32_t p_index) const { return _sources[p_index]; };
+      /**
+       * \brief Retrieve the destination address of the datagram p_index, ss_family is AF_UNSPEC if not available
+       * \remark Requires IP_PKTINFO/IPV6_RECVPKTINFO to be enabled on the socket
+       */
+      inline const struct sockaddr_storage & destination(const uint32_t p_index) const { return _destinations[p_index]; };
+      /**
+       * \brief Retrieve the kernel reception timestamp of the datagram p_index, in nanoseconds since Epoch, 0 if not available
+       * \remark Requires SO_TIMESTAMPNS to be enabled on the socket
+       */
+      inline const uint64_t timestamp(const uint32_t p_index) const { return _timestamps[p_index]; };
+      /**
+       * \brief Copy the payload of the datagram p_index
+       * \param[in] p_index   The datagram index
+       * \param[out] p_buffer The datagram payload
+       */
+      void copy(const uint32_t p_index, std::vector<uint8_t> & p_buffer) const;
+      /**
+       * \brief Copy the payload of the datagram p_index
+       * \param[in] p_index   The datagram index
+       * \param[out] p_buffer The datagram payload, small payloads do not allocate
+       */
+      void copy(const uint32_t p_index, byte_buffer & p_buffer) const;
+
+    }; // End of class datagram_batch
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
@@ -0,0 +1,62 @@
+/**
+ * \file      multicast_group.h
+ * \brief     Header file for multicast group membership description.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \struct multicast_statistics
+     * \brief Reception counters of one multicast group
+     */
+    struct multicast_statistics {
+      uint64_t datagrams;      /** Number of datagrams received for this group */
+      uint64_t bytes;          /** Number of bytes received for this group */
+      uint64_t truncated;      /** Number of datagrams truncated because larger than the receive slot */
+      uint32_t sources;        /** Number of sources joined (SSM), 0 for ASM */
+      uint32_t if_index;       /** Interface index used to join the group, 0 for the default interface */
+
+      multicast_statistics() : datagrams(0), bytes(0), truncated(0), sources(0), if_index(0) { };
+    }; // End of struct multicast_statistics
+
+    /**
+     * \brief Key used to index the multicast groups: the raw IPv4 (4 first bytes) or IPv6 (16 bytes) group address
+     */
+    typedef std::array<uint8_t, 16> multicast_group_key;
+
+    /**
+     * \brief Build the group key from a raw socket address
+     * \param[in] p_addr The IPv4 or IPv6 socket address
+     * \return The group key
+     */
+    inline multicast_group_key to_multicast_group_key(const struct sockaddr_storage & p_addr) {
+      multicast_group_key key = { { 0 } };
+      if (p_addr.ss_family == AF_INET) {
+        const uint8_t * a = reinterpret_cast<const uint8_t *>(&reinterpret_cast<const struct sockaddr_in *>(&p_addr)->sin_addr);
+        std::copy(a, a + sizeof(struct in_addr), key.begin());
+      } else if (p_addr.ss_family == AF_INET6) {
+        const uint8_t * a = reinterpret_cast<const uint8_t *>(&reinterpret_cast<const struct sockaddr_in6 *>(&p_addr)->sin6_addr);
+        std::copy(a, a + sizeof(struct in6_addr), key.begin());
+      }
+      return key;
+    };
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
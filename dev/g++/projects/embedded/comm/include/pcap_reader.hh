@@ -0,0 +1,95 @@
+/**
+ * \file      pcap_reader.h
+ * \brief     Header file for the memory-mapped pcap/pcapng capture reader.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "abstract_channel.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \class pcap_reader
+     * \brief This class reads the frames of a pcap or pcapng capture file mapped in memory, without copying them
+     *
+     * \see pcapng_writer
+     */
+    class pcap_reader {
+      std::string _file_name;                 /** Capture file name */
+      const uint8_t * _data;                  /** Mapped file content */
+      size_t _size;                           /** Mapped file size */
+      size_t _offset;                         /** Offset of the next block/record */
+      bool _pcapng;                           /** Set to true for pcapng files, false for classic pcap files */
+      bool _swapped;                          /** Set to true if the file byte order differs from the host one */
+      uint64_t _units;                        /** Classic pcap timestamp units per second */
+      std::vector<uint64_t> _interface_units; /** pcapng timestamp units per second, for each interface of the current section */
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_file_name The capture file name
+       */
+      pcap_reader(const std::string & p_file_name);
+      /**
+       * \brief Destructor, the file is unmapped
+       */
+      virtual ~pcap_reader();
+
+      /**
+       * \brief Map the capture file and check its header
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t open();
+      /**
+       * \brief Unmap the capture file
+       */
+      void close();
+      /**
+       * \brief Retrieve the next frame
+       * \param[out] p_frame The frame, pointing into the mapped file
+       * \param[out] p_length The captured length
+       * \param[out] p_timestamp The timestamp in nanoseconds since Epoch
+       * \return true on success, false at the end of the file or on error
+       */
+      bool next(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp);
+      /**
+       * \brief Restart reading from the first frame
+       */
+      void rewind();
+      /**
+       * \brief Send all the remaining frames on a channel
+       * \param[in] p_channel The channel to use (e.g. a raw_channel)
+       * \param[in] p_timed Set to true to reproduce the inter-frame gaps, false to replay as fast as possible
+       * \return The number of frames sent on success, -1 otherwise
+       * \remark This call blocks: when the channel is paced in user space, it waits for the pacer between the frames
+       */
+      const int32_t replay(const abstract_channel & p_channel, const bool p_timed = false);
+
+    private:
+      inline uint16_t get_u16(const size_t p_offset) const { uint16_t v; std::memcpy(&v, _data + p_offset, sizeof(v)); return _swapped ? __builtin_bswap16(v) : v; };
+      inline uint32_t get_u32(const size_t p_offset) const { uint32_t v; std::memcpy(&v, _data + p_offset, sizeof(v)); return _swapped ? __builtin_bswap32(v) : v; };
+      bool next_pcap(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp);
+      bool next_pcapng(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp);
+      /**
+       * \brief Read the timestamp resolution of an Interface Description Block
+       * \return false if the block is malformed, true otherwise
+       */
+      bool parse_interface(const size_t p_offset, const uint32_t p_length);
+    }; // End of class pcap_reader
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
@@ -0,0 +1,129 @@
+/**
+ * \file      pcapng_writer.h
+ * \brief     Header file for the buffered pcapng capture writer.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include <sys/uio.h>
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \class pcapng_writer
+     * \brief This class writes captured frames into pcapng files (https://www.ietf.org/archive/id/draft-ietf-opsawg-pcapng-01.html)
+     *
+     * Frames are serialised as Enhanced Packet Blocks into a preallocated buffer, with nanosecond timestamps.
+     * The buffer is written with a single writev() call when it is full, so the file system sees large sequential writes only.
+     * Files can be rotated by size and/or by duration: the first file is p_file_name, the next ones are p_file_name.1, p_file_name.2...
+     * \remark This class is thread-safe, a writer can be shared between several channels
+     */
+    class pcapng_writer {
+      std::string _file_name;           /** Base file name */
+      uint16_t _link_type;              /** Link type (LINKTYPE_ETHERNET by default) */
+      uint32_t _snap_length;            /** Maximum number of bytes captured per frame */
+      uint64_t _max_file_size;          /** Rotate when a file reaches this size in bytes, 0 to disable */
+      uint64_t _max_duration;           /** Rotate after this duration in seconds, 0 to disable */
+      std::vector<uint8_t> _buffer;     /** Preallocated block buffer */
+      uint32_t _used;                   /** Number of bytes used in _buffer */
+      int32_t _fd;                      /** Current file descriptor */
+      uint32_t _index;                  /** Current rotation index */
+      uint64_t _file_size;              /** Size of the current file, including the pending bytes */
+      uint64_t _file_start;             /** Creation time of the current file, in nanoseconds */
+      bool _header_pending;             /** Set when the section header/interface description blocks are not written yet */
+      uint64_t _frames;                 /** Number of frames captured */
+      uint64_t _bytes;                  /** Number of bytes written */
+      mutable std::recursive_mutex _mutex; /** Serialise the captures of the channels sharing the writer */
+
+    public:
+      /**
+       * \brief Link type for Ethernet frames
+       */
+      static const uint16_t linktype_ethernet = 1;
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_file_name The capture file name
+       * \param[in] p_buffer_size The size of the write buffer
+       * \param[in] p_max_file_size The file size triggering a rotation, 0 to disable
+       * \param[in] p_max_duration The duration in seconds triggering a rotation, 0 to disable
+       * \param[in] p_link_type The link type
+       * \param[in] p_snap_length The maximum number of bytes captured per frame
+       */
+      pcapng_writer(const std::string & p_file_name, const uint32_t p_buffer_size = 4 * 1024 * 1024, const uint64_t p_max_file_size = 0, const uint64_t p_max_duration = 0, const uint16_t p_link_type = linktype_ethernet, const uint32_t p_snap_length = 65535);
+      /**
+       * \brief Destructor, the pending frames are flushed
+       */
+      virtual ~pcapng_writer();
+
+      /**
+       * \brief Create the first capture file
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t open();
+      /**
+       * \brief Flush the pending frames and close the current capture file
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t close();
+      /**
+       * \brief Capture a frame, timestamped with the current time
+       * \param[in] p_frame The frame
+       * \param[in] p_length The frame length
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const uint8_t * p_frame, const uint32_t p_length);
+      /**
+       * \brief Capture a frame
+       * \param[in] p_frame The frame
+       * \param[in] p_length The frame length
+       * \param[in] p_timestamp The timestamp in nanoseconds since Epoch
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t write(const uint8_t * p_frame, const uint32_t p_length, const uint64_t p_timestamp);
+      /**
+       * \brief Capture a frame, timestamped with the current time
+       * \param[in] p_frame The frame
+       * \return 0 on success, -1 otherwise
+       */
+      inline const int32_t write(const std::vector<uint8_t> & p_frame) { return write(p_frame.data(), static_cast<uint32_t>(p_frame.size())); };
+      /**
+       * \brief Write the pending frames into the current capture file
+       * \return 0 on success, -1 otherwise. On failure, the bytes not written are kept and written by the next flush()
+       */
+      const int32_t flush();
+
+      /**
+       * \brief Retrieve the name of the current capture file
+       */
+      std::string file_name() const;
+      inline const uint64_t frames() const { std::lock_guard<std::recursive_mutex> lock(_mutex); return _frames; };
+      inline const uint64_t bytes() const { std::lock_guard<std::recursive_mutex> lock(_mutex); return _bytes; };
+
+    private:
+      const int32_t rotate();
+      /**
+       * \brief Write the pending header blocks, then the vectors
+       * \param[out] p_written The number of bytes of the vectors written, the header blocks excluded. Optional
+       */
+      const int32_t write_vector(struct iovec * p_iov, const uint32_t p_count, size_t * p_written = nullptr);
+      void append_header(std::vector<uint8_t> & p_header) const;
+      static uint64_t now();
+    }; // End of class pcapng_writer
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
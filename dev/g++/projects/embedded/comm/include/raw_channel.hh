@@ -23,6 +23,7 @@ namespace comm {
      * \see abstract_channel
      */
     class raw_channel : public abstract_channel {
+      std::shared_ptr<pcapng_writer> _capture; /** Capture writer, NULL if the traffic is not recorded */
 
     public:
       /**
@@ -88,6 +89,13 @@ namespace comm {
        * \return 0 on success, -1 otherwise
        */
       inline const int32_t data_available() const { throw std::runtime_error("Not implemented yet"); };
+
+      /**
+       * \brief Record the frames sent and received into a capture file
+       * \param p_capture The capture writer, NULL to stop the capture
+       * \return 0 on success, -1 otherwise
+       */
+      inline const int32_t set_capture(const std::shared_ptr<pcapng_writer> & p_capture) { _capture = p_capture; return 0; };
       
     }; // End of class raw_channel
 
@@ -0,0 +1,112 @@
+/**
+ * \file      stream_reader.h
+ * \brief     Header file for the buffered channel reader.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace comm {
+
+  class abstract_channel; // Forward declaration
+
+  namespace network {
+
+    /**
+     * \class stream_reader
+     * \brief This class provides buffered reads (lines, delimited records, fixed size records) on top of a stream channel
+     *
+     * The buffer is refilled with a single read() of all the free space, and is compacted or doubled when it is full, up to p_max_size.
+     * Each method returns the number of bytes consumed on success, 0 if the data is not complete yet on a non-blocking channel
+     * (the partial data is kept buffered), and -1 on error, end of stream, or if a record exceeds the maximum buffer size.
+     * \remark The data buffered here is not visible from abstract_channel::read(std::vector<uint8_t> &), except for tcp_channel
+     */
+    class stream_reader {
+      const abstract_channel & _channel;  /** Channel to read */
+      std::vector<uint8_t> _buffer;       /** Buffered data */
+      size_t _head;                       /** Offset of the first unread byte */
+      size_t _tail;                       /** Offset of the first free byte */
+      size_t _max_size;                   /** Maximum size of the buffer */
+      bool _eof;                          /** Set to true when the peer closed the stream */
+      uint64_t _fills;                    /** Number of read() system calls */
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_channel The channel to read
+       * \param[in] p_size The initial size of the buffer
+       * \param[in] p_max_size The maximum size of the buffer, i.e. the maximum size of a line or a record
+       */
+      stream_reader(const abstract_channel & p_channel, const size_t p_size = 64 * 1024, const size_t p_max_size = 1024 * 1024);
+      /**
+       * \brief Default destructor
+       */
+      virtual ~stream_reader() { };
+
+      /**
+       * \brief Read a line terminated by '\n', the trailing "\n" or "\r\n" is removed. At the end of the stream, the remaining
+       *        bytes are returned as the last line
+       * \param[out] p_line The line
+       * \return The number of bytes consumed on success, 0 if incomplete, -1 otherwise
+       */
+      const int32_t read_line(std::string & p_line);
+      /**
+       * \brief Read up to and including the specified delimiter
+       * \param[in] p_delimiter The delimiter
+       * \param[out] p_buffer The data read, including the delimiter, except for the remaining bytes at the end of the stream
+       * \return The number of bytes consumed on success, 0 if incomplete, -1 otherwise
+       */
+      const int32_t read_until(const uint8_t p_delimiter, std::vector<uint8_t> & p_buffer);
+      /**
+       * \brief Read exactly the specified number of bytes
+       * \param[in] p_length The number of bytes to read
+       * \param[out] p_buffer The data read
+       * \return The number of bytes consumed on success, 0 if incomplete, -1 otherwise
+       */
+      const int32_t read_exact(const size_t p_length, std::vector<uint8_t> & p_buffer);
+      /**
+       * \brief Retrieve the next byte without consuming it
+       * \param[out] p_byte The next byte
+       * \return 1 on success, 0 if no data is available, -1 otherwise
+       */
+      const int32_t peek(uint8_t & p_byte);
+      /**
+       * \brief Copy and consume the buffered data, without any system call
+       * \param[out] p_buffer The destination buffer
+       * \param[in] p_length The size of the destination buffer
+       * \return The number of bytes copied
+       */
+      size_t drain(uint8_t * p_buffer, const size_t p_length);
+
+      /**
+       * \brief Retrieve the number of bytes buffered
+       */
+      inline const size_t available() const { return _tail - _head; };
+      /**
+       * \brief Indicate if the peer closed the stream
+       */
+      inline const bool eof() const { return _eof; };
+      /**
+       * \brief Retrieve the number of read() system calls done
+       */
+      inline const uint64_t fills() const { return _fills; };
+
+    private:
+      /**
+       * \brief Read all the data available into the free space of the buffer
+       * \return The number of bytes read on success, 0 if no data is available, -1 otherwise
+       */
+      const int32_t fill();
+    }; // End of class stream_reader
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
@@ -92,7 +92,12 @@ namespace comm {
        * \return 0 on success, -1 otherwise
        */
       inline const int32_t data_available() const { throw std::runtime_error("Not implemented yet"); };
-      
+
+      /**
+       * \brief Allocate the instances from a pool: a TCP channel is created for each accepted connection
+       */
+      static void * operator new(size_t p_size);
+      static void operator delete(void * p_channel, size_t p_size);
       
     }; // End of class tcp_channel
 
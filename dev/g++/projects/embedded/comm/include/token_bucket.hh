@@ -0,0 +1,89 @@
+/**
+ * \file      token_bucket.h
+ * \brief     Header file for the outbound traffic pacer.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+
+namespace comm {
+
+  namespace network {
+
+    /**
+     * \enum pacing_mode
+     * \brief Indicate where the outbound traffic is paced
+     */
+    enum class pacing_mode : unsigned char {
+      kernel = 0x00,    /** Pacing done by the kernel (SO_MAX_PACING_RATE) for TCP, or for UDP when fq is the default qdisc, user space pacer used otherwise */
+      user = 0x01,      /** Pacing done by the user space token bucket */
+      kernel_fq = 0x02  /** Pacing done by the kernel, the caller guarantees that the fq qdisc is configured on the NIC */
+    }; // End of enum pacing_mode
+
+    /**
+     * \class token_bucket
+     * \brief This class implements a thread-safe token bucket, expressed as a virtual scheduling (GCRA) to avoid any periodic refill
+     *
+     * A token_bucket instance can be shared by several channels (e.g. all the multicast groups sent on the same link) to enforce an aggregate rate.
+     */
+    class token_bucket {
+      uint64_t _rate;                                     /** Rate in bytes per second, 0 means unlimited */
+      uint64_t _burst;                                    /** Burst size in bytes */
+      std::chrono::nanoseconds _tolerance;                /** Burst size expressed in time */
+      std::chrono::steady_clock::time_point _tat;         /** Theoretical arrival time of the next byte */
+      mutable std::mutex _mutex;                          /** Protect _tat when the bucket is shared between threads */
+
+    public:
+      /**
+       * \brief Constructor
+       * \param[in] p_rate  The rate in bytes per second, 0 means unlimited
+       * \param[in] p_burst The burst size in bytes, the bucket is full at creation time
+       */
+      token_bucket(const uint64_t p_rate, const uint64_t p_burst);
+      /**
+       * \brief Default destructor
+       */
+      virtual ~token_bucket() { };
+
+      /**
+       * \brief Consume p_size bytes if the bucket allows it
+       * \param[in] p_size The number of bytes to send
+       * \return true if the bytes can be sent now, false otherwise
+       * \remark A single datagram larger than the burst size is allowed as soon as the bucket is full
+       */
+      bool try_consume(const uint64_t p_size);
+      /**
+       * \brief Consume p_size bytes, waiting until the bucket allows it
+       * \param[in] p_size The number of bytes to send
+       */
+      void consume(const uint64_t p_size);
+      /**
+       * \brief Retrieve the time to wait before try_consume() succeeds, e.g. to arm an event loop timer
+       * \return The delay, 0 if data can be sent now
+       */
+      std::chrono::nanoseconds delay() const;
+
+      /**
+       * \brief Change the rate and the burst size
+       * \param[in] p_rate  The rate in bytes per second, 0 means unlimited
+       * \param[in] p_burst The burst size in bytes
+       */
+      void set_rate(const uint64_t p_rate, const uint64_t p_burst);
+      inline const uint64_t rate() const { return _rate; };
+      inline const uint64_t burst() const { return _burst; };
+
+    private:
+      inline std::chrono::nanoseconds cost(const uint64_t p_size) const { return std::chrono::nanoseconds((_rate == 0) ? 0 : static_cast<int64_t>(p_size * 1000000000ULL / _rate)); };
+    }; // End of class token_bucket
+
+  } // End of namespace network
+
+} // End of namespace comm
+
+using namespace comm::network;
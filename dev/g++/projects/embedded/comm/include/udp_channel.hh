@@ -9,6 +9,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <map>
 
 #include "abstract_channel.hh"
 #include "socket_address.hh"
@@ -24,6 +25,9 @@ namespace comm {
      * \see abstract_channel
      */
     class udp_channel : public abstract_channel {
+      bool _is_ipv6;                                                     /** Address family of the socket */
+      mutable bool _pktinfo;                                             /** Set to true once IP_PKTINFO/IPV6_RECVPKTINFO is enabled */
+      mutable std::map<multicast_group_key, multicast_statistics> _groups; /** Joined multicast groups and their reception counters */
 
     public:
       /**
@@ -89,6 +93,87 @@ namespace comm {
        * \return 0 on success, -1 otherwise
        */
       inline const int32_t data_available() const { throw std::runtime_error("Not implemented yet"); };
+
+      /**
+       * \brief Retrieve several datagrams with a single recvmmsg() call
+       * The per-group counters are updated for the datagrams received on a joined multicast group
+       * \param p_batch The preallocated reception slots
+       * \return The number of datagrams received on success (0 if none is pending on a non-blocking socket), -1 otherwise
+       */
+      const int32_t read(datagram_batch & p_batch) const;
+
+      /**
+       * \brief Join a multicast group (Any-Source Multicast)
+       * \param p_group The multicast group address
+       * \param p_nic_name The NIC name, empty for the default interface
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t join_group(const socket_address & p_group, const std::string & p_nic_name = "") const;
+      /**
+       * \brief Join a multicast group for the specified source only (Source-Specific Multicast)
+       * \param p_group The multicast group address
+       * \param p_source The source address
+       * \param p_nic_name The NIC name, empty for the default interface
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t join_source_group(const socket_address & p_group, const socket_address & p_source, const std::string & p_nic_name = "") const;
+      /**
+       * \brief Leave a multicast group
+       * \param p_group The multicast group address
+       * \param p_nic_name The NIC name, empty for the default interface
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t leave_group(const socket_address & p_group, const std::string & p_nic_name = "") const;
+      /**
+       * \brief Stop receiving the specified source of a multicast group
+       * \param p_group The multicast group address
+       * \param p_source The source address
+       * \param p_nic_name The NIC name, empty for the default interface
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t leave_source_group(const socket_address & p_group, const socket_address & p_source, const std::string & p_nic_name = "") const;
+      /**
+       * \brief Set the interface used to send multicast datagrams
+       * \param p_nic_name The NIC name
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_multicast_interface(const std::string & p_nic_name) const;
+      /**
+       * \brief Enable/disable the local delivery of the multicast datagrams sent (IP_MULTICAST_LOOP/IPV6_MULTICAST_LOOP)
+       * \param p_loop Set to true to receive our own datagrams
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_multicast_loop(const bool p_loop) const;
+      /**
+       * \brief Set the TTL (IP_MULTICAST_TTL) or hop limit (IPV6_MULTICAST_HOPS) of the multicast datagrams sent
+       * \param p_ttl The TTL value
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t set_multicast_ttl(const uint8_t p_ttl) const;
+      /**
+       * \brief Retrieve the reception counters of a joined multicast group
+       * \param p_group The multicast group address
+       * \param p_statistics The reception counters
+       * \return 0 on success, -1 otherwise
+       */
+      const int32_t get_group_statistics(const socket_address & p_group, multicast_statistics & p_statistics) const;
+
+    private:
+      /**
+       * \brief Apply a protocol independent membership option (MCAST_JOIN_GROUP, MCAST_LEAVE_SOURCE_GROUP...)
+       * \param p_option The socket option
+       * \param p_group The multicast group address
+       * \param p_source The source address, NULL for ASM options
+       * \param p_nic_name The NIC name, empty for the default interface
+       * \return The interface index on success, -1 otherwise
+       */
+      const int32_t membership(const int32_t p_option, const socket_address & p_group, const socket_address * p_source, const std::string & p_nic_name) const;
+      /**
+       * \brief Fill a raw socket address structure
+       * \param p_address The address
+       * \param p_storage The raw socket address structure
+       */
+      void to_storage(const socket_address & p_address, struct sockaddr_storage & p_storage) const;
       
     }; // End of class udp_channel
     
@@ -0,0 +1,68 @@
+/**
+ * @file      abstract_channel.cc
+ * @brief     Implementation file for the communication channel interface.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <fstream>
+#include <string>
+
+#include <sys/socket.h>
+
+#include "abstract_channel.hh"
+
+namespace comm {
+
+  /**
+   * @brief Indicate if the kernel paces the datagrams of the new interfaces, i.e. fq is the default qdisc
+   */
+  static bool is_fq_default_qdisc() {
+    std::ifstream is("/proc/sys/net/core/default_qdisc");
+    std::string qdisc;
+    return (is >> qdisc) && (qdisc == "fq");
+  }
+
+  const int32_t abstract_channel::set_pacing_rate(const uint64_t p_rate, const uint64_t p_burst, const comm::network::pacing_mode p_mode) {
+    if (_socket.get() == NULL) {
+      return -1;
+    }
+
+    bool kernel = (p_mode == comm::network::pacing_mode::kernel_fq);
+    if (p_mode == comm::network::pacing_mode::kernel) {
+      int type = 0;
+      socklen_t length = sizeof(type);
+      if (::getsockopt(_socket->get_fd(), SOL_SOCKET, SO_TYPE, (void *)&type, &length) == 0) {
+        kernel = (type == SOCK_STREAM) || is_fq_default_qdisc(); // TCP paces its own flows, the datagrams require fq
+      }
+    }
+    if (kernel) {
+      uint32_t rate = (p_rate == 0) ? ~0U : static_cast<uint32_t>(std::min(p_rate, static_cast<uint64_t>(~0U - 1)));
+      if (::setsockopt(_socket->get_fd(), SOL_SOCKET, SO_MAX_PACING_RATE, (const void *)&rate, sizeof(rate)) == 0) {
+        if (!_shared_pacer) {
+          _pacer.reset();
+        }
+        return 0;
+      }
+      std::clog << "abstract_channel::set_pacing_rate: Kernel pacing not available, fallback to user space pacing" << std::endl;
+    }
+
+    // User space pacing: no kernel limit left on the socket
+    uint32_t unlimited = ~0U;
+    ::setsockopt(_socket->get_fd(), SOL_SOCKET, SO_MAX_PACING_RATE, (const void *)&unlimited, sizeof(unlimited));
+    if (_shared_pacer) {
+      std::cerr << "abstract_channel::set_pacing_rate: A shared pacer is attached, use set_pacer" << std::endl;
+      return -1;
+    }
+    if (p_rate == 0) {
+      _pacer.reset();
+    } else if (_pacer.get() == NULL) {
+      _pacer.reset(new comm::network::token_bucket(p_rate, p_burst));
+    } else {
+      _pacer->set_rate(p_rate, p_burst);
+    }
+    return 0;
+  }
+
+} // End of namespace comm
@@ -0,0 +1,188 @@
+/**
+ * @file      can_channel.cc
+ * @brief     Implementation file for communication with SocketCAN raw socket.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+
+#include "can_channel.hh"
+
+namespace comm {
+
+  namespace network {
+
+    can_channel::can_channel(const std::string & p_nic_name, const bool p_fd_frames) : _fd(-1), _if_index(0), _fd_frames(p_fd_frames) {
+      if ((_fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW)) < 0) {
+        std::cerr << "can_channel::can_channel: " << std::strerror(errno) << std::endl;
+        throw std::runtime_error("can_channel::can_channel");
+      }
+      if (p_nic_name != "any") {
+        if ((_if_index = ::if_nametoindex(p_nic_name.c_str())) == 0) {
+          std::cerr << "can_channel::can_channel: " << p_nic_name << ": " << std::strerror(errno) << std::endl;
+          ::close(_fd);
+          throw std::runtime_error("can_channel::can_channel");
+        }
+      }
+      int32_t on = 1;
+      if (_fd_frames && (::setsockopt(_fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, (const void *)&on, sizeof(on)) == -1)) {
+        std::cerr << "can_channel::can_channel: CAN_RAW_FD_FRAMES: " << std::strerror(errno) << std::endl;
+        ::close(_fd);
+        throw std::runtime_error("can_channel::can_channel");
+      }
+      // Kernel reception timestamps
+      if (::setsockopt(_fd, SOL_SOCKET, SO_TIMESTAMPNS, (const void *)&on, sizeof(on)) == -1) {
+        std::cerr << "can_channel::can_channel: SO_TIMESTAMPNS: " << std::strerror(errno) << std::endl;
+      }
+      struct sockaddr_can addr;
+      ::memset((void *)&addr, 0x00, sizeof(addr));
+      addr.can_family = AF_CAN;
+      addr.can_ifindex = _if_index;
+      if (::bind(_fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        std::cerr << "can_channel::can_channel: " << std::strerror(errno) << std::endl;
+        ::close(_fd);
+        throw std::runtime_error("can_channel::can_channel");
+      }
+    }
+
+    can_channel::~can_channel() {
+      disconnect();
+    }
+
+    const int32_t can_channel::connect() const {
+      return (_fd == -1) ? -1 : 0; // Bound at construction time
+    }
+
+    const int32_t can_channel::accept_connection() const {
+      return -1; // No listen/accept for CAN
+    }
+
+    const int32_t can_channel::disconnect() const {
+      if (_fd == -1) {
+        return -1;
+      }
+      ::close(_fd);
+      _fd = -1;
+
+      return 0;
+    }
+
+    const int32_t can_channel::write(const std::string & p_string) const {
+      return send_frame(p_string.data(), p_string.length());
+    }
+
+    const int32_t can_channel::write(const std::vector<uint8_t> & p_buffer) const {
+      return send_frame(p_buffer.data(), p_buffer.size());
+    }
+
+    const int32_t can_channel::write(const struct can_frame & p_frame) const {
+      return send_frame(&p_frame, CAN_MTU);
+    }
+
+    const int32_t can_channel::write(const struct canfd_frame & p_frame) const {
+      return send_frame(&p_frame, CANFD_MTU);
+    }
+
+    const int32_t can_channel::read(std::vector<uint8_t> & p_buffer) const {
+      p_buffer.resize(CANFD_MTU);
+      ssize_t result;
+      do {
+        result = ::read(_fd, p_buffer.data(), p_buffer.size());
+      } while ((result < 0) && (errno == EINTR));
+      if (result < 0) {
+        std::cerr << "can_channel::read: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      p_buffer.resize(result);
+
+      return 0;
+    }
+
+    const int32_t can_channel::data_available() const {
+      int32_t length = 0;
+      if (::ioctl(_fd, FIONREAD, &length) == -1) {
+        std::cerr << "can_channel::data_available: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return length;
+    }
+
+    const int32_t can_channel::read(datagram_batch & p_batch) const {
+      int32_t result;
+      do {
+        result = ::recvmmsg(_fd, p_batch.prepare(), p_batch.capacity(), MSG_WAITFORONE, NULL);
+      } while ((result < 0) && (errno == EINTR));
+      if (result < 0) {
+        p_batch.complete(0);
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+          return 0;
+        }
+        std::cerr << "can_channel::read: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      p_batch.complete(static_cast<uint32_t>(result));
+
+      return result;
+    }
+
+    const int32_t can_channel::set_filters(const std::vector<struct can_filter> & p_filters) const {
+      if (::setsockopt(_fd, SOL_CAN_RAW, CAN_RAW_FILTER, (const void *)p_filters.data(), p_filters.size() * sizeof(struct can_filter)) == -1) {
+        std::cerr << "can_channel::set_filters: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return 0;
+    }
+
+    const int32_t can_channel::set_error_filter(const can_err_mask_t p_mask) const {
+      if (::setsockopt(_fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, (const void *)&p_mask, sizeof(p_mask)) == -1) {
+        std::cerr << "can_channel::set_error_filter: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return 0;
+    }
+
+    const int32_t can_channel::set_receive_own(const bool p_flag) const {
+      int32_t flag = (p_flag) ? 1 : 0;
+      if (::setsockopt(_fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, (const void *)&flag, sizeof(flag)) == -1) {
+        std::cerr << "can_channel::set_receive_own: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return 0;
+    }
+
+    const int32_t can_channel::send_frame(const void * p_frame, const size_t p_length) const {
+      // Sanity checks
+      if ((p_length != CAN_MTU) && ((p_length != CANFD_MTU) || !_fd_frames)) {
+        std::cerr << "can_channel::send_frame: Invalid frame length: " << p_length << std::endl;
+        return -1;
+      }
+
+      if (!pace(p_length)) {
+        return -1;
+      }
+      ssize_t result;
+      do {
+        result = ::write(_fd, p_frame, p_length);
+      } while ((result < 0) && (errno == EINTR));
+      if (result < 0) {
+        std::cerr << "can_channel::send_frame: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return 0;
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
@@ -17,6 +17,7 @@
 #include "raw_channel.hh"
 #include "udp_channel.hh"
 #include "tcp_channel.hh"
+#include "can_channel.hh"
 
 namespace comm {
 
@@ -209,6 +210,26 @@ namespace comm {
     return initialise_channel(channel);
   } // End of method create_channel
   
+  const int32_t channel_manager::create_channel(const channel_type p_channel_type, const std::string & p_nic_name, const bool p_fd_frames) {
+    std::clog << ">>> channel_manager::create_channel(5): " << p_nic_name << std::endl;
+
+    // Sanity check
+    if (p_channel_type != channel_type::can) {
+      std::cerr << "channel_manager::create_channel (5): Unsupported channel type" << std::endl;
+      return -1;
+    }
+
+    abstract_channel *channel = NULL;
+    try {
+      channel = new can_channel(p_nic_name, p_fd_frames);
+    } catch (std::runtime_error & e) {
+      std::cerr << "channel_manager::create_channel (5): Failed to create device instance" << std::endl;
+      return -1;
+    }
+
+    return initialise_channel(channel);
+  } // End of method create_channel
+  
   const int32_t channel_manager::remove_channel(const uint32_t p_channel) {
     std::clog << ">>> channel_manager::remove_channel: " << p_channel << std::endl;
     
@@ -0,0 +1,268 @@
+/**
+ * @file      channel_relay.cc
+ * @brief     Implementation file for the zero-copy relay between two channels.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "channel_relay.hh"
+
+namespace comm {
+
+  namespace network {
+
+    channel_relay::channel_relay(const int32_t p_fd_a, const int32_t p_fd_b, const bool p_bidirectional, const size_t p_buffer_size) : _buffer_size(p_buffer_size) {
+      initialise(_paths[a_to_b], p_fd_a, p_fd_b);
+      if (p_bidirectional) {
+        initialise(_paths[b_to_a], p_fd_b, p_fd_a);
+      }
+    } // End of ctor
+
+    channel_relay::channel_relay(const abstract_channel & p_channel_a, const abstract_channel & p_channel_b, const bool p_bidirectional, const size_t p_buffer_size) : _buffer_size(p_buffer_size) {
+      initialise(_paths[a_to_b], p_channel_a.get_fd(), p_channel_b.get_fd());
+      if (p_bidirectional) {
+        initialise(_paths[b_to_a], p_channel_b.get_fd(), p_channel_a.get_fd());
+      }
+    } // End of ctor
+
+    channel_relay::~channel_relay() {
+      for (uint8_t i = 0; i < 2; i++) {
+        for (uint8_t j = 0; j < 2; j++) {
+          if (_paths[i].pipe[j] != -1) {
+            ::close(_paths[i].pipe[j]);
+          }
+        } // End of 'for' statement
+      } // End of 'for' statement
+    } // End of dtor
+
+    const int32_t channel_relay::step(const int32_t p_timeout) {
+      struct pollfd fds[4];
+      nfds_t count = 0;
+      for (uint8_t i = 0; i < 2; i++) {
+        path & p = _paths[i];
+        if (!p.active) {
+          continue;
+        }
+        if (!p.eof && (p.pending < _buffer_size)) {
+          fds[count].fd = p.in;
+          fds[count].events = POLLIN;
+          fds[count++].revents = 0;
+        }
+        if (p.pending != 0) {
+          fds[count].fd = p.out;
+          fds[count].events = POLLOUT;
+          fds[count++].revents = 0;
+        }
+      } // End of 'for' statement
+      if (count == 0) {
+        return 0;
+      }
+
+      if (::poll(fds, count, p_timeout) < 0) {
+        if (errno == EINTR) {
+          return 0;
+        }
+        std::cerr << "channel_relay::step: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      int32_t moved = 0;
+      for (uint8_t i = 0; i < 2; i++) {
+        if (_paths[i].active) {
+          int32_t result = transfer(_paths[i]);
+          if (result == -1) {
+            return -1;
+          }
+          moved += result;
+        }
+      } // End of 'for' statement
+
+      return moved;
+    }
+
+    const int32_t channel_relay::run() {
+      while (active()) {
+        if (step(-1) == -1) {
+          return -1;
+        }
+      } // End of 'while' statement
+
+      return 0;
+    }
+
+    void channel_relay::initialise(path & p_path, const int32_t p_in, const int32_t p_out) {
+      p_path.in = p_in;
+      p_path.out = p_out;
+      p_path.active = true;
+
+      int32_t type = 0;
+      socklen_t length = sizeof(type);
+      p_path.datagram = (::getsockopt(p_in, SOL_SOCKET, SO_TYPE, (void *)&type, &length) == 0) && (type == SOCK_DGRAM);
+      if (!p_path.datagram && (::pipe2(p_path.pipe, O_NONBLOCK | O_CLOEXEC) == 0)) {
+        ::fcntl(p_path.pipe[1], F_SETPIPE_SZ, static_cast<int>(_buffer_size)); // Best effort
+        p_path.use_splice = true;
+      } else { // Datagram boundaries cannot go through a pipe
+        p_path.ring.assign(_buffer_size, 0x00);
+      }
+    }
+
+    const int32_t channel_relay::transfer(path & p_path) {
+      int32_t result = (p_path.use_splice) ? transfer_splice(p_path) : transfer_ring(p_path);
+      if ((result != -1) && p_path.eof && (p_path.pending == 0)) {
+        terminate(p_path);
+      }
+
+      return result;
+    }
+
+    const int32_t channel_relay::transfer_splice(path & p_path) {
+      int32_t moved = 0;
+      bool progress;
+      do {
+        progress = false;
+        if (!p_path.eof && (p_path.pending < _buffer_size)) {
+          ssize_t result = ::splice(p_path.in, NULL, p_path.pipe[1], NULL, _buffer_size - p_path.pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+          if (result > 0) {
+            p_path.pending += result;
+            progress = true;
+          } else if (result == 0) {
+            p_path.eof = true;
+          } else if (errno == EINVAL) { // Source does not support splice
+            return (fallback(p_path) == -1) ? -1 : moved + transfer_ring(p_path);
+          } else if ((errno != EAGAIN) && (errno != EINTR)) {
+            std::cerr << "channel_relay::transfer_splice: " << std::strerror(errno) << std::endl;
+            return -1;
+          }
+        }
+        if (p_path.pending != 0) {
+          ssize_t result = ::splice(p_path.pipe[0], NULL, p_path.out, NULL, p_path.pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+          if (result > 0) {
+            p_path.pending -= result;
+            p_path.bytes += result;
+            moved += result;
+            progress = true;
+          } else if ((result < 0) && (errno == EINVAL)) { // Destination does not support splice
+            return (fallback(p_path) == -1) ? -1 : moved + transfer_ring(p_path);
+          } else if ((result < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+            std::cerr << "channel_relay::transfer_splice: " << std::strerror(errno) << std::endl;
+            return -1;
+          }
+        }
+      } while (progress);
+
+      return moved;
+    }
+
+    const int32_t channel_relay::transfer_ring(path & p_path) {
+      const size_t size = p_path.ring.size();
+      uint8_t * ring = p_path.ring.data();
+      int32_t moved = 0;
+      bool progress;
+      do {
+        progress = false;
+        int32_t next = 0;
+        if (p_path.datagram && (::ioctl(p_path.in, FIONREAD, &next) == 0) && (p_path.pending != 0) && (static_cast<size_t>(next) > size - p_path.pending)) {
+          next = -1; // Wait for room to read the next datagram without truncating it
+        }
+        if (!p_path.eof && (p_path.pending < size) && (next != -1)) {
+          // Free space: from tail to the end of the ring, then from the beginning up to head
+          size_t tail = (p_path.head + p_path.pending) % size;
+          struct iovec iov[2];
+          int count = 1;
+          iov[0].iov_base = ring + tail;
+          if (tail >= p_path.head) {
+            iov[0].iov_len = size - tail;
+            iov[1].iov_base = ring;
+            iov[1].iov_len = p_path.head;
+            count = (p_path.head == 0) ? 1 : 2;
+          } else {
+            iov[0].iov_len = p_path.head - tail;
+          }
+          ssize_t result = ::readv(p_path.in, iov, count);
+          if (result > 0) {
+            p_path.pending += result;
+            progress = true;
+          } else if ((result == 0) && !p_path.datagram) {
+            p_path.eof = true;
+          } else if ((result < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+            std::cerr << "channel_relay::transfer_ring: " << std::strerror(errno) << std::endl;
+            return -1;
+          }
+        }
+        if (p_path.pending != 0) {
+          struct iovec iov[2];
+          int count = 1;
+          iov[0].iov_base = ring + p_path.head;
+          if (p_path.head + p_path.pending > size) {
+            iov[0].iov_len = size - p_path.head;
+            iov[1].iov_base = ring;
+            iov[1].iov_len = p_path.pending - iov[0].iov_len;
+            count = 2;
+          } else {
+            iov[0].iov_len = p_path.pending;
+          }
+          ssize_t result = ::writev(p_path.out, iov, count);
+          if (result > 0) {
+            p_path.head = (p_path.head + result) % size;
+            p_path.pending -= result;
+            p_path.bytes += result;
+            moved += result;
+            progress = true;
+            if (p_path.pending == 0) {
+              p_path.head = 0; // Keep the free space contiguous
+            }
+          } else if ((result < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+            std::cerr << "channel_relay::transfer_ring: " << std::strerror(errno) << std::endl;
+            return -1;
+          }
+        }
+      } while (progress);
+
+      return moved;
+    }
+
+    const int32_t channel_relay::fallback(path & p_path) {
+      std::clog << "channel_relay::fallback: splice not supported, use ring buffer for fd=" << p_path.in << std::endl;
+      p_path.ring.assign(_buffer_size, 0x00);
+      p_path.head = 0;
+      // Move the data already in the pipe into the ring buffer
+      size_t offset = 0;
+      while (offset < p_path.pending) {
+        ssize_t result = ::read(p_path.pipe[0], p_path.ring.data() + offset, p_path.pending - offset);
+        if (result <= 0) {
+          if ((result < 0) && (errno == EINTR)) {
+            continue;
+          }
+          std::cerr << "channel_relay::fallback: " << std::strerror(errno) << std::endl;
+          return -1;
+        }
+        offset += result;
+      } // End of 'while' statement
+      ::close(p_path.pipe[0]);
+      ::close(p_path.pipe[1]);
+      p_path.pipe[0] = p_path.pipe[1] = -1;
+      p_path.use_splice = false;
+
+      return 0;
+    }
+
+    void channel_relay::terminate(path & p_path) {
+      p_path.active = false;
+      ::shutdown(p_path.out, SHUT_WR); // Propagate the end of stream, fails silently if not a socket
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
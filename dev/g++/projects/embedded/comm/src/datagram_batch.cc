@@ -0,0 +1,92 @@
+/**
+ * @file      datagram_batch.cc
+ * @brief     Implementation file for batched datagram reception buffers.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <cstring>
+#include <algorithm>
+
+#include <time.h>
+
+#include "datagram_batch.hh"
+
+namespace comm {
+
+  namespace network {
+
+    datagram_batch::datagram_batch(const uint32_t p_slots, const uint32_t p_slot_size) :
+      _slot_size(p_slot_size),
+      _count(0),
+      _buffer(p_slots * p_slot_size, 0x00),
+      _controls(p_slots * control_size, 0x00),
+      _iovecs(p_slots),
+      _headers(p_slots),
+      _sources(p_slots),
+      _destinations(p_slots),
+      _timestamps(p_slots, 0) {
+      for (uint32_t i = 0; i < p_slots; i++) {
+        _iovecs[i].iov_base = _buffer.data() + i * _slot_size;
+        _iovecs[i].iov_len = _slot_size;
+      } // End of 'for' statement
+    } // End of ctor
+
+    struct mmsghdr * datagram_batch::prepare() {
+      _count = 0;
+      for (uint32_t i = 0; i < _headers.size(); i++) {
+        struct msghdr & hdr = _headers[i].msg_hdr;
+        hdr.msg_name = &_sources[i];
+        hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        hdr.msg_iov = &_iovecs[i];
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = _controls.data() + i * control_size;
+        hdr.msg_controllen = control_size;
+        hdr.msg_flags = 0;
+        _headers[i].msg_len = 0;
+      } // End of 'for' statement
+      return _headers.data();
+    }
+
+    void datagram_batch::complete(const uint32_t p_count) {
+      _count = p_count;
+      for (uint32_t i = 0; i < _count; i++) {
+        struct msghdr & hdr = _headers[i].msg_hdr;
+        struct sockaddr_storage & destination = _destinations[i];
+        destination.ss_family = AF_UNSPEC;
+        _timestamps[i] = 0;
+        for (struct cmsghdr * cmsg = CMSG_FIRSTHDR(&hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+          if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO)) {
+            struct in_pktinfo info;
+            ::memcpy((void *)&info, CMSG_DATA(cmsg), sizeof(struct in_pktinfo));
+            struct sockaddr_in * addr = reinterpret_cast<struct sockaddr_in *>(&destination);
+            addr->sin_family = AF_INET;
+            addr->sin_addr = info.ipi_addr;
+          } else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO)) {
+            struct in6_pktinfo info;
+            ::memcpy((void *)&info, CMSG_DATA(cmsg), sizeof(struct in6_pktinfo));
+            struct sockaddr_in6 * addr = reinterpret_cast<struct sockaddr_in6 *>(&destination);
+            addr->sin6_family = AF_INET6;
+            addr->sin6_addr = info.ipi6_addr;
+          } else if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS)) {
+            struct timespec ts;
+            ::memcpy((void *)&ts, CMSG_DATA(cmsg), sizeof(struct timespec));
+            _timestamps[i] = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+          }
+        } // End of 'for' statement
+      } // End of 'for' statement
+    }
+
+    void datagram_batch::copy(const uint32_t p_index, std::vector<uint8_t> & p_buffer) const {
+      const uint8_t * p = data(p_index);
+      p_buffer.assign(p, p + std::min(length(p_index), _slot_size));
+    }
+
+    void datagram_batch::copy(const uint32_t p_index, byte_buffer & p_buffer) const {
+      p_buffer.assign(data(p_index), std::min(length(p_index), _slot_size));
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
@@ -264,6 +264,9 @@ namespace comm {
       case channel_type::raw:
         result = this->send_raw(p_buffer);
         break;
+      case channel_type::can:
+        std::cerr << "ipv4_socket::send: CAN frames are not supported, use can_channel" << std::endl;
+        break;
       } // End of 'switch' statement
 
       return result;
@@ -288,6 +291,9 @@ namespace comm {
         result = this->receive_raw(p_buffer, &from);
       }
         break;
+      case channel_type::can:
+        std::cerr << "ipv4_socket::receive: CAN frames are not supported, use can_channel" << std::endl;
+        break;
       } // End of 'switch' statement
 
       return result;
@@ -312,6 +318,9 @@ namespace comm {
         result = this->receive_raw(p_buffer, p_length, &from);
       }
         break;
+      case channel_type::can:
+        std::cerr << "ipv4_socket::receive: CAN frames are not supported, use can_channel" << std::endl;
+        break;
       } // End of 'switch' statement
 
       return result;
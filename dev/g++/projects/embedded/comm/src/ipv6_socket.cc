@@ -165,6 +165,9 @@ namespace comm {
       case channel_type::raw:
 	// TODO 
 	break;
+      case channel_type::can:
+	std::cerr << "ipv6_socket::send: CAN frames are not supported, use can_channel" << std::endl;
+	break;
       } // End of 'switch' statement
 
       return result;
@@ -186,6 +189,9 @@ namespace comm {
       case channel_type::raw:
 	// TODO 
 	break;
+      case channel_type::can:
+	std::cerr << "ipv6_socket::receive: CAN frames are not supported, use can_channel" << std::endl;
+	break;
       } // End of 'switch' statement
 
       return result;
@@ -207,6 +213,9 @@ namespace comm {
       case channel_type::raw:
 	// TODO 
 	break;
+      case channel_type::can:
+	std::cerr << "ipv6_socket::receive: CAN frames are not supported, use can_channel" << std::endl;
+	break;
       } // End of 'switch' statement
 
       return result;
@@ -0,0 +1,280 @@
+/**
+ * @file      pcap_reader.cc
+ * @brief     Implementation file for the memory-mapped pcap/pcapng capture reader.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "pcap_reader.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /** Classic pcap magic numbers */
+    static const uint32_t pcap_magic_us = 0xa1b2c3d4;
+    static const uint32_t pcap_magic_ns = 0xa1b23c4d;
+    static const uint32_t pcap_header_size = 24;
+    static const uint32_t pcap_record_size = 16;
+    /** pcapng block types */
+    static const uint32_t section_header_block = 0x0A0D0D0A;
+    static const uint32_t interface_description_block = 0x00000001;
+    static const uint32_t simple_packet_block = 0x00000003;
+    static const uint32_t enhanced_packet_block = 0x00000006;
+    static const uint32_t byte_order_magic = 0x1A2B3C4D;
+
+    /**
+     * \brief Convert a timestamp expressed in p_units per second into nanoseconds
+     */
+    static inline uint64_t to_nanoseconds(const uint64_t p_timestamp, const uint64_t p_units) {
+      if (p_units == 1000000000ULL) {
+        return p_timestamp;
+      }
+      // The remainder is below p_units, up to 2^63: scaled on 128 bits so that sub-nanosecond resolutions do not overflow
+      return (p_timestamp / p_units) * 1000000000ULL + static_cast<uint64_t>(static_cast<unsigned __int128>(p_timestamp % p_units) * 1000000000ULL / p_units);
+    }
+
+    pcap_reader::pcap_reader(const std::string & p_file_name) : _file_name(p_file_name), _data(NULL), _size(0), _offset(0), _pcapng(false), _swapped(false), _units(1000000), _interface_units() {
+    } // End of ctor
+
+    pcap_reader::~pcap_reader() {
+      close();
+    } // End of dtor
+
+    const int32_t pcap_reader::open() {
+      if (_data != NULL) {
+        return 0;
+      }
+
+      int32_t fd = ::open(_file_name.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd == -1) {
+        std::cerr << "pcap_reader::open: " << _file_name << ": " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      struct stat st;
+      if (::fstat(fd, &st) == -1) {
+        std::cerr << "pcap_reader::open: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+      }
+      if (st.st_size < pcap_header_size) {
+        std::cerr << "pcap_reader::open: " << _file_name << ": File too short" << std::endl;
+        ::close(fd);
+        return -1;
+      }
+      void * data = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd); // The mapping keeps a reference on the file
+      if (data == MAP_FAILED) {
+        std::cerr << "pcap_reader::open: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+      _data = static_cast<const uint8_t *>(data);
+      _size = st.st_size;
+
+      // Identify the file format
+      uint32_t magic;
+      std::memcpy(&magic, _data, sizeof(magic));
+      if (magic == section_header_block) {
+        _pcapng = true;
+      } else if ((magic == pcap_magic_us) || (magic == __builtin_bswap32(pcap_magic_us))) {
+        _pcapng = false;
+        _swapped = (magic != pcap_magic_us);
+        _units = 1000000;
+      } else if ((magic == pcap_magic_ns) || (magic == __builtin_bswap32(pcap_magic_ns))) {
+        _pcapng = false;
+        _swapped = (magic != pcap_magic_ns);
+        _units = 1000000000;
+      } else {
+        std::cerr << "pcap_reader::open: " << _file_name << ": Unknown file format" << std::endl;
+        close();
+        return -1;
+      }
+      rewind();
+
+      return 0;
+    }
+
+    void pcap_reader::close() {
+      if (_data != NULL) {
+        ::munmap(const_cast<uint8_t *>(_data), _size);
+        _data = NULL;
+        _size = 0;
+      }
+    }
+
+    void pcap_reader::rewind() {
+      _offset = (_pcapng) ? 0 : pcap_header_size;
+      _interface_units.clear();
+    }
+
+    bool pcap_reader::next(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp) {
+      if (_data == NULL) {
+        return false;
+      }
+
+      return (_pcapng) ? next_pcapng(p_frame, p_length, p_timestamp) : next_pcap(p_frame, p_length, p_timestamp);
+    }
+
+    const int32_t pcap_reader::replay(const abstract_channel & p_channel, const bool p_timed) {
+      const uint8_t * frame;
+      uint32_t length;
+      uint64_t timestamp;
+      uint64_t first = 0;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      std::vector<uint8_t> buffer;
+      int32_t count = 0;
+      while (next(frame, length, timestamp)) {
+        if (p_timed) {
+          if (count == 0) {
+            first = timestamp;
+          } else if (timestamp > first) {
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(timestamp - first));
+          }
+        }
+        buffer.assign(frame, frame + length);
+        int32_t result;
+        while (((result = p_channel.write(buffer)) == -1) && (errno == EAGAIN) && (p_channel.get_pacer().get() != NULL)) { // Rate exceeded, wait for the pacer
+          std::this_thread::sleep_for(p_channel.pacing_delay());
+        } // End of 'while' statement
+        if (result == -1) {
+          return -1;
+        }
+        count += 1;
+      } // End of 'while' statement
+
+      return count;
+    }
+
+    bool pcap_reader::next_pcap(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp) {
+      if (_offset + pcap_record_size > _size) {
+        return false;
+      }
+      uint32_t length = get_u32(_offset + 8);
+      if (_offset + pcap_record_size + length > _size) {
+        std::cerr << "pcap_reader::next: Truncated record" << std::endl;
+        return false;
+      }
+      p_timestamp = static_cast<uint64_t>(get_u32(_offset)) * 1000000000ULL + to_nanoseconds(get_u32(_offset + 4), _units);
+      p_length = length;
+      p_frame = _data + _offset + pcap_record_size;
+      _offset += pcap_record_size + length;
+
+      return true;
+    }
+
+    bool pcap_reader::next_pcapng(const uint8_t *& p_frame, uint32_t & p_length, uint64_t & p_timestamp) {
+      while (_offset + 12 <= _size) {
+        uint32_t type;
+        std::memcpy(&type, _data + _offset, sizeof(type));
+        if (type == section_header_block) { // New section, byte order may change
+          uint32_t magic;
+          std::memcpy(&magic, _data + _offset + 8, sizeof(magic));
+          if ((magic != byte_order_magic) && (magic != __builtin_bswap32(byte_order_magic))) {
+            std::cerr << "pcap_reader::next: Invalid section header" << std::endl;
+            return false;
+          }
+          _swapped = (magic != byte_order_magic);
+          _interface_units.clear();
+        } else {
+          type = get_u32(_offset);
+        }
+        uint32_t length = get_u32(_offset + 4);
+        if ((length < 12) || ((length & 3) != 0) || (_offset + length > _size)) {
+          std::cerr << "pcap_reader::next: Invalid block length" << std::endl;
+          return false;
+        }
+        size_t offset = _offset;
+        _offset += length;
+
+        switch (type) {
+        case interface_description_block:
+          if (!parse_interface(offset, length)) {
+            std::cerr << "pcap_reader::next: Invalid interface description block" << std::endl;
+            return false;
+          }
+          break;
+        case enhanced_packet_block: {
+          if (length < 32) {
+            return false;
+          }
+          uint32_t interface = get_u32(offset + 8);
+          uint64_t timestamp = (static_cast<uint64_t>(get_u32(offset + 12)) << 32) | get_u32(offset + 16);
+          uint32_t captured = get_u32(offset + 20);
+          if (captured > length - 32) {
+            std::cerr << "pcap_reader::next: Invalid captured length" << std::endl;
+            return false;
+          }
+          p_timestamp = to_nanoseconds(timestamp, (interface < _interface_units.size()) ? _interface_units[interface] : 1000000);
+          p_length = captured;
+          p_frame = _data + offset + 28;
+          return true;
+        }
+        case simple_packet_block: {
+          if (length < 16) {
+            return false;
+          }
+          uint32_t original = get_u32(offset + 8);
+          p_timestamp = 0;
+          p_length = (original < length - 16) ? original : length - 16;
+          p_frame = _data + offset + 12;
+          return true;
+        }
+        default:
+          // Skip the other blocks
+          break;
+        } // End of 'switch' statement
+      } // End of 'while' statement
+
+      return false;
+    }
+
+    bool pcap_reader::parse_interface(const size_t p_offset, const uint32_t p_length) {
+      uint64_t units = 1000000; // Default resolution is microsecond
+      size_t offset = p_offset + 16;
+      size_t end = p_offset + p_length - 4;
+      while (offset + 4 <= end) {
+        uint16_t code = get_u16(offset);
+        uint16_t length = get_u16(offset + 2);
+        if ((code == 0) || (offset + 4 + length > end)) { // opt_endofopt
+          break;
+        }
+        if ((code == 9) && (length == 1)) { // if_tsresol
+          uint8_t value = _data[offset + 4];
+          if ((value & 0x80) != 0) {
+            if ((value & 0x7f) > 63) { // 2^exponent does not fit into 64 bits
+              return false;
+            }
+            units = 1ULL << (value & 0x7f);
+          } else {
+            if (value > 19) { // 10^exponent does not fit into 64 bits
+              return false;
+            }
+            units = 1;
+            for (uint8_t i = 0; i < value; i++) {
+              units *= 10;
+            } // End of 'for' statement
+          }
+        }
+        offset += 4 + ((length + 3) & ~3U);
+      } // End of 'while' statement
+      _interface_units.push_back(units);
+
+      return true;
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
@@ -0,0 +1,277 @@
+/**
+ * @file      pcapng_writer.cc
+ * @brief     Implementation file for the buffered pcapng capture writer.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "pcapng_writer.hh"
+
+namespace comm {
+
+  namespace network {
+
+    /** pcapng block types */
+    static const uint32_t section_header_block = 0x0A0D0D0A;
+    static const uint32_t interface_description_block = 0x00000001;
+    static const uint32_t enhanced_packet_block = 0x00000006;
+    static const uint32_t byte_order_magic = 0x1A2B3C4D;
+    /** Size of the Enhanced Packet Block without the frame data */
+    static const uint32_t epb_header_size = 28;
+    static const uint32_t epb_trailer_size = 4;
+
+    static inline void put_u16(uint8_t * p_buffer, const uint16_t p_value) { std::memcpy(p_buffer, &p_value, sizeof(p_value)); }
+    static inline void put_u32(uint8_t * p_buffer, const uint32_t p_value) { std::memcpy(p_buffer, &p_value, sizeof(p_value)); }
+
+    pcapng_writer::pcapng_writer(const std::string & p_file_name, const uint32_t p_buffer_size, const uint64_t p_max_file_size, const uint64_t p_max_duration, const uint16_t p_link_type, const uint32_t p_snap_length) :
+      _file_name(p_file_name),
+      _link_type(p_link_type),
+      _snap_length(p_snap_length),
+      _max_file_size(p_max_file_size),
+      _max_duration(p_max_duration * 1000000000ULL),
+      _buffer(p_buffer_size, 0x00),
+      _used(0),
+      _fd(-1),
+      _index(0),
+      _file_size(0),
+      _file_start(0),
+      _header_pending(false),
+      _frames(0),
+      _bytes(0) {
+    } // End of ctor
+
+    pcapng_writer::~pcapng_writer() {
+      close();
+    } // End of dtor
+
+    const int32_t pcapng_writer::open() {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      if (_fd != -1) {
+        return 0;
+      }
+
+      std::string name = file_name();
+      if ((_fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) == -1) {
+        std::cerr << "pcapng_writer::open: " << name << ": " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      _header_pending = true;
+      _file_size = 0;
+      _file_start = now();
+
+      return 0;
+    }
+
+    const int32_t pcapng_writer::close() {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      if (_fd == -1) {
+        return 0;
+      }
+
+      int32_t result = flush();
+      if (result == -1) { // Kept by flush() for a retry, lost once the file is closed
+        std::cerr << "pcapng_writer::close: " << _used << " bytes of pending frames lost" << std::endl;
+        _used = 0;
+      }
+      if (::close(_fd) == -1) {
+        std::cerr << "pcapng_writer::close: " << std::strerror(errno) << std::endl;
+        result = -1;
+      }
+      _fd = -1;
+
+      return result;
+    }
+
+    const int32_t pcapng_writer::write(const uint8_t * p_frame, const uint32_t p_length) {
+      return write(p_frame, p_length, now());
+    }
+
+    const int32_t pcapng_writer::write(const uint8_t * p_frame, const uint32_t p_length, const uint64_t p_timestamp) {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      if ((_fd == -1) && (open() == -1)) {
+        return -1;
+      }
+
+      uint32_t captured = (p_length > _snap_length) ? _snap_length : p_length;
+      uint32_t padded = (captured + 3) & ~3U;
+      uint32_t block_length = epb_header_size + padded + epb_trailer_size;
+
+      // Check rotation
+      if (((_max_file_size != 0) && (_file_size != 0) && (_file_size + block_length > _max_file_size)) || ((_max_duration != 0) && (p_timestamp > _file_start) && (p_timestamp - _file_start >= _max_duration))) {
+        if (rotate() == -1) {
+          return -1;
+        }
+      }
+
+      uint8_t header[epb_header_size];
+      put_u32(header, enhanced_packet_block);
+      put_u32(header + 4, block_length);
+      put_u32(header + 8, 0); // Interface identifier
+      put_u32(header + 12, static_cast<uint32_t>(p_timestamp >> 32));
+      put_u32(header + 16, static_cast<uint32_t>(p_timestamp & 0xffffffff));
+      put_u32(header + 20, captured);
+      put_u32(header + 24, p_length);
+
+      if (block_length > _buffer.size()) { // Frame larger than the buffer, write it directly
+        if (flush() == -1) {
+          return -1;
+        }
+        uint8_t trailer[3 + epb_trailer_size] = { 0 };
+        put_u32(trailer + (padded - captured), block_length);
+        struct iovec iov[3] = {
+          { static_cast<void *>(header), epb_header_size },
+          { const_cast<uint8_t *>(p_frame), captured },
+          { static_cast<void *>(trailer), padded - captured + epb_trailer_size }
+        };
+        if (write_vector(iov, 3) == -1) {
+          return -1;
+        }
+      } else {
+        if ((_used + block_length > _buffer.size()) && (flush() == -1)) {
+          return -1;
+        }
+        uint8_t * p = _buffer.data() + _used;
+        std::memcpy(p, header, epb_header_size);
+        std::memcpy(p + epb_header_size, p_frame, captured);
+        std::memset(p + epb_header_size + captured, 0x00, padded - captured);
+        put_u32(p + epb_header_size + padded, block_length);
+        _used += block_length;
+      }
+      _file_size += block_length;
+      _frames += 1;
+
+      return 0;
+    }
+
+    const int32_t pcapng_writer::flush() {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      if ((_fd == -1) || ((_used == 0) && !_header_pending)) {
+        return 0;
+      }
+
+      struct iovec iov = { static_cast<void *>(_buffer.data()), _used };
+      size_t written = 0;
+      int32_t result = write_vector(&iov, 1, &written);
+      if (result == -1) { // Keep the bytes not written, the next flush() resumes where this one stopped
+        std::memmove(_buffer.data(), _buffer.data() + written, _used - written);
+      }
+      _used -= static_cast<uint32_t>(written);
+
+      return result;
+    }
+
+    std::string pcapng_writer::file_name() const {
+      std::lock_guard<std::recursive_mutex> lock(_mutex);
+      if (_index == 0) {
+        return _file_name;
+      }
+
+      std::ostringstream os;
+      os << _file_name << "." << _index;
+      return os.str();
+    }
+
+    const int32_t pcapng_writer::rotate() {
+      if (close() == -1) {
+        return -1;
+      }
+      _index += 1;
+
+      return open();
+    }
+
+    const int32_t pcapng_writer::write_vector(struct iovec * p_iov, const uint32_t p_count, size_t * p_written) {
+      // Prepend the section header and the interface description blocks for a new file
+      std::vector<struct iovec> iov;
+      iov.reserve(p_count + 1);
+      std::vector<uint8_t> header;
+      if (_header_pending) {
+        append_header(header);
+        struct iovec h = { static_cast<void *>(header.data()), header.size() };
+        iov.push_back(h);
+        _file_size += header.size();
+      }
+      iov.insert(iov.end(), p_iov, p_iov + p_count);
+
+      // Write all the vectors, handling partial writes
+      const size_t header_size = header.size();
+      size_t written = 0;
+      size_t index = 0;
+      while (index < iov.size()) {
+        ssize_t result = ::writev(_fd, &iov[index], static_cast<int>(iov.size() - index));
+        if (result < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          std::cerr << "pcapng_writer::write_vector: " << std::strerror(errno) << std::endl;
+          if (written >= header_size) {
+            _header_pending = false;
+          }
+          if (p_written != nullptr) {
+            *p_written = (written > header_size) ? written - header_size : 0;
+          }
+          return -1;
+        }
+        _bytes += result;
+        written += result;
+        while ((index < iov.size()) && (static_cast<size_t>(result) >= iov[index].iov_len)) {
+          result -= iov[index].iov_len;
+          index += 1;
+        } // End of 'while' statement
+        if (index < iov.size()) {
+          iov[index].iov_base = static_cast<uint8_t *>(iov[index].iov_base) + result;
+          iov[index].iov_len -= result;
+        }
+      } // End of 'while' statement
+      _header_pending = false;
+      if (p_written != nullptr) {
+        *p_written = written - header_size;
+      }
+
+      return 0;
+    }
+
+    void pcapng_writer::append_header(std::vector<uint8_t> & p_header) const {
+      // Section Header Block: no option, unspecified section length
+      p_header.assign(28 + 32, 0x00);
+      uint8_t * p = p_header.data();
+      put_u32(p, section_header_block);
+      put_u32(p + 4, 28);
+      put_u32(p + 8, byte_order_magic);
+      put_u16(p + 12, 1); // Major version
+      put_u16(p + 14, 0); // Minor version
+      std::memset(p + 16, 0xff, 8); // Section length
+      put_u32(p + 24, 28);
+      // Interface Description Block with if_tsresol option set to nanoseconds
+      p += 28;
+      put_u32(p, interface_description_block);
+      put_u32(p + 4, 32);
+      put_u16(p + 8, _link_type);
+      put_u16(p + 10, 0);
+      put_u32(p + 12, _snap_length);
+      put_u16(p + 16, 9); // if_tsresol
+      put_u16(p + 18, 1);
+      p[20] = 9; // 10^-9
+      put_u32(p + 24, 0); // opt_endofopt
+      put_u32(p + 28, 32);
+    }
+
+    uint64_t pcapng_writer::now() {
+      struct timespec ts;
+      ::clock_gettime(CLOCK_REALTIME, &ts);
+      return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
@@ -58,7 +58,12 @@ namespace comm {
 	return 0;
       }
       
-      return _socket->send(converter::get_instance().string_to_bytes(p_string));
+      std::vector<uint8_t> buffer = converter::get_instance().string_to_bytes(p_string);
+      int32_t result = _socket->send(buffer);
+      if ((result != -1) && (_capture.get() != NULL)) {
+        _capture->write(buffer);
+      }
+      return result;
     }
 
     const int32_t raw_channel::write(const std::vector<uint8_t> & p_buffer) const {
@@ -66,7 +71,11 @@ namespace comm {
 	return 0;
       }
 
-      return _socket->send(p_buffer);
+      int32_t result = _socket->send(p_buffer);
+      if ((result != -1) && (_capture.get() != NULL)) {
+        _capture->write(p_buffer);
+      }
+      return result;
     }
 
     const int32_t raw_channel::read(std::vector<uint8_t> & p_buffer) const {
@@ -74,7 +83,11 @@ namespace comm {
 	return 0;
       }
 
-      return _socket->receive(p_buffer);
+      int32_t result = _socket->receive(p_buffer);
+      if ((result != -1) && (_capture.get() != NULL)) {
+        _capture->write(p_buffer);
+      }
+      return result;
     }
 
     const uint8_t raw_channel::read() const {
@@ -0,0 +1,148 @@
+/**
+ * @file      stream_reader.cc
+ * @brief     Implementation file for the buffered channel reader.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include "stream_reader.hh"
+#include "abstract_channel.hh"
+
+namespace comm {
+
+  namespace network {
+
+    stream_reader::stream_reader(const abstract_channel & p_channel, const size_t p_size, const size_t p_max_size) : _channel(p_channel), _buffer(p_size, 0x00), _head(0), _tail(0), _max_size(p_max_size), _eof(false), _fills(0) {
+    } // End of ctor
+
+    const int32_t stream_reader::read_line(std::string & p_line) {
+      std::vector<uint8_t> buffer;
+      int32_t result = read_until('\n', buffer);
+      if (result <= 0) {
+        return result;
+      }
+
+      size_t length = buffer.size();
+      if (buffer[length - 1] == '\n') { // Not present on the last line of the stream
+        length -= 1;
+        if ((length != 0) && (buffer[length - 1] == '\r')) {
+          length -= 1;
+        }
+      }
+      p_line.assign(reinterpret_cast<const char *>(buffer.data()), length);
+
+      return result;
+    }
+
+    const int32_t stream_reader::read_until(const uint8_t p_delimiter, std::vector<uint8_t> & p_buffer) {
+      size_t scanned = 0; // Number of bytes already scanned, relative to _head because fill() may move the data
+      while (true) {
+        const uint8_t * p = static_cast<const uint8_t *>(::memchr(_buffer.data() + _head + scanned, p_delimiter, available() - scanned));
+        if (p != NULL) {
+          size_t length = p - (_buffer.data() + _head) + 1;
+          p_buffer.assign(_buffer.data() + _head, _buffer.data() + _head + length);
+          _head += length;
+          return static_cast<int32_t>(length);
+        }
+        scanned = available();
+        int32_t result = fill();
+        if ((result == -1) && _eof && (scanned != 0)) { // End of stream, the remaining bytes are the last chunk
+          p_buffer.assign(_buffer.data() + _head, _buffer.data() + _tail);
+          _head = _tail;
+          return static_cast<int32_t>(scanned);
+        } else if (result <= 0) {
+          return result;
+        }
+      } // End of 'while' statement
+    }
+
+    const int32_t stream_reader::read_exact(const size_t p_length, std::vector<uint8_t> & p_buffer) {
+      if (p_length > _max_size) {
+        std::cerr << "stream_reader::read_exact: Length exceeds the maximum buffer size" << std::endl;
+        return -1;
+      }
+
+      while (available() < p_length) {
+        int32_t result = fill();
+        if (result <= 0) {
+          return result;
+        }
+      } // End of 'while' statement
+      p_buffer.assign(_buffer.data() + _head, _buffer.data() + _head + p_length);
+      _head += p_length;
+
+      return static_cast<int32_t>(p_length);
+    }
+
+    const int32_t stream_reader::peek(uint8_t & p_byte) {
+      if (available() == 0) {
+        int32_t result = fill();
+        if (result <= 0) {
+          return result;
+        }
+      }
+      p_byte = _buffer[_head];
+
+      return 1;
+    }
+
+    size_t stream_reader::drain(uint8_t * p_buffer, const size_t p_length) {
+      size_t length = (p_length < available()) ? p_length : available();
+      ::memcpy(p_buffer, _buffer.data() + _head, length);
+      _head += length;
+
+      return length;
+    }
+
+    const int32_t stream_reader::fill() {
+      if (_eof) {
+        return -1;
+      }
+
+      // Make room at the end of the buffer
+      if (_head == _tail) {
+        _head = _tail = 0;
+      } else if ((_tail == _buffer.size()) && (_head != 0)) {
+        ::memmove(_buffer.data(), _buffer.data() + _head, available());
+        _tail -= _head;
+        _head = 0;
+      }
+      if (_tail == _buffer.size()) {
+        if (_buffer.size() >= _max_size) {
+          std::cerr << "stream_reader::fill: Maximum buffer size reached" << std::endl;
+          return -1;
+        }
+        _buffer.resize(std::min(_buffer.size() * 2, _max_size));
+      }
+
+      ssize_t result;
+      do {
+        result = ::read(_channel.get_fd(), _buffer.data() + _tail, _buffer.size() - _tail);
+      } while ((result < 0) && (errno == EINTR));
+      _fills += 1;
+      if (result < 0) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+          return 0;
+        }
+        std::cerr << "stream_reader::fill: " << std::strerror(errno) << std::endl;
+        return -1;
+      } else if (result == 0) {
+        _eof = true;
+        return -1;
+      }
+      _tail += result;
+
+      return static_cast<int32_t>(result);
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
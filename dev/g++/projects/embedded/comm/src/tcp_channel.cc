@@ -12,11 +12,32 @@
 #include "tcp_channel.hh"
 
 #include "converter.hh"
+#include "object_pool.hh"
 
 namespace comm {
 
   namespace network {
 
+    /**
+     * \brief Returns the pool of the TCP channels. It is never destroyed, channels may be deleted by static destructors
+     */
+    static object_pool<tcp_channel> & channel_pool() {
+      static object_pool<tcp_channel> * pool = new object_pool<tcp_channel>(16);
+      return *pool;
+    }
+
+    void * tcp_channel::operator new(size_t p_size) {
+      return (p_size == sizeof(tcp_channel)) ? channel_pool().allocate() : ::operator new(p_size); // Derived classes are not pooled
+    }
+
+    void tcp_channel::operator delete(void * p_channel, size_t p_size) {
+      if (p_size == sizeof(tcp_channel)) {
+        channel_pool().deallocate(p_channel);
+      } else {
+        ::operator delete(p_channel);
+      }
+    }
+
     tcp_channel::tcp_channel(const socket_address & p_host_address) { // Constructor for a TCP client
       _socket.reset(new socket(p_host_address, channel_type::tcp));
       if (_socket.get() == NULL) {
@@ -70,7 +91,10 @@ namespace comm {
       if (p_string.length() == 0) {
         return 0;
       }
-      
+
+      if (!pace(p_string.length())) {
+        return -1;
+      }
       return _socket->send(converter::get_instance().string_to_bytes(p_string));
     }
 
@@ -79,6 +103,9 @@ namespace comm {
         return 0;
       }
 
+      if (!pace(p_buffer.size())) {
+        return -1;
+      }
       return _socket->send(p_buffer);
     }
 
@@ -89,17 +116,24 @@ namespace comm {
         return 0;
       }
 
+      // Data already buffered by the stream reader shall be consumed first
+      if ((_reader.get() != NULL) && (_reader->available() != 0)) {
+        p_buffer.resize(_reader->drain(p_buffer.data(), p_buffer.size()));
+        return 0;
+      }
+
       return _socket->receive(p_buffer);
     }
 
     const uint8_t tcp_channel::read() const {
       std::clog << ">>> tcp_channel::read (1)" << std::endl;
 
-      uint32_t length = 1;
+      // Use the stream reader to avoid one system call per byte
       uint8_t buffer[1] = { 0 };
-      if (_socket->receive(&buffer[0], &length) < 0) {
+      if (reader().peek(buffer[0]) <= 0) {
         return '\00';
       }
+      reader().drain(&buffer[0], 1);
       return (uint8_t)buffer[0];
     }
 
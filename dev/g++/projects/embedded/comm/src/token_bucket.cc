@@ -0,0 +1,59 @@
+/**
+ * @file      token_bucket.cc
+ * @brief     Implementation file for the outbound traffic pacer.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ */
+#include <thread>
+
+#include "token_bucket.hh"
+
+namespace comm {
+
+  namespace network {
+
+    token_bucket::token_bucket(const uint64_t p_rate, const uint64_t p_burst) : _rate(0), _burst(0), _tolerance(0), _tat(std::chrono::steady_clock::now()), _mutex() {
+      set_rate(p_rate, p_burst);
+    } // End of ctor
+
+    bool token_bucket::try_consume(const uint64_t p_size) {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_rate == 0) {
+        return true;
+      }
+      std::chrono::steady_clock::time_point tat = (_tat < now) ? now : _tat;
+      if (tat - now > _tolerance) {
+        return false; // Bucket empty
+      }
+      _tat = tat + cost(p_size);
+
+      return true;
+    }
+
+    void token_bucket::consume(const uint64_t p_size) {
+      while (!try_consume(p_size)) {
+        std::this_thread::sleep_for(delay());
+      } // End of 'while' statement
+    }
+
+    std::chrono::nanoseconds token_bucket::delay() const {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::chrono::nanoseconds wait = std::chrono::duration_cast<std::chrono::nanoseconds>(_tat - _tolerance - now);
+      return (wait.count() < 0) ? std::chrono::nanoseconds(0) : wait;
+    }
+
+    void token_bucket::set_rate(const uint64_t p_rate, const uint64_t p_burst) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _rate = p_rate;
+      _burst = p_burst;
+      _tolerance = cost(_burst);
+      _tat = std::chrono::steady_clock::now();
+    }
+
+  } // End of namespace network
+
+} // End of namespace comm
@@ -9,6 +9,9 @@
 #include <cstring>
 #include <stdexcept>
 
+#include <net/if.h> // Used for if_nametoindex
+#include <netinet/in.h>
+
 #include "udp_channel.hh"
 
 #include "converter.hh"
@@ -17,7 +20,7 @@ namespace comm {
 
   namespace network {
 
-    udp_channel::udp_channel(const socket_address & p_host_address) { // Constructorfor an UDP client
+    udp_channel::udp_channel(const socket_address & p_host_address) : _is_ipv6(p_host_address.is_ipv6()), _pktinfo(false), _groups() { // Constructorfor an UDP client
       _socket.reset(new socket(p_host_address));
       if (_socket.get() == NULL) {
       	std::cerr << "udp_channel::udp_channel: " << std::strerror(errno) << std::endl;
@@ -26,7 +29,7 @@ namespace comm {
       // _socket->bind();
     }
 
-    udp_channel::udp_channel(const socket_address & p_host_address, const socket_address & p_remote_address) { // Constructorfor an UDP server
+    udp_channel::udp_channel(const socket_address & p_host_address, const socket_address & p_remote_address) : _is_ipv6(p_host_address.is_ipv6()), _pktinfo(false), _groups() { // Constructorfor an UDP server
       _socket.reset(new socket(p_host_address, p_remote_address));
       if (_socket.get() == NULL) {
       	std::cerr << "udp_channel::udp_channel: " << std::strerror(errno) << std::endl;
@@ -56,6 +59,9 @@ namespace comm {
         return 0;
       }
 
+      if (!pace(p_string.length())) {
+        return -1;
+      }
       return _socket->send(converter::get_instance().string_to_bytes(p_string));
     }
 
@@ -64,6 +70,9 @@ namespace comm {
         return 0;
       }
 
+      if (!pace(p_buffer.size())) {
+        return -1;
+      }
       return _socket->send(p_buffer);
     }
 
@@ -84,6 +93,219 @@ namespace comm {
       return (uint8_t)buffer[0];
     }
 
+    const int32_t udp_channel::read(datagram_batch & p_batch) const {
+      int32_t result;
+      do {
+        result = ::recvmmsg(_socket->get_fd(), p_batch.prepare(), p_batch.capacity(), MSG_WAITFORONE, NULL);
+      } while ((result < 0) && (errno == EINTR));
+      if (result < 0) {
+        p_batch.complete(0);
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+          return 0; // Nothing pending on a non-blocking socket
+        }
+        std::cerr << "udp_channel::read: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      p_batch.complete(static_cast<uint32_t>(result));
+
+      // Update per-group counters
+      if (!_groups.empty()) {
+        for (uint32_t i = 0; i < p_batch.size(); i++) {
+          if (p_batch.destination(i).ss_family == AF_UNSPEC) {
+            continue;
+          }
+          std::map<multicast_group_key, multicast_statistics>::iterator it = _groups.find(to_multicast_group_key(p_batch.destination(i)));
+          if (it != _groups.end()) {
+            it->second.datagrams += 1;
+            it->second.bytes += p_batch.length(i);
+            if (p_batch.truncated(i)) {
+              it->second.truncated += 1;
+            }
+          }
+        } // End of 'for' statement
+      }
+
+      return result;
+    }
+
+    const int32_t udp_channel::join_group(const socket_address & p_group, const std::string & p_nic_name) const {
+      int32_t if_index = membership(MCAST_JOIN_GROUP, p_group, NULL, p_nic_name);
+      if (if_index == -1) {
+        return -1;
+      }
+      struct sockaddr_storage group;
+      to_storage(p_group, group);
+      multicast_statistics & statistics = _groups[to_multicast_group_key(group)];
+      statistics.if_index = static_cast<uint32_t>(if_index);
+      return 0;
+    }
+
+    const int32_t udp_channel::join_source_group(const socket_address & p_group, const socket_address & p_source, const std::string & p_nic_name) const {
+      int32_t if_index = membership(MCAST_JOIN_SOURCE_GROUP, p_group, &p_source, p_nic_name);
+      if (if_index == -1) {
+        return -1;
+      }
+      struct sockaddr_storage group;
+      to_storage(p_group, group);
+      multicast_statistics & statistics = _groups[to_multicast_group_key(group)];
+      statistics.if_index = static_cast<uint32_t>(if_index);
+      statistics.sources += 1;
+      return 0;
+    }
+
+    const int32_t udp_channel::leave_group(const socket_address & p_group, const std::string & p_nic_name) const {
+      if (membership(MCAST_LEAVE_GROUP, p_group, NULL, p_nic_name) == -1) {
+        return -1;
+      }
+      struct sockaddr_storage group;
+      to_storage(p_group, group);
+      _groups.erase(to_multicast_group_key(group));
+      return 0;
+    }
+
+    const int32_t udp_channel::leave_source_group(const socket_address & p_group, const socket_address & p_source, const std::string & p_nic_name) const {
+      if (membership(MCAST_LEAVE_SOURCE_GROUP, p_group, &p_source, p_nic_name) == -1) {
+        return -1;
+      }
+      struct sockaddr_storage group;
+      to_storage(p_group, group);
+      std::map<multicast_group_key, multicast_statistics>::iterator it = _groups.find(to_multicast_group_key(group));
+      if (it != _groups.end()) {
+        if (it->second.sources <= 1) { // Last source, the kernel drops the membership
+          _groups.erase(it);
+        } else {
+          it->second.sources -= 1;
+        }
+      }
+      return 0;
+    }
+
+    const int32_t udp_channel::set_multicast_interface(const std::string & p_nic_name) const {
+      uint32_t if_index = ::if_nametoindex(p_nic_name.c_str());
+      if (if_index == 0) {
+        std::cerr << "udp_channel::set_multicast_interface: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      int32_t result;
+      if (_is_ipv6) {
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IPV6, IPV6_MULTICAST_IF, (const void *)&if_index, sizeof(if_index));
+      } else {
+        struct ip_mreqn mreq;
+        ::memset((void *)&mreq, 0x00, sizeof(mreq));
+        mreq.imr_ifindex = if_index;
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IP, IP_MULTICAST_IF, (const void *)&mreq, sizeof(mreq));
+      }
+      if (result == -1) {
+        std::cerr << "udp_channel::set_multicast_interface: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      return 0;
+    }
+
+    const int32_t udp_channel::set_multicast_loop(const bool p_loop) const {
+      int32_t result;
+      if (_is_ipv6) {
+        uint32_t loop = p_loop ? 1 : 0;
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IPV6, IPV6_MULTICAST_LOOP, (const void *)&loop, sizeof(loop));
+      } else {
+        uint8_t loop = p_loop ? 1 : 0;
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IP, IP_MULTICAST_LOOP, (const void *)&loop, sizeof(loop));
+      }
+      if (result == -1) {
+        std::cerr << "udp_channel::set_multicast_loop: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      return 0;
+    }
+
+    const int32_t udp_channel::set_multicast_ttl(const uint8_t p_ttl) const {
+      int32_t result;
+      if (_is_ipv6) {
+        int32_t hops = p_ttl;
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IPV6, IPV6_MULTICAST_HOPS, (const void *)&hops, sizeof(hops));
+      } else {
+        result = ::setsockopt(_socket->get_fd(), IPPROTO_IP, IP_MULTICAST_TTL, (const void *)&p_ttl, sizeof(p_ttl));
+      }
+      if (result == -1) {
+        std::cerr << "udp_channel::set_multicast_ttl: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+      return 0;
+    }
+
+    const int32_t udp_channel::get_group_statistics(const socket_address & p_group, multicast_statistics & p_statistics) const {
+      struct sockaddr_storage group;
+      to_storage(p_group, group);
+      std::map<multicast_group_key, multicast_statistics>::const_iterator it = _groups.find(to_multicast_group_key(group));
+      if (it == _groups.end()) {
+        return -1;
+      }
+      p_statistics = it->second;
+      return 0;
+    }
+
+    const int32_t udp_channel::membership(const int32_t p_option, const socket_address & p_group, const socket_address * p_source, const std::string & p_nic_name) const {
+      // Sanity checks
+      if (!p_group.is_multicast() || (p_group.is_ipv6() != _is_ipv6) || ((p_source != NULL) && (p_source->is_ipv6() != _is_ipv6))) {
+        std::cerr << "udp_channel::membership: Invalid group/source address" << std::endl;
+        return -1;
+      }
+
+      uint32_t if_index = 0;
+      if (!p_nic_name.empty()) {
+        if ((if_index = ::if_nametoindex(p_nic_name.c_str())) == 0) {
+          std::cerr << "udp_channel::membership: " << std::strerror(errno) << std::endl;
+          return -1;
+        }
+      }
+      int32_t level = (_is_ipv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+
+      // Request the destination address of each datagram, used to dispatch the per-group counters
+      if (!_pktinfo) {
+        int32_t on = 1;
+        if (::setsockopt(_socket->get_fd(), level, (_is_ipv6) ? IPV6_RECVPKTINFO : IP_PKTINFO, (const void *)&on, sizeof(on)) == -1) {
+          std::cerr << "udp_channel::membership: " << std::strerror(errno) << std::endl;
+          return -1;
+        }
+        _pktinfo = true;
+      }
+
+      int32_t result;
+      if (p_source == NULL) {
+        struct group_req req;
+        ::memset((void *)&req, 0x00, sizeof(req));
+        req.gr_interface = if_index;
+        to_storage(p_group, req.gr_group);
+        result = ::setsockopt(_socket->get_fd(), level, p_option, (const void *)&req, sizeof(req));
+      } else {
+        struct group_source_req req;
+        ::memset((void *)&req, 0x00, sizeof(req));
+        req.gsr_interface = if_index;
+        to_storage(p_group, req.gsr_group);
+        to_storage(*p_source, req.gsr_source);
+        result = ::setsockopt(_socket->get_fd(), level, p_option, (const void *)&req, sizeof(req));
+      }
+      if (result == -1) {
+        std::cerr << "udp_channel::membership: " << std::strerror(errno) << std::endl;
+        return -1;
+      }
+
+      return static_cast<int32_t>(if_index);
+    }
+
+    void udp_channel::to_storage(const socket_address & p_address, struct sockaddr_storage & p_storage) const {
+      ::memset((void *)&p_storage, 0x00, sizeof(struct sockaddr_storage));
+      if (p_address.is_ipv6()) {
+        struct sockaddr_in6 * addr = reinterpret_cast<struct sockaddr_in6 *>(&p_storage);
+        addr->sin6_family = AF_INET6;
+        ::memcpy((void *)&addr->sin6_addr, p_address.addr(), p_address.length());
+      } else {
+        struct sockaddr_in * addr = reinterpret_cast<struct sockaddr_in *>(&p_storage);
+        addr->sin_family = AF_INET;
+        ::memcpy((void *)&addr->sin_addr, p_address.addr(), p_address.length());
+      }
+    }
+
   } // End of namespace network
 
 } // End of namespace comm
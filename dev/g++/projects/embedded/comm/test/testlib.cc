@@ -9,17 +9,29 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <fstream>
 #include <algorithm>
 #include <chrono>
 #include <thread>
 
+#include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <net/if.h>
+
 #include <gtest.h>
 #define ASSERT_TRUE_MSG(exp1, msg) ASSERT_TRUE(exp1) << msg
 
 #include "socket_address.hh"
 #include "channel_manager.hh"
+#include "pcap_reader.hh"
+#include "channel_relay.hh"
+#include "can_channel.hh"
 
 #include "runnable.hh"
+#include "runtime.hh"
 
 #define LOCAL_IPv4_ADDRESS "10.0.2.15"
 #define LOCAL_IPv4_PORT    12345
@@ -634,6 +646,593 @@ TEST(channel_manager_tcp_test_suite, create_channel_tcp_5) {
   ASSERT_TRUE(channel_manager::get_instance().remove_channel(channel) != -1);
 } // End of method test_create_channel_tcp_5
   
+/**
+ * @class Channel manager/UDP multicast test suite implementation
+ */
+class channel_manager_mcast_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see abstract_channel::join_group
+ * @see abstract_channel::set_multicast_loop
+ * @see abstract_channel::set_multicast_ttl
+ * @see abstract_channel::read(datagram_batch &)
+ * @see abstract_channel::get_group_statistics
+ * @see abstract_channel::leave_group
+ */
+TEST(channel_manager_mcast_test_suite, udp_multicast_1) {
+  // Create UDP listener and join the group
+  socket_address host(std::string(ANY_IPv4_ADDRESS), static_cast<const uint16_t>(12350));
+  socket_address group(std::string("239.255.0.1"), static_cast<const uint16_t>(12350));
+  int32_t listener = channel_manager::get_instance().create_channel(channel_type::udp, host, group);
+  ASSERT_TRUE(listener != -1);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).join_group(group) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).join_group(host) == -1); // Not a multicast address
+
+  // Create UDP sender
+  int32_t sender = channel_manager::get_instance().create_channel(channel_type::udp, group);
+  ASSERT_TRUE(sender != -1);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(sender).set_multicast_loop(true) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(sender).set_multicast_ttl(1) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(sender).connect() != -1);
+  std::vector<uint8_t> buffer = { 'H', 'e', 'l', 'l', 'o' };
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(channel_manager::get_instance().get_channel(sender).write(buffer) != -1);
+  } // End of 'for' statement
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Read all the datagrams at once
+  datagram_batch batch(8, 1500);
+  int32_t result = channel_manager::get_instance().get_channel(listener).read(batch);
+  ASSERT_TRUE(result == 3);
+  ASSERT_TRUE(batch.size() == 3);
+  ASSERT_TRUE(batch.length(0) == buffer.size());
+  ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), batch.data(2)));
+  ASSERT_TRUE(batch.destination(0).ss_family == AF_INET);
+  byte_buffer payload;
+  batch.copy(1, payload);
+  ASSERT_TRUE(payload.is_inline() && (payload == byte_buffer(buffer)));
+
+  // Check statistics
+  multicast_statistics statistics;
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).get_group_statistics(group, statistics) == 0);
+  ASSERT_TRUE(statistics.datagrams == 3);
+  ASSERT_TRUE(statistics.bytes == 3 * buffer.size());
+  ASSERT_TRUE(statistics.truncated == 0);
+
+  // Nothing more pending
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).read(batch) == 0);
+
+  // Leave the group
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).leave_group(group) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(listener).get_group_statistics(group, statistics) == -1);
+
+  // Remove channels
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(sender) != -1);
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(listener) != -1);
+} // End of method udp_multicast_1
+  
+/**
+ * @class Token bucket/pacing test suite implementation
+ */
+class token_bucket_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see token_bucket::try_consume
+ * @see token_bucket::delay
+ */
+TEST(token_bucket_test_suite, token_bucket_1) {
+  token_bucket bucket(1000, 100); // 1000 bytes/s, 100 bytes burst
+  ASSERT_TRUE(bucket.try_consume(100));
+  ASSERT_TRUE(bucket.try_consume(100));
+  ASSERT_FALSE(bucket.try_consume(100));
+  ASSERT_TRUE(bucket.delay() > std::chrono::milliseconds(50));
+  ASSERT_TRUE(bucket.delay() <= std::chrono::milliseconds(100));
+  std::this_thread::sleep_for(bucket.delay());
+  ASSERT_TRUE(bucket.try_consume(100));
+
+  // Unlimited
+  bucket.set_rate(0, 0);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(bucket.try_consume(1500));
+  } // End of 'for' statement
+  ASSERT_TRUE(bucket.delay() == std::chrono::nanoseconds(0));
+} // End of method token_bucket_1
+
+/**
+ * @brief Test case for @see abstract_channel::set_pacing_rate - User space pacing
+ */
+TEST(token_bucket_test_suite, udp_pacing_1) {
+  socket_address addr(std::string("127.0.0.1"), static_cast<const uint16_t>(12351));
+  int32_t channel = channel_manager::get_instance().create_channel(channel_type::udp, addr);
+  ASSERT_TRUE(channel != -1);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(10000, 100, pacing_mode::user) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).get_pacer().get() != NULL);
+
+  std::vector<uint8_t> buffer(100, 0x55);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).write(buffer) != -1);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).write(buffer) != -1);
+  // Rate exceeded: write() does not block
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).write(buffer) == -1);
+  ASSERT_TRUE(errno == EAGAIN);
+  ASSERT_TRUE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(5));
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).pacing_delay() > std::chrono::nanoseconds(0));
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).pacing_delay() <= std::chrono::milliseconds(10));
+
+  // Send the remaining datagrams from the event loop
+  runtime rt(false);
+  ASSERT_TRUE(rt.is_open());
+  int sent = 2;
+  ASSERT_TRUE(rt.add_timer(std::chrono::milliseconds(2), [&rt, &sent, &buffer, channel](const uint64_t p_expirations) {
+        while ((sent < 10) && (channel_manager::get_instance().get_channel(channel).write(buffer) != -1)) {
+          sent += 1;
+        } // End of 'while' statement
+        if (sent == 10) {
+          rt.stop();
+        }
+      }) != -1);
+  ASSERT_TRUE(rt.run() == 0);
+  ASSERT_TRUE(sent == 10);
+  ASSERT_TRUE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(70)); // 1000 bytes at 10000 bytes/s minus the burst
+
+  // Disable pacing
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(0, 0, pacing_mode::user) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).get_pacer().get() == NULL);
+  
+  // Kernel pacing: the datagrams are paced by the kernel only with the fq qdisc, user space pacer otherwise
+  std::ifstream qdisc("/proc/sys/net/core/default_qdisc");
+  std::string default_qdisc;
+  qdisc >> default_qdisc;
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(1000000, 0) == 0);
+  ASSERT_TRUE((channel_manager::get_instance().get_channel(channel).get_pacer().get() == NULL) == (default_qdisc == "fq"));
+
+  // A shared pacer is kept
+  std::shared_ptr<token_bucket> shared(new token_bucket(20000, 100));
+  channel_manager::get_instance().get_channel(channel).set_pacer(shared);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(1000000, 0, pacing_mode::kernel_fq) == 0);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).get_pacer() == shared);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(10000, 100, pacing_mode::user) == -1);
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).get_pacer() == shared);
+  channel_manager::get_instance().get_channel(channel).set_pacer(std::shared_ptr<token_bucket>());
+  ASSERT_TRUE(channel_manager::get_instance().get_channel(channel).set_pacing_rate(10000, 100, pacing_mode::user) == 0);
+  uint32_t rate = 0;
+  socklen_t length = sizeof(rate);
+  ASSERT_TRUE(::getsockopt(channel_manager::get_instance().get_channel(channel).get_fd(), SOL_SOCKET, SO_MAX_PACING_RATE, &rate, &length) == 0);
+  ASSERT_TRUE(rate == ~0U); // Kernel limit cleared
+    
+  // Remove channel
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(channel) != -1);
+} // End of method udp_pacing_1
+  
+/**
+ * @class Capture writer/reader test suite implementation
+ */
+class capture_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see pcapng_writer::write
+ * @see pcap_reader::next
+ */
+TEST(capture_test_suite, pcapng_1) {
+  std::string file_name("/tmp/test_comm_1.pcapng");
+  pcapng_writer writer(file_name, 256); // Small buffer to exercise the flush and the large frame paths
+  ASSERT_TRUE(writer.open() == 0);
+  std::vector<uint8_t> frame(61, 0x00);
+  for (uint32_t i = 0; i < 10; i++) {
+    frame[0] = static_cast<uint8_t>(i);
+    ASSERT_TRUE(writer.write(frame.data(), frame.size(), 1000000000ULL + i) == 0);
+  } // End of 'for' statement
+  std::vector<uint8_t> large(1000, 0xaa);
+  ASSERT_TRUE(writer.write(large.data(), large.size(), 2000000000ULL) == 0);
+  ASSERT_TRUE(writer.close() == 0);
+  ASSERT_TRUE(writer.frames() == 11);
+
+  pcap_reader reader(file_name);
+  ASSERT_TRUE(reader.open() == 0);
+  const uint8_t * data;
+  uint32_t length;
+  uint64_t timestamp;
+  for (uint32_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(reader.next(data, length, timestamp));
+    ASSERT_TRUE(length == frame.size());
+    ASSERT_TRUE(data[0] == i);
+    ASSERT_TRUE(timestamp == 1000000000ULL + i);
+  } // End of 'for' statement
+  ASSERT_TRUE(reader.next(data, length, timestamp));
+  ASSERT_TRUE(length == large.size());
+  ASSERT_TRUE(std::equal(large.begin(), large.end(), data));
+  ASSERT_TRUE(timestamp == 2000000000ULL);
+  ASSERT_FALSE(reader.next(data, length, timestamp));
+  reader.rewind();
+  ASSERT_TRUE(reader.next(data, length, timestamp));
+  ASSERT_TRUE(data[0] == 0);
+  reader.close();
+  std::remove(file_name.c_str());
+} // End of method pcapng_1
+
+/**
+ * @brief Test case for @see pcapng_writer rotation
+ */
+TEST(capture_test_suite, pcapng_2) {
+  std::string file_name("/tmp/test_comm_2.pcapng");
+  pcapng_writer writer(file_name, 4096, 1024); // Rotate every 1024 bytes
+  std::vector<uint8_t> frame(100, 0x55);
+  for (uint32_t i = 0; i < 20; i++) {
+    ASSERT_TRUE(writer.write(frame) == 0);
+  } // End of 'for' statement
+  ASSERT_TRUE(writer.file_name() != file_name);
+  ASSERT_TRUE(writer.close() == 0);
+
+  // Each file shall be readable on its own
+  pcap_reader reader(file_name + ".1");
+  ASSERT_TRUE(reader.open() == 0);
+  const uint8_t * data;
+  uint32_t length;
+  uint64_t timestamp;
+  int count = 0;
+  while (reader.next(data, length, timestamp)) {
+    ASSERT_TRUE(length == frame.size());
+    count += 1;
+  } // End of 'while' statement
+  ASSERT_TRUE(count > 0);
+  ASSERT_TRUE(count < 20);
+  reader.close();
+  std::remove(file_name.c_str());
+  for (int i = 1; i < 20; i++) {
+    std::remove((file_name + "." + std::to_string(i)).c_str());
+  } // End of 'for' statement
+} // End of method pcapng_2
+
+/**
+ * @brief Test case for @see pcapng_writer shared between several threads
+ */
+TEST(capture_test_suite, pcapng_3) {
+  std::string file_name("/tmp/test_comm_3.pcapng");
+  pcapng_writer writer(file_name, 1024);
+  std::vector<std::thread> threads;
+  for (uint8_t t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&writer, t]() {
+          std::vector<uint8_t> frame(64, t);
+          for (uint32_t i = 0; i < 500; i++) {
+            writer.write(frame);
+          } // End of 'for' statement
+        }));
+  } // End of 'for' statement
+  for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+    it->join();
+  } // End of 'for' statement
+  ASSERT_TRUE(writer.close() == 0);
+  ASSERT_TRUE(writer.frames() == 2000);
+
+  pcap_reader reader(file_name);
+  ASSERT_TRUE(reader.open() == 0);
+  const uint8_t * data;
+  uint32_t length;
+  uint64_t timestamp;
+  int count = 0;
+  while (reader.next(data, length, timestamp)) {
+    ASSERT_TRUE(length == 64);
+    ASSERT_TRUE(std::count(data, data + length, data[0]) == 64); // Frames are not interleaved
+    count += 1;
+  } // End of 'while' statement
+  ASSERT_TRUE(count == 2000);
+  reader.close();
+  std::remove(file_name.c_str());
+} // End of method pcapng_3
+
+/**
+ * @brief Test case for @see pcap_reader::next with an out of range if_tsresol option
+ */
+TEST(capture_test_suite, pcapng_4) {
+  std::string file_name("/tmp/test_comm_4.pcapng");
+  const uint8_t resolutions[] = { 0x80 | 64, 0x80 | 127, 20, 127 };
+  for (uint32_t r = 0; r < sizeof(resolutions); r++) {
+    uint32_t blocks[] = {
+      0x0A0D0D0A, 28, 0x1A2B3C4D, 0x00000001, 0xffffffff, 0xffffffff, 28,       // Section header block
+      0x00000001, 28, 0x00000001, 65535, 0x00010009, resolutions[r], 28,         // Interface description block with if_tsresol
+      0x00000006, 32, 0, 0, 0, 0, 0, 32                                          // Enhanced packet block
+    };
+    std::ofstream os(file_name.c_str(), std::ios::binary);
+    os.write(reinterpret_cast<const char *>(blocks), sizeof(blocks));
+    os.close();
+
+    pcap_reader reader(file_name);
+    ASSERT_TRUE(reader.open() == 0);
+    const uint8_t * data;
+    uint32_t length;
+    uint64_t timestamp;
+    ASSERT_FALSE(reader.next(data, length, timestamp));
+    reader.close();
+  } // End of 'for' statement
+  std::remove(file_name.c_str());
+} // End of method pcapng_4
+
+/**
+ * @brief Test case for @see pcap_reader::next with a picosecond resolution (if_tsresol = 12)
+ */
+TEST(capture_test_suite, pcapng_5) {
+  std::string file_name("/tmp/test_comm_5.pcapng");
+  const uint64_t picoseconds = 1234567890123456789ULL; // 1234567.890123456789 s
+  uint32_t blocks[] = {
+    0x0A0D0D0A, 28, 0x1A2B3C4D, 0x00000001, 0xffffffff, 0xffffffff, 28,                                                  // Section header block
+    0x00000001, 28, 0x00000001, 65535, 0x00010009, 12, 28,                                                                // Interface description block with if_tsresol
+    0x00000006, 32, 0, static_cast<uint32_t>(picoseconds >> 32), static_cast<uint32_t>(picoseconds & 0xffffffff), 0, 0, 32 // Enhanced packet block
+  };
+  std::ofstream os(file_name.c_str(), std::ios::binary);
+  os.write(reinterpret_cast<const char *>(blocks), sizeof(blocks));
+  os.close();
+
+  pcap_reader reader(file_name);
+  ASSERT_TRUE(reader.open() == 0);
+  const uint8_t * data;
+  uint32_t length;
+  uint64_t timestamp;
+  ASSERT_TRUE(reader.next(data, length, timestamp));
+  ASSERT_TRUE(length == 0);
+  ASSERT_TRUE(timestamp == picoseconds / 1000);
+  reader.close();
+  std::remove(file_name.c_str());
+} // End of method pcapng_5
+
+/**
+ * @brief Test case for @see pcapng_writer::flush failing on a partial write: the bytes not written are kept for the next flush
+ */
+TEST(capture_test_suite, pcapng_6) {
+  std::string file_name("/tmp/test_comm_6.pcapng");
+  pcapng_writer writer(file_name, 64 * 1024);
+  std::vector<uint8_t> frame(61, 0x00);
+  for (uint32_t i = 0; i < 100; i++) {
+    frame[0] = static_cast<uint8_t>(i);
+    ASSERT_TRUE(writer.write(frame.data(), frame.size(), 1000000000ULL + i) == 0);
+  } // End of 'for' statement
+
+  struct rlimit saved, limit;
+  ASSERT_TRUE(::getrlimit(RLIMIT_FSIZE, &saved) == 0);
+  limit = saved;
+  limit.rlim_cur = 4096; // The file cannot grow beyond 4096 bytes: EFBIG
+  void (* handler)(int) = ::signal(SIGXFSZ, SIG_IGN);
+  ASSERT_TRUE(::setrlimit(RLIMIT_FSIZE, &limit) == 0);
+  const int32_t failed = writer.flush();
+  ::setrlimit(RLIMIT_FSIZE, &saved);
+  ::signal(SIGXFSZ, handler);
+  ASSERT_TRUE(failed == -1);
+  ASSERT_TRUE(writer.close() == 0); // Resumes the flush
+
+  pcap_reader reader(file_name);
+  ASSERT_TRUE(reader.open() == 0);
+  const uint8_t * data;
+  uint32_t length;
+  uint64_t timestamp;
+  for (uint32_t i = 0; i < 100; i++) {
+    ASSERT_TRUE(reader.next(data, length, timestamp));
+    ASSERT_TRUE((length == frame.size()) && (data[0] == i) && (timestamp == 1000000000ULL + i));
+  } // End of 'for' statement
+  ASSERT_FALSE(reader.next(data, length, timestamp));
+  reader.close();
+  std::remove(file_name.c_str());
+} // End of method pcapng_6
+  
+/**
+ * @class Stream reader test suite implementation
+ */
+class stream_reader_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see abstract_channel::read_line
+ * @see abstract_channel::read_until
+ * @see abstract_channel::read_exact
+ * @see abstract_channel::peek
+ */
+TEST(stream_reader_test_suite, stream_reader_1) {
+  int fds[2];
+  ASSERT_TRUE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  socket_address addr(std::string("127.0.0.1"), static_cast<const uint16_t>(12352));
+  int32_t channel = channel_manager::get_instance().create_channel(fds[0], addr, addr); // Non-blocking TCP channel
+  ASSERT_TRUE(channel != -1);
+  const abstract_channel & c = channel_manager::get_instance().get_channel(channel);
+
+  std::string data("line1\r\nline2\npart");
+  ASSERT_TRUE(::write(fds[1], data.c_str(), data.length()) == static_cast<ssize_t>(data.length()));
+  std::string line;
+  ASSERT_TRUE(c.read_line(line) == 7);
+  ASSERT_TRUE(line == "line1");
+  ASSERT_TRUE(c.read_line(line) == 6);
+  ASSERT_TRUE(line == "line2");
+  ASSERT_TRUE(c.read_line(line) == 0); // Incomplete
+  data.assign("ial\nabc;defgh");
+  ASSERT_TRUE(::write(fds[1], data.c_str(), data.length()) == static_cast<ssize_t>(data.length()));
+  ASSERT_TRUE(c.read_line(line) == 8);
+  ASSERT_TRUE(line == "partial");
+  std::vector<uint8_t> buffer;
+  ASSERT_TRUE(c.read_until(';', buffer) == 4);
+  ASSERT_TRUE(std::string(buffer.begin(), buffer.end()) == "abc;");
+  uint8_t byte;
+  ASSERT_TRUE(c.peek(byte) == 1);
+  ASSERT_TRUE(byte == 'd');
+  ASSERT_TRUE(c.read_exact(3, buffer) == 3);
+  ASSERT_TRUE(std::string(buffer.begin(), buffer.end()) == "def");
+  ASSERT_TRUE(c.read_exact(3, buffer) == 0); // Incomplete
+  ASSERT_TRUE(c.read() == 'g');
+  buffer.assign(10, 0x00);
+  ASSERT_TRUE(c.read(buffer) == 0); // Buffered data consumed first
+  ASSERT_TRUE(buffer.size() == 1);
+  ASSERT_TRUE(buffer[0] == 'h');
+
+  // Peer closed
+  ::close(fds[1]);
+  ASSERT_TRUE(c.read_line(line) == -1);
+
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(channel) != -1);
+} // End of method stream_reader_1
+
+/**
+ * @brief Test case for @see abstract_channel::read_line - Last line without end of line
+ * @see abstract_channel::read_until
+ */
+TEST(stream_reader_test_suite, stream_reader_2) {
+  int fds[2];
+  ASSERT_TRUE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  socket_address addr(std::string("127.0.0.1"), static_cast<const uint16_t>(12352));
+  int32_t channel = channel_manager::get_instance().create_channel(fds[0], addr, addr);
+  ASSERT_TRUE(channel != -1);
+  const abstract_channel & c = channel_manager::get_instance().get_channel(channel);
+
+  std::string data("line1\nlast\r");
+  ASSERT_TRUE(::write(fds[1], data.c_str(), data.length()) == static_cast<ssize_t>(data.length()));
+  std::string line;
+  ASSERT_TRUE(c.read_line(line) == 6);
+  ASSERT_TRUE(line == "line1");
+  ASSERT_TRUE(c.read_line(line) == 0); // Incomplete while the peer is connected
+  ::close(fds[1]);
+  ASSERT_TRUE(c.read_line(line) == 5);
+  ASSERT_TRUE(line == "last\r"); // Only a complete end of line is removed
+  ASSERT_TRUE(c.read_line(line) == -1);
+
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(channel) != -1);
+} // End of method stream_reader_2
+  
+/**
+ * @class Channel relay test suite implementation
+ */
+class channel_relay_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see channel_relay::step - Stream to stream, using splice
+ */
+TEST(channel_relay_test_suite, channel_relay_1) {
+  int a[2], b[2];
+  ASSERT_TRUE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, a) == 0);
+  ASSERT_TRUE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, b) == 0);
+  channel_relay relay(a[1], b[0]);
+  ASSERT_TRUE(relay.zero_copy(channel_relay::a_to_b));
+
+  char buffer[64];
+  ASSERT_TRUE(::write(a[0], "Hello World", 11) == 11);
+  ASSERT_TRUE(relay.step(100) == 11);
+  ASSERT_TRUE(::read(b[1], buffer, sizeof(buffer)) == 11);
+  ASSERT_TRUE(std::memcmp(buffer, "Hello World", 11) == 0);
+  ASSERT_TRUE(::write(b[1], "Hi man", 6) == 6);
+  ASSERT_TRUE(relay.step(100) == 6);
+  ASSERT_TRUE(::read(a[0], buffer, sizeof(buffer)) == 6);
+  ASSERT_TRUE(relay.bytes(channel_relay::a_to_b) == 11);
+  ASSERT_TRUE(relay.bytes(channel_relay::b_to_a) == 6);
+
+  // End of stream is propagated
+  ::close(a[0]);
+  relay.step(100);
+  ASSERT_TRUE(::read(b[1], buffer, sizeof(buffer)) == 0);
+  ASSERT_TRUE(relay.active());
+  ::close(b[1]);
+  relay.step(100);
+  ASSERT_FALSE(relay.active());
+  ::close(a[1]);
+  ::close(b[0]);
+} // End of method channel_relay_1
+
+/**
+ * @brief Test case for @see channel_relay::step - Datagram to file, using the ring buffer
+ */
+TEST(channel_relay_test_suite, channel_relay_2) {
+  int a[2];
+  ASSERT_TRUE(::socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, a) == 0);
+  std::string file_name("/tmp/test_comm_relay.bin");
+  int fd = ::open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  ASSERT_TRUE(fd != -1);
+  channel_relay relay(a[1], fd, false, 16);
+  ASSERT_FALSE(relay.zero_copy(channel_relay::a_to_b));
+
+  ASSERT_TRUE(::write(a[0], "0123456789", 10) == 10);
+  ASSERT_TRUE(::write(a[0], "abcdefghij", 10) == 10);
+  ASSERT_TRUE(relay.step(100) == 20);
+  ASSERT_TRUE(relay.bytes(channel_relay::a_to_b) == 20);
+  char buffer[64];
+  ASSERT_TRUE(::pread(fd, buffer, sizeof(buffer), 0) == 20);
+  ASSERT_TRUE(std::memcmp(buffer, "0123456789abcdefghij", 20) == 0);
+
+  ::close(fd);
+  ::close(a[0]);
+  ::close(a[1]);
+  std::remove(file_name.c_str());
+} // End of method channel_relay_2
+  
+/**
+ * @class Channel manager/CAN test suite implementation
+ */
+class channel_manager_can_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+	
+/**
+ * @brief Test case for @see channel_manager::create_channel - CAN
+ * Use command sudo modprobe vcan && sudo ip link add dev vcan0 type vcan && sudo ip link set vcan0 mtu 72 up to create the virtual CAN interface
+ * @see can_channel::set_filters
+ * @see can_channel::read(datagram_batch &)
+ */
+TEST(channel_manager_can_test_suite, create_channel_can_1) {
+  if (::if_nametoindex("vcan0") == 0) {
+    GTEST_SKIP() << "vcan0 not available";
+  }
+  int32_t receiver = channel_manager::get_instance().create_channel(channel_type::can, std::string("vcan0"));
+  ASSERT_TRUE(receiver != -1);
+  int32_t sender = channel_manager::get_instance().create_channel(channel_type::can, std::string("vcan0"));
+  ASSERT_TRUE(sender != -1);
+  ASSERT_TRUE(channel_manager::get_instance().create_channel(channel_type::can, std::string("unknown0")) == -1);
+
+  // Receive only the identifier 0x123
+  can_channel & r = dynamic_cast<can_channel &>(channel_manager::get_instance().get_channel(receiver));
+  std::vector<struct can_filter> filters(1);
+  filters[0].can_id = 0x123;
+  filters[0].can_mask = CAN_SFF_MASK;
+  ASSERT_TRUE(r.set_filters(filters) == 0);
+
+  const can_channel & s = dynamic_cast<const can_channel &>(channel_manager::get_instance().get_channel(sender));
+  struct can_frame frame;
+  std::memset(&frame, 0x00, sizeof(frame));
+  for (uint8_t i = 0; i < 4; i++) {
+    frame.can_id = (i % 2 == 0) ? 0x123 : 0x456;
+    frame.can_dlc = 1;
+    frame.data[0] = i;
+    ASSERT_TRUE(s.write(frame) == 0);
+  } // End of 'for' statement
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  datagram_batch batch(8, CANFD_MTU);
+  ASSERT_TRUE(r.read(batch) == 2);
+  for (uint32_t i = 0; i < batch.size(); i++) {
+    ASSERT_TRUE(batch.length(i) == CAN_MTU);
+    const struct can_frame * f = reinterpret_cast<const struct can_frame *>(batch.data(i));
+    ASSERT_TRUE(f->can_id == 0x123);
+    ASSERT_TRUE(f->data[0] == 2 * i);
+    ASSERT_TRUE(batch.timestamp(i) != 0);
+  } // End of 'for' statement
+
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(sender) != -1);
+  ASSERT_TRUE(channel_manager::get_instance().remove_channel(receiver) != -1);
+} // End of method create_channel_can_1
+  
 /**
  * @brief Main test program
  * @param[in] p_argc Number of argumrnt
@@ -21,6 +21,11 @@
 #include <climits> // LONG_MAX, LLONG_MAX
 #include <ctime>   // time_t, struct tm, difftime, time, mktime
 
+#include <stdexcept> // Used for std::invalid_argument, std::out_of_range
+
+#include "endianness.hh"
+#include "numeric.hh"
+
 namespace helpers {
 
   /*!
@@ -163,6 +168,42 @@ namespace helpers {
      */
     std::string time_to_string(const struct tm & p_time);
 
+  private:
+    /*!
+     * \brief Store a value into a new bytes array
+     * \param[in] p_value The value
+     * \param[in] p_endianess Endianess style
+     * \return The bytes array value
+     */
+    template<typename T> inline std::vector<uint8_t> to_bytes(const T p_value, const endian_t p_endianess) const {
+      std::vector<uint8_t> result(sizeof(T));
+      if (p_endianess == big_endian) {
+        store_be(result.data(), p_value);
+      } else {
+        store_le(result.data(), p_value);
+      }
+      return result;
+    }; // End of to_bytes
+
+    /*!
+     * \brief Load an integral value from a bytes array of up to sizeof(T) bytes
+     * \param[in] p_value The bytes array
+     * \param[in] p_endianess Endianess style
+     * \return The integral value
+     */
+    template<typename T> inline T from_bytes(const std::vector<uint8_t> & p_value, const endian_t p_endianess) const {
+      if (p_value.size() == sizeof(T)) {
+        return (p_endianess == big_endian) ? load_be<T>(p_value.data()) : load_le<T>(p_value.data());
+      }
+      // Shorter bytes array
+      T value = 0;
+      for (size_t i = 0; i < p_value.size(); i++) {
+        value = (value << 8) + p_value[(p_endianess == big_endian) ? i : p_value.size() - 1 - i];
+      } // End of 'for' statement
+      return value;
+    }; // End of from_bytes
+
+  public:
     /*!
      * \brief Convert a 16-bits integer (int16_t) into a bytes array
      * \param[in] p_value The 16-bits integer value
@@ -170,12 +211,7 @@ namespace helpers {
      * \return The bytes array value
      */
     inline std::vector<uint8_t> short_to_bytes(const int16_t p_value, const endian_t p_endianess = big_endian) const {
-      std::vector<uint8_t> result(sizeof(short), 0x00);
-      for (int i = sizeof(short) - 1; i >= 0; i--) {
-        int offset = (sizeof(short) - 1 - i) * 8;
-        result[i] = static_cast<uint8_t>((p_value >> offset) & 0xFF);
-      } // End of 'for' statement
-      return result;
+      return to_bytes(p_value, p_endianess);
     }; // End of short_to_bytes
 
     /*!
@@ -186,14 +222,10 @@ namespace helpers {
      */
     inline int16_t bytes_to_short(const std::vector<uint8_t> & p_value, const endian_t p_endianess = big_endian) const {
       // Sanity check
-      if (p_value.size() > sizeof(short)) {
+      if (p_value.size() > sizeof(int16_t)) {
         return SHRT_MAX;
       }
-      int16_t value = 0;
-      for (size_t i = 0; i < p_value.size(); i++) {
-        value = (value << 8) + (p_value[i] & 0xff);
-      } // End of 'for' statement
-      return value;
+      return from_bytes<int16_t>(p_value, p_endianess);
     }; // End of bytes_to_short
 
     /*!
@@ -203,19 +235,7 @@ namespace helpers {
      * \return The bytes array value
      */
     inline std::vector<uint8_t> int_to_bytes(const int32_t p_value, const endian_t p_endianess = big_endian) const {
-      /*uint8_t bytes[sizeof(p_value)];
-      std::copy(
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)),
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)) + sizeof(p_value),
-                bytes
-		);
-		std::vector<uint8_t> result(bytes, bytes + sizeof(bytes) / sizeof(uint8_t));*/
-      std::vector<uint8_t> result(sizeof(int), 0x00);
-      for (int i = sizeof(int) - 1; i >= 0; i--) {
-        int offset = (sizeof(int) - 1 - i) * 8;
-        result[i] = static_cast<uint8_t>((p_value >> offset) & 0xFF);
-      } // End of 'for' statement
-      return result;
+      return to_bytes(p_value, p_endianess);
     }; // End of int_to_bytes
 
     /*!
@@ -226,15 +246,10 @@ namespace helpers {
      */
     inline int32_t bytes_to_int(const std::vector<uint8_t> & p_value, const endian_t p_endianess = big_endian) const {
       // Sanity check
-      if (p_value.size() > sizeof(int)) {
+      if (p_value.size() > sizeof(int32_t)) {
         return INT_MAX;
       }
-      int32_t value = 0;
-      for (size_t i = 0; i < p_value.size(); i++) {
-        value = (value << 8) + (p_value[i] & 0xff);
-      } // End of 'for' statement
-      return value;
-      //      return *((int *)(&p_value[0]));
+      return from_bytes<int32_t>(p_value, p_endianess);
     }; // End of bytes_to_int
 
     /*!
@@ -244,19 +259,7 @@ namespace helpers {
      * \return The bytes array value
      */
     inline std::vector<uint8_t> long_to_bytes(const int64_t p_value, const endian_t p_endianess = big_endian) const {
-      /*uint8_t bytes[sizeof(p_value)];
-      std::copy(
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)),
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)) + sizeof(p_value),
-                bytes
-		);
-		std::vector<uint8_t> result(bytes, bytes + sizeof(bytes) / sizeof(uint8_t));*/
-      std::vector<uint8_t> result(sizeof(int64_t), 0x00);
-      for (int i = sizeof(int64_t) - 1; i >= 0; i--) {
-        int offset = (sizeof(int64_t) - 1 - i) * 8;
-        result[i] = static_cast<uint8_t>((p_value >> offset) & 0xFF);
-      } // End of 'for' statement
-      return result;
+      return to_bytes(p_value, p_endianess);
     }; // End of long_to_bytes
 
     /*!
@@ -270,28 +273,20 @@ namespace helpers {
       if (p_value.size() > sizeof(int64_t)) {
         return LLONG_MAX;
       }
-      int64_t value = 0;
-      for (size_t i = 0; i < p_value.size(); i++) {
-        value = (value << 8) + (p_value[i] & 0xff);
-      } // End of 'for' statement
-      return value;
-      //      return *((long *)(&p_value[0]));
+      return from_bytes<int64_t>(p_value, p_endianess);
     }; // End of bytes_to_long
 
     /*!
      * \brief Convert a float value into a bytes array
      * \param[in] p_value The float value
-     * \return The bytes array value
+     * \return The bytes array value, in host byte order
      */
     inline std::vector<uint8_t> float_to_bytes(const float p_value) const {
-      uint8_t bytes[sizeof(p_value)];
-      std::copy(
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)),
-                static_cast<const uint8_t *>(static_cast<const void *>(&p_value)) + sizeof(p_value),
-                bytes
-		);
-      std::vector<uint8_t> result(bytes, bytes + sizeof(bytes) / sizeof(uint8_t));
-      return result;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      return to_bytes(p_value, little_endian);
+#else
+      return to_bytes(p_value, big_endian);
+#endif
     }; // End of float_to_long
 
     /*!
@@ -300,7 +295,11 @@ namespace helpers {
      * \return The float value
      */
     inline float bytes_to_float(const std::vector<uint8_t> & p_value) const {
-      return *((float *)(&p_value[0]));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      return load_le<float>(p_value.data());
+#else
+      return load_be<float>(p_value.data());
+#endif
     }; // End of bytes_to_float
 
     /*!
@@ -324,24 +323,66 @@ namespace helpers {
   public:
     /*!
      * \brief Convert a string into an integer
-     * \param[in] p_value The string value
+     * \param[in] p_value The string value. Leading whitespaces and '+' sign are ignored
      * \return The integer value
+     * \exception std::invalid_argument if the string does not start with a number, std::out_of_range if the number does not fit, as std::stoi
+     * \see parse_integer to convert without exception
      */
     inline int32_t string_to_int(const std::string & p_value) const {
-      return std::stoi(p_value);
-      //return atoi(p_value.c_str());
+      const char * first = number_start(p_value);
+      int32_t value = 0;
+      check(parse_integer(first, p_value.c_str() + p_value.length(), value), "string_to_int");
+      return value;
     }; // End of string_to_int
 
+    /*!
+     * \brief Convert a string into a floating point value
+     * \param[in] p_value The string value. Leading whitespaces and '+' sign are ignored
+     * \return The floating point value
+     * \exception std::invalid_argument if the string does not start with a number, std::out_of_range if the number does not fit, as std::stof
+     * \see parse_float to convert without exception
+     */
+    inline float string_to_float(const std::string & p_value) const {
+      const char * first = number_start(p_value);
+      float value = 0.0;
+      check(parse_float(first, p_value.c_str() + p_value.length(), value), "string_to_float");
+      return value;
+    }; // End of string_to_float
+
     /*!
      * \brief Convert an integer into a string
      * \param[in] p_value The integer value
      * \return The string value
      */
     inline std::string int_to_string(const int32_t & p_value) const {
-      std::ostringstream ss;
-      ss << p_value;
-      return ss.str();
-    }; // End of string_to_bytes
+      char buffer[16];
+      return std::string(buffer, format_integer(buffer, buffer + sizeof(buffer), p_value));
+    }; // End of int_to_string
+
+  private:
+    /*!
+     * \brief Skip leading whitespaces and '+' sign, as std::stoi
+     * \remark At most one sign is accepted: the '+' of "+-5" is kept, so that the parsing fails
+     */
+    inline const char * number_start(const std::string & p_value) const {
+      const size_t start = p_value.find_first_not_of(" \t\n\v\f\r");
+      if (start == std::string::npos) {
+        return p_value.c_str() + p_value.length();
+      }
+      const bool plus = (p_value[start] == '+') && (p_value[start + 1] != '-') && (p_value[start + 1] != '+');
+      return p_value.c_str() + start + (plus ? 1 : 0);
+    }; // End of number_start
+
+    /*!
+     * \brief Raise the exception matching a parsing error
+     */
+    inline void check(const parse_result & p_result, const char * p_function) const {
+      if (p_result.error == EINVAL) {
+        throw std::invalid_argument(p_function);
+      } else if (p_result.error == ERANGE) {
+        throw std::out_of_range(p_function);
+      }
+    }; // End of check
 
   public:
         
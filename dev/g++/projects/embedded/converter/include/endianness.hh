@@ -0,0 +1,124 @@
+/*!
+ * \file      endianness.h
+ * \brief     Header file for the allocation-free endian conversion templates.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2020 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace helpers {
+
+  /*!
+   * \struct uint_of_size
+   * \brief Unsigned integral type of N bytes, used to move the bytes of any arithmetic type
+   */
+  template<size_t N> struct uint_of_size;
+  template<> struct uint_of_size<1> { typedef uint8_t type; };
+  template<> struct uint_of_size<2> { typedef uint16_t type; };
+  template<> struct uint_of_size<4> { typedef uint32_t type; };
+  template<> struct uint_of_size<8> { typedef uint64_t type; };
+
+  /*!
+   * \brief Reverse the bytes of an unsigned value
+   * \remark Compiled into a single bswap/rev instruction (or a rotation for 16-bit values)
+   */
+  constexpr inline uint8_t byte_swap(const uint8_t p_value) { return p_value; };
+  constexpr inline uint16_t byte_swap(const uint16_t p_value) { return __builtin_bswap16(p_value); };
+  constexpr inline uint32_t byte_swap(const uint32_t p_value) { return __builtin_bswap32(p_value); };
+  constexpr inline uint64_t byte_swap(const uint64_t p_value) { return __builtin_bswap64(p_value); };
+
+  /*!
+   * \brief Convert an integral value from the host byte order into big endian order, and vice versa
+   */
+  template<typename T> constexpr inline T host_to_be(const T p_value) {
+    static_assert(std::is_integral<T>::value, "host_to_be: integral type expected");
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return static_cast<T>(byte_swap(static_cast<typename uint_of_size<sizeof(T)>::type>(p_value)));
+#else
+    return p_value;
+#endif
+  };
+  template<typename T> constexpr inline T be_to_host(const T p_value) { return host_to_be(p_value); };
+
+  /*!
+   * \brief Convert an integral value from the host byte order into little endian order, and vice versa
+   */
+  template<typename T> constexpr inline T host_to_le(const T p_value) {
+    static_assert(std::is_integral<T>::value, "host_to_le: integral type expected");
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return static_cast<T>(byte_swap(static_cast<typename uint_of_size<sizeof(T)>::type>(p_value)));
+#else
+    return p_value;
+#endif
+  };
+  template<typename T> constexpr inline T le_to_host(const T p_value) { return host_to_le(p_value); };
+
+  /*!
+   * \brief Read a value of type T stored in big endian order
+   * \param[in] p_buffer The first byte of the value, no alignment required. At least sizeof(T) bytes shall be readable
+   * \return The value
+   * \remark T is any integral or floating point type. The load is a single (unaligned) move followed by a bswap, or a movbe
+   * \code
+   * const uint16_t length = load_be<uint16_t>(header + 2);
+   * \endcode
+   */
+  template<typename T> inline T load_be(const uint8_t * p_buffer) {
+    static_assert(std::is_arithmetic<T>::value, "load_be: arithmetic type expected");
+    typename uint_of_size<sizeof(T)>::type value;
+    std::memcpy(&value, p_buffer, sizeof(T));
+    value = host_to_be(value);
+    T result;
+    std::memcpy(&result, &value, sizeof(T));
+    return result;
+  };
+
+  /*!
+   * \brief Read a value of type T stored in little endian order
+   * \param[in] p_buffer The first byte of the value, no alignment required. At least sizeof(T) bytes shall be readable
+   * \return The value
+   */
+  template<typename T> inline T load_le(const uint8_t * p_buffer) {
+    static_assert(std::is_arithmetic<T>::value, "load_le: arithmetic type expected");
+    typename uint_of_size<sizeof(T)>::type value;
+    std::memcpy(&value, p_buffer, sizeof(T));
+    value = host_to_le(value);
+    T result;
+    std::memcpy(&result, &value, sizeof(T));
+    return result;
+  };
+
+  /*!
+   * \brief Write a value of type T in big endian order
+   * \param[in] p_buffer The first byte of the value, no alignment required. At least sizeof(T) bytes shall be writable
+   * \param[in] p_value The value to write
+   */
+  template<typename T> inline void store_be(uint8_t * p_buffer, const T p_value) {
+    static_assert(std::is_arithmetic<T>::value, "store_be: arithmetic type expected");
+    typename uint_of_size<sizeof(T)>::type value;
+    std::memcpy(&value, &p_value, sizeof(T));
+    value = host_to_be(value);
+    std::memcpy(p_buffer, &value, sizeof(T));
+  };
+
+  /*!
+   * \brief Write a value of type T in little endian order
+   * \param[in] p_buffer The first byte of the value, no alignment required. At least sizeof(T) bytes shall be writable
+   * \param[in] p_value The value to write
+   */
+  template<typename T> inline void store_le(uint8_t * p_buffer, const T p_value) {
+    static_assert(std::is_arithmetic<T>::value, "store_le: arithmetic type expected");
+    typename uint_of_size<sizeof(T)>::type value;
+    std::memcpy(&value, &p_value, sizeof(T));
+    value = host_to_le(value);
+    std::memcpy(p_buffer, &value, sizeof(T));
+  };
+
+} // End of namespace helpers
+
+using namespace helpers;
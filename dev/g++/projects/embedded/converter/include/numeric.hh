@@ -0,0 +1,103 @@
+/*!
+ * \file      numeric.h
+ * \brief     Header file for the locale-independent numeric parsing and formatting functions.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2020 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ *
+ * C++11 equivalent of std::from_chars/std::to_chars: the functions below never allocate, never throw, ignore the
+ * current locale and do not skip leading whitespace. The character range is [p_first, p_last), it does not need to be null-terminated.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
+#include <type_traits>
+
+namespace helpers {
+
+  /*!
+   * \struct parse_result
+   * \brief Result of a parse_* function
+   */
+  struct parse_result {
+    const char * ptr; /*!< The first character not consumed. On EINVAL error, the first character of the range */
+    int32_t error;    /*!< 0 on success, EINVAL if the range does not start with a number, ERANGE if the number does not fit */
+  }; // End of struct parse_result
+
+  /*!
+   * \brief Parse an integer: an optional '-' for signed types, followed by digits
+   * \param[in] p_first The first character of the range
+   * \param[in] p_last The end of the range
+   * \param[out] p_value The parsed value, unchanged on error
+   * \param[in] p_base The base, from 2 to 36. Letters are case insensitive. Default: 10
+   * \return The parsing result
+   * \code
+   * uint32_t satellites;
+   * parse_result r = parse_integer(field, field_end, satellites);
+   * if (r.error != 0) ...
+   * \endcode
+   */
+  template<typename T> parse_result parse_integer(const char * p_first, const char * p_last, T & p_value, const uint32_t p_base = 10);
+
+  /*!
+   * \brief Parse a decimal floating point number: [-]digits[.digits][(e|E)[+|-]digits], or [-].digits
+   * \param[in] p_first The first character of the range
+   * \param[in] p_last The end of the range
+   * \param[out] p_value The parsed value, correctly rounded. Unchanged on error
+   * \return The parsing result
+   * \remark Numbers with up to 15 significant digits and a small exponent, which covers NMEA and tools output, are converted
+   *         with a single multiplication or division. Others fall back to strtod_l with the "C" locale. Hexadecimal floats,
+   *         infinity and NaN are not recognized
+   */
+  parse_result parse_float(const char * p_first, const char * p_last, double & p_value);
+  parse_result parse_float(const char * p_first, const char * p_last, float & p_value);
+
+  /*!
+   * \brief Parse a decimal number into a fixed-point integer, e.g. "4807.038" with 3 decimals gives 4807038
+   * \param[in] p_first The first character of the range
+   * \param[in] p_last The end of the range
+   * \param[out] p_value The parsed value, scaled by 10^p_decimals. Unchanged on error
+   * \param[in] p_decimals The number of decimals of the fixed-point value, up to 18. Extra decimals are truncated
+   * \return The parsing result
+   */
+  parse_result parse_fixed(const char * p_first, const char * p_last, int64_t & p_value, const uint32_t p_decimals);
+
+  /*!
+   * \brief Format an integer in base 10
+   * \param[in] p_first The first character of the output buffer
+   * \param[in] p_last The end of the output buffer
+   * \param[in] p_value The value to format
+   * \return The end of the written characters (not null-terminated), nullptr if the buffer is too small
+   */
+  template<typename T> char * format_integer(char * p_first, char * p_last, const T p_value);
+
+  /*!
+   * \brief Format a fixed-point integer, e.g. 4807038 with 3 decimals gives "4807.038"
+   * \param[in] p_first The first character of the output buffer
+   * \param[in] p_last The end of the output buffer
+   * \param[in] p_value The fixed-point value, scaled by 10^p_decimals
+   * \param[in] p_decimals The number of decimals, up to 18
+   * \return The end of the written characters (not null-terminated), nullptr if the buffer is too small
+   */
+  char * format_fixed(char * p_first, char * p_last, const int64_t p_value, const uint32_t p_decimals);
+
+  /*!
+   * \brief Format a floating point value with p_precision decimals, as printf("%.*f") in the "C" locale
+   * \param[in] p_first The first character of the output buffer
+   * \param[in] p_last The end of the output buffer
+   * \param[in] p_value The value to format
+   * \param[in] p_precision The number of decimals, up to 17
+   * \return The end of the written characters (not null-terminated), nullptr if the buffer is too small
+   * \remark Values below 2^52 / 10^p_precision are scaled and formatted through format_fixed, the rounding error of the scaling
+   *         being recovered with a fused multiply-add, so the output is the same as printf. Other values fall back to snprintf
+   */
+  char * format_float(char * p_first, char * p_last, const double p_value, const uint32_t p_precision);
+
+} // End of namespace helpers
+
+#include "numeric.t.h"
+
+using namespace helpers;
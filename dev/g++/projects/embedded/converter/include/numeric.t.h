@@ -0,0 +1,125 @@
+/*!
+ * \file      numeric.t.h
+ * \brief     Template header file for the locale-independent numeric parsing and formatting functions.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2020 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <limits>
+
+#include "numeric.hh"
+
+namespace helpers {
+
+  /*!
+   * \brief The 100 two-digits strings "00".."99", concatenated
+   */
+  extern const char g_digit_pairs[201];
+
+  /*!
+   * \brief Value of a digit in base 36, 36 if the character is not a digit
+   */
+  inline uint32_t numeric_digit(const char p_char) {
+    uint32_t digit = static_cast<uint8_t>(p_char) - '0';
+    if (digit < 10) {
+      return digit;
+    }
+    digit = (static_cast<uint8_t>(p_char) | 0x20) - 'a';
+    return (digit < 26) ? digit + 10 : 36;
+  }
+
+  template<typename T> parse_result parse_integer(const char * p_first, const char * p_last, T & p_value, const uint32_t p_base) {
+    static_assert(std::is_integral<T>::value, "parse_integer: integral type expected");
+    typedef typename std::make_unsigned<T>::type U;
+
+    parse_result result = { p_first, EINVAL };
+    const char * p = p_first;
+    bool negative = false;
+    if (std::is_signed<T>::value && (p != p_last) && (*p == '-')) {
+      negative = true;
+      p += 1;
+    }
+    const char * digits = p;
+
+    // Up to digits10 decimal digits cannot overflow, no need to check them
+    U value = 0;
+    if (p_base <= 10) {
+      const char * end = ((p_last - p) > std::numeric_limits<T>::digits10) ? p + std::numeric_limits<T>::digits10 : p_last;
+      for ( ; p != end; ++p) {
+        const uint32_t digit = numeric_digit(*p);
+        if (digit >= p_base) {
+          break;
+        }
+        value = value * p_base + digit;
+      } // End of 'for' statement
+    }
+    // Remaining digits
+    const U limit = negative ? static_cast<U>(std::numeric_limits<T>::max()) + 1 : static_cast<U>(std::numeric_limits<T>::max());
+    bool overflow = false;
+    for ( ; p != p_last; ++p) {
+      const uint32_t digit = numeric_digit(*p);
+      if (digit >= p_base) {
+        break;
+      }
+      if (value > (limit - digit) / p_base) {
+        overflow = true;
+      } else {
+        value = value * p_base + digit;
+      }
+    } // End of 'for' statement
+
+    if (p == digits) { // No digit
+      return result;
+    }
+    result.ptr = p;
+    if (overflow) {
+      result.error = ERANGE;
+      return result;
+    }
+    p_value = negative ? static_cast<T>(0 - value) : static_cast<T>(value);
+    result.error = 0;
+    return result;
+  }; // End of function parse_integer
+
+  template<typename T> char * format_integer(char * p_first, char * p_last, const T p_value) {
+    static_assert(std::is_integral<T>::value, "format_integer: integral type expected");
+    typedef typename std::make_unsigned<T>::type U;
+
+    U value = static_cast<U>(p_value);
+    char * p = p_first;
+    if (std::is_signed<T>::value && (p_value < 0)) {
+      if (p == p_last) {
+        return nullptr;
+      }
+      *p++ = '-';
+      value = 0 - value;
+    }
+    uint32_t length = 1;
+    for (U v = value; v >= 10; v /= 10) {
+      length += 1;
+    } // End of 'for' statement
+    if (static_cast<size_t>(p_last - p) < length) {
+      return nullptr;
+    }
+
+    // Two digits at a time, from the end
+    char * end = p + length;
+    p = end;
+    while (value >= 100) {
+      const uint32_t i = static_cast<uint32_t>(value % 100) * 2;
+      value /= 100;
+      *--p = g_digit_pairs[i + 1];
+      *--p = g_digit_pairs[i];
+    } // End of 'while' statement
+    if (value >= 10) {
+      const uint32_t i = static_cast<uint32_t>(value) * 2;
+      *--p = g_digit_pairs[i + 1];
+      *--p = g_digit_pairs[i];
+    } else {
+      *--p = static_cast<char>('0' + value);
+    }
+    return end;
+  }; // End of function format_integer
+
+} // End of namespace helpers
@@ -0,0 +1,138 @@
+/*!
+ * \file      text_codec.h
+ * \brief     Header file for the hexadecimal and base64 encoders/decoders.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2020 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace helpers {
+
+  /*!
+   * \class text_codec
+   * \brief Code path selection of the hexa and base64 codecs
+   * \remark The widest instruction set supported by the running CPU is used by default. It can be lowered, e.g. to test or to
+   *         benchmark the scalar code path on a SIMD capable CPU
+   */
+  class text_codec {
+  public:
+    /*!
+     * \enum simd_level_t
+     * \brief The code paths
+     */
+    typedef enum {
+      simd_none,  /*!< Table-driven scalar code path */
+      simd_ssse3, /*!< SSSE3 code path, x86 only */
+      simd_avx2   /*!< AVX2 code path, x86 only */
+    } simd_level_t;
+
+    /*!
+     * \brief Indicate the widest code path supported by the running CPU
+     */
+    static simd_level_t supported_simd_level();
+    /*!
+     * \brief Indicate the code path in use
+     */
+    static simd_level_t simd_level();
+    /*!
+     * \brief Select the code path
+     * \param[in] p_level The code path, supported_simd_level() restores the default one
+     * \return 0 on success, -1 if the running CPU does not support it
+     */
+    static const int32_t set_simd_level(const simd_level_t p_level);
+  }; // End of class text_codec
+
+  /*!
+   * \class hexa
+   * \brief Hexadecimal encoder/decoder working on caller-provided buffers
+   * \remark SSSE3 and AVX2 code paths are selected at runtime when available, a table-driven scalar code path is used otherwise
+   */
+  class hexa {
+  public:
+    /*!
+     * \brief Indicate the size of the hexadecimal string of p_length bytes
+     */
+    inline static size_t encoded_size(const size_t p_length) { return 2 * p_length; };
+    /*!
+     * \brief Indicate the number of bytes encoded by an hexadecimal string of p_length characters
+     */
+    inline static size_t decoded_size(const size_t p_length) { return p_length / 2; };
+
+    /*!
+     * \brief Convert a bytes array into an hexadecimal string
+     * \param[in] p_data The bytes array
+     * \param[in] p_length The length of the bytes array
+     * \param[out] p_output The hexadecimal string, at least encoded_size(p_length) characters long. It is not null-terminated
+     * \param[in] p_upper_case Set to true to use 'A'..'F' digits. Default: false
+     * \return The number of characters written
+     */
+    static size_t encode(const uint8_t * p_data, const size_t p_length, char * p_output, const bool p_upper_case = false);
+
+    /*!
+     * \brief Convert an hexadecimal string into a bytes array
+     * \param[in] p_text The hexadecimal string, upper or lower case digits
+     * \param[in] p_length The length of the hexadecimal string
+     * \param[out] p_output The bytes array, at least decoded_size(p_length) bytes long
+     * \return 0 on success, -1 on odd length or invalid digit
+     */
+    static const int32_t decode(const char * p_text, const size_t p_length, uint8_t * p_output);
+  }; // End of class hexa
+
+  /*!
+   * \class base64
+   * \brief Base64 (RFC 4648 section 4) and base64url (RFC 4648 section 5) encoder/decoder working on caller-provided buffers
+   * \remark SSSE3 and AVX2 code paths are selected at runtime when available, a table-driven scalar code path is used otherwise
+   */
+  class base64 {
+  public:
+    /*!
+     * \enum alphabet_t
+     * \brief Base64 alphabet
+     */
+    typedef enum {
+      standard, /*!< '+' and '/' for the digits 62 and 63 */
+      url       /*!< '-' and '_' for the digits 62 and 63 */
+    } alphabet_t;
+
+    /*!
+     * \brief Indicate the size of the base64 string of p_length bytes
+     * \param[in] p_length The number of bytes to encode
+     * \param[in] p_padding Set to false if the '=' padding characters are omitted. Default: true
+     */
+    inline static size_t encoded_size(const size_t p_length, const bool p_padding = true) { return p_padding ? 4 * ((p_length + 2) / 3) : (4 * p_length + 2) / 3; };
+    /*!
+     * \brief Indicate the maximum number of bytes encoded by a base64 string of p_length characters
+     */
+    inline static size_t decoded_size(const size_t p_length) { return (3 * p_length) / 4 + 3; };
+
+    /*!
+     * \brief Convert a bytes array into a base64 string
+     * \param[in] p_data The bytes array
+     * \param[in] p_length The length of the bytes array
+     * \param[out] p_output The base64 string, at least encoded_size(p_length, p_padding) characters long. It is not null-terminated
+     * \param[in] p_alphabet The base64 alphabet. Default: standard
+     * \param[in] p_padding Set to false to omit the '=' padding characters. Default: true
+     * \return The number of characters written
+     */
+    static size_t encode(const uint8_t * p_data, const size_t p_length, char * p_output, const alphabet_t p_alphabet = standard, const bool p_padding = true);
+
+    /*!
+     * \brief Convert a base64 string into a bytes array
+     * \param[in] p_text The base64 string, with or without '=' padding characters
+     * \param[in] p_length The length of the base64 string
+     * \param[out] p_output The bytes array, at least decoded_size(p_length) bytes long
+     * \param[out] p_decoded The number of bytes written
+     * \param[in] p_alphabet The base64 alphabet. Default: standard
+     * \return 0 on success, -1 on invalid character or length
+     */
+    static const int32_t decode(const char * p_text, const size_t p_length, uint8_t * p_output, size_t & p_decoded, const alphabet_t p_alphabet = standard);
+  }; // End of class base64
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -9,6 +9,7 @@
 #include <cctype> // Used for toupper
 
 #include "converter.hh"
+#include "text_codec.hh"
 
 namespace helpers {
 
@@ -49,56 +50,17 @@ namespace helpers {
   }
     
   std::string converter::bytes_to_hexa(const std::vector<uint8_t> & p_value) {
-    std::ostringstream oss;
-    oss << std::setfill('0');
-    std::for_each(
-		  p_value.begin(), 
-		  p_value.end(),
-		  [&oss](uint8_t ch) {
-		    oss << std::hex
-			<< std::setw(2)
-			<< static_cast<int>(ch);
-		  }
-		  );
-    return oss.str();
+    std::string output(hexa::encoded_size(p_value.size()), '\0');
+    hexa::encode(p_value.data(), p_value.size(), &output[0]);
+    return output;
   }
 
   std::vector<uint8_t> converter::hexa_to_bytes(const std::string & p_value) {
-    static const char * const lut = "0123456789ABCDEF";
-
-    // Sanity check
-    std::vector<uint8_t> output;
-    if (p_value.length() & 1) {
-      return output;
+    std::vector<uint8_t> output(hexa::decoded_size(p_value.length()));
+    if (hexa::decode(p_value.data(), p_value.length(), output.data()) == -1) {
+      output.clear();
     }
-    
-    std::string input(p_value);
-    std::for_each(
-		  input.begin(), 
-		  input.end(), 
-		  [](char & c) { 
-		    c = std::toupper(c);
-		  }
-		  );
-        
-    output.reserve(p_value.length() / 2);
-    for (uint32_t i = 0; i < p_value.length(); i += 2) {
-      char msbDigit = input[i];
-      const char *msbIndex = std::lower_bound(lut, lut + 16, msbDigit);
-      if (*msbIndex != msbDigit) {
-	output.clear();
-	return output;
-      }
-      char lsbDigit = input[i + 1];
-      const char* lsbIndex = std::lower_bound(lut, lut + 16, lsbDigit);
-      if (*lsbIndex != lsbDigit) {
-	output.clear();
-	return output;
-      }
-      output.push_back(((msbIndex - lut) << 4) | (lsbIndex - lut));
-    } // End of 'for' statement
-    
-    return output;    
+    return output;
   }
 
   std::string converter::time_to_string(const time_t p_time) {
@@ -147,90 +109,34 @@ namespace helpers {
   }
 
   std::string converter::string_to_base64(const std::string& p_string) {
-    std::string base64;
-
-    int val = 0, valb =- 6;
-    for (char c : p_string) {
-      val = (val << 8) + c;
-      valb += 8;
-      while (valb >= 0) {
-        base64.push_back(converter::base64_chars[(val >> valb) & 0x3F]);
-        valb -= 6;
-      } // End of 'while' statement
-    } // End of 'for' statement
-    if (valb > -6) {
-      base64.push_back(converter::base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    }
-    while (base64.size() % 4) {
-      base64.push_back('=');
-    }
-
-    return base64;
+    std::string output(base64::encoded_size(p_string.length()), '\0');
+    base64::encode(reinterpret_cast<const uint8_t *>(p_string.data()), p_string.length(), &output[0]);
+    return output;
   }
 
   std::string converter::binary_to_base64(const std::vector<uint8_t>& p_buffer) {
-    std::string base64;
-
-    int val = 0, valb =- 6;
-    for (uint8_t c : p_buffer) {
-      val = (val << 8) + c;
-      valb += 8;
-      while (valb >= 0) {
-        base64.push_back(converter::base64_chars[(val >> valb) & 0x3F]);
-        valb -= 6;
-      } // End of 'while' statement
-    } // End of 'for' statement
-    if (valb > -6) {
-      base64.push_back(converter::base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    }
-    while (base64.size() % 4) {
-      base64.push_back('=');
-    }
-
-    return base64;
+    std::string output(base64::encoded_size(p_buffer.size()), '\0');
+    base64::encode(p_buffer.data(), p_buffer.size(), &output[0]);
+    return output;
   }
 
   std::string converter::base64_to_string(const std::string& p_base64) {
-    std::string buffer;
-
-    std::vector<int> T(256, -1);
-    for (int i = 0; i < 64; i++) T[converter::base64_chars[i]] = i;
-
-    int val = 0, valb = -8;
-    for (char c : p_base64) {
-      if (T[c] == -1) {
-        break;
-      }
-      val = (val <<6 ) + T[c];
-      valb += 6;
-      if (valb >= 0) {
-        buffer.push_back(char((val >> valb) & 0xFF));
-        valb -= 8;
-      }
-    } // End of 'for' statement
-
-    return buffer;
+    const std::vector<uint8_t> buffer = base64_to_binary(p_base64);
+    return std::string(buffer.cbegin(), buffer.cend());
   }
 
   std::vector<uint8_t> converter::base64_to_binary(const std::string& p_base64) {
-    std::vector<uint8_t> buffer;
-
-    std::vector<int> T(256, -1);
-    for (int i = 0; i < 64; i++) T[converter::base64_chars[i]] = i;
-
-    int val = 0, valb = -8;
-    for (char c : p_base64) {
-      if (T[c] == -1) {
-        break;
-      }
-      val = (val <<6 ) + T[c];
-      valb += 6;
-      if (valb >= 0) {
-        buffer.push_back(char((val >> valb) & 0xFF));
-        valb -= 8;
+    std::vector<uint8_t> buffer(base64::decoded_size(p_base64.length()));
+    size_t length;
+    if (base64::decode(p_base64.data(), p_base64.length(), buffer.data(), length) == -1) {
+      // Decode up to the first character out of the alphabet, as the previous implementation did
+      length = std::min(p_base64.find_first_not_of(converter::base64_chars), p_base64.length());
+      if ((length & 3) == 1) { // Not enough bits for one more byte
+        length -= 1;
       }
-    } // End of 'for' statement
-
+      base64::decode(p_base64.data(), length, buffer.data(), length);
+    }
+    buffer.resize(length);
     return buffer;
   }
 
@@ -0,0 +1,329 @@
+/*!
+ * \file      numeric.cpp
+ * \brief     Implementation file for the locale-independent numeric parsing and formatting functions.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <locale.h> // Used for newlocale, uselocale
+
+#include "numeric.hh"
+
+namespace helpers {
+
+  const char g_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  static const double g_pow10[] = { // Exactly representable powers of 10
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  static const float g_pow10f[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+  static const uint64_t g_pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL
+  };
+
+  /*!
+   * \brief The "C" locale, used by the slow paths
+   */
+  static locale_t c_locale() {
+    static const locale_t locale = ::newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+    return locale;
+  }
+
+  /*!
+   * \struct decimal_t
+   * \brief Decimal number split by scan_decimal
+   */
+  typedef struct {
+    uint64_t mantissa;  /*!< Up to 19 significant digits */
+    int32_t exponent;   /*!< Power of 10 applied to the mantissa */
+    bool negative;
+    bool truncated;     /*!< Set if non-zero digits did not fit into the mantissa */
+  } decimal_t;
+
+  /*!
+   * \brief Split a decimal number into its mantissa and exponent
+   * \return The first character not consumed, p_first if there is no number
+   */
+  static const char * scan_decimal(const char * p_first, const char * p_last, decimal_t & p_decimal) {
+    const char * p = p_first;
+    p_decimal.mantissa = 0;
+    p_decimal.exponent = 0;
+    p_decimal.negative = false;
+    p_decimal.truncated = false;
+    if ((p != p_last) && (*p == '-')) {
+      p_decimal.negative = true;
+      p += 1;
+    }
+
+    bool digits = false;
+    uint32_t significant = 0;
+    uint32_t digit;
+    for ( ; (p != p_last) && ((digit = static_cast<uint8_t>(*p) - '0') < 10); ++p) { // Integer part
+      digits = true;
+      if ((significant == 0) && (digit == 0)) {
+        continue; // Leading zero
+      } else if (significant < 19) {
+        p_decimal.mantissa = p_decimal.mantissa * 10 + digit;
+        significant += 1;
+      } else {
+        p_decimal.exponent += 1;
+        p_decimal.truncated |= (digit != 0);
+      }
+    } // End of 'for' statement
+    if ((p != p_last) && (*p == '.')) { // Fractional part
+      const char * q = p + 1;
+      for ( ; (q != p_last) && ((digit = static_cast<uint8_t>(*q) - '0') < 10); ++q) {
+        digits = true;
+        if ((significant == 0) && (digit == 0)) {
+          p_decimal.exponent -= 1;
+        } else if (significant < 19) {
+          p_decimal.mantissa = p_decimal.mantissa * 10 + digit;
+          p_decimal.exponent -= 1;
+          significant += 1;
+        } else {
+          p_decimal.truncated |= (digit != 0);
+        }
+      } // End of 'for' statement
+      if (digits) {
+        p = q;
+      }
+    }
+    if (!digits) {
+      return p_first;
+    }
+
+    if ((p != p_last) && ((*p | 0x20) == 'e')) { // Exponent, consumed only if followed by digits
+      const char * q = p + 1;
+      bool negative = false;
+      if ((q != p_last) && ((*q == '-') || (*q == '+'))) {
+        negative = (*q == '-');
+        q += 1;
+      }
+      if ((q != p_last) && (static_cast<uint32_t>(static_cast<uint8_t>(*q) - '0') < 10)) {
+        int32_t exponent = 0;
+        for ( ; (q != p_last) && ((digit = static_cast<uint8_t>(*q) - '0') < 10); ++q) {
+          if (exponent < 100000) { // Far beyond the double range
+            exponent = exponent * 10 + digit;
+          }
+        } // End of 'for' statement
+        p_decimal.exponent += negative ? -exponent : exponent;
+        p = q;
+      }
+    }
+
+    return p;
+  }
+
+  /*!
+   * \brief Slow path: strtod_l/strtof_l on a null-terminated copy of the number
+   */
+  template<typename T> static parse_result parse_float_slow(const char * p_first, const char * p_end, T & p_value) {
+    parse_result result = { p_end, 0 };
+    char buffer[128];
+    std::string copy; // Very long numbers only
+    const char * text = buffer;
+    const size_t length = p_end - p_first;
+    if (length < sizeof(buffer)) {
+      std::memcpy(buffer, p_first, length);
+      buffer[length] = '\0';
+    } else {
+      copy.assign(p_first, length);
+      text = copy.c_str();
+    }
+
+    errno = 0;
+    const T value = std::is_same<T, float>::value ? ::strtof_l(text, nullptr, c_locale()) : ::strtod_l(text, nullptr, c_locale());
+    if ((errno == ERANGE) && ((value == 0) || std::isinf(value))) { // Subnormal results are accepted
+      result.error = ERANGE;
+    } else {
+      p_value = value;
+    }
+    return result;
+  }
+
+  parse_result parse_float(const char * p_first, const char * p_last, double & p_value) {
+    decimal_t decimal;
+    const char * end = scan_decimal(p_first, p_last, decimal);
+    if (end == p_first) {
+      parse_result result = { p_first, EINVAL };
+      return result;
+    }
+
+    // Fast path: mantissa and power of 10 are exact doubles, a single rounding occurs
+    if (!decimal.truncated && (decimal.mantissa <= (1ULL << 53)) && (decimal.exponent >= -22) && (decimal.exponent <= 22)) {
+      double value = static_cast<double>(decimal.mantissa);
+      value = (decimal.exponent < 0) ? value / g_pow10[-decimal.exponent] : value * g_pow10[decimal.exponent];
+      p_value = decimal.negative ? -value : value;
+      parse_result result = { end, 0 };
+      return result;
+    }
+    return parse_float_slow(p_first, end, p_value);
+  }
+
+  parse_result parse_float(const char * p_first, const char * p_last, float & p_value) {
+    decimal_t decimal;
+    const char * end = scan_decimal(p_first, p_last, decimal);
+    if (end == p_first) {
+      parse_result result = { p_first, EINVAL };
+      return result;
+    }
+
+    if (!decimal.truncated && (decimal.mantissa <= (1ULL << 24)) && (decimal.exponent >= -10) && (decimal.exponent <= 10)) {
+      float value = static_cast<float>(decimal.mantissa);
+      value = (decimal.exponent < 0) ? value / g_pow10f[-decimal.exponent] : value * g_pow10f[decimal.exponent];
+      p_value = decimal.negative ? -value : value;
+      parse_result result = { end, 0 };
+      return result;
+    }
+    return parse_float_slow(p_first, end, p_value);
+  }
+
+  parse_result parse_fixed(const char * p_first, const char * p_last, int64_t & p_value, const uint32_t p_decimals) {
+    parse_result result = { p_first, EINVAL };
+    if (p_decimals > 18) {
+      return result;
+    }
+
+    const char * p = p_first;
+    bool negative = false;
+    if ((p != p_last) && (*p == '-')) {
+      negative = true;
+      p += 1;
+    }
+    const uint64_t limit = negative ? static_cast<uint64_t>(INT64_MAX) + 1 : static_cast<uint64_t>(INT64_MAX);
+    uint64_t value = 0;
+    bool overflow = false;
+    bool digits = false;
+    uint32_t digit;
+    for ( ; (p != p_last) && ((digit = static_cast<uint8_t>(*p) - '0') < 10); ++p) { // Integer part
+      digits = true;
+      if (value > (limit - digit) / 10) {
+        overflow = true;
+      } else {
+        value = value * 10 + digit;
+      }
+    } // End of 'for' statement
+    uint32_t decimals = 0;
+    if ((p != p_last) && (*p == '.')) { // Fractional part, extra decimals are truncated
+      const char * q = p + 1;
+      for ( ; (q != p_last) && ((digit = static_cast<uint8_t>(*q) - '0') < 10); ++q) {
+        digits = true;
+        if (decimals < p_decimals) {
+          if (value > (limit - digit) / 10) {
+            overflow = true;
+          } else {
+            value = value * 10 + digit;
+          }
+          decimals += 1;
+        }
+      } // End of 'for' statement
+      if (digits) {
+        p = q;
+      }
+    }
+    if (!digits) {
+      return result;
+    }
+    // Scale the missing decimals
+    if (value > limit / g_pow10_u64[p_decimals - decimals]) {
+      overflow = true;
+    } else {
+      value *= g_pow10_u64[p_decimals - decimals];
+    }
+
+    result.ptr = p;
+    if (overflow) {
+      result.error = ERANGE;
+      return result;
+    }
+    p_value = negative ? static_cast<int64_t>(0 - value) : static_cast<int64_t>(value);
+    result.error = 0;
+    return result;
+  }
+
+  char * format_fixed(char * p_first, char * p_last, const int64_t p_value, const uint32_t p_decimals) {
+    if (p_decimals == 0) {
+      return format_integer(p_first, p_last, p_value);
+    } else if (p_decimals > 18) {
+      return nullptr;
+    }
+
+    char * p = p_first;
+    uint64_t value = static_cast<uint64_t>(p_value);
+    if (p_value < 0) {
+      if (p == p_last) {
+        return nullptr;
+      }
+      *p++ = '-';
+      value = 0 - value;
+    }
+    if ((p = format_integer(p, p_last, value / g_pow10_u64[p_decimals])) == nullptr) {
+      return nullptr;
+    }
+    if (static_cast<size_t>(p_last - p) < p_decimals + 1) {
+      return nullptr;
+    }
+    *p++ = '.';
+    value %= g_pow10_u64[p_decimals];
+    for (int32_t i = p_decimals - 1; i >= 0; i--) {
+      p[i] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } // End of 'for' statement
+    return p + p_decimals;
+  }
+
+  char * format_float(char * p_first, char * p_last, const double p_value, const uint32_t p_precision) {
+    const uint32_t precision = (p_precision > 17) ? 17 : p_precision;
+
+    const double scaled = p_value * g_pow10[precision];
+    if (std::fabs(scaled) < 4503599627370496.0) { // 2^52: the rounded value and the halves are exact
+      double rounded = std::nearbyint(scaled); // Ties to even, as printf
+      if (std::fabs(scaled - std::trunc(scaled)) == 0.5) { // Tie after the multiplication: use its exact rounding error
+        const double error = std::fma(p_value, g_pow10[precision], -scaled);
+        if (error != 0.0) {
+          rounded = (error > 0.0) ? std::ceil(scaled) : std::floor(scaled);
+        }
+      }
+      const int64_t value = static_cast<int64_t>(rounded);
+      char * p = p_first;
+      if ((value == 0) && std::signbit(p_value)) { // As printf, e.g. "-0.00"
+        if (p == p_last) {
+          return nullptr;
+        }
+        *p++ = '-';
+      }
+      return format_fixed(p, p_last, value, precision);
+    }
+
+    // Slow path: large values, infinity and NaN
+    const locale_t locale = ::uselocale(c_locale());
+    const int result = std::snprintf(p_first, p_last - p_first, "%.*f", static_cast<int>(precision), p_value);
+    ::uselocale(locale);
+    if ((result < 0) || (result >= p_last - p_first)) {
+      return nullptr;
+    }
+    return p_first + result;
+  }
+
+} // End of namespace helpers
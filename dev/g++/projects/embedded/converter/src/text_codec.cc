@@ -0,0 +1,442 @@
+/*!
+ * \file      text_codec.cpp
+ * \brief     Implementation file for the hexadecimal and base64 encoders/decoders.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <atomic>
+
+#include "text_codec.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXT_CODEC_X86
+#endif
+
+namespace helpers {
+
+  static const char * const hexa_lower = "0123456789abcdef";
+  static const char * const hexa_upper = "0123456789ABCDEF";
+  static const char * const base64_standard = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  static const char * const base64_url = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+  /*!
+   * \struct decoding_tables
+   * \brief Reverse lookup tables, built once. Invalid characters have the bit 7 set
+   */
+  struct decoding_tables {
+    int8_t hexa[256];
+    uint8_t base64[2][256];
+
+    decoding_tables() {
+      for (int i = 0; i < 256; i++) {
+        hexa[i] = -1;
+        base64[base64::standard][i] = 0xff;
+        base64[base64::url][i] = 0xff;
+      } // End of 'for' statement
+      for (int i = 0; i < 16; i++) {
+        hexa[static_cast<uint8_t>(hexa_lower[i])] = i;
+        hexa[static_cast<uint8_t>(hexa_upper[i])] = i;
+      } // End of 'for' statement
+      for (int i = 0; i < 64; i++) {
+        base64[base64::standard][static_cast<uint8_t>(base64_standard[i])] = i;
+        base64[base64::url][static_cast<uint8_t>(base64_url[i])] = i;
+      } // End of 'for' statement
+    };
+  }; // End of struct decoding_tables
+
+  static const decoding_tables & tables() {
+    static const decoding_tables t;
+    return t;
+  }
+
+  /*!
+   * \brief The code path in use, the widest one supported by the running CPU by default
+   */
+  static std::atomic<text_codec::simd_level_t> & current_simd_level() {
+    static std::atomic<text_codec::simd_level_t> level(text_codec::supported_simd_level());
+    return level;
+  }
+
+  text_codec::simd_level_t text_codec::supported_simd_level() {
+#if defined(TEXT_CODEC_X86)
+    static const simd_level_t level = __builtin_cpu_supports("avx2") ? simd_avx2 : (__builtin_cpu_supports("ssse3") ? simd_ssse3 : simd_none);
+    return level;
+#else
+    return simd_none;
+#endif
+  }
+
+  text_codec::simd_level_t text_codec::simd_level() {
+    return current_simd_level().load(std::memory_order_relaxed);
+  }
+
+  const int32_t text_codec::set_simd_level(const simd_level_t p_level) {
+    if (p_level > supported_simd_level()) {
+      return -1;
+    }
+    current_simd_level().store(p_level, std::memory_order_relaxed);
+    return 0;
+  }
+
+#if defined(TEXT_CODEC_X86)
+
+  /*
+   * Hexadecimal: each nibble indexes a 16 characters table with pshufb, digits are validated and converted by range checks
+   * then pairs of nibbles are merged with pmaddubsw
+   */
+
+  __attribute__((target("ssse3"))) static size_t hexa_encode_ssse3(const uint8_t * p_data, const size_t p_length, char * p_output, const char * p_digits) {
+    const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_digits));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for ( ; i + 16 <= p_length; i += 16) {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i));
+      const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+      const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p_output + 2 * i), _mm_unpacklo_epi8(hi, lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p_output + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("ssse3"))) static inline bool hexa_nibbles_ssse3(const __m128i p_text, __m128i & p_nibbles) {
+    const __m128i digit = _mm_sub_epi8(p_text, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(p_text, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+      return false;
+    }
+    p_nibbles = _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    return true;
+  }
+
+  __attribute__((target("ssse3"))) static size_t hexa_decode_ssse3(const char * p_text, const size_t p_length, uint8_t * p_output) {
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for ( ; i + 32 <= p_length; i += 32) {
+      __m128i a, b;
+      if (!hexa_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_text + i)), a) ||
+          !hexa_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_text + i + 16)), b)) {
+        break; // Let the scalar code report the error
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p_output + i / 2), _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static size_t hexa_encode_avx2(const uint8_t * p_data, const size_t p_length, char * p_output, const char * p_digits) {
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_digits)));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for ( ; i + 32 <= p_length; i += 32) {
+      const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_data + i));
+      const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+      const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+      const __m256i first = _mm256_unpacklo_epi8(hi, lo);  // Bytes 0..7 and 16..23
+      const __m256i second = _mm256_unpackhi_epi8(hi, lo); // Bytes 8..15 and 24..31
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_output + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_output + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static inline bool hexa_nibbles_avx2(const __m256i p_text, __m256i & p_nibbles) {
+    const __m256i digit = _mm256_sub_epi8(p_text, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(p_text, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) {
+      return false;
+    }
+    p_nibbles = _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    return true;
+  }
+
+  __attribute__((target("avx2"))) static size_t hexa_decode_avx2(const char * p_text, const size_t p_length, uint8_t * p_output) {
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+    for ( ; i + 64 <= p_length; i += 64) {
+      __m256i a, b;
+      if (!hexa_nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_text + i)), a) ||
+          !hexa_nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_text + i + 32)), b)) {
+        break; // Let the scalar code report the error
+      }
+      // packus works per 128-bit lane, restore the order of the 64-bit blocks
+      const __m256i out = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_output + i / 2), _mm256_permute4x64_epi64(out, 0xd8));
+    } // End of 'for' statement
+    return i;
+  }
+
+  /*
+   * Base64: 12 bytes are spread into 16 6-bit indices with pshufb and multiplications, indices are translated into ASCII by adding
+   * an offset selected with pshufb. Decoding validates and translates characters with nibble lookup tables, then packs 16 characters
+   * into 12 bytes with pmaddubsw/pmaddwd
+   */
+
+  __attribute__((target("ssse3"))) static inline __m128i base64_indices_ssse3(const __m128i p_in) {
+    const __m128i in = _mm_shuffle_epi8(p_in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+  }
+
+  __attribute__((target("ssse3"))) static size_t base64_encode_ssse3(const uint8_t * p_data, const size_t p_length, char * p_output, const base64::alphabet_t p_alphabet) {
+    const __m128i shift = (p_alphabet == base64::standard) ?
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0) :
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+    size_t i = 0;
+    char * output = p_output;
+    for ( ; i + 16 <= p_length; i += 12, output += 16) { // 16 bytes are loaded, 12 are encoded
+      const __m128i indices = base64_indices_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i)));
+      __m128i selector = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+      selector = _mm_or_si128(selector, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_add_epi8(_mm_shuffle_epi8(shift, selector), indices));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("ssse3"))) static size_t base64_decode_ssse3(const char * p_text, const size_t p_length, uint8_t * p_output, const base64::alphabet_t p_alphabet) {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2f);
+    size_t i = 0;
+    uint8_t * output = p_output;
+    for ( ; i + 24 <= p_length; i += 16, output += 12) { // 16 bytes are stored, 12 are decoded
+      __m128i text = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_text + i));
+      if (p_alphabet == base64::url) { // Reject '+' and '/', then map '-' and '_' on them
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(text, _mm_set1_epi8('+')), _mm_cmpeq_epi8(text, _mm_set1_epi8('/')))) != 0) {
+          break;
+        }
+        text = _mm_sub_epi8(text, _mm_and_si128(_mm_cmpeq_epi8(text, _mm_set1_epi8('-')), _mm_set1_epi8('-' - '+')));
+        text = _mm_sub_epi8(text, _mm_and_si128(_mm_cmpeq_epi8(text, _mm_set1_epi8('_')), _mm_set1_epi8('_' - '/')));
+      }
+      const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(text, 4), mask_2f);
+      const __m128i lo_nibbles = _mm_and_si128(text, mask_2f);
+      const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+      const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+      if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+        break; // Let the scalar code report the error
+      }
+      const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(text, mask_2f), hi_nibbles));
+      text = _mm_add_epi8(text, roll);
+      const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(text, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static size_t base64_encode_avx2(const uint8_t * p_data, const size_t p_length, char * p_output, const base64::alphabet_t p_alphabet) {
+    const __m256i shift = _mm256_broadcastsi128_si256((p_alphabet == base64::standard) ?
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0) :
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0));
+    const __m256i spread = _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    size_t i = 0;
+    char * output = p_output;
+    for ( ; i + 28 <= p_length; i += 24, output += 32) { // Each 128-bit lane encodes 12 of the 16 bytes it loads
+      __m256i in = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i)));
+      in = _mm256_inserti128_si256(in, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i + 12)), 1);
+      in = _mm256_shuffle_epi8(in, spread);
+      const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+      const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+      const __m256i indices = _mm256_or_si256(t0, t1);
+      __m256i selector = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+      selector = _mm256_or_si256(selector, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), _mm256_add_epi8(_mm256_shuffle_epi8(shift, selector), indices));
+    } // End of 'for' statement
+    return i;
+  }
+
+  __attribute__((target("avx2"))) static size_t base64_decode_avx2(const char * p_text, const size_t p_length, uint8_t * p_output, const base64::alphabet_t p_alphabet) {
+    const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+    const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+    const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+    size_t i = 0;
+    uint8_t * output = p_output;
+    for ( ; i + 48 <= p_length; i += 32, output += 24) { // 32 bytes are stored, 24 are decoded
+      __m256i text = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_text + i));
+      if (p_alphabet == base64::url) { // Reject '+' and '/', then map '-' and '_' on them
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(text, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(text, _mm256_set1_epi8('/')))) != 0) {
+          break;
+        }
+        text = _mm256_sub_epi8(text, _mm256_and_si256(_mm256_cmpeq_epi8(text, _mm256_set1_epi8('-')), _mm256_set1_epi8('-' - '+')));
+        text = _mm256_sub_epi8(text, _mm256_and_si256(_mm256_cmpeq_epi8(text, _mm256_set1_epi8('_')), _mm256_set1_epi8('_' - '/')));
+      }
+      const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(text, 4), mask_2f);
+      const __m256i lo_nibbles = _mm256_and_si256(text, mask_2f);
+      const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+      const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+      if (!_mm256_testz_si256(lo, hi)) {
+        break; // Let the scalar code report the error
+      }
+      const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(text, mask_2f), hi_nibbles));
+      text = _mm256_add_epi8(text, roll);
+      __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(text, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+      merged = _mm256_shuffle_epi8(merged, pack); // 12 bytes at the beginning of each lane
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+    } // End of 'for' statement
+    return i;
+  }
+
+#endif // TEXT_CODEC_X86
+
+  size_t hexa::encode(const uint8_t * p_data, const size_t p_length, char * p_output, const bool p_upper_case) {
+    const char * digits = p_upper_case ? hexa_upper : hexa_lower;
+    size_t i = 0;
+#if defined(TEXT_CODEC_X86)
+    switch (text_codec::simd_level()) {
+    case text_codec::simd_avx2:
+      i = hexa_encode_avx2(p_data, p_length, p_output, digits);
+      break;
+    case text_codec::simd_ssse3:
+      i = hexa_encode_ssse3(p_data, p_length, p_output, digits);
+      break;
+    default:
+      break;
+    } // End of 'switch' statement
+#endif
+    for (char * output = p_output + 2 * i; i < p_length; i++) {
+      *output++ = digits[p_data[i] >> 4];
+      *output++ = digits[p_data[i] & 0x0f];
+    } // End of 'for' statement
+    return 2 * p_length;
+  }
+
+  const int32_t hexa::decode(const char * p_text, const size_t p_length, uint8_t * p_output) {
+    // Sanity check
+    if (p_length & 1) {
+      return -1;
+    }
+
+    size_t i = 0;
+#if defined(TEXT_CODEC_X86)
+    switch (text_codec::simd_level()) {
+    case text_codec::simd_avx2:
+      i = hexa_decode_avx2(p_text, p_length, p_output);
+      break;
+    case text_codec::simd_ssse3:
+      i = hexa_decode_ssse3(p_text, p_length, p_output);
+      break;
+    default:
+      break;
+    } // End of 'switch' statement
+#endif
+    const int8_t * lut = tables().hexa;
+    for ( ; i < p_length; i += 2) {
+      const int8_t hi = lut[static_cast<uint8_t>(p_text[i])];
+      const int8_t lo = lut[static_cast<uint8_t>(p_text[i + 1])];
+      if ((hi | lo) < 0) {
+        return -1;
+      }
+      p_output[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    } // End of 'for' statement
+    return 0;
+  }
+
+  size_t base64::encode(const uint8_t * p_data, const size_t p_length, char * p_output, const alphabet_t p_alphabet, const bool p_padding) {
+    const char * alphabet = (p_alphabet == standard) ? base64_standard : base64_url;
+    size_t i = 0;
+    char * output = p_output;
+#if defined(TEXT_CODEC_X86)
+    switch (text_codec::simd_level()) {
+    case text_codec::simd_avx2:
+      i = base64_encode_avx2(p_data, p_length, p_output, p_alphabet);
+      break;
+    case text_codec::simd_ssse3:
+      i = base64_encode_ssse3(p_data, p_length, p_output, p_alphabet);
+      break;
+    default:
+      break;
+    } // End of 'switch' statement
+    output += 4 * (i / 3);
+#endif
+    for ( ; i + 3 <= p_length; i += 3) {
+      const uint32_t value = (p_data[i] << 16) | (p_data[i + 1] << 8) | p_data[i + 2];
+      *output++ = alphabet[value >> 18];
+      *output++ = alphabet[(value >> 12) & 0x3f];
+      *output++ = alphabet[(value >> 6) & 0x3f];
+      *output++ = alphabet[value & 0x3f];
+    } // End of 'for' statement
+    if (i < p_length) { // 1 or 2 bytes left
+      const uint32_t value = (p_data[i] << 16) | ((i + 1 < p_length) ? (p_data[i + 1] << 8) : 0);
+      *output++ = alphabet[value >> 18];
+      *output++ = alphabet[(value >> 12) & 0x3f];
+      if (i + 1 < p_length) {
+        *output++ = alphabet[(value >> 6) & 0x3f];
+      } else if (p_padding) {
+        *output++ = '=';
+      }
+      if (p_padding) {
+        *output++ = '=';
+      }
+    }
+    return output - p_output;
+  }
+
+  const int32_t base64::decode(const char * p_text, const size_t p_length, uint8_t * p_output, size_t & p_decoded, const alphabet_t p_alphabet) {
+    p_decoded = 0;
+
+    // Remove padding
+    size_t length = p_length;
+    if (((length & 3) == 0) && (length != 0) && (p_text[length - 1] == '=')) {
+      length -= (p_text[length - 2] == '=') ? 2 : 1;
+    }
+    if ((length & 3) == 1) {
+      return -1;
+    }
+
+    size_t i = 0;
+    uint8_t * output = p_output;
+#if defined(TEXT_CODEC_X86)
+    switch (text_codec::simd_level()) {
+    case text_codec::simd_avx2:
+      i = base64_decode_avx2(p_text, length, p_output, p_alphabet);
+      break;
+    case text_codec::simd_ssse3:
+      i = base64_decode_ssse3(p_text, length, p_output, p_alphabet);
+      break;
+    default:
+      break;
+    } // End of 'switch' statement
+    output += 3 * (i / 4);
+#endif
+    const uint8_t * lut = tables().base64[p_alphabet];
+    for ( ; i + 4 <= length; i += 4) {
+      const uint8_t a = lut[static_cast<uint8_t>(p_text[i])];
+      const uint8_t b = lut[static_cast<uint8_t>(p_text[i + 1])];
+      const uint8_t c = lut[static_cast<uint8_t>(p_text[i + 2])];
+      const uint8_t d = lut[static_cast<uint8_t>(p_text[i + 3])];
+      if ((a | b | c | d) & 0x80) {
+        return -1;
+      }
+      const uint32_t value = (a << 18) | (b << 12) | (c << 6) | d;
+      *output++ = static_cast<uint8_t>(value >> 16);
+      *output++ = static_cast<uint8_t>(value >> 8);
+      *output++ = static_cast<uint8_t>(value);
+    } // End of 'for' statement
+    if (i < length) { // 2 or 3 characters left
+      const uint8_t a = lut[static_cast<uint8_t>(p_text[i])];
+      const uint8_t b = lut[static_cast<uint8_t>(p_text[i + 1])];
+      const uint8_t c = (i + 2 < length) ? lut[static_cast<uint8_t>(p_text[i + 2])] : 0;
+      if ((a | b | c) & 0x80) {
+        return -1;
+      }
+      const uint32_t value = (a << 18) | (b << 12) | (c << 6);
+      *output++ = static_cast<uint8_t>(value >> 16);
+      if (i + 2 < length) {
+        *output++ = static_cast<uint8_t>(value >> 8);
+      }
+    }
+
+    p_decoded = output - p_output;
+    return 0;
+  }
+
+} // End of namespace helpers
@@ -10,10 +10,15 @@
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 #include <gtest.h>
 
 #include "converter.hh"
+#include "text_codec.hh"
+#include "endianness.hh"
+#include "numeric.hh"
 #include "helper.hh"
 
 using namespace std;
@@ -303,6 +308,341 @@ TEST(converter_test_suite,  base64_to_binary_1) {
   ASSERT_TRUE(plain_binary[3] == expected_result[3]);
 }
 
+/**
+ * @brief Test case for @see hexa::encode/hexa::decode, lengths covering the vectorized and the scalar code paths
+ * @see text_codec::set_simd_level
+ */
+TEST(converter_test_suite, hexa_1) {
+  std::vector<uint8_t> data(259);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 37 + 11);
+  } // End of 'for' statement
+  for (int level = text_codec::simd_none; level <= text_codec::supported_simd_level(); level++) {
+    ASSERT_TRUE(text_codec::set_simd_level(static_cast<text_codec::simd_level_t>(level)) == 0);
+    for (size_t length = 0; length <= data.size(); length++) {
+      std::string text(hexa::encoded_size(length), '\0');
+      ASSERT_TRUE(hexa::encode(data.data(), length, &text[0]) == 2 * length);
+      for (size_t i = 0; i < length; i++) {
+        char expected[3];
+        std::sprintf(expected, "%02x", data[i]);
+        ASSERT_TRUE(text.compare(2 * i, 2, expected) == 0) << "level " << level;
+      } // End of 'for' statement
+      std::vector<uint8_t> decoded(hexa::decoded_size(text.length()));
+      ASSERT_TRUE(hexa::decode(text.data(), text.length(), decoded.data()) == 0);
+      ASSERT_TRUE(std::equal(decoded.cbegin(), decoded.cend(), data.cbegin())) << "level " << level;
+    } // End of 'for' statement
+  } // End of 'for' statement
+  text_codec::set_simd_level(text_codec::supported_simd_level());
+  ASSERT_TRUE(text_codec::set_simd_level(static_cast<text_codec::simd_level_t>(text_codec::simd_avx2 + 1)) == -1);
+  std::string upper(2, '\0');
+  hexa::encode(data.data() + 4, 1, &upper[0], true); // 0x9f
+  ASSERT_TRUE(upper.compare("9F") == 0);
+}
+
+/**
+ * @brief Test case for @see hexa::decode with invalid input
+ */
+TEST(converter_test_suite, hexa_2) {
+  std::string text(128, 'A');
+  std::vector<uint8_t> decoded(64);
+  ASSERT_TRUE(hexa::decode(text.data(), text.length(), decoded.data()) == 0);
+  ASSERT_TRUE(decoded[0] == 0xaa);
+  ASSERT_TRUE(hexa::decode(text.data(), 127, decoded.data()) == -1); // Odd length
+  const char invalid[] = { 'g', 'G', ':', '/', '@', '`', ' ', '\x80' };
+  for (size_t pos = 0; pos < text.length(); pos += 13) {
+    for (size_t i = 0; i < sizeof(invalid); i++) {
+      std::string wrong(text);
+      wrong[pos] = invalid[i];
+      ASSERT_TRUE(hexa::decode(wrong.data(), wrong.length(), decoded.data()) == -1);
+    } // End of 'for' statement
+  } // End of 'for' statement
+  ASSERT_TRUE(converter::get_instance().hexa_to_bytes("0a1G").empty());
+}
+
+/**
+ * @brief Bitwise base64 encoder, one character at a time, used as an independent reference
+ */
+static std::string base64_reference(const uint8_t * p_data, const size_t p_length, const char * p_alphabet) {
+  std::string text;
+  uint32_t value = 0;
+  int32_t bits = -6;
+  for (size_t i = 0; i < p_length; i++) {
+    value = ((value << 8) | p_data[i]) & 0xffffff;
+    bits += 8;
+    while (bits >= 0) {
+      text.push_back(p_alphabet[(value >> bits) & 0x3f]);
+      bits -= 6;
+    } // End of 'while' statement
+  } // End of 'for' statement
+  if (bits > -6) {
+    text.push_back(p_alphabet[(value << 8 >> (bits + 8)) & 0x3f]);
+  }
+  return text;
+}
+
+/**
+ * @brief Test case for @see base64::encode/base64::decode with the RFC 4648 section 10 test vectors
+ */
+TEST(converter_test_suite, base64_1) {
+  const char * vectors[][2] = {
+    { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" }, { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" }
+  };
+  for (int level = text_codec::simd_none; level <= text_codec::supported_simd_level(); level++) {
+    ASSERT_TRUE(text_codec::set_simd_level(static_cast<text_codec::simd_level_t>(level)) == 0);
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+      const size_t length = std::strlen(vectors[v][0]);
+      std::string text(base64::encoded_size(length), '\0');
+      ASSERT_TRUE(base64::encode(reinterpret_cast<const uint8_t *>(vectors[v][0]), length, &text[0]) == text.length());
+      ASSERT_TRUE(text.compare(vectors[v][1]) == 0) << "level " << level << ": " << text;
+      std::vector<uint8_t> decoded(base64::decoded_size(text.length()));
+      size_t decoded_length;
+      ASSERT_TRUE(base64::decode(vectors[v][1], std::strlen(vectors[v][1]), decoded.data(), decoded_length) == 0);
+      ASSERT_TRUE((decoded_length == length) && std::equal(decoded.cbegin(), decoded.cbegin() + length, vectors[v][0]));
+    } // End of 'for' statement
+  } // End of 'for' statement
+  text_codec::set_simd_level(text_codec::supported_simd_level());
+}
+
+/**
+ * @brief Test case for @see base64::encode/base64::decode, both alphabets, with and without padding, on each code path
+ * @see text_codec::set_simd_level
+ */
+TEST(converter_test_suite, base64_2) {
+  const char * alphabets[] = { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/", "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_" };
+  std::vector<uint8_t> data(259);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 97 + 3);
+  } // End of 'for' statement
+  for (int level = text_codec::simd_none; level <= text_codec::supported_simd_level(); level++) {
+    ASSERT_TRUE(text_codec::set_simd_level(static_cast<text_codec::simd_level_t>(level)) == 0);
+    for (size_t length = 0; length <= data.size(); length++) {
+      for (int alphabet = base64::standard; alphabet <= base64::url; alphabet++) {
+        const std::string reference = base64_reference(data.data(), length, alphabets[alphabet]);
+        for (int padding = 0; padding < 2; padding++) {
+          std::string text(base64::encoded_size(length, padding == 1), '\0');
+          ASSERT_TRUE(base64::encode(data.data(), length, &text[0], static_cast<base64::alphabet_t>(alphabet), padding == 1) == text.length());
+          ASSERT_TRUE(text.compare(0, reference.length(), reference) == 0) << "level " << level << ", length " << length;
+          ASSERT_TRUE(text.find_first_not_of('=', reference.length()) == std::string::npos);
+          std::vector<uint8_t> decoded(base64::decoded_size(text.length()));
+          size_t decoded_length;
+          ASSERT_TRUE(base64::decode(text.data(), text.length(), decoded.data(), decoded_length, static_cast<base64::alphabet_t>(alphabet)) == 0);
+          ASSERT_TRUE(decoded_length == length);
+          ASSERT_TRUE(std::equal(data.cbegin(), data.cbegin() + length, decoded.cbegin())) << "level " << level << ", length " << length;
+        } // End of 'for' statement
+      } // End of 'for' statement
+    } // End of 'for' statement
+  } // End of 'for' statement
+  text_codec::set_simd_level(text_codec::supported_simd_level());
+}
+
+/**
+ * @brief Test case for @see base64::decode with invalid input
+ */
+TEST(converter_test_suite, base64_3) {
+  std::vector<uint8_t> data(120, 0xfb);
+  std::string text(base64::encoded_size(data.size()), '\0');
+  base64::encode(data.data(), data.size(), &text[0]);  // "+/v7..."
+  std::vector<uint8_t> decoded(base64::decoded_size(text.length()));
+  size_t length;
+  ASSERT_TRUE(base64::decode(text.data(), text.length(), decoded.data(), length) == 0);
+  ASSERT_TRUE(base64::decode(text.data(), text.length(), decoded.data(), length, base64::url) == -1);
+  ASSERT_TRUE(base64::decode(text.data(), 5, decoded.data(), length) == -1); // Truncated
+  const char invalid[] = { '-', '_', '=', '*', ' ', '\0', '\x80', '\xff' };
+  for (size_t pos = 0; pos < text.length(); pos += 7) {
+    for (size_t i = 0; i < sizeof(invalid); i++) {
+      std::string wrong(text);
+      wrong[pos] = invalid[i];
+      ASSERT_TRUE(base64::decode(wrong.data(), wrong.length(), decoded.data(), length) == -1);
+    } // End of 'for' statement
+  } // End of 'for' statement
+  // The converter keeps decoding up to the first invalid character
+  ASSERT_TRUE(converter::get_instance().base64_to_string("RGVjb2Rl*ZnJvbQ==").compare("Decode") == 0);
+}
+
+/**
+ * @brief Test case for @see load_be/load_le/store_be/store_le
+ */
+TEST(converter_test_suite, endianness_1) {
+  static_assert(be_to_host(host_to_be(static_cast<uint32_t>(0xcafedeca))) == 0xcafedeca, "constexpr conversion expected");
+  const uint8_t buffer[] = { 0x00, 0xca, 0xfe, 0xde, 0xca, 0x01, 0x02, 0x03, 0x04 };
+  // Unaligned loads
+  ASSERT_TRUE(load_be<uint16_t>(buffer + 1) == 0xcafe);
+  ASSERT_TRUE(load_le<uint16_t>(buffer + 1) == 0xfeca);
+  ASSERT_TRUE(load_be<int16_t>(buffer + 1) == static_cast<int16_t>(0xcafe));
+  ASSERT_TRUE(load_be<uint32_t>(buffer + 1) == 0xcafedeca);
+  ASSERT_TRUE(load_le<uint32_t>(buffer + 1) == 0xcadefeca);
+  ASSERT_TRUE(load_be<uint64_t>(buffer + 1) == 0xcafedeca01020304ULL);
+  ASSERT_TRUE(load_le<int64_t>(buffer + 1) == 0x04030201cadefecaLL);
+  ASSERT_TRUE(load_be<uint8_t>(buffer + 2) == 0xfe);
+
+  uint8_t output[9] = { 0 };
+  store_be<uint32_t>(output + 1, 0xcafedeca);
+  ASSERT_TRUE(std::equal(output + 1, output + 5, buffer + 1));
+  store_le<uint64_t>(output + 1, 0x04030201cadefecaULL);
+  ASSERT_TRUE(std::equal(output + 1, output + 9, buffer + 1));
+  ASSERT_TRUE(output[0] == 0x00);
+
+  // IEEE 754 values
+  store_be(output, 1.0f);
+  ASSERT_TRUE((output[0] == 0x3f) && (output[1] == 0x80) && (output[2] == 0x00) && (output[3] == 0x00));
+  ASSERT_TRUE(load_be<float>(output) == 1.0f);
+  store_le(output, -2.5);
+  ASSERT_TRUE((output[7] == 0xc0) && (output[6] == 0x04) && (output[0] == 0x00));
+  ASSERT_TRUE(load_le<double>(output) == -2.5);
+}
+
+/**
+ * @brief Test case for the endianess parameter of @see converter::int_to_bytes and @see converter::bytes_to_int
+ */
+TEST(converter_test_suite, endianness_2) {
+  std::vector<uint8_t> result = converter::get_instance().int_to_bytes(0x01020304, converter::little_endian);
+  ASSERT_TRUE((result.size() == 4) && (result[0] == 0x04) && (result[3] == 0x01));
+  ASSERT_TRUE(converter::get_instance().bytes_to_int(result, converter::little_endian) == 0x01020304);
+  result = converter::get_instance().short_to_bytes(static_cast<int16_t>(0xcafe), converter::little_endian);
+  ASSERT_TRUE((result.size() == 2) && (result[0] == 0xfe) && (result[1] == 0xca));
+  // Shorter arrays
+  std::vector<uint8_t> value = { 0x01, 0x02, 0x03 };
+  ASSERT_TRUE(converter::get_instance().bytes_to_int(value) == 0x010203);
+  ASSERT_TRUE(converter::get_instance().bytes_to_int(value, converter::little_endian) == 0x030201);
+  ASSERT_TRUE(converter::get_instance().bytes_to_long(value, converter::little_endian) == 0x030201);
+  value.push_back(0x04);
+  value.push_back(0x05);
+  ASSERT_TRUE(converter::get_instance().bytes_to_int(value) == INT_MAX);
+}
+
+/**
+ * @brief Test case for @see parse_integer and @see format_integer
+ */
+TEST(converter_test_suite, numeric_1) {
+  const char * text = "-2147483648,4294967295,2147483648,0x1f";
+  const char * end = text + std::strlen(text);
+  int32_t value = 0;
+  parse_result result = parse_integer(text, end, value);
+  ASSERT_TRUE((result.error == 0) && (value == INT32_MIN) && (*result.ptr == ','));
+  uint32_t unsigned_value = 0;
+  result = parse_integer(result.ptr + 1, end, unsigned_value);
+  ASSERT_TRUE((result.error == 0) && (unsigned_value == 4294967295U));
+  result = parse_integer(result.ptr + 1, end, value);
+  ASSERT_TRUE((result.error == ERANGE) && (*result.ptr == ',') && (value == INT32_MIN)); // Unchanged
+  result = parse_integer(result.ptr + 1, end, value);
+  ASSERT_TRUE((result.error == 0) && (value == 0) && (*result.ptr == 'x'));
+  result = parse_integer(result.ptr + 1, end, value, 16);
+  ASSERT_TRUE((result.error == 0) && (value == 0x1f) && (result.ptr == end));
+  // Errors
+  const std::string invalid[] = { "", "-", "+1", " 1", "x" };
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(std::string); i++) {
+    result = parse_integer(invalid[i].c_str(), invalid[i].c_str() + invalid[i].length(), value);
+    ASSERT_TRUE((result.error == EINVAL) && (result.ptr == invalid[i].c_str()));
+  } // End of 'for' statement
+  result = parse_integer(text, end, unsigned_value); // No sign for unsigned types
+  ASSERT_TRUE(result.error == EINVAL);
+  uint8_t byte;
+  ASSERT_TRUE(parse_integer(text + 1, end, byte).error == ERANGE);
+  ASSERT_TRUE(converter::get_instance().string_to_int("  +42 km") == 42);
+  ASSERT_THROW(converter::get_instance().string_to_int("km"), std::invalid_argument);
+  ASSERT_THROW(converter::get_instance().string_to_int("+-5"), std::invalid_argument);
+  ASSERT_THROW(converter::get_instance().string_to_int("++5"), std::invalid_argument);
+  ASSERT_THROW(converter::get_instance().string_to_float("+-5.0"), std::invalid_argument);
+  ASSERT_TRUE(converter::get_instance().string_to_int("-5") == -5);
+  ASSERT_THROW(converter::get_instance().string_to_int("99999999999"), std::out_of_range);
+
+  char buffer[24];
+  ASSERT_TRUE(std::string(buffer, format_integer(buffer, buffer + sizeof(buffer), INT64_MIN)).compare("-9223372036854775808") == 0);
+  ASSERT_TRUE(std::string(buffer, format_integer(buffer, buffer + sizeof(buffer), UINT64_MAX)).compare("18446744073709551615") == 0);
+  ASSERT_TRUE(std::string(buffer, format_integer(buffer, buffer + sizeof(buffer), 0)).compare("0") == 0);
+  ASSERT_TRUE(std::string(buffer, format_integer(buffer, buffer + sizeof(buffer), static_cast<uint8_t>(7))).compare("7") == 0);
+  ASSERT_TRUE(format_integer(buffer, buffer + 3, 1000) == nullptr);
+  for (int32_t i = -100000; i <= 100000; i += 7) {
+    ASSERT_TRUE(converter::get_instance().int_to_string(i).compare(std::to_string(i)) == 0);
+  } // End of 'for' statement
+}
+
+/**
+ * @brief Test case for @see parse_float, compared with strtod
+ */
+TEST(converter_test_suite, numeric_2) {
+  const std::string values[] = {
+    "0", "-0", "4807.038", "01131.000", "022.4", "084.4", "545.4", "1e10", "1.5E-3", ".5", "5.", "0.1", "0.3", "123456789012345678",
+    "9007199254740993", "1.7976931348623157e308", "4.9e-324", "2.2250738585072014e-308", "0.000000000000000000000000001",
+    "3.141592653589793238462643383279", "100000000000000000000000", "7.0e+22", "-12.5e-2"
+  };
+  for (size_t i = 0; i < sizeof(values) / sizeof(std::string); i++) {
+    const char * first = values[i].c_str();
+    double value = -1.0;
+    parse_result result = parse_float(first, first + values[i].length(), value);
+    ASSERT_TRUE((result.error == 0) && (result.ptr == first + values[i].length()));
+    ASSERT_TRUE(value == std::strtod(first, nullptr));
+    ASSERT_TRUE(std::signbit(value) == std::signbit(std::strtod(first, nullptr)));
+    float float_value = -1.0;
+    result = parse_float(first, first + values[i].length(), float_value);
+    errno = 0;
+    const float expected = std::strtof(first, nullptr);
+    if ((errno == ERANGE) && ((expected == 0) || std::isinf(expected))) { // Out of the float range
+      ASSERT_TRUE((result.error == ERANGE) && (float_value == -1.0));
+    } else {
+      ASSERT_TRUE((result.error == 0) && (float_value == expected));
+    }
+  } // End of 'for' statement
+  // Random values
+  std::srand(0);
+  char buffer[64];
+  for (int i = 0; i < 10000; i++) {
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.*f", std::rand() % 10, (std::rand() - RAND_MAX / 2) / 1000.0);
+    double value;
+    ASSERT_TRUE((parse_float(buffer, buffer + length, value).error == 0) && (value == std::strtod(buffer, nullptr)));
+  } // End of 'for' statement
+  // Partial input and errors
+  const char * text = "22.4,N*3e";
+  double value = 0.0;
+  parse_result result = parse_float(text, text + 9, value);
+  ASSERT_TRUE((result.error == 0) && (value == 22.4) && (*result.ptr == ','));
+  result = parse_float(text + 5, text + 9, value);
+  ASSERT_TRUE((result.error == EINVAL) && (result.ptr == text + 5));
+  text = "2e";
+  ASSERT_TRUE((parse_float(text, text + 2, value).ptr == text + 1) && (value == 2.0)); // The exponent requires digits
+  text = "1e999";
+  ASSERT_TRUE((parse_float(text, text + 5, value).error == ERANGE) && (value == 2.0));
+  ASSERT_TRUE(converter::get_instance().string_to_float(" 0.25") == 0.25f);
+  ASSERT_THROW(converter::get_instance().string_to_float("."), std::invalid_argument);
+}
+
+/**
+ * @brief Test case for @see parse_fixed, @see format_fixed and @see format_float
+ */
+TEST(converter_test_suite, numeric_3) {
+  const char * text = "4807.0381,-0.5,12,.";
+  const char * end = text + std::strlen(text);
+  int64_t value = 0;
+  parse_result result = parse_fixed(text, end, value, 3);
+  ASSERT_TRUE((result.error == 0) && (value == 4807038) && (*result.ptr == ',')); // Truncated
+  result = parse_fixed(result.ptr + 1, end, value, 3);
+  ASSERT_TRUE((result.error == 0) && (value == -500));
+  result = parse_fixed(result.ptr + 1, end, value, 2);
+  ASSERT_TRUE((result.error == 0) && (value == 1200));
+  result = parse_fixed(result.ptr + 1, end, value, 2);
+  ASSERT_TRUE(result.error == EINVAL);
+  text = "92233720368547758.08";
+  ASSERT_TRUE(parse_fixed(text, text + std::strlen(text), value, 2).error == ERANGE);
+  ASSERT_TRUE(parse_fixed(text, text + std::strlen(text), value, 1).error == 0);
+
+  char buffer[400];
+  ASSERT_TRUE(std::string(buffer, format_fixed(buffer, buffer + sizeof(buffer), 4807038, 3)).compare("4807.038") == 0);
+  ASSERT_TRUE(std::string(buffer, format_fixed(buffer, buffer + sizeof(buffer), -5, 3)).compare("-0.005") == 0);
+  ASSERT_TRUE(format_fixed(buffer, buffer + 5, 4807038, 3) == nullptr);
+  // format_float matches printf, including the ties
+  std::srand(0);
+  for (int i = 0; i < 10000; i++) {
+    const double value = (std::rand() - RAND_MAX / 2) / 1024.0 / 3.0;
+    const int precision = std::rand() % 8;
+    char expected[64];
+    std::snprintf(expected, sizeof(expected), "%.*f", precision, value);
+    ASSERT_TRUE(std::string(buffer, format_float(buffer, buffer + sizeof(buffer), value, precision)).compare(expected) == 0);
+  } // End of 'for' statement
+  ASSERT_TRUE(std::string(buffer, format_float(buffer, buffer + sizeof(buffer), -0.001, 2)).compare("-0.00") == 0);
+  ASSERT_TRUE(std::string(buffer, format_float(buffer, buffer + sizeof(buffer), 1e300, 1)).compare(0, 2, "10") == 0); // Slow path
+  ASSERT_TRUE(std::string(buffer, format_float(buffer, buffer + sizeof(buffer), 1.0 / 0.0, 1)).compare("inf") == 0);
+}
+
 /**
  * @brief Main test program
  * @param[in] p_argc Number of argumrnt
@@ -0,0 +1,98 @@
+/*!
+ * \file      main.cpp
+ * \brief     Viewer of the statistics published by a stats_registry.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <memory>
+
+#include "get_opt.hh"
+#include "runtime.hh" // Event loop
+#include "stats_registry.hh"
+
+static const char * g_kinds[] = { "", "counter", "gauge", "histogram" };
+
+/**
+ * \brief Display the statistics, with the rate of the counters since the previous display
+ */
+static void display(const std::string & p_name, const stats_reader & p_reader, const double p_interval, std::map<std::string, int64_t> & p_previous) {
+  std::vector<stats_value> values;
+  std::clog << "\033[H\033[2J"; // Home, clear screen
+  if (p_reader.read(values) == -1) {
+    std::clog << p_name << ": no statistics (q to quit)" << std::endl;
+    return;
+  }
+  std::clog << p_name << " - pid " << p_reader.pid() << " - " << values.size() << " statistics (q to quit)" << std::endl << std::endl;
+  std::clog << std::left << std::setw(40) << "NAME" << std::setw(10) << "KIND" << std::right << std::setw(16) << "VALUE" << std::setw(12) << "RATE/s"
+            << std::setw(12) << "P50" << std::setw(12) << "P99" << std::setw(12) << "MAX" << std::endl;
+  for (std::vector<stats_value>::const_iterator it = values.cbegin(); it != values.cend(); ++it) {
+    std::clog << std::left << std::setw(40) << it->name << std::setw(10) << g_kinds[it->kind] << std::right << std::setw(16) << it->value;
+    if (it->kind == stats_gauge_kind) {
+      std::clog << std::endl;
+      continue;
+    }
+    std::map<std::string, int64_t>::const_iterator previous = p_previous.find(it->name);
+    if ((previous != p_previous.cend()) && (it->value >= previous->second)) {
+      std::clog << std::setw(12) << std::fixed << std::setprecision(1) << (it->value - previous->second) / p_interval;
+    } else {
+      std::clog << std::setw(12) << "-";
+    }
+    p_previous[it->name] = it->value;
+    if (it->kind == stats_histogram_kind) {
+      std::clog << std::setw(12) << it->p50 << std::setw(12) << it->p99 << std::setw(12) << it->max;
+    }
+    std::clog << std::endl;
+  } // End of 'for' statement
+}
+
+int32_t main(const int32_t p_argc, const char** p_argv) {
+  // SIGINT/SIGTERM are received by the event loop, create it before any thread
+  runtime rt;
+
+  // Parse comand line
+  std::string name;
+  uint32_t interval;
+  bool json;
+  get_opt::get_opt opt(p_argc, p_argv);
+  opt >> get_opt::option('n', "name", name, "");
+  opt >> get_opt::option('i', "interval", interval, (uint32_t)1000);
+  opt >> get_opt::option_present('j', "json", json);
+  if (name.empty() || (interval == 0)) {
+    std::cerr << "Usage: " << p_argv[0] << " -n <segment name> [-i <refresh interval in ms>] [-j]" << std::endl;
+    return -1;
+  }
+
+  if (json) { // One dump on the standard output
+    stats_reader reader(name);
+    std::vector<stats_value> values;
+    if (reader.read(values) == -1) {
+      std::cerr << p_argv[0] << ": cannot read segment " << name << std::endl;
+      return -1;
+    }
+    std::cout << "{\"name\":\"" << name << "\",\"pid\":" << reader.pid() << ",\"stats\":";
+    stats_reader::to_json(values, std::cout);
+    std::cout << "}" << std::endl;
+    return 0;
+  }
+
+  // Top-like view until 'q' is pressed or SIGINT/SIGTERM is received
+  std::map<std::string, int64_t> previous;
+  rt.add_timer(std::chrono::milliseconds(interval), [&name, &previous, interval](const uint64_t p_expirations) {
+      stats_reader reader(name); // Opened again on each refresh, the observed process may have been restarted
+      display(name, reader, p_expirations * interval / 1000.0, previous);
+    });
+  rt.on_key([&rt](const char p_key) {
+      if ((p_key == 'q') || (p_key == 'Q')) {
+        rt.stop();
+      }
+    });
+  rt.run();
+
+  return 0; // Succeed
+} // End of main function
@@ -15,6 +15,7 @@
 #include "helper.hh"
 #include "get_opt.hh"
 #include "runnable.hh"
+#include "stats_registry.hh"
 
 #include "socket_address.hh"
 #include "channel_manager.hh"
@@ -26,8 +27,11 @@ class tcp_echo_server : public runnable{
   socket_address _host_addr;
   socket_address _peer_addr;
   uint32_t _channel;
+  stats_counter _connections;
+  stats_counter _bytes;
+  stats_histogram _echo_latency;
 public:
-  tcp_echo_server(const std::string& p_host_address, const std::string& p_peer_address, const uint16_t p_port, logger::logger& p_logger);
+  tcp_echo_server(const std::string& p_host_address, const std::string& p_peer_address, const uint16_t p_port, logger::logger& p_logger, stats_registry& p_stats);
   virtual ~tcp_echo_server();
 
   void run();
@@ -12,13 +12,18 @@
 
 #include "tcp_echo.hh"
 #include "tcp_echo_server.hh"
-#include "keyboard.hh"
+#include "runtime.hh" // Event loop
 #include "runnable.hh" // Thread implementation
+#include "stats_registry.hh" // Statistics, see stats_top -n tcp_echo
 
 static int g_index = 0;
 std::vector<int8_t> g_wait_cursor { '|', '/', '-', '\\', '|', '/', '-', '\\' };
 
 int32_t main(const int32_t p_argc, const char** p_argv) {
+  // SIGINT/SIGTERM are received by the event loop, create it before any thread
+  runtime rt;
+  stats_registry stats("tcp_echo");
+
   // Create logger instance
   std::string s("logger1");
   std::string path(std::getenv("HOME_TMP") + std::string("/") + s + ".log");
@@ -36,19 +41,10 @@ int32_t main(const int32_t p_argc, const char** p_argv) {
   logger_factory::get_instance().get_logger(s).info("Command line args: %x, %s, %u", is_debug_set, address.c_str(), port);
 
   // Launch the TCP echo server
-  tcp_echo_server server(std::string("0.0.0.0"), address, port, logger_factory::get_instance().get_logger(s));
+  tcp_echo_server server(std::string("0.0.0.0"), address, port, logger_factory::get_instance().get_logger(s), stats);
   server.start();
   std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-  /***
-  // Wait for stop keyword
-  while (static_cast<char>(keyboard::kbhit()) == 0) {
-    std::clog << g_wait_cursor[g_index] << '\b';
-    g_index = (g_index + 1) % g_wait_cursor.size();
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-  };
-  ***/
-
   // Send a TCP message to the server
   int32_t result;
   tcp_echo client(address.c_str(), port, logger_factory::get_instance().get_logger(s));
@@ -57,8 +53,13 @@ int32_t main(const int32_t p_argc, const char** p_argv) {
   std::string response;
   result = client.receive(response);
   logger_factory::get_instance().get_logger(s).info("Receive from server: %s", response.c_str());
-  // Wait some few seconds
-  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  // Serve until a key is pressed or SIGINT/SIGTERM is received
+  rt.add_timer(std::chrono::milliseconds(500), [](const uint64_t p_expirations) {
+      std::clog << g_wait_cursor[g_index] << '\b';
+      g_index = (g_index + 1) % g_wait_cursor.size();
+    });
+  rt.on_key([&rt](const char p_key) { rt.stop(); });
+  rt.run();
 
   // Stop the server
   server.stop();
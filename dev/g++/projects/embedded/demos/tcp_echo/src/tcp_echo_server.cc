@@ -8,10 +8,13 @@
  */
 #include "tcp_echo_server.hh"
 
-tcp_echo_server::tcp_echo_server(const std::string& p_host_address, const std::string& p_peer_address, const uint16_t p_port, logger::logger& p_logger) :
+tcp_echo_server::tcp_echo_server(const std::string& p_host_address, const std::string& p_peer_address, const uint16_t p_port, logger::logger& p_logger, stats_registry& p_stats) :
   _logger(p_logger),
   _host_addr(p_host_address, p_port),
-  _peer_addr(p_peer_address, p_port) {
+  _peer_addr(p_peer_address, p_port),
+  _connections(p_stats.counter("server.connections")),
+  _bytes(p_stats.counter("server.bytes")),
+  _echo_latency(p_stats.histogram("server.echo_ns")) {
   _channel = channel_manager::get_instance().create_channel(channel_type::tcp, _host_addr, _peer_addr);
   if (_channel < 0) {
     // TODO Throw an execption
@@ -39,6 +42,7 @@ void tcp_echo_server::run() {
       int32_t result = channel_manager::get_instance().get_channel(_channel).accept_connection();
       _logger.info("tcp_echo_server: Accept return %d", result);
       if (result != -1) { // Incoming connection
+        _connections.increment();
         s.push_back(result);
         _logger.info("tcp_echo_server: 1111");
         fds.clear();
@@ -49,6 +53,7 @@ void tcp_echo_server::run() {
         if (it != fds.end()) { // Some data are available
           _logger.info("tcp_echo_server: 4444: %d", *it);
           // Read incoming data
+          std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
           std::vector<uint8_t> buffer(128, 0xff);
           uint32_t result = channel_manager::get_instance().get_channel(*it).read(buffer);
           _logger.info("tcp_echo_server: receive data: result=%d", result);
@@ -56,6 +61,8 @@ void tcp_echo_server::run() {
           // Echo
           _logger.info("Send echo...");
           channel_manager::get_instance().get_channel(*it).write(buffer);
+          _bytes.add(result);
+          _echo_latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
           // Wait some few seconds
           std::this_thread::sleep_for(std::chrono::milliseconds(500));
         }
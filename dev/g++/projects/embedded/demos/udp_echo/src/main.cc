@@ -13,8 +13,12 @@
 #include "udp_echo.hh"
 #include "udp_echo_server.hh"
 #include "runnable.hh" // Thread implementation
+#include "runtime.hh" // Event loop
 
 int32_t main(const int32_t p_argc, const char** p_argv) {
+  // SIGINT/SIGTERM are received by the event loop, create it before any thread
+  runtime rt;
+
   // Create logger instance
   std::string s("logger1");
   std::string path(std::getenv("HOME_TMP") + std::string("/") + s + ".log");
@@ -41,6 +45,10 @@ int32_t main(const int32_t p_argc, const char** p_argv) {
   udp_echo client(address.c_str(), port, logger_factory::get_instance().get_logger(s));
   result = client.send(std::string("This is a message from the client side"));
 
+  // Serve until a key is pressed or SIGINT/SIGTERM is received
+  rt.on_key([&rt](const char p_key) { rt.stop(); });
+  rt.run();
+
   // Stop the server
   server.stop();
 
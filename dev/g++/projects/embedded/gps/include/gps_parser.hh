@@ -8,9 +8,11 @@
  */
 #pragma once
 
+#include <string>
 #include <map>
 #include <vector>
 #include <functional> // Used for std::cref
+#include <cstdint>
 
 namespace gps {
 
@@ -40,6 +42,13 @@ namespace gps {
       virtual const int32_t process(const std::vector<uint8_t> & p_gps_frame) = 0;
       virtual const int32_t process(const std::string & p_gps_frame) = 0;
       virtual inline const std::map<uint8_t, std::string> & get_result() const { return std::ref(_values); };
+      /**
+       * \brief Convert a value of the last processed frame into a number, without allocation
+       * \param[in] p_index The index of the value (e.g. speed_idx)
+       * \param[out] p_value The numeric value. For latitude and longitude, the raw NMEA value (ddmm.mmmm) without the hemisphere
+       * \return 0 on success, -1 if the value is empty or not a number
+       */
+      const int32_t get_value(const uint8_t p_index, double & p_value) const;
       
     }; // End of class gps_parser
     
@@ -8,6 +8,7 @@
  */
 
 #include "gps_parser.hh"
+#include "numeric.hh"
 
 namespace gps {
 
@@ -33,6 +34,15 @@ namespace gps {
       
     }
 
+    const int32_t gps_parser::get_value(const uint8_t p_index, double & p_value) const {
+      std::map<uint8_t, std::string>::const_iterator it = _values.find(p_index);
+      if (it == _values.cend()) {
+        return -1;
+      }
+      const std::string & value = it->second;
+      return (parse_float(value.c_str(), value.c_str() + value.length(), p_value).error == 0) ? 0 : -1;
+    }
+
   } // End of namespace parsers
 
 } // End of namespace gps
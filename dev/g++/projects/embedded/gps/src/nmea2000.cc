@@ -12,6 +12,8 @@
 
 #include "nmea2000.hh"
 
+#include "checksum.hh"
+
 namespace gps {
 
   namespace parsers {
@@ -150,6 +152,10 @@ namespace gps {
 	//      std::clog << "New command: '" << line << "'" << std::endl;
 	_buffer = _buffer.substr(end_command + 2);
 	//      std::clog << "New buffer: '" << _buffer << "'" << std::endl;
+	// Discard corrupted sentences
+	if (checksum::verify_nmea(line) == -1) {
+	  return -1;
+	}
 	// Extract the command
 	_matches = (regmatch_t *)new uint8_t[sizeof(regmatch_t) * (1 + _regex_command.re_nsub)];
 	if ((_result_code = regexec(&_regex_command, line.c_str(), 1 + _regex_command.re_nsub, _matches, 0)) != 0) {
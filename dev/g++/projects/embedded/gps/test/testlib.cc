@@ -69,7 +69,18 @@ protected:
     ASSERT_TRUE(values[gps_parser::altitude_idx] == "499.6");
     ASSERT_TRUE(values[gps_parser::heading_idx].empty());
     ASSERT_TRUE(values[gps_parser::yawrate_idx].empty());
-    ASSERT_TRUE_MSG(p->process("$GPGGA,092725.00,4717.11399,H,00833.91590,E,1,8,1.01,499.6,M,48.0,M,,0*5B\r\n") != 0, "$GPGGA frame processing shall fail due to invalid Latitude direction");
+    ASSERT_TRUE_MSG(p->process("$GPGGA,092725.00,4717.11399,H,00833.91590,E,1,8,1.01,499.6,M,48.0,M,,0*5D\r\n") != 0, "$GPGGA frame processing shall fail due to invalid Latitude direction");
+  }  
+  
+  /**
+   * @brief Test case for @see gps_parser::process with a corrupted sentence
+   * @see checksum::verify_nmea
+   */
+  TEST(nmea2000_test_suite, nmea2000_4) {
+    std::shared_ptr<gps_parser> p(gps_parser_factory::get_instance().create()); // NMEA 2000
+    ASSERT_TRUE_MSG(p->process("$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*58\r\n") != 0, "$GPRMC frame processing shall fail due to invalid checksum");
+    ASSERT_TRUE_MSG(p->process("$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091203,,,A*57\r\n") != 0, "$GPRMC frame processing shall fail due to corrupted data");
+    ASSERT_TRUE_MSG(p->process("$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n") == 0, "$GPRMC frame processing failed");
   }  
   
 /**
@@ -0,0 +1,268 @@
+/**
+ * \file      bit_codec.h
+ * \brief     Header file for the schema-driven binary codec.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+#include "bit_stream.hh"
+
+namespace helpers {
+
+  /**
+   * \enum byte_order
+   * \brief Byte order of a multi-byte field
+   */
+  enum class byte_order : uint8_t {
+    big_endian = 0x00,   /*!< Most significant byte first (network order) */
+    little_endian = 0x01 /*!< Least significant byte first */
+  }; // End of enum byte_order
+
+  /**
+   * \brief Indicate if a member value is encoded into p_bits bits without loss
+   * \param[in] p_value The member value
+   * \param[in] p_bits The field width
+   * \param[in] p_sign_extended Set when the decoding sign-extends the field: signed values shall fit into the signed p_bits-bit range,
+   *            otherwise into the unsigned one
+   */
+  template<typename T> inline bool bit_fits(const T p_value, const uint32_t p_bits, const bool p_sign_extended) {
+    typedef typename std::conditional<std::is_enum<T>::value, std::underlying_type<T>, std::enable_if<true, T> >::type::type I;
+    const I value = static_cast<I>(p_value);
+    if (std::is_signed<I>::value && (value < 0)) {
+      if (!p_sign_extended || (p_bits == 0)) {
+        return false;
+      }
+      return (p_bits >= 64) || (static_cast<int64_t>(value) >= -(static_cast<int64_t>(1) << (p_bits - 1)));
+    }
+    const uint32_t bits = (std::is_signed<I>::value && p_sign_extended) ? p_bits - 1 : p_bits; // The sign bit of a positive value shall be 0
+    return (p_bits != 0) ? ((bits >= 64) || ((static_cast<uint64_t>(value) >> bits) == 0)) : (value == 0);
+  }
+
+  /**
+   * \struct bit_value
+   * \brief Conversion between a member value and its N-bit wire representation
+   */
+  template<typename T, uint32_t N, byte_order O> struct bit_value {
+    static inline uint64_t to_wire(const T p_value) {
+      uint64_t value = static_cast<uint64_t>(p_value);
+      if (O == byte_order::little_endian) {
+        value = __builtin_bswap64(value << (64 - N));
+      }
+      return value;
+    };
+    static inline T from_wire(uint64_t p_value) {
+      if (O == byte_order::little_endian) {
+        p_value = __builtin_bswap64(p_value << (64 - N));
+      }
+      if (std::is_signed<T>::value && (N < 64)) { // Sign extension
+        const uint64_t sign = static_cast<uint64_t>(1) << ((N - 1) % 64);
+        p_value = (p_value ^ sign) - sign;
+      }
+      return static_cast<T>(p_value);
+    };
+  }; // End of struct bit_value
+
+  /**
+   * \struct bit_field
+   * \brief Fixed-width field: N bits stored into the member M of the message S
+   * \remark Signed members are sign-extended on decoding. Little endian fields shall be a multiple of 8 bits. A value which does
+   *         not fit into N bits is rejected on encoding
+   */
+  template<typename S, typename T, T S::*M, uint32_t N, byte_order O = byte_order::big_endian> struct bit_field {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "bit_field: integral or enum member expected");
+    static_assert((N > 0) && (N <= 64) && (N <= 8 * sizeof(T)), "bit_field: invalid width");
+    static_assert((O == byte_order::big_endian) || ((N % 8) == 0), "bit_field: little endian fields shall be a multiple of 8 bits");
+
+    static constexpr uint32_t min_bits = N; /*!< Number of bits always present */
+
+    static inline bool decode(bit_reader & p_reader, S & p_message, const uint32_t p_reserved) { p_message.*M = bit_value<T, N, O>::from_wire(p_reader.fetch(N)); return true; };
+    static inline bool encode(const S & p_message, bit_writer & p_writer) {
+      if (!bit_fits(p_message.*M, N, true)) {
+        return false;
+      }
+      p_writer.write(bit_value<T, N, O>::to_wire(p_message.*M), N);
+      return true;
+    };
+  }; // End of struct bit_field
+
+  /**
+   * \struct bit_field_var
+   * \brief Variable-width field: the number of bits of the member M is given by the member W, which shall be decoded before
+   * \remark The field is not sign-extended on decoding, negative values are rejected on encoding
+   */
+  template<typename S, typename T, T S::*M, typename U, U S::*W> struct bit_field_var {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "bit_field_var: integral or enum member expected");
+    static_assert(std::is_integral<U>::value, "bit_field_var: integral width member expected");
+
+    static constexpr uint32_t min_bits = 0;
+
+    static inline bool decode(bit_reader & p_reader, S & p_message, const uint32_t p_reserved) {
+      const uint32_t bits = static_cast<uint32_t>(p_message.*W);
+      if ((bits > 8 * sizeof(T)) || (p_reader.remaining() < bits + p_reserved)) {
+        return false;
+      }
+      p_message.*M = static_cast<T>(p_reader.fetch(bits));
+      return true;
+    };
+    static inline bool encode(const S & p_message, bit_writer & p_writer) {
+      const uint64_t bits = static_cast<uint64_t>(p_message.*W); // A negative width is rejected too
+      if ((bits > 8 * sizeof(T)) || !bit_fits(p_message.*M, static_cast<uint32_t>(bits), false)) { // Same limit as decode, at most 64 bits
+        return false;
+      }
+      p_writer.write(static_cast<uint64_t>(p_message.*M), static_cast<uint32_t>(bits));
+      return true;
+    };
+  }; // End of struct bit_field_var
+
+  /**
+   * \struct bit_array
+   * \brief Length-prefixed array: an L-bit element count followed by the elements of the member M, N bits each
+   * \remark Arrays of bytes are copied with a single read_bytes()/write_bytes() call
+   */
+  template<typename S, typename E, std::vector<E> S::*M, uint32_t L, uint32_t N = 8 * sizeof(E)> struct bit_array {
+    static_assert(std::is_integral<E>::value, "bit_array: integral elements expected");
+    static_assert((L > 0) && (L <= 32), "bit_array: invalid length width");
+    static_assert((N > 0) && (N <= 8 * sizeof(E)), "bit_array: invalid element width");
+
+    static constexpr uint32_t min_bits = L;
+
+    static inline bool decode(bit_reader & p_reader, S & p_message, const uint32_t p_reserved) {
+      const uint64_t count = p_reader.fetch(L);
+      if (p_reader.remaining() < count * N + p_reserved) { // Single bounds check for the whole array
+        return false;
+      }
+      std::vector<E> & elements = p_message.*M;
+      elements.resize(static_cast<size_t>(count));
+      if ((N == 8) && (sizeof(E) == 1)) {
+        p_reader.read_bytes(reinterpret_cast<uint8_t *>(elements.data()), static_cast<uint32_t>(count * 8));
+      } else {
+        for (typename std::vector<E>::iterator it = elements.begin(); it != elements.end(); ++it) {
+          *it = bit_value<E, N, byte_order::big_endian>::from_wire(p_reader.fetch(N));
+        } // End of 'for' statement
+      }
+      return true;
+    };
+    static inline bool encode(const S & p_message, bit_writer & p_writer) {
+      const std::vector<E> & elements = p_message.*M;
+      if ((static_cast<uint64_t>(elements.size()) >> L) != 0) { // The element count does not fit into the length field
+        return false;
+      }
+      p_writer.write(elements.size(), L);
+      if ((N == 8) && (sizeof(E) == 1)) {
+        p_writer.write_bytes(reinterpret_cast<const uint8_t *>(elements.data()), static_cast<uint32_t>(elements.size() * 8));
+      } else {
+        for (typename std::vector<E>::const_iterator it = elements.cbegin(); it != elements.cend(); ++it) {
+          if (!bit_fits(*it, N, true)) {
+            return false;
+          }
+          p_writer.write(static_cast<uint64_t>(*it), N);
+        } // End of 'for' statement
+      }
+      return true;
+    };
+  }; // End of struct bit_array
+
+  /**
+   * \struct bit_reserved
+   * \brief N reserved bits, ignored on decoding and set to 0 on encoding
+   */
+  template<uint32_t N> struct bit_reserved {
+    static constexpr uint32_t min_bits = N;
+
+    template<typename S> static inline bool decode(bit_reader & p_reader, S & p_message, const uint32_t p_reserved) { p_reader.skip(N); return true; };
+    template<typename S> static inline bool encode(const S & p_message, bit_writer & p_writer) {
+      for (uint32_t bits = N; bits != 0; bits -= (bits > 64) ? 64 : bits) {
+        p_writer.write(0, (bits > 64) ? 64 : bits);
+      } // End of 'for' statement
+      return true;
+    };
+  }; // End of struct bit_reserved
+
+  /**
+   * \struct bit_fields
+   * \brief Compile-time list of fields
+   */
+  template<typename... F> struct bit_fields;
+
+  template<> struct bit_fields<> {
+    static constexpr uint32_t min_bits = 0;
+
+    template<typename S> static inline bool decode(bit_reader & p_reader, S & p_message) { return true; };
+    template<typename S> static inline bool encode(const S & p_message, bit_writer & p_writer) { return true; };
+  }; // End of struct bit_fields<>
+
+  template<typename F, typename... R> struct bit_fields<F, R...> {
+    static constexpr uint32_t min_bits = F::min_bits + bit_fields<R...>::min_bits;
+
+    template<typename S> static inline bool decode(bit_reader & p_reader, S & p_message) {
+      return F::decode(p_reader, p_message, bit_fields<R...>::min_bits) && bit_fields<R...>::decode(p_reader, p_message);
+    };
+    template<typename S> static inline bool encode(const S & p_message, bit_writer & p_writer) {
+      return F::encode(p_message, p_writer) && bit_fields<R...>::encode(p_message, p_writer);
+    };
+  }; // End of struct bit_fields<F, R...>
+
+  /**
+   * \class bit_codec
+   * \brief Encoder and decoder of the message S generated from the description of its layout
+   *
+   * The layout is described once as a list of fields, e.g.
+   * \code
+   * typedef bit_codec<basic_header,
+   *                   bit_field<basic_header, uint8_t, &basic_header::version, 4>,
+   *                   bit_field<basic_header, uint8_t, &basic_header::next_header, 4>,
+   *                   bit_reserved<8>,
+   *                   bit_array<basic_header, uint8_t, &basic_header::payload, 16> > basic_header_codec;
+   * \endcode
+   * All the field accesses are resolved at compile time and inlined. The bits required by the fixed-width part of the layout
+   * are checked once before decoding, variable-width fields only check their variable part.
+   */
+  template<typename S, typename... F> class bit_codec {
+  public:
+    /**
+     * \brief Minimal encoded size of the message, in bits
+     */
+    static constexpr uint32_t min_bits = bit_fields<F...>::min_bits;
+
+    /**
+     * \brief Decode a message
+     * \param[in] p_reader The bit stream to decode
+     * \param[out] p_message The decoded message
+     * \return 0 on success, -1 otherwise
+     */
+    static const int32_t decode(bit_reader & p_reader, S & p_message);
+    /**
+     * \brief Decode a message
+     * \param[in] p_data The binary data to decode
+     * \param[in] p_size The size of the data in bits
+     * \param[out] p_message The decoded message
+     * \return 0 on success, -1 otherwise
+     */
+    static const int32_t decode(const uint8_t * p_data, const uint32_t p_size, S & p_message);
+    /**
+     * \brief Encode a message
+     * \param[in] p_message The message to encode
+     * \param[in] p_writer The bit stream to write
+     * \return 0 on success, -1 if a field does not fit into its width (the content of p_writer is then undefined)
+     */
+    static const int32_t encode(const S & p_message, bit_writer & p_writer);
+    /**
+     * \brief Encode a message
+     * \param[in] p_message The message to encode
+     * \return The encoded message, padded up to the next byte boundary, empty if a field does not fit into its width
+     */
+    static std::vector<uint8_t> encode(const S & p_message);
+  }; // End of class bit_codec
+
+} // End of namespace helpers
+
+#include "bit_codec.t.h"
+
+using namespace helpers;
@@ -0,0 +1,38 @@
+/*!
+ * \file      bit_codec.t.h
+ * \brief     Template header file for the schema-driven binary codec.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include "bit_codec.hh"
+
+namespace helpers {
+
+  template<typename S, typename... F> const int32_t bit_codec<S, F...>::decode(bit_reader & p_reader, S & p_message) {
+    // Hoisted bounds check
+    if (p_reader.remaining() < min_bits) {
+      return -1;
+    }
+    return bit_fields<F...>::decode(p_reader, p_message) ? 0 : -1;
+  }; // End of method decode
+
+  template<typename S, typename... F> const int32_t bit_codec<S, F...>::decode(const uint8_t * p_data, const uint32_t p_size, S & p_message) {
+    bit_reader reader(p_data, p_size);
+    return decode(reader, p_message);
+  }; // End of method decode
+
+  template<typename S, typename... F> const int32_t bit_codec<S, F...>::encode(const S & p_message, bit_writer & p_writer) {
+    return bit_fields<F...>::encode(p_message, p_writer) ? 0 : -1;
+  }; // End of method encode
+
+  template<typename S, typename... F> std::vector<uint8_t> bit_codec<S, F...>::encode(const S & p_message) {
+    bit_writer writer((min_bits + 7) / 8);
+    if (!bit_fields<F...>::encode(p_message, writer)) {
+      return std::vector<uint8_t>();
+    }
+    return writer.flush();
+  }; // End of method encode
+
+} // End of namespace helpers
@@ -0,0 +1,332 @@
+/**
+ * \file      bit_stream.h
+ * \brief     Header file for the word-at-a-time bit reader/writer engine.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "endianness.hh"
+
+namespace helpers {
+
+  /**
+   * \enum bit_order
+   * \brief Order in which the bits of a byte are consumed/produced
+   */
+  enum class bit_order : uint8_t {
+    msb_first = 0x00, /*!< Network order: the first bit is the most significant bit of the first byte (ASN.1 PER, ITS headers...) */
+    lsb_first = 0x01  /*!< The first bit is the least significant bit of the first byte (Deflate, CAN signals...) */
+  }; // End of enum bit_order
+
+  /**
+   * \brief Load 8 bytes as a big endian 64-bit word
+   */
+  inline uint64_t load_be64(const uint8_t * p_buffer) { return load_be<uint64_t>(p_buffer); };
+
+  /**
+   * \brief Load 8 bytes as a little endian 64-bit word
+   */
+  inline uint64_t load_le64(const uint8_t * p_buffer) { return load_le<uint64_t>(p_buffer); };
+
+  /**
+   * \brief Store a 64-bit word as 8 big endian bytes
+   */
+  inline void store_be64(uint8_t * p_buffer, const uint64_t p_value) { store_be(p_buffer, p_value); };
+
+  /**
+   * \class bit_reader
+   * \brief Non-owning bit stream reader
+   *
+   * The reader keeps up to 64 bits of the input in a cache refilled with one unaligned 8-byte load, so any field of
+   * 1 to 64 bits is extracted with a couple of shifts and masks instead of a loop over the bits.
+   * \remark The reader does not copy the input data: the buffer shall outlive the reader
+   */
+  class bit_reader {
+    const uint8_t * _data; /*!< The input data */
+    uint32_t _length;      /*!< The size of the input data in bytes */
+    uint32_t _size;        /*!< The size of the input data in bits */
+    uint32_t _position;    /*!< The index of the next bit to read */
+    uint32_t _next;        /*!< The index of the next byte to load into the cache */
+    uint64_t _cache;       /*!< The bits loaded from the input data and not read yet */
+    uint32_t _cached;      /*!< The number of valid bits in the cache */
+    bit_order _order;      /*!< The bit order */
+
+  public:
+    /**
+     * \brief Default ctor
+     */
+    bit_reader() : _data(nullptr), _length(0), _size(0), _position(0), _next(0), _cache(0), _cached(0), _order(bit_order::msb_first) { };
+    /**
+     * \brief Creation ctor
+     * \param[in] p_data The binary input data
+     * \param[in] p_size The size of the input data in bits
+     * \param[in] p_order The bit order. Default: bit_order::msb_first
+     */
+    bit_reader(const uint8_t * p_data, const uint32_t p_size, const bit_order p_order = bit_order::msb_first) { open(p_data, p_size, p_order); };
+    /**
+     * \brief Default dtor
+     */
+    virtual ~bit_reader() { };
+
+    /**
+     * \brief Attach the reader to a new input data
+     * \param[in] p_data The binary input data
+     * \param[in] p_size The size of the input data in bits
+     * \param[in] p_order The bit order. Default: bit_order::msb_first
+     */
+    void open(const uint8_t * p_data, const uint32_t p_size, const bit_order p_order = bit_order::msb_first);
+
+    /**
+     * \brief Read up to 64 bits
+     * \param[out] p_value The bits read, right-aligned. In bit_order::lsb_first order, the first bit read is the bit 0
+     * \param[in] p_bits The number of bits to read, 64 maximum
+     * \return The number of bits read, lower than p_bits if the end of the input data is reached
+     */
+    inline uint32_t read(uint64_t & p_value, const uint32_t p_bits) {
+      uint32_t bits = (p_bits < remaining()) ? p_bits : remaining();
+      p_value = fetch(bits);
+      return bits;
+    };
+
+    /**
+     * \brief Read up to 64 bits without bounds checking
+     * \param[in] p_bits The number of bits to read, 64 maximum. The caller shall ensure that remaining() >= p_bits
+     * \return The bits read, right-aligned
+     */
+    inline uint64_t fetch(const uint32_t p_bits) {
+      if (p_bits <= 56) {
+        return extract(p_bits);
+      } else if (_order == bit_order::msb_first) {
+        uint64_t value = extract(p_bits - 32) << 32;
+        return value | extract(32);
+      }
+      uint64_t value = extract(32);
+      return value | (extract(p_bits - 32) << 32);
+    };
+
+    /**
+     * \brief Read up to 64 bits without moving the read position
+     * \param[out] p_value The bits read, right-aligned
+     * \param[in] p_bits The number of bits to read, 64 maximum
+     * \return The number of bits read
+     */
+    inline uint32_t peek(uint64_t & p_value, const uint32_t p_bits) const { bit_reader reader(*this); return reader.read(p_value, p_bits); };
+
+    /**
+     * \brief Read a sequence of bits into a byte buffer
+     * \param[out] p_buffer The output buffer, at least (p_bits + 7) / 8 bytes long. The bits are left-aligned, the unused bits of the last byte are set to 0
+     * \param[in] p_bits The number of bits to read
+     * \return The number of bits read
+     * \remark In bit_order::lsb_first order, the bits are right-aligned in each byte instead
+     */
+    uint32_t read_bytes(uint8_t * p_buffer, const uint32_t p_bits);
+
+    /**
+     * \brief Skip one or more bits
+     * \param[in] p_bits The number of bits to skip
+     * \return The number of bits skipped
+     */
+    uint32_t skip(const uint32_t p_bits);
+
+    /**
+     * \brief Change the read position
+     * \param[in] p_position The new absolute position within the input data, in bits
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t seek(const uint32_t p_position);
+
+    /**
+     * \brief Returns the position of the next bit to read
+     */
+    inline uint32_t position() const { return _position; };
+    /**
+     * \brief Indicate the size of the input data in bits
+     */
+    inline uint32_t size() const { return _size; };
+    /**
+     * \brief Indicate the number of bits remaining to read
+     */
+    inline uint32_t remaining() const { return _size - _position; };
+    /**
+     * \brief Returns the bit order of the reader
+     */
+    inline bit_order order() const { return _order; };
+    /**
+     * \brief Returns the input data
+     */
+    inline const uint8_t * data() const { return _data; };
+
+  private:
+    /**
+     * \brief Load as many bytes as possible into the cache
+     * \remark When 8 bytes are available, a single unaligned load is used and the cache holds at least 56 bits afterwards.
+     *         The bits loaded beyond _cached are the actual next bits of the input data, so OR-ing them again on the next refill is harmless
+     */
+    inline void refill() {
+      if (_next + sizeof(uint64_t) <= _length) {
+        if (_order == bit_order::msb_first) {
+          _cache |= load_be64(_data + _next) >> _cached;
+        } else {
+          _cache |= load_le64(_data + _next) << _cached;
+        }
+        _next += (63 - _cached) >> 3;
+        _cached |= 56;
+      } else {
+        while ((_cached <= 56) && (_next < _length)) {
+          if (_order == bit_order::msb_first) {
+            _cache |= static_cast<uint64_t>(_data[_next++]) << (56 - _cached);
+          } else {
+            _cache |= static_cast<uint64_t>(_data[_next++]) << _cached;
+          }
+          _cached += 8;
+        } // End of 'while' statement
+      }
+    };
+
+    /**
+     * \brief Extract up to 56 bits from the cache
+     * \param[in] p_bits The number of bits to extract, the caller shall ensure there are enough remaining bits
+     * \return The bits extracted, right-aligned
+     */
+    inline uint64_t extract(const uint32_t p_bits) {
+      if (p_bits == 0) {
+        return 0;
+      }
+      if (_cached < p_bits) {
+        refill();
+      }
+      uint64_t value;
+      if (_order == bit_order::msb_first) {
+        value = _cache >> (64 - p_bits);
+        _cache <<= p_bits;
+      } else {
+        value = _cache & ((static_cast<uint64_t>(1) << p_bits) - 1);
+        _cache >>= p_bits;
+      }
+      _cached -= p_bits;
+      _position += p_bits;
+      return value;
+    };
+  }; // End of class bit_reader
+
+  /**
+   * \class bit_writer
+   * \brief Bit stream writer
+   *
+   * The bits are gathered into a 64-bit accumulator and appended to the output buffer 32 bits at a time.
+   */
+  class bit_writer {
+    std::vector<uint8_t> _buffer; /*!< The bytes already flushed */
+    uint64_t _accumulator;        /*!< The bits not flushed yet: right-aligned in bit_order::msb_first order, starting at bit 0 otherwise */
+    uint32_t _pending;            /*!< The number of bits in the accumulator, always lower than 32 between two calls */
+    bit_order _order;             /*!< The bit order */
+
+  public:
+    /**
+     * \brief Default ctor
+     * \param[in] p_capacity The expected size of the output data in bytes. Default: 128
+     * \param[in] p_order The bit order. Default: bit_order::msb_first
+     */
+    bit_writer(const uint32_t p_capacity = 128, const bit_order p_order = bit_order::msb_first) : _buffer(), _accumulator(0), _pending(0), _order(p_order) { _buffer.reserve(p_capacity); };
+    /**
+     * \brief Default dtor
+     */
+    virtual ~bit_writer() { };
+
+    /**
+     * \brief Write up to 64 bits
+     * \param[in] p_value The bits to write, right-aligned. In bit_order::lsb_first order, the bit 0 is written first
+     * \param[in] p_bits The number of bits to write, 64 maximum
+     * \return The number of bits written
+     */
+    inline uint32_t write(const uint64_t p_value, const uint32_t p_bits) {
+      if (p_bits > 32) {
+        if (_order == bit_order::msb_first) {
+          append(p_value >> 32, p_bits - 32);
+          append(p_value, 32);
+        } else {
+          append(p_value, 32);
+          append(p_value >> 32, p_bits - 32);
+        }
+      } else if (p_bits != 0) {
+        append(p_value, p_bits);
+      }
+      return (p_bits > 64) ? 64 : p_bits;
+    };
+
+    /**
+     * \brief Write a sequence of bits from a byte buffer
+     * \param[in] p_buffer The input buffer, the bits of the last byte are left-aligned (right-aligned in bit_order::lsb_first order)
+     * \param[in] p_bits The number of bits to write
+     * \return The number of bits written
+     */
+    uint32_t write_bytes(const uint8_t * p_buffer, const uint32_t p_bits);
+
+    /**
+     * \brief Pad the stream with 0 bits up to the next byte boundary
+     */
+    void align();
+
+    /**
+     * \brief Pad the stream up to the next byte boundary and move all the pending bits into the output buffer
+     * \return The output data
+     */
+    const std::vector<uint8_t> & flush();
+
+    /**
+     * \brief Returns the number of bits written
+     */
+    inline uint32_t position() const { return static_cast<uint32_t>(_buffer.size()) * 8 + _pending; };
+    /**
+     * \brief Returns the bit order of the writer
+     */
+    inline bit_order order() const { return _order; };
+    /**
+     * \brief Discard all the bits written
+     */
+    inline void reset() { _buffer.clear(); _accumulator = 0; _pending = 0; };
+
+  private:
+    /**
+     * \brief Append up to 32 bits to the accumulator and flush 32 bits when full
+     */
+    inline void append(const uint64_t p_value, const uint32_t p_bits) {
+      uint64_t value = p_value & ((static_cast<uint64_t>(1) << p_bits) - 1);
+      if (_order == bit_order::msb_first) {
+        _accumulator = (_accumulator << p_bits) | value;
+      } else {
+        _accumulator |= value << _pending;
+      }
+      _pending += p_bits;
+      if (_pending >= 32) {
+        size_t size = _buffer.size();
+        _buffer.resize(size + 4);
+        uint8_t * p = _buffer.data() + size;
+        if (_order == bit_order::msb_first) {
+          uint32_t word = static_cast<uint32_t>(_accumulator >> (_pending - 32));
+          p[0] = static_cast<uint8_t>(word >> 24); p[1] = static_cast<uint8_t>(word >> 16); p[2] = static_cast<uint8_t>(word >> 8); p[3] = static_cast<uint8_t>(word);
+        } else {
+          uint32_t word = static_cast<uint32_t>(_accumulator);
+          p[0] = static_cast<uint8_t>(word); p[1] = static_cast<uint8_t>(word >> 8); p[2] = static_cast<uint8_t>(word >> 16); p[3] = static_cast<uint8_t>(word >> 24);
+          _accumulator >>= 32;
+        }
+        _pending -= 32;
+      }
+    };
+
+    /**
+     * \brief Move the whole bytes of the accumulator into the output buffer
+     */
+    void drain();
+  }; // End of class bit_writer
+
+} // End of namespace helpers
+
+using namespace helpers;
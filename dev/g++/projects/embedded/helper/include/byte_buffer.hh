@@ -0,0 +1,321 @@
+/**
+ * \file      byte_buffer.h
+ * \brief     Header file for the reference-counted byte buffer.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "byte_span.hh"
+
+namespace helpers {
+
+  /**
+   * \class byte_buffer
+   * \brief Owning byte buffer with cheap copies and slices
+   *
+   * Payloads up to inline_capacity bytes are stored inside the object itself, no allocation is done. Larger payloads live in a
+   * reference-counted heap slab: copying or slicing the buffer shares the slab instead of copying the bytes.
+   * The content of a shared slab is immutable: call mutable_data() before writing, it copies the bytes if the slab is shared
+   * (explicit copy-on-write).
+   * \remark Like std::shared_ptr, distinct buffers sharing a slab can be used concurrently, a single buffer cannot
+   */
+  class byte_buffer {
+  public:
+    static const size_t inline_capacity = 40; /*!< Largest payload stored inline, sizeof(byte_buffer) is 64 bytes */
+
+  private:
+    /**
+     * \struct slab_t
+     * \brief Heap storage shared by the buffers
+     */
+    struct slab_t {
+      std::atomic<uint32_t> references; /*!< Number of buffers sharing the slab */
+      std::vector<uint8_t> bytes;       /*!< The storage, its size is the capacity of the slab */
+      explicit slab_t(const size_t p_capacity) : references(1), bytes(p_capacity) { };
+      explicit slab_t(std::vector<uint8_t> && p_bytes) : references(1), bytes(std::move(p_bytes)) { };
+    }; // End of struct slab_t
+
+    slab_t * _slab;                   /*!< The shared storage, nullptr if the payload is stored inline */
+    uint8_t * _data;                  /*!< The first byte of the payload, in the slab or in _inline */
+    size_t _size;                     /*!< The number of bytes of the payload */
+    uint8_t _inline[inline_capacity]; /*!< The inline storage */
+
+  public:
+    /**
+     * \brief Default ctor, an empty buffer
+     */
+    byte_buffer() : _slab(nullptr), _data(_inline), _size(0), _inline() { };
+    /**
+     * \brief Creation ctor
+     * \param[in] p_size The number of bytes of the buffer, set to 0
+     */
+    explicit byte_buffer(const size_t p_size) : _slab(nullptr), _data(_inline), _size(0), _inline() { resize(p_size); };
+    /**
+     * \brief Creation ctor, copying the bytes
+     * \param[in] p_data The first byte to copy
+     * \param[in] p_size The number of bytes to copy
+     */
+    byte_buffer(const uint8_t * p_data, const size_t p_size) : _slab(nullptr), _data(_inline), _size(0), _inline() { assign(p_data, p_size); };
+    /**
+     * \brief Creation ctor, copying the bytes
+     * \param[in] p_span The bytes to copy
+     */
+    explicit byte_buffer(const byte_span & p_span) : _slab(nullptr), _data(_inline), _size(0), _inline() { assign(p_span.data(), p_span.size()); };
+    /**
+     * \brief Creation ctor, copying the bytes
+     * \param[in] p_buffer The bytes to copy
+     */
+    explicit byte_buffer(const std::vector<uint8_t> & p_buffer) : _slab(nullptr), _data(_inline), _size(0), _inline() { assign(p_buffer.data(), p_buffer.size()); };
+    /**
+     * \brief Creation ctor, taking over the storage of the vector
+     * \param[in] p_buffer The bytes, left empty
+     * \remark Small payloads are copied inline and the storage of the vector is released
+     */
+    explicit byte_buffer(std::vector<uint8_t> && p_buffer) : _slab(nullptr), _data(_inline), _size(p_buffer.size()), _inline() {
+      if (_size <= inline_capacity) {
+        if (_size != 0) {
+          std::memcpy(_inline, p_buffer.data(), _size);
+        }
+        std::vector<uint8_t>().swap(p_buffer);
+      } else {
+        _slab = new slab_t(std::move(p_buffer));
+        _data = _slab->bytes.data();
+      }
+    };
+    /**
+     * \brief Copy ctor, the slab is shared
+     */
+    byte_buffer(const byte_buffer & p_buffer) : _slab(p_buffer._slab), _data((_slab != nullptr) ? p_buffer._data : _inline), _size(p_buffer._size), _inline() {
+      if (_slab != nullptr) {
+        _slab->references.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        std::memcpy(_inline, p_buffer._inline, inline_capacity);
+      }
+    };
+    /**
+     * \brief Move ctor, the moved buffer is left empty
+     */
+    byte_buffer(byte_buffer && p_buffer) : _slab(p_buffer._slab), _data((_slab != nullptr) ? p_buffer._data : _inline), _size(p_buffer._size), _inline() {
+      if (_slab == nullptr) {
+        std::memcpy(_inline, p_buffer._inline, inline_capacity);
+      }
+      p_buffer._slab = nullptr;
+      p_buffer._data = p_buffer._inline;
+      p_buffer._size = 0;
+    };
+    /**
+     * \brief Default dtor
+     */
+    ~byte_buffer() { release(); };
+
+    /**
+     * \brief Assignment operator, the slab is shared
+     */
+    byte_buffer & operator= (const byte_buffer & p_buffer) {
+      if (this != &p_buffer) {
+        byte_buffer copy(p_buffer);
+        swap(copy);
+      }
+      return *this;
+    };
+    /**
+     * \brief Move assignment operator, the moved buffer is left empty
+     */
+    byte_buffer & operator= (byte_buffer && p_buffer) {
+      if (this != &p_buffer) {
+        byte_buffer moved(std::move(p_buffer));
+        swap(moved);
+      }
+      return *this;
+    };
+
+    inline const uint8_t * data() const { return _data; };
+    inline size_t size() const { return _size; };
+    inline bool empty() const { return _size == 0; };
+    inline const uint8_t * begin() const { return data(); };
+    inline const uint8_t * end() const { return data() + _size; };
+    inline const uint8_t & operator[] (const size_t p_index) const { return data()[p_index]; };
+    inline operator byte_span() const { return byte_span(data(), _size); };
+
+    /**
+     * \brief Indicate if the payload is stored inside the object
+     * \return true if no slab is used, false otherwise
+     */
+    inline bool is_inline() const { return _slab == nullptr; };
+    /**
+     * \brief Indicate if the slab is shared with another buffer
+     * \return true if mutable_data() would copy the bytes, false otherwise
+     */
+    inline bool is_shared() const { return (_slab != nullptr) && (_slab->references.load(std::memory_order_acquire) != 1); };
+
+    /**
+     * \brief Returns a sub-range of this buffer, clamped to the buffer boundaries
+     * \param[in] p_offset The index of the first byte of the sub-range
+     * \param[in] p_count The number of bytes of the sub-range. Default: up to the end of the buffer
+     * \return The sub-range, sharing the slab of this buffer or copied inline if it is small enough
+     */
+    inline byte_buffer slice(const size_t p_offset, const size_t p_count = static_cast<size_t>(-1)) const {
+      const size_t offset = (p_offset < _size) ? p_offset : _size;
+      const size_t count = (p_count < _size - offset) ? p_count : _size - offset;
+      if ((_slab == nullptr) || (count <= inline_capacity)) {
+        return byte_buffer(data() + offset, count);
+      }
+      byte_buffer slice(*this);
+      slice._data += offset;
+      slice._size = count;
+      return slice;
+    };
+
+    /**
+     * \brief Retrieve a writable pointer on the payload, copying it first if the slab is shared
+     * \return The first byte of the payload
+     */
+    inline uint8_t * mutable_data() {
+      if (is_shared()) {
+        reallocate(_size);
+      }
+      return _data;
+    };
+
+    /**
+     * \brief Change the size of the payload
+     * \param[in] p_size The new number of bytes. The added bytes are set to 0
+     * \remark Shrinking never copies the payload, growing copies it if the slab is shared or too small
+     */
+    void resize(const size_t p_size) {
+      if (p_size > _size) {
+        if (p_size > capacity()) {
+          reallocate((p_size < 2 * _size) ? 2 * _size : p_size);
+        } else if (is_shared()) {
+          reallocate(p_size);
+        }
+        std::memset(mutable_data() + _size, 0x00, p_size - _size);
+      }
+      _size = p_size;
+    };
+
+    /**
+     * \brief Append bytes to the payload
+     * \param[in] p_data The first byte to append
+     * \param[in] p_size The number of bytes to append
+     */
+    inline void append(const uint8_t * p_data, const size_t p_size) {
+      if (p_size == 0) {
+        return;
+      }
+      const size_t size = _size;
+      resize(_size + p_size);
+      std::memcpy(mutable_data() + size, p_data, p_size);
+    };
+
+    /**
+     * \brief Replace the payload by a copy of the specified bytes
+     * \param[in] p_data The first byte to copy
+     * \param[in] p_size The number of bytes to copy
+     */
+    inline void assign(const uint8_t * p_data, const size_t p_size) {
+      clear();
+      append(p_data, p_size);
+    };
+
+    /**
+     * \brief Empty the buffer, releasing its slab
+     */
+    inline void clear() {
+      release();
+      _slab = nullptr;
+      _data = _inline;
+      _size = 0;
+    };
+
+    /**
+     * \brief Copy the payload
+     * \return An owning copy of the bytes
+     */
+    inline std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); };
+
+    /**
+     * \brief Move the payload out of the buffer, which is left empty
+     * \return The bytes, without copying them if this buffer is the only owner of the whole slab
+     */
+    std::vector<uint8_t> release_vector() {
+      std::vector<uint8_t> bytes;
+      if ((_slab != nullptr) && !is_shared() && (_data == _slab->bytes.data())) {
+        bytes.swap(_slab->bytes);
+        bytes.resize(_size);
+      } else {
+        bytes.assign(begin(), end());
+      }
+      clear();
+      return bytes;
+    };
+
+    inline void swap(byte_buffer & p_buffer) {
+      uint8_t bytes[inline_capacity];
+      std::memcpy(bytes, _inline, inline_capacity);
+      std::memcpy(_inline, p_buffer._inline, inline_capacity);
+      std::memcpy(p_buffer._inline, bytes, inline_capacity);
+      std::swap(_slab, p_buffer._slab);
+      std::swap(_data, p_buffer._data);
+      std::swap(_size, p_buffer._size);
+      if (_slab == nullptr) {
+        _data = _inline;
+      }
+      if (p_buffer._slab == nullptr) {
+        p_buffer._data = p_buffer._inline;
+      }
+    };
+
+    inline bool operator== (const byte_buffer & p_buffer) const { return (_size == p_buffer._size) && (std::memcmp(data(), p_buffer.data(), _size) == 0); };
+    inline bool operator!= (const byte_buffer & p_buffer) const { return !(*this == p_buffer); };
+
+  private:
+    /**
+     * \brief The number of bytes the payload can grow to without reallocation
+     */
+    inline size_t capacity() const { return (_slab != nullptr) ? _slab->bytes.size() - (_data - _slab->bytes.data()) : inline_capacity; };
+
+    /**
+     * \brief Move the payload into storage owned by this buffer only
+     * \param[in] p_capacity The minimal capacity of the new storage
+     */
+    void reallocate(const size_t p_capacity) {
+      if (p_capacity <= inline_capacity) {
+        if (_slab != nullptr) {
+          std::memcpy(_inline, _data, _size);
+          release();
+          _slab = nullptr;
+          _data = _inline;
+        }
+        return;
+      }
+      slab_t * slab = new slab_t(p_capacity);
+      std::memcpy(slab->bytes.data(), _data, _size);
+      release();
+      _slab = slab;
+      _data = slab->bytes.data();
+    };
+
+    /**
+     * \brief Drop the reference on the slab
+     */
+    inline void release() {
+      if ((_slab != nullptr) && (_slab->references.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+        delete _slab;
+      }
+    };
+  }; // End of class byte_buffer
+
+} // End of namespace helpers
+
+using namespace helpers;
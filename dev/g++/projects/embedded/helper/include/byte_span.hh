@@ -0,0 +1,73 @@
+/**
+ * \file      byte_span.h
+ * \brief     Header file for the non-owning byte range view.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace helpers {
+
+  /**
+   * \class byte_span
+   * \brief Non-owning view on a contiguous range of bytes (C++11 equivalent of std::span<const uint8_t>)
+   * \remark A byte_span borrows the memory it refers to: it is valid as long as the underlying buffer is neither destroyed nor reallocated.
+   *         Use to_vector() to get an owning copy
+   */
+  class byte_span {
+    const uint8_t * _data; /*!< The first byte of the range */
+    size_t _size;          /*!< The number of bytes of the range */
+
+  public:
+    /**
+     * \brief Default ctor, an empty view
+     */
+    byte_span() : _data(nullptr), _size(0) { };
+    /**
+     * \brief Creation ctor
+     * \param[in] p_data The first byte of the range
+     * \param[in] p_size The number of bytes of the range
+     */
+    byte_span(const uint8_t * p_data, const size_t p_size) : _data(p_data), _size(p_size) { };
+    /**
+     * \brief Creation ctor, the view borrows the content of the vector
+     * \param[in] p_buffer The vector to view
+     */
+    byte_span(const std::vector<uint8_t> & p_buffer) : _data(p_buffer.data()), _size(p_buffer.size()) { };
+
+    inline const uint8_t * data() const { return _data; };
+    inline size_t size() const { return _size; };
+    inline bool empty() const { return _size == 0; };
+    inline const uint8_t * begin() const { return _data; };
+    inline const uint8_t * end() const { return _data + _size; };
+    inline const uint8_t & operator[] (const size_t p_index) const { return _data[p_index]; };
+
+    /**
+     * \brief Returns a sub-range of this view, clamped to the view boundaries
+     * \param[in] p_offset The index of the first byte of the sub-range
+     * \param[in] p_count The number of bytes of the sub-range. Default: up to the end of the view
+     * \return The sub-range view, borrowing the same buffer
+     */
+    inline byte_span subspan(const size_t p_offset, const size_t p_count = static_cast<size_t>(-1)) const {
+      if (p_offset >= _size) {
+        return byte_span(end(), 0);
+      }
+      return byte_span(_data + p_offset, (p_count < _size - p_offset) ? p_count : _size - p_offset);
+    };
+
+    /**
+     * \brief Copy the content of the view
+     * \return An owning copy of the bytes
+     */
+    inline std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); };
+  }; // End of class byte_span
+
+} // End of namespace helpers
+
+using namespace helpers;
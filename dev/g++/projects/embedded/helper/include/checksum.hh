@@ -0,0 +1,172 @@
+/*!
+ * \file      checksum.h
+ * \brief     Header file for the checksum and CRC kernels.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "byte_span.hh"
+
+namespace helpers {
+
+  /*!
+   * \namespace checksum
+   * \brief Integrity checks for frames and stored records
+   *
+   * Each CRC class is a streaming accumulator: update() may be called any number of times, value() returns the CRC of all the
+   * bytes seen so far. The static compute() methods are shortcuts for a single buffer.
+   * \remark The hardware code paths are selected at runtime when available, a table-driven scalar code path is used otherwise
+   */
+  namespace checksum {
+
+    /*!
+     * \class crc32c
+     * \brief CRC-32C (Castagnoli, iSCSI/ext4/SCTP), reflected polynomial 0x82f63b78
+     * \remark SSE4.2 crc32 instruction on x86, ARMv8 CRC extension when the compiler targets it, slicing-by-8 otherwise
+     */
+    class crc32c {
+      uint32_t _crc; /*!< The inverted CRC register */
+    public:
+      /*!
+       * \brief Default ctor
+       * \param[in] p_crc The CRC of the preceding bytes, to resume a computation. Default: 0
+       */
+      explicit crc32c(const uint32_t p_crc = 0) : _crc(~p_crc) { };
+      /*!
+       * \brief Add bytes to the CRC
+       * \param[in] p_data The bytes to add
+       * \param[in] p_length The number of bytes to add
+       * \return This accumulator
+       */
+      crc32c & update(const uint8_t * p_data, const size_t p_length);
+      inline crc32c & update(const byte_span & p_data) { return update(p_data.data(), p_data.size()); };
+      inline uint32_t value() const { return ~_crc; };
+      inline void reset() { _crc = 0xffffffff; };
+      inline static uint32_t compute(const byte_span & p_data) { return crc32c().update(p_data).value(); };
+    }; // End of class crc32c
+
+    /*!
+     * \class crc32
+     * \brief CRC-32 (IEEE 802.3, zlib, PNG), reflected polynomial 0xedb88320
+     * \remark Carry-less multiplication folding (PCLMULQDQ) on x86 for 64 bytes and more, slicing-by-8 otherwise
+     */
+    class crc32 {
+      uint32_t _crc; /*!< The inverted CRC register */
+    public:
+      /*!
+       * \brief Default ctor
+       * \param[in] p_crc The CRC of the preceding bytes, to resume a computation. Default: 0
+       */
+      explicit crc32(const uint32_t p_crc = 0) : _crc(~p_crc) { };
+      /*!
+       * \brief Add bytes to the CRC
+       * \param[in] p_data The bytes to add
+       * \param[in] p_length The number of bytes to add
+       * \return This accumulator
+       */
+      crc32 & update(const uint8_t * p_data, const size_t p_length);
+      inline crc32 & update(const byte_span & p_data) { return update(p_data.data(), p_data.size()); };
+      inline uint32_t value() const { return ~_crc; };
+      inline void reset() { _crc = 0xffffffff; };
+      inline static uint32_t compute(const byte_span & p_data) { return crc32().update(p_data).value(); };
+    }; // End of class crc32
+
+    /*!
+     * \class crc16_ccitt
+     * \brief CRC-16/CCITT, polynomial 0x1021 not reflected, initial value 0xffff (CRC-16/CCITT-FALSE) by default
+     * \remark Table-driven, two bytes per iteration
+     */
+    class crc16_ccitt {
+      uint16_t _crc; /*!< The CRC register */
+    public:
+      /*!
+       * \brief Default ctor
+       * \param[in] p_crc The initial value, or the CRC of the preceding bytes to resume a computation. Default: 0xffff
+       */
+      explicit crc16_ccitt(const uint16_t p_crc = 0xffff) : _crc(p_crc) { };
+      /*!
+       * \brief Add bytes to the CRC
+       * \param[in] p_data The bytes to add
+       * \param[in] p_length The number of bytes to add
+       * \return This accumulator
+       */
+      crc16_ccitt & update(const uint8_t * p_data, const size_t p_length);
+      inline crc16_ccitt & update(const byte_span & p_data) { return update(p_data.data(), p_data.size()); };
+      inline uint16_t value() const { return _crc; };
+      inline void reset(const uint16_t p_crc = 0xffff) { _crc = p_crc; };
+      inline static uint16_t compute(const byte_span & p_data) { return crc16_ccitt().update(p_data).value(); };
+    }; // End of class crc16_ccitt
+
+    /*!
+     * \class crc8
+     * \brief CRC-8 (SMBus PEC), polynomial 0x07 not reflected, initial value 0x00
+     * \remark Table-driven
+     */
+    class crc8 {
+      uint8_t _crc; /*!< The CRC register */
+    public:
+      /*!
+       * \brief Default ctor
+       * \param[in] p_crc The initial value, or the CRC of the preceding bytes to resume a computation. Default: 0x00
+       */
+      explicit crc8(const uint8_t p_crc = 0x00) : _crc(p_crc) { };
+      /*!
+       * \brief Add bytes to the CRC
+       * \param[in] p_data The bytes to add
+       * \param[in] p_length The number of bytes to add
+       * \return This accumulator
+       */
+      crc8 & update(const uint8_t * p_data, const size_t p_length);
+      inline crc8 & update(const byte_span & p_data) { return update(p_data.data(), p_data.size()); };
+      inline uint8_t value() const { return _crc; };
+      inline void reset(const uint8_t p_crc = 0x00) { _crc = p_crc; };
+      inline static uint8_t compute(const byte_span & p_data) { return crc8().update(p_data).value(); };
+    }; // End of class crc8
+
+    /*!
+     * \brief Enable or disable the hardware code paths of the CRC-32 classes, e.g. to test the slicing-by-8 code path on a capable CPU
+     * \param[in] p_enabled Set to false to use the table-driven code paths only. Default: enabled
+     */
+    void use_hardware(const bool p_enabled);
+
+    /*!
+     * \brief XOR of all the bytes (longitudinal parity)
+     * \param[in] p_data The bytes
+     * \param[in] p_length The number of bytes
+     * \param[in] p_xor The XOR of the preceding bytes, to resume a computation. Default: 0
+     * \return The XOR of all the bytes
+     * \remark Processed 16 bytes (SSE2) or 8 bytes at a time
+     */
+    uint8_t xor8(const uint8_t * p_data, const size_t p_length, const uint8_t p_xor = 0x00);
+
+    /*!
+     * \brief Sum of all the bytes, modulo 256
+     * \param[in] p_data The bytes
+     * \param[in] p_length The number of bytes
+     * \param[in] p_sum The sum of the preceding bytes, to resume a computation. Default: 0
+     * \return The sum of all the bytes, modulo 256
+     * \remark Processed 16 bytes (SSE2) or 8 bytes at a time
+     */
+    uint8_t sum8(const uint8_t * p_data, const size_t p_length, const uint8_t p_sum = 0x00);
+
+    /*!
+     * \brief Verify the checksum of a NMEA 0183 sentence such as "$GPGGA,...*47"
+     * \param[in] p_sentence The sentence, starting with '$' or '!'. Trailing characters after the two checksum digits are ignored
+     * \param[in] p_length The length of the sentence
+     * \return 0 if the checksum is valid or absent (it is optional in NMEA 0183), -1 if it is invalid or truncated
+     */
+    const int32_t verify_nmea(const char * p_sentence, const size_t p_length);
+    inline const int32_t verify_nmea(const std::string & p_sentence) { return verify_nmea(p_sentence.data(), p_sentence.length()); };
+
+  } // End of namespace checksum
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -11,7 +11,10 @@
 #include <iostream>
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <array>
 #include <regex>
+#include <ctime>
 
 #include <string.h>
 
@@ -127,6 +130,112 @@ namespace helpers {
 
   }; // End of class date_time
 
+  /*!
+   * \enum timestamp_format_t
+   * \brief List of the standard timestamp formats
+   */
+  typedef enum {
+    iso8601 = 0x00, /*!< Local time with the UTC offset, e.g. 2017-05-15T06:36:00.123456+02:00 */
+    rfc3339 = 0x01  /*!< UTC time, e.g. 2017-05-15T04:36:00.123456Z */
+  } timestamp_format_t;
+
+  /*!
+   * \class timestamp_formatter
+   * \brief Timestamp formatting with a cache of the formatted seconds
+   *
+   * The date and time up to the second (and the UTC offset) are formatted with strftime once per second and kept in a
+   * cache: the other calls only append the sub-second digits to the cached prefix.
+   * \remark An instance is not thread-safe, use one instance per thread (see timestamp::format)
+   */
+  class timestamp_formatter {
+    std::string _pattern;    /*!< The strftime pattern of the prefix */
+    uint32_t _digits;        /*!< The number of sub-second digits, 0 to 9 */
+    bool _utc;               /*!< Set to format UTC time instead of local time */
+    int32_t _zone;           /*!< The suffix: -1 none, 0 'Z', 1 UTC offset */
+    time_t _second;          /*!< The second of the cached prefix */
+    char _prefix[64];        /*!< The cached prefix */
+    size_t _prefix_length;   /*!< The length of the cached prefix */
+    char _suffix[8];         /*!< The cached suffix, e.g. "+02:00" */
+    size_t _suffix_length;   /*!< The length of the cached suffix */
+
+  public: /*! \publicsection */
+    /*!
+     * \brief Creation ctor for a standard format
+     * \param[in] p_format The timestamp format
+     * \param[in] p_digits The number of sub-second digits, up to 9. Default: 6
+     */
+    timestamp_formatter(const timestamp_format_t p_format, const uint32_t p_digits = 6);
+    /*!
+     * \brief Creation ctor for a custom format
+     * \param[in] p_pattern The strftime pattern of the date/time up to the seconds, e.g. "%H:%M:%S"
+     * \param[in] p_digits The number of sub-second digits, up to 9, 0 for none. Default: 6
+     * \param[in] p_utc Set to true for UTC time, false for local time. Default: false
+     */
+    timestamp_formatter(const std::string & p_pattern, const uint32_t p_digits = 6, const bool p_utc = false);
+    virtual ~timestamp_formatter() { };
+
+    /*!
+     * \brief Format a timestamp
+     * \param[out] p_buffer The output buffer, null-terminated on success
+     * \param[in] p_size The size of the output buffer
+     * \param[in] p_realtime The time in nanoseconds since the Epoch (CLOCK_REALTIME)
+     * \return The number of characters written, the null character excluded, 0 if the buffer is too small
+     */
+    size_t format(char * p_buffer, const size_t p_size, const uint64_t p_realtime);
+
+  private: /*! \privatesection */
+    void update(const time_t p_second);
+  }; // End of class timestamp_formatter
+
+  /*!
+   * \class timestamp
+   * \brief Clock readings and thread-safe timestamp formatting
+   * \code
+   * char buffer[40];
+   * timestamp::format(buffer, sizeof(buffer), timestamp::realtime()); // 2017-05-15T04:36:00.123456Z
+   * const uint64_t t0 = timestamp::monotonic();
+   * ...
+   * std::clog << timestamp::to_string(timestamp::monotonic_to_realtime(t0), iso8601, 3) << std::endl;
+   * \endcode
+   */
+  class timestamp {
+  public: /*! \publicsection */
+    /*!
+     * \brief Returns the wall clock time in nanoseconds since the Epoch
+     * \param[in] p_coarse Set to true to read CLOCK_REALTIME_COARSE: a few milliseconds resolution, cheaper. Default: false
+     */
+    static inline uint64_t realtime(const bool p_coarse = false) { return now(p_coarse ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME); };
+    /*!
+     * \brief Returns the monotonic time in nanoseconds, not affected by the wall clock adjustments
+     * \param[in] p_coarse Set to true to read CLOCK_MONOTONIC_COARSE. Default: false
+     */
+    static inline uint64_t monotonic(const bool p_coarse = false) { return now(p_coarse ? CLOCK_MONOTONIC_COARSE : CLOCK_MONOTONIC); };
+    /*!
+     * \brief Convert a monotonic time into a wall clock time
+     * \param[in] p_monotonic The monotonic time in nanoseconds
+     * \return The wall clock time in nanoseconds since the Epoch
+     * \remark The offset between both clocks is measured once per second and per thread, so the conversion follows the wall clock adjustments
+     */
+    static uint64_t monotonic_to_realtime(const uint64_t p_monotonic);
+
+    /*!
+     * \brief Format a timestamp, using a per-thread cache
+     * \see timestamp_formatter::format
+     */
+    static size_t format(char * p_buffer, const size_t p_size, const uint64_t p_realtime, const timestamp_format_t p_format = rfc3339, const uint32_t p_digits = 6);
+    /*!
+     * \brief Format a timestamp into a string
+     */
+    static std::string to_string(const uint64_t p_realtime, const timestamp_format_t p_format = rfc3339, const uint32_t p_digits = 6);
+
+  private: /*! \privatesection */
+    static inline uint64_t now(const clockid_t p_clock) {
+      struct timespec ts;
+      ::clock_gettime(p_clock, &ts);
+      return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    };
+  }; // End of class timestamp
+
 } // End of namespace helpers
 
 using namespace helpers;
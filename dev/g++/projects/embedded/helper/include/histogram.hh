@@ -0,0 +1,199 @@
+/**
+ * \file      histogram.h
+ * \brief     Header file for the latency histograms.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace helpers {
+
+  /**
+   * \struct log_linear_buckets
+   * \brief The bucket layout shared by histogram and stats_histogram_cells
+   *
+   * The values below 2^p_significant_bits have their own bucket, above each power of 2 is split into
+   * 2^(p_significant_bits - 1) buckets
+   */
+  struct log_linear_buckets {
+    /**
+     * \brief Returns the bucket counting a value, the caller clamps the value to its highest bucket
+     */
+    static inline size_t index(const uint64_t p_value, const uint32_t p_significant_bits) {
+      if (p_value < (static_cast<uint64_t>(1) << p_significant_bits)) { // Exact buckets
+        return static_cast<size_t>(p_value);
+      }
+      const uint32_t msb = 63 - __builtin_clzll(p_value);
+      const uint32_t shift = msb - p_significant_bits + 1;
+      return (static_cast<size_t>(1) << p_significant_bits) + (msb - p_significant_bits) * (static_cast<size_t>(1) << (p_significant_bits - 1)) + static_cast<size_t>((p_value >> shift) - (static_cast<uint64_t>(1) << (p_significant_bits - 1)));
+    };
+    /**
+     * \brief Returns the smallest and the greatest values counted by a bucket
+     */
+    static void range(const size_t p_index, const uint32_t p_significant_bits, uint64_t & p_lowest, uint64_t & p_highest);
+    /**
+     * \brief Returns the bucket reaching a percentage of the values
+     * \param[in] p_counts The count of each bucket
+     * \param[in] p_bucket_count The number of buckets
+     * \param[in] p_total The number of values, greater than 0
+     * \param[in] p_percentile The percentage, clamped to 100.0
+     * \return The bucket index, p_bucket_count if the counts do not reach the percentage (values recorded concurrently)
+     */
+    static size_t percentile(const uint64_t * p_counts, const size_t p_bucket_count, const uint64_t p_total, const double p_percentile);
+  }; // End of struct log_linear_buckets
+
+  /**
+   * \class histogram
+   * \brief Fixed-memory, lock-free histogram of integer values (typically latencies in nanoseconds), HDR histogram style
+   *
+   * The values are counted in log-linear buckets: values below 2^p_significant_bits have their own bucket, above each power
+   * of 2 is split into 2^(p_significant_bits - 1) buckets, so the relative error of a reported value is at most
+   * 2^(1 - p_significant_bits) (0.8% with 8 bits) whatever its magnitude. All the memory is allocated by the constructor.
+   *
+   * record() costs a few instructions and one relaxed atomic increment, without lock nor system call. The counts are spread
+   * over several shards, each thread recording into its own shard, and merged when the histogram is read:
+   * \code{.cpp}
+   *     static histogram g_send_latency;
+   *     {
+   *       scope_timer t(g_send_latency);
+   *       channel.write(buffer);
+   *     }
+   *     std::clog << "send p99 " << g_send_latency.percentile(99.0) << " ns" << std::endl;
+   * \endcode
+   */
+  class histogram {
+  public:
+    /**
+     * \class snapshot
+     * \brief Merged copy of the counts of a histogram, for the queries
+     */
+    class snapshot {
+      friend class histogram;
+      const histogram * _histogram; /*!< The histogram, for the bucket boundaries */
+      std::vector<uint64_t> _counts; /*!< The count of each bucket */
+      uint64_t _total;               /*!< The number of values */
+      uint64_t _min;                 /*!< The smallest value */
+      uint64_t _max;                 /*!< The greatest value */
+      double _sum;                   /*!< The sum of the values */
+    public:
+      snapshot() : _histogram(nullptr), _counts(), _total(0), _min(0), _max(0), _sum(0.0) { };
+
+      inline uint64_t count() const { return _total; };
+      inline uint64_t min() const { return _min; };
+      inline uint64_t max() const { return _max; };
+      inline double mean() const { return (_total == 0) ? 0.0 : _sum / _total; };
+      /**
+       * \brief Returns the value below or at which a percentage of the values are
+       * \param[in] p_percentile The percentage, 0.0 to 100.0 (e.g. 99.9)
+       * \return The highest value equivalent to the bucket reaching the percentage, 0 if there are no values
+       */
+      uint64_t percentile(const double p_percentile) const;
+      /**
+       * \brief Write a one line summary: count, min, mean, p50, p90, p99, p99.9 and max
+       */
+      void print_summary(std::ostream & p_os) const;
+      /**
+       * \brief Write the percentile distribution, one line per non empty bucket (value, percentile, cumulated count)
+       */
+      void print_distribution(std::ostream & p_os) const;
+    }; // End of class snapshot
+
+  private:
+    /**
+     * \struct shard
+     * \brief The counters of a group of threads
+     */
+    struct shard {
+      std::unique_ptr<std::atomic<uint64_t>[]> counts; /*!< The count of each bucket */
+      std::atomic<uint64_t> total;                     /*!< The number of values */
+      std::atomic<uint64_t> min;                       /*!< The smallest value */
+      std::atomic<uint64_t> max;                       /*!< The greatest value */
+      std::atomic<uint64_t> sum;                       /*!< The sum of the values, wrapping */
+      uint8_t padding[88];                             /*!< Keeps the counters of two shards on distinct cache lines */
+    };
+
+    const uint32_t _significant_bits;    /*!< The number of significant bits of a bucket */
+    const uint64_t _highest_value;       /*!< The greatest value counted precisely, greater values are counted in the last bucket */
+    const size_t _bucket_count;          /*!< The number of buckets */
+    std::unique_ptr<shard[]> _shards;    /*!< The shards */
+
+  public:
+    static const uint32_t shard_count = 8;
+
+    /**
+     * \brief Default ctor
+     * \param[in] p_highest_value The greatest value to be counted precisely, greater values are clamped. Default: 60 s in ns
+     * \param[in] p_significant_bits The precision, 2 to 16 bits. Default: 8 (relative error < 0.8%)
+     */
+    explicit histogram(const uint64_t p_highest_value = 60000000000ULL, const uint32_t p_significant_bits = 8);
+    virtual ~histogram() { };
+
+    /**
+     * \brief Count a value
+     * \param[in] p_value The value, clamped to the highest value
+     */
+    inline void record(const uint64_t p_value) { record(p_value, 1); };
+    /**
+     * \brief Count a value several times
+     * \param[in] p_value The value, clamped to the highest value
+     * \param[in] p_count The number of occurences
+     */
+    void record(const uint64_t p_value, const uint64_t p_count);
+
+    /**
+     * \brief Merge the shards
+     * \return The merged counts
+     * \remark Values recorded concurrently may or may not be part of the snapshot
+     */
+    snapshot get_snapshot() const;
+    inline uint64_t percentile(const double p_percentile) const { return get_snapshot().percentile(p_percentile); };
+    inline uint64_t count() const { return get_snapshot().count(); };
+    /**
+     * \brief Clear the counts. Values recorded concurrently may be lost
+     */
+    void reset();
+
+    inline size_t bucket_count() const { return _bucket_count; };
+    /**
+     * \brief Returns the bucket counting a value
+     */
+    inline size_t bucket_index(const uint64_t p_value) const { return log_linear_buckets::index((p_value > _highest_value) ? _highest_value : p_value, _significant_bits); };
+    /**
+     * \brief Returns the smallest and the greatest values counted by a bucket
+     */
+    inline void bucket_range(const size_t p_index, uint64_t & p_lowest, uint64_t & p_highest) const { log_linear_buckets::range(p_index, _significant_bits, p_lowest, p_highest); };
+
+  private:
+    histogram(const histogram &) = delete;
+    histogram & operator = (const histogram &) = delete;
+  }; // End of class histogram
+
+  /**
+   * \class scope_timer
+   * \brief Record the lifetime of a scope into a histogram, in nanoseconds (CLOCK_MONOTONIC, no system call)
+   */
+  class scope_timer {
+    histogram & _histogram;                              /*!< The histogram */
+    std::chrono::steady_clock::time_point _start;        /*!< The construction time */
+  public:
+    explicit scope_timer(histogram & p_histogram) : _histogram(p_histogram), _start(std::chrono::steady_clock::now()) { };
+    ~scope_timer() { _histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count())); };
+  private:
+    scope_timer(const scope_timer &) = delete;
+    scope_timer & operator = (const scope_timer &) = delete;
+  }; // End of class scope_timer
+
+} // End of namespace helpers
+
+using namespace helpers;
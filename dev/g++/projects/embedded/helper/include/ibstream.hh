@@ -12,16 +12,22 @@
 #include <vector>
 #include <cstdint>
 
+#include "bit_stream.hh"
+#include "byte_span.hh"
+#include "byte_buffer.hh"
+
 namespace helpers {
 
   /**
    * \class ibstream
    * \brief Input binary stream
+   *
+   * The stream either owns its input data (std::vector/byte_buffer ctor/open) or borrows it (pointer/byte_span ctor/open).
+   * A byte_buffer is shared, not copied, and so is the data of a stream owning its data when the stream is copied.
+   * In borrowing mode, the input data shall outlive the stream and every byte_span returned by read_span(); call copy() to
+   * make the stream own its data.
    */
   class ibstream {
-    /*!< Bit masks */
-    static uint8_t g_masks[];
-
   public:
     /**
      * \brief Default ctor
@@ -35,10 +41,43 @@ namespace helpers {
      */
     ibstream(const std::vector<uint8_t> & p_input_buffer, const uint32_t p_size);
 
+    /**
+     * \brief Creation ctor, the stream borrows the input data
+     * \param[in] p_input_data The binary input data of the stream
+     * \param[in] p_size The size of the input data in bits
+     */
+    ibstream(const uint8_t * p_input_data, const uint32_t p_size);
+
+    /**
+     * \brief Creation ctor, the stream borrows the input data
+     * \param[in] p_input_data The binary input data of the stream
+     * \param[in] p_size The size of the input data in bits
+     */
+    ibstream(const byte_span & p_input_data, const uint32_t p_size);
+
+    /**
+     * \brief Creation ctor, the stream shares the input data
+     * \param[in] p_input_buffer The binary input data of the stream
+     * \param[in] p_size The size of the input data in bits
+     */
+    ibstream(const byte_buffer & p_input_buffer, const uint32_t p_size);
+
+    /**
+     * \brief Copy ctor
+     * \remark A stream owning its data shares it with the copy, a borrowing stream borrows the same data
+     */
+    ibstream(const ibstream & p_ibstream);
+
     /**
      * \brief Default dtor
      */
     virtual ~ibstream();
+
+    /**
+     * \brief Assignment operator
+     * \remark A stream owning its data shares it with the copy, a borrowing stream borrows the same data
+     */
+    ibstream & operator= (const ibstream & p_ibstream);
     
     /**
      * \brief Create a new binary input data stream
@@ -47,6 +86,31 @@ namespace helpers {
      */
     void open(const std::vector<uint8_t> & p_input_buffer, const uint32_t p_size);
 
+    /**
+     * \brief Create a new binary input data stream borrowing the input data
+     * \param[in] p_input_data The binary input data of the stream
+     * \param[in] p_size The size of the input data in bits
+     */
+    void open(const uint8_t * p_input_data, const uint32_t p_size);
+
+    /**
+     * \brief Create a new binary input data stream sharing the input data
+     * \param[in] p_input_buffer The binary input data of the stream
+     * \param[in] p_size The size of the input data in bits
+     */
+    void open(const byte_buffer & p_input_buffer, const uint32_t p_size);
+
+    /**
+     * \brief Make the stream own its input data, copying it if it is borrowed
+     */
+    void copy();
+
+    /**
+     * \brief Indicate if the stream borrows its input data
+     * \return true if the stream borrows its input data, false if it owns it
+     */
+    inline const bool is_view() const { return (_data != nullptr) && (_data != _buffer.data()); };
+
     /**
      * \brief Close the binary input data stream
      */
@@ -68,6 +132,23 @@ namespace helpers {
      */
     uint32_t read_bits(std::vector<uint8_t> & p_buffer, const uint32_t p_bits_to_read);
 
+    /**
+     * \brief Read up to 64 bits from the current stream as an unsigned value
+     * \param[out] p_value The bits read, right-aligned
+     * \param[in] p_bits_to_read The number of bits to read, 64 maximum
+     * \return The number of bits read
+     */
+    uint32_t read_bits(uint64_t & p_value, const uint32_t p_bits_to_read);
+
+    /**
+     * \brief Read one or more bytes from the current stream without copying them
+     * \param[out] p_span The view on the bytes read, borrowing the input data of the stream
+     * \param[in] p_bytes_to_read The number of bytes to read
+     * \return The number of bits read, 0 if the current position is not byte-aligned or if there are not enough bytes remaining
+     * \remark The view is valid as long as the input data of the stream is: the borrowed buffer, or the stream itself until the next open(), close() or copy()
+     */
+    uint32_t read_span(byte_span & p_span, const uint32_t p_bytes_to_read);
+
     /**
      * \brief Skip one or more bits from the current stream
      * \param[in] p_bits_to_ignore The number of bits to ignore
@@ -108,7 +189,7 @@ namespace helpers {
      * \brief Returns a pointer to the internal bit buffer
      * \return The pointer to the internal bit buffer
      */
-    inline const uint8_t * rdbuf() const { return _buffer.data(); };
+    inline const uint8_t * rdbuf() const { return _data; };
 
     /**
      * \brief Compare bit streams
@@ -154,8 +235,31 @@ namespace helpers {
     /**
      * \brief The buffer of bits
      */
-    std::vector<uint8_t> _buffer;
+    byte_buffer _buffer;
+    /**
+     * \brief The input data: either _buffer.data() or the borrowed data
+     */
+    const uint8_t * _data;
     std::ios_base::iostate _state;
+
+  private:
+    /**
+     * \brief Attach the bit reader to the buffer and move it to the current bit index
+     * \remark The bit reader keeps its cache between two sequential reads, ignore() and seekg() only move _bits_index
+     */
+    inline void sync() {
+      if ((_reader.data() != _data) || (_reader.size() != _size)) {
+        _reader.open(_data, _size);
+      }
+      if (_reader.position() != _bits_index) {
+        _reader.seek(_bits_index);
+      }
+    };
+
+    /**
+     * \brief The word-at-a-time bit reader over _buffer
+     */
+    bit_reader _reader;
   }; // End of class ibstream
 
 } // End of namespace helpers
@@ -6,44 +6,34 @@
  * \license   This project is released under the MIT License
  * \version   0.1
  */
+#include <type_traits>
+
 #include "ibstream.hh"
 #include "converter.hh"
 
 namespace helpers {
   
   template<typename T> uint32_t ibstream::read(T & p_value, const uint32_t p_bits_to_read) {
-    //    std::clog << ">>> read(T)" << std::endl; 
-
-    uint32_t result = 0;
-    std::vector<unsigned char> value;
-    if (read_bits(value, p_bits_to_read) == 0) {
-      return 0;
-    } else {
-      if (std::is_floating_point<T>::value) { // 'float' and 'int' have the same size in bytes
-	p_value = converter::get_instance().bytes_to_float(value);
-      } else {
-	switch (sizeof(T)) {
-	case sizeof(int8_t):
-	  p_value = static_cast<uint8_t>(value[0]);
-	  break;
-	case sizeof(int16_t):
-	  p_value = converter::get_instance().bytes_to_short(value);
-	  break;
-	case sizeof(int32_t):
-	  p_value = converter::get_instance().bytes_to_int(value);
-	  break;
-	case sizeof(int64_t):
-	  p_value = converter::get_instance().bytes_to_long(value);
-	  break;
-	default:
-	std::cerr << "converter::ibstream::read(T): Unsupported type, size=" << (uint32_t)sizeof(T) << std::endl; 	  
-	  break;
-	} // End of 'switch' statement
+    if (std::is_floating_point<T>::value) { // 'float' and 'int' have the same size in bytes
+      std::vector<unsigned char> value;
+      if (read_bits(value, p_bits_to_read) == 0) {
+        return 0;
       }
+      p_value = converter::get_instance().bytes_to_float(value);
+      return p_bits_to_read;
+    } else if (sizeof(T) > sizeof(uint64_t)) {
+      std::cerr << "converter::ibstream::read(T): Unsupported type, size=" << (uint32_t)sizeof(T) << std::endl;
+      return 0;
     }
-    
-    //    std::clog << "<<< read(T):" << (uint32_t)result << " - value:" << (int64_t)p_value << std::endl; 
-    return p_bits_to_read;
+
+    // Integral types are extracted directly from the bit cache, right-aligned
+    uint64_t value;
+    uint32_t result = read_bits(value, p_bits_to_read);
+    if (result != 0) {
+      p_value = static_cast<T>(value);
+    }
+
+    return result;
   }; // End of method read
   
 } // End of namespace helpers
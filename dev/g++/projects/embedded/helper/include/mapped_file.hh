@@ -0,0 +1,177 @@
+/**
+ * \file      mapped_file.h
+ * \brief     Header file for the read-only memory-mapped files.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "byte_span.hh"
+
+namespace helpers {
+
+  /**
+   * \class mapped_file
+   * \brief Read-only memory mapping of a whole file
+   *
+   * The file content is accessed in place: opening a file costs a few system calls whatever its size, pages are loaded by
+   * the kernel on first access (or up front with p_populate) and can be dropped under memory pressure without swapping.
+   * \code
+   * mapped_file capture;
+   * if (capture.open("capture.bin") == 0) {
+   *   ibstream ibs(capture.span(), capture.size() * 8); // Borrowing, no copy
+   *   ...
+   * }
+   * \endcode
+   * \remark The mapping and every byte_span obtained from it are valid until close() or the destruction of the object.
+   *         The file shall not be truncated while mapped
+   */
+  class mapped_file {
+  public:
+    /**
+     * \enum access_t
+     * \brief Expected access pattern, forwarded to the kernel with madvise()
+     */
+    typedef enum {
+      normal = 0x00,     /*!< Default kernel read-ahead */
+      sequential = 0x01, /*!< Aggressive read-ahead, pages can be freed soon after they were read */
+      random_access = 0x02 /*!< No read-ahead */
+    } access_t;
+
+  private:
+    const uint8_t * _data; /*!< The mapped content, nullptr for an empty file */
+    size_t _size;          /*!< The size of the file in bytes */
+    bool _opened;          /*!< Set when a file is open, empty files cannot be mapped */
+
+  public:
+    /**
+     * \brief Default ctor, no file is mapped
+     */
+    mapped_file() : _data(nullptr), _size(0), _opened(false) { };
+    /**
+     * \brief Creation ctor, check is_open() for the result
+     * \see open
+     */
+    mapped_file(const std::string & p_file_name, const access_t p_access = sequential, const bool p_populate = false) : _data(nullptr), _size(0), _opened(false) { open(p_file_name, p_access, p_populate); };
+    /**
+     * \brief Move ctor, p_file is left closed
+     */
+    mapped_file(mapped_file && p_file) : _data(p_file._data), _size(p_file._size), _opened(p_file._opened) { p_file._data = nullptr; p_file._size = 0; p_file._opened = false; };
+    /**
+     * \brief Default dtor, unmap the file
+     */
+    virtual ~mapped_file() { close(); };
+
+    mapped_file & operator = (mapped_file && p_file);
+
+    /**
+     * \brief Map a file
+     * \param[in] p_file_name The full file name
+     * \param[in] p_access The expected access pattern. Default: sequential
+     * \param[in] p_populate Set to true to read the whole file during the call (MAP_POPULATE), so that no page fault
+     *            occurs later on. Default: false, pages are read on first access
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t open(const std::string & p_file_name, const access_t p_access = sequential, const bool p_populate = false);
+    /**
+     * \brief Unmap the file
+     */
+    void close();
+
+    /**
+     * \brief Change the expected access pattern of a range of the file
+     * \param[in] p_access The expected access pattern
+     * \param[in] p_offset The offset of the range, rounded down to a page boundary. Default: 0
+     * \param[in] p_length The length of the range. Default: up to the end of the file
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t advise(const access_t p_access, const size_t p_offset = 0, const size_t p_length = static_cast<size_t>(-1)) const;
+    /**
+     * \brief Ask the kernel to start reading a range of the file in background (MADV_WILLNEED)
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t prefetch(const size_t p_offset, const size_t p_length) const;
+    /**
+     * \brief Release the memory of a range of the file already processed (MADV_DONTNEED). The content remains accessible,
+     *        released pages are read again from the file on next access
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t release(const size_t p_offset, const size_t p_length) const;
+
+    inline bool is_open() const { return _opened; };
+    inline const uint8_t * data() const { return _data; };
+    inline size_t size() const { return _size; };
+    /**
+     * \brief Returns a view on the whole file content
+     */
+    inline byte_span span() const { return byte_span(_data, _size); };
+
+  private:
+    mapped_file(const mapped_file &) = delete;
+    mapped_file & operator = (const mapped_file &) = delete;
+
+    const int32_t advise_range(const size_t p_offset, const size_t p_length, const int p_advice) const;
+  }; // End of class mapped_file
+
+  /**
+   * \class mapped_file_reader
+   * \brief Sequential reader over a mapped file
+   *
+   * The reader returns views on the mapped content (no copy). While it moves forward, it asks the kernel to read ahead the
+   * next window of the file and, if p_release is set, releases the pages located more than one window behind, so the
+   * resident memory stays around two windows whatever the size of the file.
+   */
+  class mapped_file_reader {
+    const mapped_file & _file; /*!< The mapped file */
+    size_t _position;          /*!< Offset of the next byte to read */
+    size_t _window;            /*!< Size of the read-ahead window */
+    bool _release;             /*!< Set to release the pages behind the read position */
+    size_t _prefetched;        /*!< End of the range already prefetched */
+    size_t _released;          /*!< End of the range already released */
+
+  public:
+    /**
+     * \brief Creation ctor
+     * \param[in] p_file The mapped file, it shall outlive the reader
+     * \param[in] p_window The size of the read-ahead window in bytes. Default: 4 MiB
+     * \param[in] p_release Set to true to release the pages once processed. Default: true
+     */
+    mapped_file_reader(const mapped_file & p_file, const size_t p_window = 4 * 1024 * 1024, const bool p_release = true);
+    virtual ~mapped_file_reader() { };
+
+    /**
+     * \brief Read a block of bytes
+     * \param[out] p_span The view on the block, it may be shorter than requested at the end of the file
+     * \param[in] p_bytes The number of bytes to read
+     * \return The number of bytes read
+     */
+    size_t read(byte_span & p_span, const size_t p_bytes);
+    /**
+     * \brief Read a line
+     * \param[out] p_line The view on the line, without the end of line character(s) ("\n" or "\r\n")
+     * \return 0 on success, -1 at the end of the file
+     */
+    const int32_t read_line(byte_span & p_line);
+    /**
+     * \brief Move the read position
+     * \param[in] p_position The new offset, clamped to the size of the file
+     */
+    void seek(const size_t p_position);
+
+    inline size_t position() const { return _position; };
+    inline size_t remaining() const { return _file.size() - _position; };
+    inline bool eof() const { return _position >= _file.size(); };
+
+  private:
+    void advance(const size_t p_bytes);
+  }; // End of class mapped_file_reader
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -0,0 +1,194 @@
+/**
+ * \file      micro_benchmark.h
+ * \brief     Header file for the micro-benchmark harness.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <istream>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+
+namespace helpers {
+
+  /**
+   * \brief Prevent the compiler from optimising away the computation of a value
+   */
+  template <typename T> inline void do_not_optimize(const T & p_value) { asm volatile("" : : "r,m"(p_value) : "memory"); }
+  /**
+   * \brief Prevent the compiler from optimising away or reordering the memory writes
+   */
+  inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+  /**
+   * \class perf_counters
+   * \brief Hardware counters of the calling thread (perf_event_open), user space only
+   * \remark The counters are not available without PMU (most virtual machines) or when /proc/sys/kernel/perf_event_paranoid
+   *         forbids it. The available counters are opened as one group led by the first available one, so that they count
+   *         the same instructions; the unavailable counters are skipped
+   */
+  class perf_counters {
+  public:
+    /**
+     * \enum counter_t
+     * \brief The counters
+     */
+    typedef enum {
+      cycles = 0x00,        /*!< CPU cycles */
+      instructions = 0x01,  /*!< Retired instructions */
+      cache_misses = 0x02,  /*!< Last level cache misses */
+      branch_misses = 0x03, /*!< Mispredicted branches */
+      counters_count = 0x04
+    } counter_t;
+
+  private:
+    int _fds[counters_count]; /*!< The counter file descriptors, -1 if not available */
+    int _leader;              /*!< The first available counter, enables and disables the whole group */
+
+  public:
+    perf_counters();
+    virtual ~perf_counters();
+
+    inline bool is_open() const { return _leader != -1; };
+    inline bool is_available(const counter_t p_counter) const { return _fds[p_counter] != -1; };
+    /**
+     * \brief Returns the JSON name of a counter
+     */
+    static const char * name(const counter_t p_counter);
+
+    /**
+     * \brief Reset and start the counters
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t start();
+    /**
+     * \brief Stop the counters and read them
+     * \param[out] p_values The counter values, 0 for the counters not available
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t stop(uint64_t (& p_values)[counters_count]);
+
+  private:
+    perf_counters(const perf_counters &) = delete;
+    perf_counters & operator = (const perf_counters &) = delete;
+  }; // End of class perf_counters
+
+  /**
+   * \struct benchmark_result
+   * \brief The measures of a benchmark, per iteration, median of the repetitions
+   */
+  struct benchmark_result {
+    std::string name;
+    uint64_t iterations;                             /*!< The number of iterations of one repetition */
+    uint32_t repetitions;                            /*!< The number of repetitions measured */
+    double ns;                                       /*!< Median duration of one iteration, in nanoseconds */
+    double ns_min;                                   /*!< Fastest repetition */
+    double ns_max;                                   /*!< Slowest repetition */
+    double counters[perf_counters::counters_count];  /*!< Median counter values per iteration, -1.0 when not available */
+  }; // End of struct benchmark_result
+
+  /**
+   * \class micro_benchmark
+   * \brief Micro-benchmark harness: warm-up, repetitions, hardware counters, JSON output and comparison with a baseline
+   *
+   * A benchmark body receives the number of iterations to run, so that the loop is compiled with the code under test:
+   * \code{.cpp}
+   *     static benchmark_registrar swap_32("converter.swap_32", [](const uint64_t p_iterations) {
+   *         for (uint64_t i = 0; i < p_iterations; i++) {
+   *           do_not_optimize(converter::get_instance().swap(static_cast<int32_t>(i)));
+   *         } // End of 'for' statement
+   *       });
+   *
+   *     int main(int p_argc, char ** p_argv) { return micro_benchmark::main(p_argc, p_argv); }
+   * \endcode
+   * The durations are always measured with clock_gettime(CLOCK_MONOTONIC); the hardware counters are added when available.
+   */
+  class micro_benchmark {
+  public:
+    typedef std::function<void(const uint64_t p_iterations)> body_t;
+
+    /**
+     * \struct settings
+     * \brief The run control
+     */
+    struct settings {
+      uint32_t warmup;       /*!< The number of repetitions run and discarded before the measures. Default: 2 */
+      uint32_t repetitions;  /*!< The number of repetitions measured. Default: 10 */
+      uint64_t iterations;   /*!< The number of iterations per repetition, 0 to calibrate. Default: 0 */
+      uint64_t min_time_ns;  /*!< The minimal duration of a calibrated repetition. Default: 10 ms */
+      settings() : warmup(2), repetitions(10), iterations(0), min_time_ns(10000000) { };
+    }; // End of struct settings
+
+  private:
+    settings _settings;      /*!< The run control */
+    perf_counters _counters; /*!< The hardware counters */
+
+  public:
+    explicit micro_benchmark(const settings & p_settings = settings());
+    virtual ~micro_benchmark() { };
+
+    inline bool has_counters() const { return _counters.is_open(); };
+
+    /**
+     * \brief Measure a benchmark body
+     * \param[in] p_name The benchmark name
+     * \param[in] p_body The benchmark body
+     * \param[out] p_result The measures
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t run(const std::string & p_name, const body_t & p_body, benchmark_result & p_result);
+
+    /**
+     * \brief Add a benchmark to the benchmarks run by main(), see benchmark_registrar
+     */
+    static void register_benchmark(const std::string & p_name, const body_t & p_body);
+    static std::vector<std::pair<std::string, body_t> > & benchmarks();
+
+    /**
+     * \brief Write results as JSON, one benchmark per line
+     */
+    static void to_json(const std::vector<benchmark_result> & p_results, std::ostream & p_os);
+    /**
+     * \brief Read results written by to_json()
+     * \return 0 on success, -1 otherwise
+     */
+    static const int32_t from_json(std::istream & p_is, std::vector<benchmark_result> & p_results);
+    /**
+     * \brief Compare results with a baseline, benchmark by benchmark
+     * \param[in] p_results The results
+     * \param[in] p_baseline The baseline results
+     * \param[in] p_threshold The slowdown of the median duration reported as a regression, in percent
+     * \param[inout] p_os The comparison report
+     * \return The number of regressions
+     */
+    static uint32_t compare(const std::vector<benchmark_result> & p_results, const std::vector<benchmark_result> & p_baseline, const double p_threshold, std::ostream & p_os);
+
+    /**
+     * \brief Command line driver, runs the registered benchmarks
+     *
+     * Options: -f|--filter <substring>, -w|--warmup <repetitions>, -r|--repetitions <repetitions>, -n|--iterations <iterations>,
+     * -o|--output <JSON file>, -b|--baseline <JSON file>, -t|--threshold <percent, default 5>
+     * \return 0 on success, 1 if a regression was found against the baseline, -1 on error
+     */
+    static int main(int p_argc, char ** p_argv);
+  }; // End of class micro_benchmark
+
+  /**
+   * \class benchmark_registrar
+   * \brief Register a benchmark at static initialisation time
+   */
+  class benchmark_registrar {
+  public:
+    benchmark_registrar(const std::string & p_name, const micro_benchmark::body_t & p_body) { micro_benchmark::register_benchmark(p_name, p_body); };
+  }; // End of class benchmark_registrar
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -0,0 +1,180 @@
+/**
+ * \file      object_pool.h
+ * \brief     Header file for the typed object pool.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace helpers {
+
+  /**
+   * \class object_pool_base
+   * \brief Non template part of the object pools: the per-thread cache indexes
+   */
+  class object_pool_base {
+  public:
+    static const uint32_t max_caches = 64;   /*!< Number of per-thread caches of a pool, the threads beyond share the central free list */
+
+  protected:
+    /**
+     * \brief Returns the index of the calling thread in the per-thread caches of all the pools
+     * \return The index, max_caches if all the indexes are taken
+     * \remark The index of a terminated thread is reused by the next new thread, with the objects left in its caches. The
+     *         thread_local destructors run after the index is given back get max_caches
+     */
+    static uint32_t cache_index();
+  }; // End of class object_pool_base
+
+  /**
+   * \class object_pool
+   * \brief Pool of objects of type T, allocated by fixed-capacity slabs and recycled without calling the system allocator
+   *
+   * The released objects are kept in a per-thread free list and served again to the same thread without any lock; the
+   * threads only exchange objects with the central free list, under a mutex, by batches. The memory of the slabs is given
+   * back to the system when the pool is destroyed.
+   * \code{.cpp}
+   *     static object_pool<sample> g_samples(256);
+   *
+   *     object_pool<sample>::unique_ptr s = g_samples.make_unique(timestamp, value); // Released by the unique_ptr
+   *     sample * raw = g_samples.acquire(timestamp, value);
+   *     g_samples.release(raw);
+   * \endcode
+   * In debug mode, the released objects are filled with a poison pattern and each slot records its state: releasing an
+   * object twice, releasing a pointer not obtained from the pool, or writing into a released object (detected when the
+   * slot is acquired again) are reported on std::cerr and counted by violations().
+   * \remark The pool shall outlive all its objects. An object may be released by any thread
+   */
+  template <typename T>
+  class object_pool : public object_pool_base {
+    /**
+     * \struct slot
+     * \brief Storage of one object, followed by the pool bookkeeping
+     */
+    struct slot {
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; /*!< The object */
+      slot * next;                                                        /*!< The next slot in a free list */
+      uint32_t state;                                                     /*!< in_use_state or free_state, debug mode only */
+    };
+
+    /**
+     * \struct cache
+     * \brief Free list of one thread, on its own cache line
+     */
+    struct cache {
+      slot * head;                  /*!< The first free slot */
+      uint32_t count;               /*!< The number of free slots */
+      std::atomic<int64_t> in_use;  /*!< The number of objects acquired minus released by the thread, only written by the thread */
+      uint8_t padding[64 - sizeof(slot *) - sizeof(uint32_t) - sizeof(std::atomic<int64_t>) - 4];
+    };
+
+    static const uint32_t in_use_state = 0xa110ca7e;
+    static const uint32_t free_state = 0xf4eef4ee;
+    static const uint8_t poison = 0xdd;
+
+    const size_t _slab_capacity;                  /*!< The number of objects per slab */
+    const uint32_t _batch;                        /*!< The number of objects exchanged with the central free list at once */
+    const bool _debug;                            /*!< Set to check the use of the released objects */
+    std::unique_ptr<uint8_t[]> _caches_memory;    /*!< The storage of _caches */
+    cache * _caches;                              /*!< The per-thread free lists, indexed by cache_index(), aligned on a cache line */
+    std::mutex _mutex;                            /*!< Protects _slabs and _free */
+    std::vector<std::unique_ptr<slot[]> > _slabs; /*!< The slabs */
+    slot * _free;                                 /*!< The central free list */
+    std::atomic<int64_t> _in_use;                 /*!< The number of objects acquired minus released by the threads without cache */
+    std::atomic<size_t> _violations;              /*!< The number of misuses detected in debug mode */
+
+  public:
+    /**
+     * \class deleter
+     * \brief std::unique_ptr deleter returning the object to its pool
+     */
+    class deleter {
+      object_pool * _pool;
+    public:
+      deleter() : _pool(nullptr) { };
+      explicit deleter(object_pool * p_pool) : _pool(p_pool) { };
+      inline void operator() (T * p_object) const { _pool->release(p_object); };
+    }; // End of class deleter
+    typedef std::unique_ptr<T, deleter> unique_ptr;
+
+    /**
+     * \brief Default ctor
+     * \param[in] p_slab_capacity The number of objects allocated at once when the pool is empty. Default: 64
+     * \param[in] p_debug Set to true to detect the misuses of the released objects. Default: false
+     */
+    explicit object_pool(const size_t p_slab_capacity = 64, const bool p_debug = false);
+    /**
+     * \brief Default dtor, release the slabs. In debug mode, the objects still in use are reported
+     */
+    virtual ~object_pool();
+
+    /**
+     * \brief Construct an object
+     * \param[in] p_args The arguments of the constructor of T
+     * \return The object, never nullptr
+     * \exception std::bad_alloc if a new slab cannot be allocated, or the exception of the constructor of T
+     */
+    template <typename... Args> T * acquire(Args &&... p_args);
+    /**
+     * \brief Construct an object owned by a unique_ptr, which releases it to the pool
+     * \see acquire
+     */
+    template <typename... Args> inline unique_ptr make_unique(Args &&... p_args) { return unique_ptr(acquire(std::forward<Args>(p_args)...), deleter(this)); };
+    /**
+     * \brief Destroy an object and return its storage to the pool
+     * \param[in] p_object The object, obtained from this pool. nullptr is ignored
+     */
+    void release(T * p_object);
+
+    /**
+     * \brief Allocate the storage of an object without constructing it, e.g. for a class operator new
+     * \return The storage, never nullptr
+     * \exception std::bad_alloc if a new slab cannot be allocated
+     */
+    void * allocate();
+    /**
+     * \brief Return the storage of a destroyed object to the pool, e.g. for a class operator delete
+     * \param[in] p_storage The storage, obtained by allocate(). nullptr is ignored
+     */
+    void deallocate(void * p_storage);
+
+    /**
+     * \brief Returns the number of objects the slabs allocated so far can hold
+     */
+    inline size_t capacity() { std::lock_guard<std::mutex> lock(_mutex); return _slabs.size() * _slab_capacity; };
+    /**
+     * \brief Returns the number of objects in use, exact when no other thread is acquiring or releasing objects
+     */
+    size_t in_use() const;
+    inline size_t violations() const { return _violations.load(); };
+    inline bool is_debug() const { return _debug; };
+
+  private:
+    object_pool(const object_pool &) = delete;
+    object_pool & operator = (const object_pool &) = delete;
+
+    slot * pop();
+    void push(slot * p_slot);
+    void refill(cache & p_cache);
+    void drain(cache & p_cache, const uint32_t p_count);
+    void report(const char * p_error, const void * p_object);
+    bool owns(const slot * p_slot);
+  }; // End of class object_pool
+
+} // End of namespace helpers
+
+#include "object_pool.t.h"
+
+using namespace helpers;
@@ -0,0 +1,243 @@
+/**
+ * \file      object_pool.t.h
+ * \brief     Template header file for the typed object pool.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+namespace helpers {
+
+  inline uint32_t object_pool_base::cache_index() {
+    static thread_local uint32_t current = max_caches + 1; // Trivial thread_local, read without any call once assigned
+    if (current <= max_caches) {
+      return current;
+    }
+
+    // Never destroyed: threads may terminate after the static objects
+    static std::mutex * mutex = new std::mutex();
+    static uint64_t * used = new uint64_t(0); // One bit per index
+    struct holder { // Give the index back when the thread terminates
+      uint32_t index;
+      holder() : index(max_caches) {
+        std::lock_guard<std::mutex> lock(*mutex);
+        for (uint32_t i = 0; i < max_caches; i++) {
+          if (((*used >> i) & 1) == 0) {
+            *used |= static_cast<uint64_t>(1) << i;
+            index = i;
+            break;
+          }
+        } // End of 'for' statement
+      };
+      ~holder() {
+        current = max_caches; // The pools used by the thread_local destructors run later use the shared free list
+        if (index < max_caches) {
+          std::lock_guard<std::mutex> lock(*mutex);
+          *used &= ~(static_cast<uint64_t>(1) << index);
+        }
+      };
+    };
+    static thread_local holder h;
+    current = h.index;
+    return current;
+  }
+
+  template <typename T>
+  object_pool<T>::object_pool(const size_t p_slab_capacity, const bool p_debug) : _slab_capacity((p_slab_capacity == 0) ? 1 : p_slab_capacity), _batch(static_cast<uint32_t>(std::max<size_t>(1, std::min<size_t>(32, p_slab_capacity / 2)))), _debug(p_debug), _caches_memory(new uint8_t[(max_caches + 1) * sizeof(cache)]), _caches(nullptr), _mutex(), _slabs(), _free(nullptr), _in_use(0), _violations(0) {
+    _caches = reinterpret_cast<cache *>((reinterpret_cast<uintptr_t>(_caches_memory.get()) + 63) & ~static_cast<uintptr_t>(63));
+    for (uint32_t i = 0; i < max_caches; i++) {
+      new (&_caches[i]) cache();
+      _caches[i].head = nullptr;
+      _caches[i].count = 0;
+      _caches[i].in_use.store(0);
+    } // End of 'for' statement
+  }
+
+  template <typename T>
+  object_pool<T>::~object_pool() {
+    if (_debug && (in_use() != 0)) {
+      std::cerr << "object_pool::~object_pool: " << in_use() << " object(s) still in use" << std::endl;
+    }
+  }
+
+  template <typename T>
+  size_t object_pool<T>::in_use() const {
+    int64_t count = _in_use.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < max_caches; i++) {
+      count += _caches[i].in_use.load(std::memory_order_relaxed);
+    } // End of 'for' statement
+    return (count < 0) ? 0 : static_cast<size_t>(count);
+  }
+
+  template <typename T>
+  template <typename... Args>
+  T * object_pool<T>::acquire(Args &&... p_args) {
+    void * storage = allocate();
+    try {
+      return new (storage) T(std::forward<Args>(p_args)...);
+    } catch (...) {
+      deallocate(storage);
+      throw;
+    }
+  }
+
+  template <typename T>
+  void object_pool<T>::release(T * p_object) {
+    if (p_object == nullptr) {
+      return;
+    }
+
+    slot * s = reinterpret_cast<slot *>(p_object);
+    if (_debug && (!owns(s) || (s->state != in_use_state))) { // Not destroyed a second time
+      report(owns(s) ? "release of a released object" : "release of a foreign object", p_object);
+      return;
+    }
+    p_object->~T();
+    deallocate(p_object);
+  }
+
+  template <typename T>
+  void * object_pool<T>::allocate() {
+    slot * s = pop();
+    if (_debug) {
+      const uint8_t * p = reinterpret_cast<const uint8_t *>(&s->storage);
+      if (std::find_if(p, p + sizeof(T), [](const uint8_t p_byte) { return p_byte != poison; }) != p + sizeof(T)) {
+        report("write after release", &s->storage);
+      }
+      s->state = in_use_state;
+    }
+    return &s->storage;
+  }
+
+  template <typename T>
+  void object_pool<T>::deallocate(void * p_storage) {
+    if (p_storage == nullptr) {
+      return;
+    }
+
+    slot * s = reinterpret_cast<slot *>(p_storage);
+    if (_debug) {
+      if (!owns(s) || (s->state != in_use_state)) {
+        report(owns(s) ? "release of a released object" : "release of a foreign object", p_storage);
+        return;
+      }
+      s->state = free_state;
+      std::memset(&s->storage, poison, sizeof(T));
+    }
+    push(s);
+  }
+
+  template <typename T>
+  typename object_pool<T>::slot * object_pool<T>::pop() {
+    const uint32_t index = cache_index();
+    if (index == max_caches) { // No cache for this thread
+      std::lock_guard<std::mutex> lock(_mutex);
+      cache c = { nullptr, 0 };
+      refill(c);
+      slot * s = c.head;
+      c.head = s->next;
+      c.count -= 1;
+      if (c.head != nullptr) { // Back to the central free list
+        slot * last = c.head;
+        while (last->next != nullptr) {
+          last = last->next;
+        } // End of 'while' statement
+        last->next = _free;
+        _free = c.head;
+      }
+      _in_use.fetch_add(1, std::memory_order_relaxed);
+      return s;
+    }
+
+    cache & c = _caches[index];
+    if (c.head == nullptr) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      refill(c);
+    }
+    slot * s = c.head;
+    c.head = s->next;
+    c.count -= 1;
+    c.in_use.store(c.in_use.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // Single writer, no atomic RMW
+    return s;
+  }
+
+  template <typename T>
+  void object_pool<T>::push(slot * p_slot) {
+    const uint32_t index = cache_index();
+    if (index == max_caches) { // No cache for this thread
+      std::lock_guard<std::mutex> lock(_mutex);
+      p_slot->next = _free;
+      _free = p_slot;
+      _in_use.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+
+    cache & c = _caches[index];
+    c.in_use.store(c.in_use.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    p_slot->next = c.head;
+    c.head = p_slot;
+    c.count += 1;
+    if (c.count >= 2 * _batch) { // Give a batch back, for the threads which release less than they acquire
+      std::lock_guard<std::mutex> lock(_mutex);
+      drain(c, _batch);
+    }
+  }
+
+  template <typename T>
+  void object_pool<T>::refill(cache & p_cache) {
+    if (_free == nullptr) { // New slab
+      std::unique_ptr<slot[]> slab(new slot[_slab_capacity]);
+      for (size_t i = 0; i < _slab_capacity; i++) {
+        slab[i].next = (i + 1 < _slab_capacity) ? &slab[i + 1] : nullptr;
+        slab[i].state = free_state;
+        if (_debug) {
+          std::memset(&slab[i].storage, poison, sizeof(T));
+        }
+      } // End of 'for' statement
+      _free = &slab[0];
+      _slabs.push_back(std::move(slab));
+    }
+
+    for (uint32_t i = 0; (i < _batch) && (_free != nullptr); i++) {
+      slot * s = _free;
+      _free = s->next;
+      s->next = p_cache.head;
+      p_cache.head = s;
+      p_cache.count += 1;
+    } // End of 'for' statement
+  }
+
+  template <typename T>
+  void object_pool<T>::drain(cache & p_cache, const uint32_t p_count) {
+    for (uint32_t i = 0; (i < p_count) && (p_cache.head != nullptr); i++) {
+      slot * s = p_cache.head;
+      p_cache.head = s->next;
+      p_cache.count -= 1;
+      s->next = _free;
+      _free = s;
+    } // End of 'for' statement
+  }
+
+  template <typename T>
+  void object_pool<T>::report(const char * p_error, const void * p_object) {
+    _violations.fetch_add(1);
+    std::cerr << "object_pool: " << p_error << " " << p_object << std::endl;
+  }
+
+  template <typename T>
+  bool object_pool<T>::owns(const slot * p_slot) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (typename std::vector<std::unique_ptr<slot[]> >::const_iterator it = _slabs.cbegin(); it != _slabs.cend(); ++it) {
+      const slot * first = it->get();
+      if ((p_slot >= first) && (p_slot < first + _slab_capacity)) {
+        return (reinterpret_cast<const uint8_t *>(p_slot) - reinterpret_cast<const uint8_t *>(first)) % sizeof(slot) == 0;
+      }
+    } // End of 'for' statement
+    return false;
+  }
+
+} // End of namespace helpers
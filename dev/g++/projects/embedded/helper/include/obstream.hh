@@ -12,6 +12,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "byte_buffer.hh"
+
 namespace helpers {
 
   /**
@@ -19,9 +21,6 @@ namespace helpers {
    * \brief Output binary stream
    */
   class obstream {
-    /*!< Bit masks */
-    static uint8_t g_masks[];
-    
   public:
     /**
      * \brief Default ctor
@@ -136,6 +135,12 @@ namespace helpers {
      */
     inline const std::vector<uint8_t> & to_bytes() const { return _buffer; };
 
+    /**
+     * \brief Move the output bits stream out of the stream, which is reset
+     * \return The bytes written, without copying them
+     */
+    inline byte_buffer release() { _buffer.resize((_bits_index + 7) / 8); byte_buffer buffer(std::move(_buffer)); reset(); return buffer; };
+
   protected:
     /**
      * \brief The index of the next bits to process
@@ -146,6 +151,15 @@ namespace helpers {
      */
     std::vector<uint8_t> _buffer;
     std::ios_base::iostate _state;
+
+  private:
+    /**
+     * \brief Write up to 64 bits at the current bit index, overwriting the bits already present
+     * \param[in] p_value The bits to write, right-aligned
+     * \param[in] p_bits_to_write The number of bits to write, 64 maximum
+     * \remark The bits are merged into the buffer 8 bytes at a time
+     */
+    void put(const uint64_t p_value, const uint32_t p_bits_to_write);
   }; // End of class obstream
 
 } // End of namespace helpers
@@ -33,73 +33,11 @@ namespace helpers {
 					       ), 
 			  p_bits_to_write
 			  );
-    } else {
-      switch (sizeof(T)) {
-      case sizeof(int8_t):
-	result = write_bits(static_cast<uint8_t>(static_cast<const uint8_t>(p_value)), p_bits_to_write);
-	break;
-      case sizeof(int16_t): 
-	{
-	  std::vector<uint8_t> convert = converter::get_instance().short_to_bytes(static_cast<const int16_t>(p_value));
-	  result = write_bits(
-			      std::vector<uint8_t>(
-						   convert.cbegin() + static_cast<uint32_t>(
-											    (
-											     sizeof(T) - 
-											     static_cast<uint32_t>(
-														   p_bits_to_write / 8
-														   )
-											     )
-											    ), 
-						   convert.cend()
-						   ), 
-			      p_bits_to_write
-			      );
-	}
-	break;
-      case sizeof(int32_t): 
-	{
-	  std::vector<uint8_t> convert = converter::get_instance().int_to_bytes(static_cast<const int32_t>(p_value));
-	  result = write_bits(
-			      std::vector<uint8_t>(
-						   convert.cbegin() + static_cast<uint32_t>(
-											    (
-											     sizeof(T) - 
-											     static_cast<uint32_t>(
-														   p_bits_to_write / 8
-														   )
-											     )
-											    ), 
-						   convert.cend()
-						   ), 
-			      p_bits_to_write
-			      );
-	}
-	break;
-      case sizeof(int64_t): 
-	{
-	  std::vector<uint8_t> convert = converter::get_instance().long_to_bytes(static_cast<const int64_t>(p_value));
-	  result = write_bits(
-			      std::vector<uint8_t>(
-						   convert.cbegin() + static_cast<uint32_t>(
-											    (
-											     sizeof(T) - 
-											     static_cast<uint32_t>(
-														   p_bits_to_write / 8
-														   )
-											     )
-											    ), 
-						   convert.cend()
-						   ), 
-			      p_bits_to_write
-			      );
-	}
-	break;
-      default:
-	//result = write_bits(p_value, p_bits_to_write);
-	std::cerr << "converter::obstream::write(T): Unsupported type, size=" << (uint32_t)sizeof(T) << std::endl; 
-	break;
-      } // End of 'switch' statement
+    } else if (sizeof(T) > sizeof(uint64_t)) {
+      std::cerr << "converter::obstream::write(T): Unsupported type, size=" << (uint32_t)sizeof(T) << std::endl; 
+    } else { // Integral types are merged directly into the buffer, right-aligned
+      result = (p_bits_to_write > (8 * sizeof(uint8_t) * sizeof(T))) ? 8 * sizeof(uint8_t) * sizeof(T) : p_bits_to_write;
+      put(static_cast<uint64_t>(p_value), result);
     }
     
     //std::clog << "<<< write(T):" << (uint32_t)result << std::endl; 
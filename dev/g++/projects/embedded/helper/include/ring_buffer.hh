@@ -0,0 +1,332 @@
+/**
+ * \file      ring_buffer.h
+ * \brief     Header file for the lock-free bounded ring buffers.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+namespace helpers {
+
+  /**
+   * \enum ring_wait_t
+   * \brief How the blocking operations of a ring wait for data or space
+   */
+  enum class ring_wait_t : uint8_t {
+    spin = 0x00,   /*!< Busy wait then yield. The non-blocking operations do not pay anything for the blocking ones */
+    futex = 0x01,  /*!< Sleep on a futex. Works for rings placed in shared memory between processes */
+    eventfd = 0x02 /*!< Data availability signaled through an eventfd (see get_fd) so the consumer can sit in a poll()/epoll() loop.
+                        The eventfd is private to the process (and its forked children) */
+  }; // End of enum ring_wait_t
+
+  /**
+   * \struct ring_event
+   * \brief Wake-up state shared by the two sides of a ring, placed in the ring header
+   */
+  struct ring_event {
+    std::atomic<uint32_t> sequence; /*!< Incremented on each wake-up, the futex word */
+    std::atomic<uint32_t> waiters;  /*!< Number of threads sleeping, or about to sleep. With an eventfd, set when the consumer is armed */
+  }; // End of struct ring_event
+
+  /**
+   * \class ring_notifier
+   * \brief Process-local handle on a ring_event
+   */
+  class ring_notifier {
+    ring_event * _event; /*!< The shared state */
+    ring_wait_t _mode;   /*!< The wait mode */
+    bool _shared;        /*!< Set when the ring is placed in shared memory (process-shared futex) */
+    int _fd;             /*!< The eventfd, -1 if unused */
+
+  public:
+    ring_notifier() : _event(nullptr), _mode(ring_wait_t::spin), _shared(false), _fd(-1) { };
+    virtual ~ring_notifier() { close(); };
+
+    /**
+     * \brief Attach the handle to an event
+     * \param[in] p_event The shared state
+     * \param[in] p_mode The wait mode
+     * \param[in] p_shared Set to true if the event lives in memory shared between processes
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t open(ring_event * p_event, const ring_wait_t p_mode, const bool p_shared);
+    void close();
+
+    inline int get_fd() const { return _fd; };
+
+    /**
+     * \brief Wake the waiters up, if any. Called after each publication, costs a fence when the mode is not spin
+     */
+    inline void notify() {
+      if (_mode == ring_wait_t::spin) {
+        return;
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst); // Paired with the fence of wait(): either the waiter sees the publication, or this thread sees the waiter
+      if (_event->waiters.load(std::memory_order_relaxed) != 0) {
+        wake();
+      }
+    };
+    /**
+     * \brief With an eventfd, request a notification for the next publication. Called by the consumer when it finds the ring
+     *        empty, so the producer writes the eventfd once per empty to non-empty transition instead of once per value
+     */
+    inline void arm() {
+      if (_fd != -1) {
+        _event->waiters.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+    };
+
+    /**
+     * \brief Wait until p_ready() returns true
+     * \param[in] p_ready The condition to wait for
+     * \param[in] p_timeout The timeout in milliseconds, -1 for infinite
+     * \return 0 on success, -1 on timeout
+     */
+    template<typename P> const int32_t wait(P p_ready, const int32_t p_timeout);
+
+  private:
+    ring_notifier(const ring_notifier &) = delete;
+    ring_notifier & operator = (const ring_notifier &) = delete;
+
+    void wake();
+    /**
+     * \brief Sleep until the sequence differs from p_sequence, or the timeout expires
+     */
+    void sleep(const uint32_t p_sequence, const int32_t p_timeout);
+  }; // End of class ring_notifier
+
+  /**
+   * \class spsc_ring
+   * \brief Wait-free single-producer/single-consumer bounded ring
+   *
+   * The producer owns the tail index and the consumer owns the head index, each on its own cache line; each side also keeps a
+   * private copy of the other index and reads the shared one only when the ring looks full (resp. empty), so a push or a pop
+   * usually touches one shared cache line.
+   * The ring state is position independent: it can be created in a caller-provided memory area, e.g. a shared_memory
+   * segment, and attached by the other process.
+   * \code
+   * spsc_ring<sample_t> ring(1024, ring_wait_t::futex);
+   * // Acquisition thread
+   * ring.push_wait(sample);
+   * // Processing thread
+   * sample_t samples[64];
+   * const uint32_t count = ring.pop(samples, 64);
+   * \endcode
+   * \remark T shall be trivially copyable. Only one thread may push and only one thread may pop at a time
+   */
+  template<typename T> class spsc_ring {
+    static_assert(std::is_trivially_copyable<T>::value, "spsc_ring: trivially copyable type expected");
+
+    /**
+     * \struct header_t
+     * \brief The shared state, followed by the slots
+     */
+    struct header_t {
+      uint32_t magic;                         /*!< Set once the header is initialised */
+      uint32_t capacity;                      /*!< The number of slots, a power of 2 */
+      char _padding0[64 - 2 * sizeof(uint32_t)];
+      std::atomic<uint32_t> head;             /*!< Index of the next slot to pop, written by the consumer */
+      char _padding1[64 - sizeof(std::atomic<uint32_t>)];
+      std::atomic<uint32_t> tail;             /*!< Index of the next slot to push, written by the producer */
+      char _padding2[64 - sizeof(std::atomic<uint32_t>)];
+      ring_event data;                        /*!< Signaled when slots are pushed */
+      ring_event space;                       /*!< Signaled when slots are popped */
+      char _padding3[64 - 2 * sizeof(ring_event)];
+    }; // End of struct header_t
+
+    std::unique_ptr<uint8_t[]> _memory; /*!< The memory of the ring, when it is not provided by the caller */
+    header_t * _header;                 /*!< The shared state */
+    T * _slots;                         /*!< The slots */
+    uint32_t _mask;                     /*!< The capacity minus one */
+    uint32_t _cached_head;              /*!< Producer side copy of the head index */
+    uint32_t _cached_tail;              /*!< Consumer side copy of the tail index */
+    ring_notifier _data;                /*!< Wake-up of the consumer */
+    ring_notifier _space;               /*!< Wake-up of the producer */
+
+  public:
+    /**
+     * \brief Creation ctor, the ring is allocated in the process memory
+     * \param[in] p_capacity The number of slots, rounded up to a power of 2
+     * \param[in] p_wait The wait mode of the blocking operations. Default: spin
+     * \exception std::invalid_argument if p_capacity is 0 or greater than 2^31
+     */
+    explicit spsc_ring(const uint32_t p_capacity, const ring_wait_t p_wait = ring_wait_t::spin);
+    /**
+     * \brief Creation ctor, the ring is placed in a caller-provided memory area
+     * \param[in] p_memory The memory area, 64-byte aligned, of at least memory_size(p_capacity) bytes. It shall outlive the ring
+     * \param[in] p_capacity The number of slots, rounded up to a power of 2
+     * \param[in] p_create Set to true to initialise the ring, false to attach to a ring initialised by another process
+     * \param[in] p_wait The wait mode of the blocking operations. Default: futex
+     * \exception std::invalid_argument if p_capacity is invalid, or if the area does not hold a ring of this capacity
+     */
+    spsc_ring(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait = ring_wait_t::futex);
+    virtual ~spsc_ring() { };
+
+    /**
+     * \brief Returns the number of bytes required to place a ring in a caller-provided memory area
+     */
+    static size_t memory_size(const uint32_t p_capacity);
+
+    /**
+     * \brief Push a value
+     * \return true on success, false if the ring is full
+     */
+    inline bool try_push(const T & p_value) { return push(&p_value, 1) == 1; };
+    /**
+     * \brief Push as many values as possible, with a single publication
+     * \param[in] p_values The values to push
+     * \param[in] p_count The number of values
+     * \return The number of values pushed
+     */
+    uint32_t push(const T * p_values, const uint32_t p_count);
+    /**
+     * \brief Push a value, waiting for a free slot if the ring is full
+     * \param[in] p_timeout The timeout in milliseconds. Default: -1, infinite
+     * \return 0 on success, -1 on timeout
+     */
+    const int32_t push_wait(const T & p_value, const int32_t p_timeout = -1);
+    /**
+     * \brief Pop a value
+     * \return true on success, false if the ring is empty
+     */
+    inline bool try_pop(T & p_value) { return pop(&p_value, 1) == 1; };
+    /**
+     * \brief Pop as many values as available, up to p_count, with a single publication
+     * \param[out] p_values The popped values
+     * \param[in] p_count The maximum number of values
+     * \return The number of values popped
+     */
+    uint32_t pop(T * p_values, const uint32_t p_count);
+    /**
+     * \brief Pop a value, waiting for data if the ring is empty
+     * \param[in] p_timeout The timeout in milliseconds. Default: -1, infinite
+     * \return 0 on success, -1 on timeout
+     */
+    const int32_t pop_wait(T & p_value, const int32_t p_timeout = -1);
+
+    inline uint32_t capacity() const { return _mask + 1; };
+    /**
+     * \brief Returns the number of values in the ring. Exact only when called by the producer or the consumer while the other side is idle
+     */
+    inline uint32_t size() const { return _header->tail.load(std::memory_order_acquire) - _header->head.load(std::memory_order_acquire); };
+    inline bool empty() const { return size() == 0; };
+    /**
+     * \brief Returns the eventfd signaled when data is pushed (ring_wait_t::eventfd only), -1 otherwise
+     */
+    inline int get_fd() const { return _data.get_fd(); };
+
+  private:
+    spsc_ring(const spsc_ring &) = delete;
+    spsc_ring & operator = (const spsc_ring &) = delete;
+
+    void setup(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait, const bool p_shared);
+  }; // End of class spsc_ring
+
+  /**
+   * \class mpmc_ring
+   * \brief Lock-free multi-producer/multi-consumer bounded ring (Vyukov)
+   *
+   * Each slot carries a sequence number telling whether it is ready to be written or read for a given round, so producers
+   * and consumers only contend on the compare-and-swap of their own index and never wait for each other, unless the ring
+   * is full or empty.
+   * \remark T shall be trivially copyable. The ring can be placed in shared memory, as spsc_ring
+   */
+  template<typename T> class mpmc_ring {
+    static_assert(std::is_trivially_copyable<T>::value, "mpmc_ring: trivially copyable type expected");
+
+    /**
+     * \struct cell_t
+     * \brief A slot and its sequence number
+     */
+    struct cell_t {
+      std::atomic<uint32_t> sequence;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+    }; // End of struct cell_t
+
+    /**
+     * \struct header_t
+     * \brief The shared state, followed by the cells
+     */
+    struct header_t {
+      uint32_t magic;                         /*!< Set once the header is initialised */
+      uint32_t capacity;                      /*!< The number of cells, a power of 2 */
+      char _padding0[64 - 2 * sizeof(uint32_t)];
+      std::atomic<uint32_t> enqueue;          /*!< Next position to push, claimed by the producers */
+      char _padding1[64 - sizeof(std::atomic<uint32_t>)];
+      std::atomic<uint32_t> dequeue;          /*!< Next position to pop, claimed by the consumers */
+      char _padding2[64 - sizeof(std::atomic<uint32_t>)];
+      ring_event data;                        /*!< Signaled when cells are pushed */
+      ring_event space;                       /*!< Signaled when cells are popped */
+      char _padding3[64 - 2 * sizeof(ring_event)];
+    }; // End of struct header_t
+
+    std::unique_ptr<uint8_t[]> _memory; /*!< The memory of the ring, when it is not provided by the caller */
+    header_t * _header;                 /*!< The shared state */
+    cell_t * _cells;                    /*!< The cells */
+    uint32_t _mask;                     /*!< The capacity minus one */
+    ring_notifier _data;                /*!< Wake-up of the consumers */
+    ring_notifier _space;               /*!< Wake-up of the producers */
+
+  public:
+    /**
+     * \brief Creation ctor, the ring is allocated in the process memory
+     * \see spsc_ring::spsc_ring
+     */
+    explicit mpmc_ring(const uint32_t p_capacity, const ring_wait_t p_wait = ring_wait_t::spin);
+    /**
+     * \brief Creation ctor, the ring is placed in a caller-provided memory area
+     * \see spsc_ring::spsc_ring
+     */
+    mpmc_ring(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait = ring_wait_t::futex);
+    virtual ~mpmc_ring() { };
+
+    static size_t memory_size(const uint32_t p_capacity);
+
+    inline bool try_push(const T & p_value) { return push(&p_value, 1) == 1; };
+    /**
+     * \brief Push up to p_count values, claiming consecutive cells with a single compare-and-swap
+     * \return The number of values pushed
+     */
+    uint32_t push(const T * p_values, const uint32_t p_count);
+    const int32_t push_wait(const T & p_value, const int32_t p_timeout = -1);
+    inline bool try_pop(T & p_value) { return pop(&p_value, 1) == 1; };
+    /**
+     * \brief Pop up to p_count values, claiming consecutive cells with a single compare-and-swap
+     * \return The number of values popped
+     */
+    uint32_t pop(T * p_values, const uint32_t p_count);
+    const int32_t pop_wait(T & p_value, const int32_t p_timeout = -1);
+
+    inline uint32_t capacity() const { return _mask + 1; };
+    /**
+     * \brief Returns the number of values in the ring, a snapshot only while other threads access the ring
+     */
+    inline uint32_t size() const {
+      const uint32_t dequeue = _header->dequeue.load(std::memory_order_acquire);
+      const int32_t size = static_cast<int32_t>(_header->enqueue.load(std::memory_order_acquire) - dequeue);
+      return (size < 0) ? 0 : static_cast<uint32_t>(size);
+    };
+    inline bool empty() const { return size() == 0; };
+    inline int get_fd() const { return _data.get_fd(); };
+
+  private:
+    mpmc_ring(const mpmc_ring &) = delete;
+    mpmc_ring & operator = (const mpmc_ring &) = delete;
+
+    void setup(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait, const bool p_shared);
+  }; // End of class mpmc_ring
+
+} // End of namespace helpers
+
+#include "ring_buffer.t.h"
+
+using namespace helpers;
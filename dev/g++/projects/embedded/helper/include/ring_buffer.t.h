@@ -0,0 +1,342 @@
+/**
+ * \file      ring_buffer.t.h
+ * \brief     Template header file for the lock-free bounded ring buffers.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstring>
+#include <new>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+
+namespace helpers {
+
+  /**
+   * \brief Value of the magic field of an initialised ring header
+   */
+  static const uint32_t ring_magic = 0x52494e47; // "RING"
+
+  /**
+   * \brief Check and round a ring capacity up to a power of 2
+   * \exception std::invalid_argument if p_capacity is 0 or greater than 2^31
+   */
+  inline uint32_t ring_capacity(const uint32_t p_capacity) {
+    if ((p_capacity == 0) || (p_capacity > 0x80000000U)) {
+      throw std::invalid_argument("ring_capacity: wrong capacity");
+    }
+    uint32_t capacity = 1;
+    while (capacity < p_capacity) {
+      capacity <<= 1;
+    } // End of 'while' statement
+    return capacity;
+  }
+
+  template<typename P> const int32_t ring_notifier::wait(P p_ready, const int32_t p_timeout) {
+    // Most waits are short: spin first
+    for (uint32_t i = 0; i < 128; i++) {
+      if (p_ready()) {
+        return 0;
+      }
+    } // End of 'for' statement
+
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(p_timeout);
+    while (true) {
+      int32_t remaining = -1;
+      if (p_timeout >= 0) {
+        const int64_t left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) {
+          return p_ready() ? 0 : -1;
+        }
+        remaining = static_cast<int32_t>(left);
+      }
+
+      if (_mode == ring_wait_t::spin) {
+        std::this_thread::yield();
+        if (p_ready()) {
+          return 0;
+        }
+        continue;
+      }
+
+      uint32_t sequence = 0;
+      if (_fd != -1) {
+        arm();
+      } else {
+        _event->waiters.fetch_add(1, std::memory_order_relaxed);
+        sequence = _event->sequence.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // Paired with the fence of notify()
+      }
+      if (p_ready()) {
+        if (_fd == -1) {
+          _event->waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return 0;
+      }
+      sleep(sequence, remaining);
+      if (_fd == -1) {
+        _event->waiters.fetch_sub(1, std::memory_order_relaxed);
+      }
+      if (p_ready()) {
+        return 0;
+      }
+    } // End of 'while' statement
+  }; // End of method wait
+
+  template<typename T> spsc_ring<T>::spsc_ring(const uint32_t p_capacity, const ring_wait_t p_wait) : _memory(), _header(nullptr), _slots(nullptr), _mask(0), _cached_head(0), _cached_tail(0) {
+    const size_t size = memory_size(p_capacity);
+    _memory.reset(new uint8_t[size + 64]);
+    uint8_t * memory = _memory.get() + ((64 - reinterpret_cast<uintptr_t>(_memory.get()) % 64) % 64);
+    setup(memory, p_capacity, true, p_wait, false);
+  }
+
+  template<typename T> spsc_ring<T>::spsc_ring(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait) : _memory(), _header(nullptr), _slots(nullptr), _mask(0), _cached_head(0), _cached_tail(0) {
+    setup(p_memory, p_capacity, p_create, p_wait, true);
+  }
+
+  template<typename T> size_t spsc_ring<T>::memory_size(const uint32_t p_capacity) {
+    return sizeof(header_t) + ring_capacity(p_capacity) * sizeof(T);
+  }
+
+  template<typename T> void spsc_ring<T>::setup(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait, const bool p_shared) {
+    const uint32_t capacity = ring_capacity(p_capacity);
+    _header = static_cast<header_t *>(p_memory);
+    if (p_create) {
+      _header = new (p_memory) header_t();
+      _header->capacity = capacity;
+      _header->head.store(0, std::memory_order_relaxed);
+      _header->tail.store(0, std::memory_order_relaxed);
+      _header->data.sequence.store(0, std::memory_order_relaxed);
+      _header->data.waiters.store(0, std::memory_order_relaxed);
+      _header->space.sequence.store(0, std::memory_order_relaxed);
+      _header->space.waiters.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      _header->magic = ring_magic;
+    } else if ((_header->magic != ring_magic) || (_header->capacity != capacity)) {
+      throw std::invalid_argument("spsc_ring::setup: no ring of this capacity in the memory area");
+    }
+    _slots = reinterpret_cast<T *>(_header + 1);
+    _mask = capacity - 1;
+    _cached_head = _header->head.load(std::memory_order_acquire);
+    _cached_tail = _header->tail.load(std::memory_order_acquire);
+    _data.open(&_header->data, p_wait, p_shared);
+    _space.open(&_header->space, (p_wait == ring_wait_t::eventfd) ? ring_wait_t::futex : p_wait, p_shared); // The producer never polls
+  }
+
+  template<typename T> uint32_t spsc_ring<T>::push(const T * p_values, const uint32_t p_count) {
+    const uint32_t tail = _header->tail.load(std::memory_order_relaxed);
+    uint32_t free = capacity() - (tail - _cached_head);
+    if (free < p_count) { // Refresh the copy of the consumer index
+      _cached_head = _header->head.load(std::memory_order_acquire);
+      free = capacity() - (tail - _cached_head);
+    }
+    const uint32_t count = (p_count < free) ? p_count : free;
+    if (count == 0) {
+      return 0;
+    }
+
+    // Two copies at most: up to the end of the slots, then from the beginning
+    const uint32_t index = tail & _mask;
+    const uint32_t first = (count < capacity() - index) ? count : capacity() - index;
+    std::memcpy(static_cast<void *>(_slots + index), p_values, first * sizeof(T));
+    std::memcpy(static_cast<void *>(_slots), p_values + first, (count - first) * sizeof(T));
+    _header->tail.store(tail + count, std::memory_order_release);
+    _data.notify();
+    return count;
+  }
+
+  template<typename T> const int32_t spsc_ring<T>::push_wait(const T & p_value, const int32_t p_timeout) {
+    if (try_push(p_value)) {
+      return 0;
+    }
+    if (_space.wait([this]() { return (_header->tail.load(std::memory_order_relaxed) - _header->head.load(std::memory_order_acquire)) != capacity(); }, p_timeout) == -1) {
+      return -1;
+    }
+    return try_push(p_value) ? 0 : -1;
+  }
+
+  template<typename T> uint32_t spsc_ring<T>::pop(T * p_values, const uint32_t p_count) {
+    const uint32_t head = _header->head.load(std::memory_order_relaxed);
+    uint32_t available = _cached_tail - head;
+    if (available < p_count) { // Refresh the copy of the producer index
+      _cached_tail = _header->tail.load(std::memory_order_acquire);
+      available = _cached_tail - head;
+    }
+    const uint32_t count = (p_count < available) ? p_count : available;
+    if (count == 0) {
+      _data.arm();
+      return 0;
+    }
+
+    const uint32_t index = head & _mask;
+    const uint32_t first = (count < capacity() - index) ? count : capacity() - index;
+    std::memcpy(static_cast<void *>(p_values), _slots + index, first * sizeof(T));
+    std::memcpy(static_cast<void *>(p_values + first), _slots, (count - first) * sizeof(T));
+    _header->head.store(head + count, std::memory_order_release);
+    _space.notify();
+    return count;
+  }
+
+  template<typename T> const int32_t spsc_ring<T>::pop_wait(T & p_value, const int32_t p_timeout) {
+    if (try_pop(p_value)) {
+      return 0;
+    }
+    if (_data.wait([this]() { return _header->tail.load(std::memory_order_acquire) != _header->head.load(std::memory_order_relaxed); }, p_timeout) == -1) {
+      return -1;
+    }
+    return try_pop(p_value) ? 0 : -1;
+  }
+
+  template<typename T> mpmc_ring<T>::mpmc_ring(const uint32_t p_capacity, const ring_wait_t p_wait) : _memory(), _header(nullptr), _cells(nullptr), _mask(0) {
+    const size_t size = memory_size(p_capacity);
+    _memory.reset(new uint8_t[size + 64]);
+    uint8_t * memory = _memory.get() + ((64 - reinterpret_cast<uintptr_t>(_memory.get()) % 64) % 64);
+    setup(memory, p_capacity, true, p_wait, false);
+  }
+
+  template<typename T> mpmc_ring<T>::mpmc_ring(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait) : _memory(), _header(nullptr), _cells(nullptr), _mask(0) {
+    setup(p_memory, p_capacity, p_create, p_wait, true);
+  }
+
+  template<typename T> size_t mpmc_ring<T>::memory_size(const uint32_t p_capacity) {
+    return sizeof(header_t) + ring_capacity(p_capacity) * sizeof(cell_t);
+  }
+
+  template<typename T> void mpmc_ring<T>::setup(void * p_memory, const uint32_t p_capacity, const bool p_create, const ring_wait_t p_wait, const bool p_shared) {
+    const uint32_t capacity = ring_capacity(p_capacity);
+    _header = static_cast<header_t *>(p_memory);
+    _cells = reinterpret_cast<cell_t *>(_header + 1);
+    if (p_create) {
+      _header = new (p_memory) header_t();
+      _header->capacity = capacity;
+      _header->enqueue.store(0, std::memory_order_relaxed);
+      _header->dequeue.store(0, std::memory_order_relaxed);
+      _header->data.sequence.store(0, std::memory_order_relaxed);
+      _header->data.waiters.store(0, std::memory_order_relaxed);
+      _header->space.sequence.store(0, std::memory_order_relaxed);
+      _header->space.waiters.store(0, std::memory_order_relaxed);
+      for (uint32_t i = 0; i < capacity; i++) { // The cell i is free for the position i
+        new (&_cells[i]) cell_t();
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+      } // End of 'for' statement
+      std::atomic_thread_fence(std::memory_order_release);
+      _header->magic = ring_magic;
+    } else if ((_header->magic != ring_magic) || (_header->capacity != capacity)) {
+      throw std::invalid_argument("mpmc_ring::setup: no ring of this capacity in the memory area");
+    }
+    _mask = capacity - 1;
+    _data.open(&_header->data, p_wait, p_shared);
+    _space.open(&_header->space, (p_wait == ring_wait_t::eventfd) ? ring_wait_t::futex : p_wait, p_shared);
+  }
+
+  template<typename T> uint32_t mpmc_ring<T>::push(const T * p_values, const uint32_t p_count) {
+    uint32_t position = _header->enqueue.load(std::memory_order_relaxed);
+    uint32_t count;
+    while (true) {
+      // Count the consecutive cells free for this round; a cell free for the position p can only be taken by the owner of p
+      for (count = 0; count < p_count; count++) {
+        const uint32_t sequence = _cells[(position + count) & _mask].sequence.load(std::memory_order_acquire);
+        if (sequence != position + count) {
+          break;
+        }
+      } // End of 'for' statement
+      if (count == 0) {
+        const uint32_t sequence = _cells[position & _mask].sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - position) < 0) { // Full: the cell still holds the value of the previous round
+          return 0;
+        }
+        position = _header->enqueue.load(std::memory_order_relaxed); // Taken by another producer
+      } else if (_header->enqueue.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+        break;
+      }
+    } // End of 'while' statement
+
+    for (uint32_t i = 0; i < count; i++) {
+      cell_t & cell = _cells[(position + i) & _mask];
+      std::memcpy(static_cast<void *>(&cell.value), &p_values[i], sizeof(T));
+      cell.sequence.store(position + i + 1, std::memory_order_release);
+    } // End of 'for' statement
+    _data.notify();
+    return count;
+  }
+
+  template<typename T> const int32_t mpmc_ring<T>::push_wait(const T & p_value, const int32_t p_timeout) {
+    // The slot may be taken by another producer after each wake up: wait again for the time left only
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(p_timeout);
+    while (!try_push(p_value)) {
+      int32_t remaining = -1;
+      if (p_timeout >= 0) {
+        const int64_t left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (left < 0) {
+          return -1;
+        }
+        remaining = static_cast<int32_t>(left);
+      }
+      const int32_t result = _space.wait([this]() {
+          const uint32_t position = _header->enqueue.load(std::memory_order_relaxed);
+          return static_cast<int32_t>(_cells[position & _mask].sequence.load(std::memory_order_acquire) - position) >= 0;
+        }, remaining);
+      if (result == -1) {
+        return -1;
+      }
+    } // End of 'while' statement
+    return 0;
+  }
+
+  template<typename T> uint32_t mpmc_ring<T>::pop(T * p_values, const uint32_t p_count) {
+    uint32_t position = _header->dequeue.load(std::memory_order_relaxed);
+    uint32_t count;
+    while (true) {
+      for (count = 0; count < p_count; count++) {
+        const uint32_t sequence = _cells[(position + count) & _mask].sequence.load(std::memory_order_acquire);
+        if (sequence != position + count + 1) {
+          break;
+        }
+      } // End of 'for' statement
+      if (count == 0) {
+        const uint32_t sequence = _cells[position & _mask].sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - (position + 1)) < 0) { // Empty: the cell was not written for this round yet
+          _data.arm();
+          return 0;
+        }
+        position = _header->dequeue.load(std::memory_order_relaxed); // Taken by another consumer
+      } else if (_header->dequeue.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+        break;
+      }
+    } // End of 'while' statement
+
+    for (uint32_t i = 0; i < count; i++) {
+      cell_t & cell = _cells[(position + i) & _mask];
+      std::memcpy(static_cast<void *>(&p_values[i]), &cell.value, sizeof(T));
+      cell.sequence.store(position + i + _mask + 1, std::memory_order_release); // Free for the next round
+    } // End of 'for' statement
+    _space.notify();
+    return count;
+  }
+
+  template<typename T> const int32_t mpmc_ring<T>::pop_wait(T & p_value, const int32_t p_timeout) {
+    // The slot may be taken by another consumer after each wake up: wait again for the time left only
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(p_timeout);
+    while (!try_pop(p_value)) {
+      int32_t remaining = -1;
+      if (p_timeout >= 0) {
+        const int64_t left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (left < 0) {
+          return -1;
+        }
+        remaining = static_cast<int32_t>(left);
+      }
+      const int32_t result = _data.wait([this]() {
+          const uint32_t position = _header->dequeue.load(std::memory_order_relaxed);
+          return static_cast<int32_t>(_cells[position & _mask].sequence.load(std::memory_order_acquire) - (position + 1)) >= 0;
+        }, remaining);
+      if (result == -1) {
+        return -1;
+      }
+    } // End of 'while' statement
+    return 0;
+  }
+
+} // End of namespace helpers
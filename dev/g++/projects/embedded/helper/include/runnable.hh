@@ -8,9 +8,15 @@
  */
 #pragma once
 
+#include <string>
+#include <vector>
 #include <memory>
 #include <atomic>
 #include <thread>
+#include <cstdint>
+
+#include <sched.h> // Used for SCHED_OTHER, SCHED_FIFO, SCHED_RR
+#include <pthread.h>
 
 /*! \namespace helpers
  *  \brief helpers namespace
@@ -22,6 +28,53 @@ namespace helpers {
    */
   namespace thread {
 
+    /*!
+     * \struct thread_config
+     * \brief Scheduling and memory settings of a runnable thread
+     *
+     * The settings are applied by the new thread itself, before run() is called:
+     * \code{.cpp}
+     *     thread_config config;
+     *     config.policy = SCHED_FIFO;
+     *     config.priority = 80;
+     *     config.cpus = 0x02;           // CPU 1 only
+     *     config.name = "gyromon";
+     *     config.lock_memory = true;
+     *     config.prefault_stack = 64 * 1024;
+     *     sampler.configure(config);
+     *     sampler.start();
+     *     if (sampler.failures() & thread_config::scheduling) { // Not privileged, still running with SCHED_OTHER
+     * \endcode
+     * \remark Real-time policies and memory locking require CAP_SYS_NICE and CAP_IPC_LOCK (or matching RLIMIT_RTPRIO and
+     *         RLIMIT_MEMLOCK). A setting which cannot be applied is reported by runnable::failures(), the thread runs anyway
+     */
+    struct thread_config {
+      /*!
+       * \enum setting_t
+       * \brief Flags identifying the settings, as reported by runnable::failures()
+       */
+      typedef enum {
+        affinity = 0x01,    /*!< CPU affinity mask */
+        scheduling = 0x02,  /*!< Scheduling policy and priority */
+        naming = 0x04,      /*!< Thread name */
+        stack = 0x08,       /*!< Stack size */
+        memory_lock = 0x10  /*!< Memory locking */
+      } setting_t;
+
+      int32_t policy;          /*!< SCHED_OTHER (default), SCHED_FIFO or SCHED_RR */
+      int32_t priority;        /*!< The real-time priority, 1 (lowest) to 99 for SCHED_FIFO and SCHED_RR, ignored otherwise */
+      uint64_t cpus;           /*!< The CPU affinity mask, bit i for the CPU i. Default: 0, any CPU */
+      std::vector<uint32_t> cpu_list; /*!< CPUs added to the affinity mask, required for the CPUs 64 and above. Default: empty */
+      std::string name;        /*!< The name shown by ps, top and gdb, truncated to 15 characters. Default: inherited */
+      size_t stack_size;       /*!< The stack size in bytes. Default: 0, the system default */
+      bool lock_memory;        /*!< Set to lock the pages of the whole process in memory (mlockall), so that no page fault delays the thread */
+      size_t prefault_stack;   /*!< The number of bytes of stack touched before run() is called, less than the stack size. Default: 0 */
+
+      thread_config() : policy(SCHED_OTHER), priority(0), cpus(0), cpu_list(), name(), stack_size(0), lock_memory(false), prefault_stack(0) { };
+
+      inline bool is_default() const { return (policy == SCHED_OTHER) && (cpus == 0) && cpu_list.empty() && name.empty() && (stack_size == 0) && !lock_memory && (prefault_stack == 0); };
+    }; // End of struct thread_config
+
     /*!
      * \class runnable
      * \brief This class implements a interface for class references to be executed as a thread 
@@ -29,17 +82,30 @@ namespace helpers {
     class runnable {
 
     protected: /*! \protectedsection */
-      /*!< Pointer to the thread */
+      /*!< Pointer to the thread, started without settings */
       std::unique_ptr<std::thread> _thread;
+      /*!< The thread started with settings, created with its own attributes */
+      pthread_t _handle;
+      /*!< Indicates if _handle shall be joined */
+      bool _has_handle;
       /*!< Indicates if the thread is running */
       std::atomic<bool> _running;
+      /*!< The settings applied by start() */
+      thread_config _config;
+      /*!< The settings which could not be applied, see thread_config::setting_t */
+      std::atomic<uint32_t> _failures;
 
     public: /*! \publicsection */
       /*!
        * \brief Default constructor
        */
       
-      runnable() : _running(false) { _thread.reset(nullptr); };
+      runnable() : _handle(), _has_handle(false), _running(false), _config(), _failures(0) { _thread.reset(nullptr); };
+      /*!
+       * \brief Constructor with thread settings
+       * \param[in] p_config The settings applied on start()
+       */
+      explicit runnable(const thread_config & p_config) : _handle(), _has_handle(false), _running(false), _config(p_config), _failures(0) { _thread.reset(nullptr); };
       /*!
        * \brief Default destructor
        */
@@ -47,22 +113,36 @@ namespace helpers {
       
       /*!
        * \fn void start();
-       * \brief Start the thread
-       * \inline
+       * \brief Start the thread. When settings are configured, the method returns once the thread applied them
        * \virtual
        */
-      inline virtual void start() { _thread.reset(new std::thread(std::ref(*this))); };
+      virtual void start();
       /*!
        * \fn void stop();
        * \brief Stop the thread
-       * \inline
        * \virtual
        */
-      inline virtual void stop() { _running = false; _thread->join(); _thread.reset(nullptr); };
+      virtual void stop();
       /*!
        * \brief Cast operator
        */
       inline void operator()() { run(); };
+
+      /*!
+       * \brief Change the settings applied on next start()
+       * \param[in] p_config The settings
+       */
+      inline void configure(const thread_config & p_config) { _config = p_config; };
+      inline const thread_config & config() const { return _config; };
+      /*!
+       * \brief Indicates the settings which could not be applied on last start()
+       * \return A combination of thread_config::setting_t flags, 0 if all the settings were applied
+       */
+      inline uint32_t failures() const { return _failures.load(); };
+      /*!
+       * \brief Returns the pthread handle of the running thread
+       */
+      inline pthread_t native_handle() { return _has_handle ? _handle : _thread->native_handle(); };
       
     protected: /*! \protectedsection */
       /*!
@@ -72,6 +152,13 @@ namespace helpers {
        * \pure
        */
       virtual void run() = 0;
+
+    private: /*! \privatesection */
+      /*!
+       * \brief Apply the settings to the calling thread, except the stack size
+       * \return The settings which could not be applied
+       */
+      uint32_t apply_config();
       
     }; // End of class runnable
 
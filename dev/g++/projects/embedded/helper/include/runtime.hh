@@ -0,0 +1,165 @@
+/**
+ * \file      runtime.h
+ * \brief     Header file for the application runtime (event loop).
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include <signal.h>
+#include <termios.h>
+
+namespace helpers {
+
+  /**
+   * \class runtime
+   * \brief Single-threaded event loop for the main thread of an application
+   *
+   * One epoll instance multiplexes the termination signals (signalfd), the periodic timers (timerfd), the key strokes on the
+   * standard input and any user file descriptor; the thread sleeps in the kernel until one of them is ready:
+   * \code{.cpp}
+   *     runtime rt;                  // Before starting any thread, see remark
+   *     app.start();
+   *     rt.add_timer(std::chrono::milliseconds(100), [&app](const uint64_t p_expirations) { app.sample(p_expirations); });
+   *     rt.on_key([&rt](const char p_key) { rt.stop(); });
+   *     rt.run();                    // Returns on SIGINT, SIGTERM, key stroke or stop()
+   *     app.stop();
+   * \endcode
+   * Timers are armed on absolute CLOCK_MONOTONIC deadlines: each expiration is computed by the kernel from the previous
+   * deadline, not from the time the callback ran, so the period does not drift. Expirations missed while the loop was busy
+   * are reported to the callback instead of being silently lost.
+   * \remark SIGINT and SIGTERM are blocked in the constructing thread and received through the loop. Threads inherit the
+   *         signal mask of their creator, so the runtime shall be created before any other thread; a thread created earlier
+   *         may still receive these signals with their default action (termination)
+   * \remark The callbacks run in the thread calling run(). They may add or remove sources, including their own one
+   */
+  class runtime {
+  public:
+    /*!< Called with the number of the received signal */
+    typedef std::function<void(const int32_t p_signal)> signal_callback;
+    /*!< Called with the number of expirations since the previous call, more than 1 if some ticks were missed */
+    typedef std::function<void(const uint64_t p_expirations)> timer_callback;
+    /*!< Called once per character read on the standard input */
+    typedef std::function<void(const char p_key)> key_callback;
+    /*!< Called with the ready file descriptor and its epoll events (EPOLLIN, EPOLLOUT, EPOLLHUP...) */
+    typedef std::function<void(const int32_t p_fd, const uint32_t p_events)> fd_callback;
+
+  private:
+    /**
+     * \struct source
+     * \brief A file descriptor watched by the loop
+     */
+    struct source {
+      std::function<void(const uint32_t p_events)> handler; /*!< The event handler */
+      bool owned;                                            /*!< Set when the file descriptor is closed on removal (timers) */
+    };
+
+    int32_t _epoll;                /*!< The epoll instance */
+    int32_t _signal_fd;            /*!< The signalfd, -1 if signals are not handled */
+    int32_t _wakeup_fd;            /*!< The eventfd written by stop() */
+    sigset_t _signals;             /*!< The signals received through _signal_fd */
+    sigset_t _saved_mask;          /*!< The signal mask of the constructing thread, restored by the destructor */
+    std::atomic<bool> _stop;       /*!< Set by stop() */
+    std::map<int32_t, std::shared_ptr<source> > _sources; /*!< The watched file descriptors, indexed by file descriptor */
+    signal_callback _on_signal;    /*!< The signal callback */
+    key_callback _on_key;          /*!< The key callback */
+    struct termios _saved_termios; /*!< The terminal settings of the standard input, restored when the key callback is removed */
+    bool _terminal_set;            /*!< Set when the standard input terminal was switched to non-canonical mode */
+
+  public:
+    /**
+     * \brief Default ctor, check is_open() for the result
+     * \param[in] p_handle_signals Set to false for a runtime used in a worker thread, the signals are then left to the
+     *            runtime of the main thread. Default: true, SIGINT and SIGTERM stop the loop
+     */
+    explicit runtime(const bool p_handle_signals = true);
+    /**
+     * \brief Default dtor, close the file descriptors and restore the signal mask and the terminal settings
+     */
+    virtual ~runtime();
+
+    inline bool is_open() const { return _epoll != -1; };
+
+    /**
+     * \brief Run the loop until stop() is called or a termination signal is received
+     * \return 0 on success, -1 otherwise
+     * \remark If stop() was called before, the method returns immediately
+     */
+    const int32_t run();
+    /**
+     * \brief Request the loop to return. Thread-safe and async-signal-safe
+     */
+    void stop();
+
+    /**
+     * \brief Receive an additional signal through the loop (e.g. SIGHUP, SIGUSR1), it does not stop the loop
+     * \param[in] p_signal The signal number
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t add_signal(const int32_t p_signal);
+    /**
+     * \brief Set the callback called on signal reception. For SIGINT and SIGTERM, the loop stops once it returns
+     * \param[in] p_callback The callback, nullptr to remove it
+     */
+    inline void on_signal(const signal_callback & p_callback) { _on_signal = p_callback; };
+
+    /**
+     * \brief Start a periodic timer
+     * \param[in] p_period The period
+     * \param[in] p_callback The callback called on each expiration
+     * \return The timer identifier on success, -1 otherwise
+     */
+    const int32_t add_timer(const std::chrono::nanoseconds & p_period, const timer_callback & p_callback);
+    /**
+     * \brief Stop a periodic timer
+     * \param[in] p_timer The timer identifier returned by add_timer()
+     * \return 0 on success, -1 otherwise
+     */
+    inline const int32_t remove_timer(const int32_t p_timer) { return remove_fd(p_timer); };
+
+    /**
+     * \brief Set the callback called on key strokes. A terminal standard input is switched to non-canonical mode without
+     *        echo, so that keys are received without waiting for the end of line
+     * \param[in] p_callback The callback, nullptr to stop reading the standard input
+     * \return 0 on success, -1 otherwise
+     * \remark The standard input is no longer watched once it reaches the end of file
+     */
+    const int32_t on_key(const key_callback & p_callback);
+
+    /**
+     * \brief Watch a user file descriptor. The loop is level-triggered: the callback is called as long as the condition holds
+     * \param[in] p_fd The file descriptor, it remains owned by the caller and shall be removed before being closed
+     * \param[in] p_events The epoll events to watch. Default: EPOLLIN
+     * \param[in] p_callback The callback
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t add_fd(const int32_t p_fd, const uint32_t p_events, const fd_callback & p_callback);
+    /**
+     * \brief Stop watching a file descriptor
+     * \param[in] p_fd The file descriptor
+     * \return 0 on success, -1 otherwise
+     */
+    const int32_t remove_fd(const int32_t p_fd);
+
+  private:
+    runtime(const runtime &) = delete;
+    runtime & operator = (const runtime &) = delete;
+
+    const int32_t add_source(const int32_t p_fd, const uint32_t p_events, const std::function<void(const uint32_t p_events)> & p_handler, const bool p_owned);
+    void process_signals();
+    void process_keys(const uint32_t p_events);
+    void restore_terminal();
+  }; // End of class runtime
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -0,0 +1,238 @@
+/**
+ * \file      stats_registry.h
+ * \brief     Header file for the shared-memory statistics registry.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+#include "histogram.hh"
+
+namespace helpers {
+
+  /**
+   * \enum stats_kind
+   * \brief The kinds of statistics
+   */
+  typedef enum {
+    stats_none = 0x00,           /*!< Unused entry */
+    stats_counter_kind = 0x01,   /*!< Monotonic counter, e.g. received messages */
+    stats_gauge_kind = 0x02,     /*!< Signed instantaneous value, e.g. queue depth */
+    stats_histogram_kind = 0x03  /*!< Distribution of values, e.g. latencies in nanoseconds */
+  } stats_kind;
+
+  /**
+   * \struct stats_histogram_cells
+   * \brief Shared-memory layout of a histogram: log-linear buckets (see log_linear_buckets), 16 per power of 2 (relative error < 6.25%) up to 2^48
+   */
+  struct stats_histogram_cells {
+    static const uint32_t significant_bits = 5;
+    static const uint32_t highest_bit = 47;
+    static const size_t bucket_count = (1 << significant_bits) + (highest_bit - significant_bits + 1) * (1 << (significant_bits - 1));
+
+    std::atomic<uint64_t> count;                 /*!< The number of values */
+    std::atomic<uint64_t> sum;                   /*!< The sum of the values, wrapping */
+    std::atomic<uint64_t> min;                   /*!< The smallest value, UINT64_MAX if none */
+    std::atomic<uint64_t> max;                   /*!< The greatest value */
+    std::atomic<uint64_t> buckets[bucket_count]; /*!< The count of each bucket */
+
+    /**
+     * \brief Returns the bucket counting a value, the values above 2^48 are counted in the last bucket
+     */
+    static inline size_t bucket_index(const uint64_t p_value) { return ((p_value >> (highest_bit + 1)) != 0) ? bucket_count - 1 : log_linear_buckets::index(p_value, significant_bits); };
+    /**
+     * \brief Returns the greatest value counted by a bucket
+     */
+    static inline uint64_t bucket_highest(const size_t p_index) { uint64_t lowest, highest; log_linear_buckets::range(p_index, significant_bits, lowest, highest); return highest; };
+  }; // End of struct stats_histogram_cells
+
+  /**
+   * \class stats_counter
+   * \brief Handle on a counter of a stats_registry. Copyable, valid as long as the registry
+   */
+  class stats_counter {
+    std::atomic<uint64_t> * _value;
+  public:
+    stats_counter();
+    explicit stats_counter(std::atomic<uint64_t> * p_value) : _value(p_value) { };
+
+    inline void increment() { _value->fetch_add(1, std::memory_order_relaxed); };
+    inline void add(const uint64_t p_value) { _value->fetch_add(p_value, std::memory_order_relaxed); };
+    inline uint64_t value() const { return _value->load(std::memory_order_relaxed); };
+  }; // End of class stats_counter
+
+  /**
+   * \class stats_gauge
+   * \brief Handle on a gauge of a stats_registry. Copyable, valid as long as the registry
+   */
+  class stats_gauge {
+    std::atomic<int64_t> * _value;
+  public:
+    stats_gauge();
+    explicit stats_gauge(std::atomic<int64_t> * p_value) : _value(p_value) { };
+
+    inline void set(const int64_t p_value) { _value->store(p_value, std::memory_order_relaxed); };
+    inline void add(const int64_t p_value) { _value->fetch_add(p_value, std::memory_order_relaxed); };
+    inline int64_t value() const { return _value->load(std::memory_order_relaxed); };
+  }; // End of class stats_gauge
+
+  /**
+   * \class stats_histogram
+   * \brief Handle on a histogram of a stats_registry. Copyable, valid as long as the registry
+   */
+  class stats_histogram {
+    stats_histogram_cells * _cells;
+  public:
+    stats_histogram();
+    explicit stats_histogram(stats_histogram_cells * p_cells) : _cells(p_cells) { };
+
+    inline void record(const uint64_t p_value) {
+      _cells->buckets[stats_histogram_cells::bucket_index(p_value)].fetch_add(1, std::memory_order_relaxed);
+      _cells->count.fetch_add(1, std::memory_order_relaxed);
+      _cells->sum.fetch_add(p_value, std::memory_order_relaxed);
+      uint64_t current = _cells->min.load(std::memory_order_relaxed);
+      while ((p_value < current) && !_cells->min.compare_exchange_weak(current, p_value, std::memory_order_relaxed)) {
+      } // End of 'while' statement
+      current = _cells->max.load(std::memory_order_relaxed);
+      while ((p_value > current) && !_cells->max.compare_exchange_weak(current, p_value, std::memory_order_relaxed)) {
+      } // End of 'while' statement
+    };
+    inline uint64_t count() const { return _cells->count.load(std::memory_order_relaxed); };
+  }; // End of class stats_histogram
+
+  /**
+   * \class stats_registry
+   * \brief Named counters, gauges and histograms of a process, laid out in a POSIX shared memory segment readable by other
+   *        processes (see stats_reader and the stats_top tool)
+   *
+   * The statistics are registered once, at initialisation time; the handles then update the shared memory directly with
+   * relaxed atomic operations, without lock nor system call:
+   * \code{.cpp}
+   *     stats_registry stats("aggreg");                        // Segment /dev/shm/aggreg
+   *     stats_counter frames = stats.counter("rx.frames");
+   *     stats_histogram latency = stats.histogram("rx.latency_ns");
+   *     ...
+   *     frames.increment();
+   *     latency.record(elapsed);
+   * \endcode
+   * When the registry is full or cannot be created, the handles point to a process-local cell, so that the instrumented
+   * code never has to check them.
+   * \remark The segment is removed by the destructor
+   */
+  class stats_registry {
+    std::string _name;    /*!< The shared memory name, starting with '/' */
+    uint8_t * _segment;   /*!< The mapped segment, nullptr on failure */
+    size_t _size;         /*!< The size of the segment in bytes */
+    std::mutex _mutex;    /*!< Serialise the registrations */
+
+  public:
+    static const size_t name_length = 47; /*!< The maximal length of a statistic name */
+
+    /**
+     * \brief Creation ctor, check is_open() for the result. An existing segment of the same name is replaced, unless the
+     *        process which created it is still running
+     * \param[in] p_name The segment name, e.g. the process name
+     * \param[in] p_capacity The maximal number of statistics. Default: 256
+     * \param[in] p_histograms The maximal number of histograms among them. Default: 32
+     */
+    explicit stats_registry(const std::string & p_name, const uint32_t p_capacity = 256, const uint32_t p_histograms = 32);
+    /**
+     * \brief Default dtor, unmap and remove the segment
+     */
+    virtual ~stats_registry();
+
+    inline bool is_open() const { return _segment != nullptr; };
+
+    /**
+     * \brief Register a counter, or returns the counter already registered with this name
+     */
+    stats_counter counter(const std::string & p_name);
+    /**
+     * \brief Register a gauge, or returns the gauge already registered with this name
+     */
+    stats_gauge gauge(const std::string & p_name);
+    /**
+     * \brief Register a histogram, or returns the histogram already registered with this name
+     */
+    stats_histogram histogram(const std::string & p_name);
+
+  private:
+    stats_registry(const stats_registry &) = delete;
+    stats_registry & operator = (const stats_registry &) = delete;
+
+    /**
+     * \brief Find or create an entry
+     * \return The address of its cells, nullptr if the name is invalid, already used by another kind, or the segment is full
+     */
+    void * reserve(const std::string & p_name, const stats_kind p_kind);
+  }; // End of class stats_registry
+
+  /**
+   * \struct stats_value
+   * \brief The value of a statistic read by a stats_reader
+   */
+  struct stats_value {
+    std::string name;
+    stats_kind kind;
+    int64_t value;        /*!< The counter or gauge value, the histogram count */
+    uint64_t sum;         /*!< Histogram only */
+    uint64_t min;         /*!< Histogram only */
+    uint64_t max;         /*!< Histogram only */
+    uint64_t p50;         /*!< Histogram only, the percentiles are upper bounds of buckets */
+    uint64_t p90;         /*!< Histogram only */
+    uint64_t p99;         /*!< Histogram only */
+    uint64_t p999;        /*!< Histogram only */
+  }; // End of struct stats_value
+
+  /**
+   * \class stats_reader
+   * \brief Read-only access to the segment of a stats_registry, from any process
+   */
+  class stats_reader {
+    const uint8_t * _segment; /*!< The mapped segment, nullptr on failure */
+    size_t _size;             /*!< The size of the segment in bytes */
+
+  public:
+    /**
+     * \brief Creation ctor, check is_open() for the result
+     * \param[in] p_name The segment name given to the stats_registry
+     */
+    explicit stats_reader(const std::string & p_name);
+    virtual ~stats_reader();
+
+    inline bool is_open() const { return _segment != nullptr; };
+    /**
+     * \brief Returns the identifier of the process which created the segment
+     */
+    int32_t pid() const;
+
+    /**
+     * \brief Read all the statistics
+     * \param[out] p_values The statistics, in registration order
+     * \return 0 on success, -1 otherwise (e.g. an entry beyond the end of the segment)
+     */
+    const int32_t read(std::vector<stats_value> & p_values) const;
+
+    /**
+     * \brief Write statistics as a JSON object, name: value for counters and gauges, name: { count, ... } for histograms
+     */
+    static void to_json(const std::vector<stats_value> & p_values, std::ostream & p_os);
+
+  private:
+    stats_reader(const stats_reader &) = delete;
+    stats_reader & operator = (const stats_reader &) = delete;
+  }; // End of class stats_reader
+
+} // End of namespace helpers
+
+using namespace helpers;
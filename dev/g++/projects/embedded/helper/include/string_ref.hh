@@ -0,0 +1,121 @@
+/**
+ * \file      string_ref.h
+ * \brief     Header file for the non-owning character range view.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <cstring>
+#include <cstddef>
+
+namespace helpers {
+
+  /**
+   * \class string_ref
+   * \brief Non-owning view on a contiguous range of characters (C++11 equivalent of std::string_view)
+   * \remark A string_ref borrows the memory it refers to: it is valid as long as the underlying string is neither destroyed nor modified.
+   *         The range is not null-terminated, use to_string() to get an owning copy
+   */
+  class string_ref {
+    const char * _data; /*!< The first character of the range */
+    size_t _size;       /*!< The number of characters of the range */
+
+  public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * \brief Default ctor, an empty view
+     */
+    string_ref() : _data(""), _size(0) { };
+    /**
+     * \brief Creation ctor
+     * \param[in] p_data The first character of the range
+     * \param[in] p_size The number of characters of the range
+     */
+    string_ref(const char * p_data, const size_t p_size) : _data(p_data), _size(p_size) { };
+    /**
+     * \brief Creation ctor, the view borrows the null-terminated string
+     * \param[in] p_string The string to view
+     */
+    string_ref(const char * p_string) : _data(p_string), _size(std::strlen(p_string)) { };
+    /**
+     * \brief Creation ctor, the view borrows the content of the string
+     * \param[in] p_string The string to view
+     */
+    string_ref(const std::string & p_string) : _data(p_string.data()), _size(p_string.length()) { };
+
+    inline const char * data() const { return _data; };
+    inline size_t size() const { return _size; };
+    inline size_t length() const { return _size; };
+    inline bool empty() const { return _size == 0; };
+    inline const char * begin() const { return _data; };
+    inline const char * end() const { return _data + _size; };
+    inline const char & operator[] (const size_t p_index) const { return _data[p_index]; };
+
+    /**
+     * \brief Returns a sub-range of this view, clamped to the view boundaries
+     * \param[in] p_position The index of the first character of the sub-range
+     * \param[in] p_count The number of characters of the sub-range. Default: up to the end of the view
+     * \return The sub-range view, borrowing the same string
+     */
+    inline string_ref substr(const size_t p_position, const size_t p_count = npos) const {
+      if (p_position >= _size) {
+        return string_ref(end(), 0);
+      }
+      return string_ref(_data + p_position, (p_count < _size - p_position) ? p_count : _size - p_position);
+    };
+
+    /**
+     * \brief Find the first occurence of a character
+     * \param[in] p_char The character to find
+     * \param[in] p_position The index where the search starts. Default: 0
+     * \return The index of the character, npos if it is not found
+     */
+    inline size_t find(const char p_char, const size_t p_position = 0) const {
+      if (p_position >= _size) {
+        return npos;
+      }
+      const void * p = std::memchr(_data + p_position, p_char, _size - p_position);
+      return (p == nullptr) ? npos : static_cast<const char *>(p) - _data;
+    };
+
+    inline bool starts_with(const string_ref & p_prefix) const { return (p_prefix._size <= _size) && (std::memcmp(_data, p_prefix._data, p_prefix._size) == 0); };
+    inline bool ends_with(const string_ref & p_suffix) const { return (p_suffix._size <= _size) && (std::memcmp(end() - p_suffix._size, p_suffix._data, p_suffix._size) == 0); };
+
+    /**
+     * \brief Remove the leading and the trailing special characters
+     * \param[in] p_trim_chars The special characters to be omitted. Default: ' ' and TAB
+     * \return The trimmed view, borrowing the same string
+     */
+    inline string_ref trim(const char * p_trim_chars = " \t") const {
+      const char * first = begin();
+      const char * last = end();
+      while ((first != last) && (std::strchr(p_trim_chars, *first) != nullptr)) {
+        first += 1;
+      } // End of 'while' statement
+      while ((last != first) && (std::strchr(p_trim_chars, *(last - 1)) != nullptr)) {
+        last -= 1;
+      } // End of 'while' statement
+      return string_ref(first, last - first);
+    };
+
+    /**
+     * \brief Copy the content of the view
+     * \return An owning copy of the characters
+     */
+    inline std::string to_string() const { return std::string(_data, _size); };
+
+    inline bool operator== (const string_ref & p_string) const { return (_size == p_string._size) && (std::memcmp(_data, p_string._data, _size) == 0); };
+    inline bool operator!= (const string_ref & p_string) const { return !(*this == p_string); };
+  }; // End of class string_ref
+
+  inline std::ostream & operator<< (std::ostream & p_os, const string_ref & p_string) { return p_os.write(p_string.data(), p_string.size()); };
+
+} // End of namespace helpers
+
+using namespace helpers;
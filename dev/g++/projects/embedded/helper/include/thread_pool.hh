@@ -0,0 +1,232 @@
+/*!
+ * \file      thread_pool.h
+ * \brief     Header file for the work-stealing thread pool.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <type_traits>
+
+#include "runnable.hh"
+
+/*! \namespace helpers
+ *  \brief helpers namespace
+ */
+namespace helpers {
+
+  /*! \namespace helpers::threads
+   *  \brief Thread specific helpers namespace
+   */
+  namespace thread {
+
+    /*!
+     * \brief A unit of work executed by the pool
+     */
+    typedef std::function<void()> task_t;
+
+    /*!
+     * \class work_stealing_deque
+     * \brief Lock-free work-stealing deque (Chase-Lev)
+     *
+     * The owner thread pushes and pops tasks at the bottom (LIFO, cache friendly); the other threads steal the oldest tasks
+     * from the top. Only steal() and the pop() of the last task synchronize with a compare-and-swap.
+     * \remark The storage grows on demand; the previous buffers are kept until the destruction of the deque because a thief
+     *         may still be reading them
+     */
+    class work_stealing_deque {
+      /*!
+       * \struct buffer_t
+       * \brief Circular buffer of tasks
+       */
+      struct buffer_t {
+        const int64_t mask;                                  /*!< The capacity minus one, the capacity is a power of 2 */
+        std::unique_ptr<std::atomic<task_t *>[]> slots;      /*!< The tasks */
+        explicit buffer_t(const int64_t p_capacity) : mask(p_capacity - 1), slots(new std::atomic<task_t *>[p_capacity]) { };
+        inline task_t * get(const int64_t p_index) const { return slots[p_index & mask].load(std::memory_order_relaxed); };
+        inline void put(const int64_t p_index, task_t * p_task) { slots[p_index & mask].store(p_task, std::memory_order_relaxed); };
+      }; // End of struct buffer_t
+
+      std::atomic<int64_t> _top;                /*!< Index of the oldest task, moved by the thieves */
+      char _padding[64 - sizeof(std::atomic<int64_t>)]; /*!< Keep _top and _bottom on distinct cache lines */
+      std::atomic<int64_t> _bottom;             /*!< Index of the next free slot, moved by the owner */
+      std::atomic<buffer_t *> _buffer;          /*!< The current buffer */
+      std::vector<std::unique_ptr<buffer_t> > _buffers; /*!< All the buffers allocated so far, owner side only */
+
+    public:
+      /*!
+       * \brief Creation ctor
+       * \param[in] p_capacity The initial capacity, rounded up to a power of 2. Default: 256
+       */
+      explicit work_stealing_deque(const size_t p_capacity = 256);
+      virtual ~work_stealing_deque() { };
+
+      /*!
+       * \brief Push a task at the bottom. Owner thread only
+       */
+      void push(task_t * p_task);
+      /*!
+       * \brief Pop the newest task. Owner thread only
+       * \return The task, nullptr if the deque is empty
+       */
+      task_t * pop();
+      /*!
+       * \brief Steal the oldest task. Any thread
+       * \return The task, nullptr if the deque is empty or if another thread won the race
+       */
+      task_t * steal();
+      /*!
+       * \brief Indicates if the deque looks empty. The result is a hint only when other threads access the deque
+       */
+      inline bool empty() const { return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed); };
+
+    private:
+      work_stealing_deque(const work_stealing_deque &) = delete;
+      work_stealing_deque & operator = (const work_stealing_deque &) = delete;
+    }; // End of class work_stealing_deque
+
+    /*!
+     * \class thread_pool
+     * \brief Work-stealing thread pool
+     *
+     * Each worker owns a work_stealing_deque: the tasks submitted by a worker (e.g. by a task splitting its work) are queued
+     * in its own deque without any lock, idle workers steal from the others. Tasks submitted by other threads go through a
+     * shared injection queue. Idle workers sleep on a condition variable, so an idle pool does not use any CPU.
+     * \code
+     * thread_pool & pool = thread_pool::get_instance();
+     * std::future<uint32_t> count = pool.submit([&]() { return count_frames(capture); });
+     * pool.parallel_for(0, samples.size(), [&](const size_t p_index) { filter(samples[p_index]); });
+     * std::clog << count.get() << std::endl;
+     * \endcode
+     * \remark A task waiting for another task shall use wait() instead of blocking on the future, so that the waiting worker
+     *         keeps executing tasks meanwhile
+     */
+    class thread_pool {
+      /*!
+       * \class worker
+       * \brief A worker thread of the pool
+       */
+      class worker : public runnable {
+        thread_pool & _pool;         /*!< The pool owning the worker */
+        const uint32_t _index;       /*!< The index of the worker in the pool */
+        work_stealing_deque _deque;  /*!< The tasks submitted by the worker itself */
+        uint32_t _victim;            /*!< State of the pseudo-random selection of the worker to steal from */
+
+      public:
+        worker(thread_pool & p_pool, const uint32_t p_index) : _pool(p_pool), _index(p_index), _deque(), _victim(p_index * 2654435761U + 1) { };
+        virtual ~worker() { };
+
+        inline const thread_pool & pool() const { return _pool; };
+        inline uint32_t index() const { return _index; };
+        inline work_stealing_deque & deque() { return _deque; };
+        /*!
+         * \brief Select the next worker to steal from (xorshift)
+         */
+        inline uint32_t next_victim() { _victim ^= _victim << 13; _victim ^= _victim >> 17; _victim ^= _victim << 5; return _victim; };
+
+      protected:
+        void run();
+      }; // End of class worker
+
+      std::vector<std::unique_ptr<worker> > _workers; /*!< The workers */
+      std::deque<task_t *> _injected;                /*!< Tasks submitted by threads outside of the pool, protected by _mutex */
+      std::atomic<size_t> _injected_size;            /*!< Size of _injected, read without lock by the idle workers */
+      std::mutex _mutex;                             /*!< Protects the injection queue and the sleep of the workers */
+      std::condition_variable _condition;            /*!< Signaled when a task is queued */
+      std::atomic<int64_t> _queued;                  /*!< Number of tasks queued, not yet taken */
+      std::atomic<uint32_t> _sleeping;               /*!< Number of workers waiting on _condition */
+      std::atomic<bool> _stopping;                   /*!< Set by the dtor */
+
+      static thread_local worker * _current;         /*!< The worker running in the calling thread, nullptr outside of any pool */
+      static std::unique_ptr<thread_pool> g_instance; /*!< The shared pool */
+
+    public:
+      /*!
+       * \brief Creation ctor, the workers are started immediately
+       * \param[in] p_workers The number of workers. Default: 0, one worker per CPU
+       * \param[in] p_pin Set to true to pin the worker i to the CPU i modulo the number of CPUs. Default: false
+       */
+      explicit thread_pool(const uint32_t p_workers = 0, const bool p_pin = false);
+      /*!
+       * \brief Default dtor. The tasks already queued are executed, then the workers are stopped
+       */
+      virtual ~thread_pool();
+
+      /*!
+       * \brief Returns the shared pool, one worker per CPU, created on first call
+       */
+      static thread_pool & get_instance();
+
+      inline uint32_t size() const { return static_cast<uint32_t>(_workers.size()); };
+      /*!
+       * \brief Returns the index of the worker running in the calling thread, -1 if it is not a worker of this pool
+       */
+      inline const int32_t current_worker() const { return ((_current != nullptr) && (&_current->pool() == this)) ? static_cast<int32_t>(_current->index()) : -1; };
+
+      /*!
+       * \brief Queue a task without any result
+       * \param[in] p_task The task. An exception thrown by the task is ignored
+       */
+      void post(const task_t & p_task);
+      /*!
+       * \brief Queue a task
+       * \param[in] p_task The callable to execute, taking no argument
+       * \return The future result of the task; it holds the exception thrown by the task, if any
+       */
+      template<typename F> std::future<typename std::result_of<F()>::type> submit(F p_task);
+      /*!
+       * \brief Wait for a future, executing the queued tasks meanwhile
+       * \param[in] p_future The future to wait for
+       */
+      template<typename R> void wait(const std::future<R> & p_future);
+      /*!
+       * \brief Execute p_body(i) for each i in [p_begin, p_end) and wait for the completion
+       *
+       * The range is split into chunks of p_grain indexes, picked up dynamically by the calling thread and the workers, so
+       * uneven chunks are balanced. The calling thread takes part in the work, parallel_for can be nested into tasks.
+       * \param[in] p_begin The first index
+       * \param[in] p_end The end of the range
+       * \param[in] p_body The callable to execute, taking a size_t index
+       * \param[in] p_grain The number of indexes of a chunk. Default: 0, about 8 chunks per thread
+       * \remark The first exception thrown by p_body is rethrown, the remaining chunks are skipped
+       */
+      template<typename F> void parallel_for(const size_t p_begin, const size_t p_end, F p_body, const size_t p_grain = 0);
+      /*!
+       * \brief Execute one queued task in the calling thread
+       * \return true if a task was executed, false if no task was found
+       */
+      const bool run_pending_task();
+
+    private:
+      thread_pool(const thread_pool &) = delete;
+      thread_pool & operator = (const thread_pool &) = delete;
+
+      void enqueue(task_t * p_task);
+      /*!
+       * \brief Take a task: from the own deque, then from the injection queue, then from another worker
+       * \param[in] p_worker The calling worker, nullptr outside of the pool
+       */
+      task_t * take(worker * p_worker);
+      void execute(task_t * p_task);
+      void worker_loop(worker & p_worker);
+    }; // End of class thread_pool
+
+  } // End of namespace thread
+
+} // End of namespace helpers
+
+#include "thread_pool.t.h"
+
+using namespace helpers::thread;
@@ -0,0 +1,97 @@
+/*!
+ * \file      thread_pool.t.h
+ * \brief     Template header file for the work-stealing thread pool.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <chrono>
+#include <thread>
+#include <exception>
+
+namespace helpers {
+
+  namespace thread {
+
+    template<typename F> std::future<typename std::result_of<F()>::type> thread_pool::submit(F p_task) {
+      typedef typename std::result_of<F()>::type result_t;
+
+      // std::function requires a copyable callable, std::packaged_task is move-only
+      std::shared_ptr<std::packaged_task<result_t()> > task = std::make_shared<std::packaged_task<result_t()> >(std::move(p_task));
+      std::future<result_t> result = task->get_future();
+      enqueue(new task_t([task]() { (*task)(); }));
+      return result;
+    }; // End of method submit
+
+    template<typename R> void thread_pool::wait(const std::future<R> & p_future) {
+      while (p_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!run_pending_task()) {
+          std::this_thread::yield();
+        }
+      } // End of 'while' statement
+    }; // End of method wait
+
+    template<typename F> void thread_pool::parallel_for(const size_t p_begin, const size_t p_end, F p_body, const size_t p_grain) {
+      if (p_begin >= p_end) {
+        return;
+      }
+
+      const size_t count = p_end - p_begin;
+      size_t grain = p_grain;
+      if (grain == 0) {
+        grain = count / (8 * (_workers.size() + 1));
+        if (grain == 0) {
+          grain = 1;
+        }
+      }
+      const size_t chunks = (count + grain - 1) / grain;
+      if ((chunks == 1) || _workers.empty()) {
+        for (size_t i = p_begin; i != p_end; i++) {
+          p_body(i);
+        } // End of 'for' statement
+        return;
+      }
+
+      // The state lives on the stack of the caller, which does not return before all the helpers completed
+      std::atomic<size_t> next(0);
+      std::atomic<size_t> completed(0);
+      std::atomic<bool> failed(false);
+      std::exception_ptr error;
+      std::function<void()> process = [&]() {
+        size_t chunk;
+        while ((chunk = next.fetch_add(1, std::memory_order_relaxed)) < chunks) {
+          const size_t first = p_begin + chunk * grain;
+          const size_t last = (p_end - first > grain) ? first + grain : p_end;
+          try {
+            for (size_t i = first; i != last; i++) {
+              p_body(i);
+            } // End of 'for' statement
+          } catch (...) {
+            if (!failed.exchange(true)) {
+              error = std::current_exception();
+            }
+            next.store(chunks, std::memory_order_relaxed); // Skip the remaining chunks
+          }
+        } // End of 'while' statement
+      };
+
+      const size_t spawned = (chunks - 1 < _workers.size()) ? chunks - 1 : _workers.size();
+      for (size_t i = 0; i < spawned; i++) {
+        enqueue(new task_t([&]() { process(); completed.fetch_add(1, std::memory_order_release); }));
+      } // End of 'for' statement
+      process();
+      while (completed.load(std::memory_order_acquire) != spawned) {
+        if (!run_pending_task()) {
+          std::this_thread::yield();
+        }
+      } // End of 'while' statement
+
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }; // End of method parallel_for
+
+  } // End of namespace thread
+
+} // End of namespace helpers
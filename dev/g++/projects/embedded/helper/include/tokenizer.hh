@@ -0,0 +1,118 @@
+/**
+ * \file      tokenizer.h
+ * \brief     Header file for the zero-allocation string tokenizer.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "string_ref.hh"
+
+namespace helpers {
+
+  /**
+   * \class tokenizer
+   * \brief Split a string into fields lazily, without copying or allocating
+   *
+   * Each field is a string_ref borrowing the input string:
+   * \code{.cpp}
+   *     tokenizer t(line, ",;");
+   *     for (string_ref field : t) { ... }
+   *
+   *     string_ref fields[8];
+   *     size_t n = tokenizer(line, ",").split(fields, 8);
+   * \endcode
+   * Fields are separated by any character of the delimiters set. Consecutive delimiters delimit empty fields unless p_skip_empty is set
+   * (e.g. to split on white spaces). When a quote character is set, a field starting with it ends at the matching quote and may contain
+   * delimiters, a doubled quote stands for one quote character (RFC 4180 CSV style). The quotes are not part of the field, use unquote()
+   * to replace the doubled quotes. A malformed quoted field, with characters between the closing quote and the next delimiter (e.g. "ab"cd),
+   * is returned verbatim, quotes included, so that no character is lost.
+   * \remark Up to 4 delimiters are searched 16 characters at a time (SSE2 on x86-64), a single delimiter uses memchr
+   */
+  class tokenizer {
+    const char * _position;   /*!< The first character of the next field */
+    const char * _end;        /*!< The end of the input string */
+    bool _done;               /*!< Set when the last field was returned */
+    char _quote;              /*!< The quote character, '\0' if the fields are not quoted */
+    bool _skip_empty;         /*!< Set to ignore the empty fields */
+    uint8_t _count;           /*!< The number of delimiters in _delimiters, 0 if there are more than 4 */
+    char _delimiters[4];      /*!< The delimiters, searched with SIMD instructions */
+    uint64_t _set[4];         /*!< The delimiters, as a 256-bit set */
+
+  public:
+    /**
+     * \class iterator
+     * \brief Input iterator over the remaining fields
+     */
+    class iterator {
+      tokenizer * _tokenizer; /*!< The tokenizer, nullptr once all the fields were read */
+      string_ref _field;      /*!< The current field */
+    public:
+      explicit iterator(tokenizer * p_tokenizer) : _tokenizer(p_tokenizer), _field() { };
+      inline const string_ref & operator* () const { return _field; };
+      inline const string_ref * operator-> () const { return &_field; };
+      inline iterator & operator++ () { if (!_tokenizer->next(_field)) { _tokenizer = nullptr; } return *this; };
+      inline bool operator== (const iterator & p_iterator) const { return _tokenizer == p_iterator._tokenizer; };
+      inline bool operator!= (const iterator & p_iterator) const { return _tokenizer != p_iterator._tokenizer; };
+    }; // End of class iterator
+
+    /**
+     * \brief Creation ctor
+     * \param[in] p_input The string to split. It shall outlive the tokenizer and the fields
+     * \param[in] p_delimiters The delimiter characters. Default: ','
+     * \param[in] p_quote The quote character, '\0' if the fields are not quoted. Default: '\0'
+     * \param[in] p_skip_empty Set to true to ignore the empty fields. Default: false
+     */
+    tokenizer(const string_ref & p_input, const char * p_delimiters = ",", const char p_quote = '\0', const bool p_skip_empty = false);
+
+    /**
+     * \brief Retrieve the next field
+     * \param[out] p_field The field, borrowing the input string
+     * \return true on success, false if there are no more fields
+     */
+    bool next(string_ref & p_field);
+
+    /**
+     * \brief Retrieve the next fields
+     * \param[out] p_fields The fields, borrowing the input string
+     * \param[in] p_max The maximum number of fields to retrieve
+     * \return The number of fields retrieved
+     */
+    size_t split(string_ref * p_fields, const size_t p_max);
+
+    /**
+     * \brief Retrieve the part of the input string not split yet
+     * \return The remaining characters, borrowing the input string
+     */
+    inline string_ref remaining() const { return _done ? string_ref(_end, 0) : string_ref(_position, _end - _position); };
+
+    inline iterator begin() { return ++iterator(this); };
+    inline iterator end() { return iterator(nullptr); };
+
+    /**
+     * \brief Find the first delimiter of a string
+     * \param[in] p_first The first character of the string
+     * \param[in] p_last The end of the string
+     * \return The first delimiter, p_last if there is none
+     */
+    const char * find_delimiter(const char * p_first, const char * p_last) const;
+
+    /**
+     * \brief Replace the doubled quotes of a quoted field
+     * \param[in] p_field The field
+     * \param[in] p_quote The quote character
+     * \param[inout] p_buffer The storage used if the field contains doubled quotes
+     * \return The field itself if it does not contain doubled quotes, a view on p_buffer otherwise
+     */
+    static string_ref unquote(const string_ref & p_field, const char p_quote, std::string & p_buffer);
+  }; // End of class tokenizer
+
+} // End of namespace helpers
+
+using namespace helpers;
@@ -0,0 +1,167 @@
+/*!
+ * \file      bit_stream.cpp
+ * \brief     Implementation file for the word-at-a-time bit reader/writer engine.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <algorithm>
+
+#include "bit_stream.hh"
+
+namespace helpers {
+
+  void bit_reader::open(const uint8_t * p_data, const uint32_t p_size, const bit_order p_order) {
+    _data = p_data;
+    _size = (p_data == nullptr) ? 0 : p_size;
+    _length = (_size + 7) / 8;
+    _order = p_order;
+    seek(0);
+  }
+
+  uint32_t bit_reader::read_bytes(uint8_t * p_buffer, const uint32_t p_bits) {
+    uint32_t bits = (p_bits < remaining()) ? p_bits : remaining();
+    uint32_t bytes = bits / 8;
+    uint32_t bits_remaining = bits % 8;
+
+    if ((_position % 8) == 0) { // Aligned: plain copy
+      std::memcpy(p_buffer, _data + _position / 8, bytes);
+      if (bits_remaining != 0) {
+        uint8_t last = _data[_position / 8 + bytes];
+        if (_order == bit_order::msb_first) {
+          p_buffer[bytes] = last & static_cast<uint8_t>(0xff << (8 - bits_remaining));
+        } else {
+          p_buffer[bytes] = last & static_cast<uint8_t>(0xff >> (8 - bits_remaining));
+        }
+      }
+      seek(_position + bits);
+      return bits;
+    }
+
+    // Unaligned: 7 bytes at a time
+    uint8_t * p = p_buffer;
+    uint64_t value;
+    while (bytes >= 7) {
+      value = extract(56);
+      if (_order == bit_order::msb_first) {
+        uint8_t chunk[8];
+        store_be64(chunk, value << 8);
+        std::memcpy(p, chunk, 7); // Exactly 7 bytes, the buffer may end here
+      } else {
+        for (uint32_t i = 0; i < 7; i++) {
+          p[i] = static_cast<uint8_t>(value >> (8 * i));
+        } // End of 'for' statement
+      }
+      p += 7;
+      bytes -= 7;
+    } // End of 'while' statement
+    uint32_t tail = bytes * 8 + bits_remaining;
+    if (tail != 0) {
+      value = extract(tail);
+      uint32_t tail_bytes = (tail + 7) / 8;
+      if (_order == bit_order::msb_first) {
+        value <<= 64 - tail; // Left-align
+        for (uint32_t i = 0; i < tail_bytes; i++) {
+          p[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+        } // End of 'for' statement
+      } else {
+        for (uint32_t i = 0; i < tail_bytes; i++) {
+          p[i] = static_cast<uint8_t>(value >> (8 * i));
+        } // End of 'for' statement
+      }
+    }
+
+    return bits;
+  }
+
+  uint32_t bit_reader::skip(const uint32_t p_bits) {
+    uint32_t bits = (p_bits < remaining()) ? p_bits : remaining();
+    if (bits <= _cached) {
+      if (_order == bit_order::msb_first) {
+        _cache <<= bits;
+      } else {
+        _cache >>= bits;
+      }
+      _cached -= bits;
+      _position += bits;
+    } else {
+      seek(_position + bits);
+    }
+    return bits;
+  }
+
+  const int32_t bit_reader::seek(const uint32_t p_position) {
+    if (p_position > _size) {
+      return -1;
+    }
+
+    _position = p_position & ~static_cast<uint32_t>(7);
+    _next = _position / 8;
+    _cache = 0;
+    _cached = 0;
+    if (_next < _length) {
+      refill();
+    }
+    extract(p_position % 8);
+
+    return 0;
+  }
+
+  uint32_t bit_writer::write_bytes(const uint8_t * p_buffer, const uint32_t p_bits) {
+    uint32_t bytes = p_bits / 8;
+    uint32_t bits_remaining = p_bits % 8;
+
+    if ((_pending % 8) == 0) { // Aligned: plain copy
+      drain();
+      _buffer.insert(_buffer.end(), p_buffer, p_buffer + bytes);
+    } else {
+      const uint8_t * p = p_buffer;
+      for ( ; bytes >= 4; bytes -= 4, p += 4) {
+        if (_order == bit_order::msb_first) {
+          append((static_cast<uint64_t>(p[0]) << 24) | (static_cast<uint64_t>(p[1]) << 16) | (static_cast<uint64_t>(p[2]) << 8) | p[3], 32);
+        } else {
+          append((static_cast<uint64_t>(p[3]) << 24) | (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[1]) << 8) | p[0], 32);
+        }
+      } // End of 'for' statement
+      for ( ; bytes != 0; bytes--, p++) {
+        append(*p, 8);
+      } // End of 'for' statement
+    }
+    if (bits_remaining != 0) {
+      uint8_t last = p_buffer[p_bits / 8];
+      if (_order == bit_order::msb_first) {
+        append(last >> (8 - bits_remaining), bits_remaining);
+      } else {
+        append(last, bits_remaining);
+      }
+    }
+
+    return p_bits;
+  }
+
+  void bit_writer::align() {
+    if ((_pending % 8) != 0) {
+      append(0, 8 - (_pending % 8));
+    }
+  }
+
+  const std::vector<uint8_t> & bit_writer::flush() {
+    align();
+    drain();
+    return _buffer;
+  }
+
+  void bit_writer::drain() {
+    while (_pending >= 8) {
+      if (_order == bit_order::msb_first) {
+        _buffer.push_back(static_cast<uint8_t>(_accumulator >> (_pending - 8)));
+      } else {
+        _buffer.push_back(static_cast<uint8_t>(_accumulator));
+        _accumulator >>= 8;
+      }
+      _pending -= 8;
+    } // End of 'while' statement
+  }
+
+} // End of namespace helpers
@@ -0,0 +1,398 @@
+/*!
+ * \file      checksum.cpp
+ * \brief     Implementation file for the checksum and CRC kernels.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstring>
+#include <atomic>
+
+#include "checksum.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHECKSUM_X86
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CHECKSUM_ARM_CRC
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CHECKSUM_LITTLE_ENDIAN
+#endif
+
+namespace helpers {
+
+  namespace checksum {
+
+    /*!
+     * \struct crc_tables
+     * \brief Lookup tables, built once. The CRC-32 ones are slicing-by-8 tables, the CRC-16 ones process two bytes per lookup
+     */
+    struct crc_tables {
+      uint32_t crc32c[8][256];
+      uint32_t crc32[8][256];
+      uint16_t crc16[2][256];
+      uint8_t crc8[256];
+
+      crc_tables() {
+        for (uint32_t i = 0; i < 256; i++) {
+          uint32_t c = i;
+          uint32_t d = i;
+          for (int j = 0; j < 8; j++) {
+            c = (c >> 1) ^ ((c & 1) ? 0x82f63b78 : 0);
+            d = (d >> 1) ^ ((d & 1) ? 0xedb88320 : 0);
+          } // End of 'for' statement
+          crc32c[0][i] = c;
+          crc32[0][i] = d;
+
+          uint16_t e = static_cast<uint16_t>(i << 8);
+          uint8_t f = static_cast<uint8_t>(i);
+          for (int j = 0; j < 8; j++) {
+            e = static_cast<uint16_t>((e << 1) ^ ((e & 0x8000) ? 0x1021 : 0));
+            f = static_cast<uint8_t>((f << 1) ^ ((f & 0x80) ? 0x07 : 0));
+          } // End of 'for' statement
+          crc16[0][i] = e;
+          crc8[i] = f;
+        } // End of 'for' statement
+        for (uint32_t i = 0; i < 256; i++) {
+          for (int k = 1; k < 8; k++) { // The CRC of the byte i followed by k null bytes
+            crc32c[k][i] = (crc32c[k - 1][i] >> 8) ^ crc32c[0][crc32c[k - 1][i] & 0xff];
+            crc32[k][i] = (crc32[k - 1][i] >> 8) ^ crc32[0][crc32[k - 1][i] & 0xff];
+          } // End of 'for' statement
+          crc16[1][i] = static_cast<uint16_t>((crc16[0][i] << 8) ^ crc16[0][crc16[0][i] >> 8]);
+        } // End of 'for' statement
+      };
+    }; // End of struct crc_tables
+
+    static const crc_tables & tables() {
+      static const crc_tables t;
+      return t;
+    }
+
+    /*!
+     * \brief Reflected CRC-32, slicing-by-8
+     * \param[in] p_crc The inverted CRC register
+     * \param[in] p_table The slicing-by-8 tables of the polynomial
+     */
+    static uint32_t crc32_slicing(uint32_t p_crc, const uint8_t * p_data, size_t p_length, const uint32_t p_table[8][256]) {
+#if defined(CHECKSUM_LITTLE_ENDIAN)
+      while (p_length >= 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p_data, sizeof(lo));
+        std::memcpy(&hi, p_data + 4, sizeof(hi));
+        lo ^= p_crc;
+        p_crc = p_table[7][lo & 0xff] ^ p_table[6][(lo >> 8) & 0xff] ^ p_table[5][(lo >> 16) & 0xff] ^ p_table[4][lo >> 24] ^
+                p_table[3][hi & 0xff] ^ p_table[2][(hi >> 8) & 0xff] ^ p_table[1][(hi >> 16) & 0xff] ^ p_table[0][hi >> 24];
+        p_data += 8;
+        p_length -= 8;
+      } // End of 'while' statement
+#endif
+      while (p_length-- != 0) {
+        p_crc = (p_crc >> 8) ^ p_table[0][(p_crc ^ *p_data++) & 0xff];
+      } // End of 'while' statement
+      return p_crc;
+    }
+
+    /*!
+     * \brief Set to false to use the table-driven code paths only
+     */
+    static std::atomic<bool> g_hardware(true);
+
+    void use_hardware(const bool p_enabled) {
+      g_hardware.store(p_enabled, std::memory_order_relaxed);
+    }
+
+#if defined(CHECKSUM_X86)
+
+    static bool has_sse42() {
+      static const bool supported = __builtin_cpu_supports("sse4.2");
+      return supported;
+    }
+
+    static bool has_pclmul() {
+      static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+      return supported;
+    }
+
+    __attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(uint32_t p_crc, const uint8_t * p_data, size_t p_length) {
+#if defined(__x86_64__)
+      uint64_t crc = p_crc;
+      while (p_length >= 32) { // Unrolled, the crc32 instruction has a 3 cycles latency and a 1 cycle throughput
+        uint64_t v[4];
+        std::memcpy(v, p_data, sizeof(v));
+        crc = _mm_crc32_u64(crc, v[0]);
+        crc = _mm_crc32_u64(crc, v[1]);
+        crc = _mm_crc32_u64(crc, v[2]);
+        crc = _mm_crc32_u64(crc, v[3]);
+        p_data += 32;
+        p_length -= 32;
+      } // End of 'while' statement
+      while (p_length >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p_data, sizeof(v));
+        crc = _mm_crc32_u64(crc, v);
+        p_data += 8;
+        p_length -= 8;
+      } // End of 'while' statement
+      p_crc = static_cast<uint32_t>(crc);
+#endif
+      while (p_length >= 4) {
+        uint32_t v;
+        std::memcpy(&v, p_data, sizeof(v));
+        p_crc = _mm_crc32_u32(p_crc, v);
+        p_data += 4;
+        p_length -= 4;
+      } // End of 'while' statement
+      while (p_length-- != 0) {
+        p_crc = _mm_crc32_u8(p_crc, *p_data++);
+      } // End of 'while' statement
+      return p_crc;
+    }
+
+    /*
+     * CRC-32 folding with carry-less multiplications, see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+     * Instruction" (Intel, 2009). Four 128-bit lanes are folded 64 bytes at a time, merged into one lane, then the 128-bit
+     * remainder is reduced to 32 bits with a Barrett reduction. The constants are x^n mod P(x) for the reflected polynomial
+     */
+    __attribute__((target("pclmul,sse4.1"))) static uint32_t crc32_pclmul(uint32_t p_crc, const uint8_t * p_data, size_t p_length) {
+      static const uint64_t k1k2[2] = { 0x0154442bd4, 0x01c6e41596 }; // x^(4*128+32), x^(4*128-32)
+      static const uint64_t k3k4[2] = { 0x01751997d0, 0x00ccaa009e }; // x^(128+32), x^(128-32)
+      static const uint64_t k5k0[2] = { 0x0163cd6124, 0x0000000000 }; // x^64
+      static const uint64_t poly[2] = { 0x01db710641, 0x01f7011641 }; // P(x), floor(x^64 / P(x))
+
+      __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data));
+      __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 16));
+      __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 32));
+      __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 48));
+      x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(p_crc)));
+      __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(k1k2));
+      p_data += 64;
+      p_length -= 64;
+
+      while (p_length >= 64) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x5), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data)));
+        x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k, 0x11), x6), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 16)));
+        x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k, 0x11), x7), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 32)));
+        x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k, 0x11), x8), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + 48)));
+        p_data += 64;
+        p_length -= 64;
+      } // End of 'while' statement
+
+      // Fold the four lanes into one
+      k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(k3k4));
+      x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x2);
+      x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x3);
+      x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x4);
+      while (p_length >= 16) {
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data)));
+        p_data += 16;
+        p_length -= 16;
+      } // End of 'while' statement
+
+      // Fold 128 bits to 64 bits
+      const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+      x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+      x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+      k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+      x2 = _mm_srli_si128(x1, 4);
+      x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x2);
+
+      // Barrett reduction to 32 bits
+      k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(poly));
+      x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+      x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+      x1 = _mm_xor_si128(x1, x2);
+      p_crc = static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+
+      return crc32_slicing(p_crc, p_data, p_length, tables().crc32); // Less than 16 bytes remaining
+    }
+
+#endif
+
+#if defined(CHECKSUM_ARM_CRC)
+
+    static uint32_t crc32c_arm(uint32_t p_crc, const uint8_t * p_data, size_t p_length) {
+      while (p_length >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p_data, sizeof(v));
+        p_crc = __crc32cd(p_crc, v);
+        p_data += 8;
+        p_length -= 8;
+      } // End of 'while' statement
+      while (p_length-- != 0) {
+        p_crc = __crc32cb(p_crc, *p_data++);
+      } // End of 'while' statement
+      return p_crc;
+    }
+
+    static uint32_t crc32_arm(uint32_t p_crc, const uint8_t * p_data, size_t p_length) {
+      while (p_length >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p_data, sizeof(v));
+        p_crc = __crc32d(p_crc, v);
+        p_data += 8;
+        p_length -= 8;
+      } // End of 'while' statement
+      while (p_length-- != 0) {
+        p_crc = __crc32b(p_crc, *p_data++);
+      } // End of 'while' statement
+      return p_crc;
+    }
+
+#endif
+
+    crc32c & crc32c::update(const uint8_t * p_data, const size_t p_length) {
+#if defined(CHECKSUM_X86)
+      if (has_sse42() && g_hardware.load(std::memory_order_relaxed)) {
+        _crc = crc32c_sse42(_crc, p_data, p_length);
+        return *this;
+      }
+#elif defined(CHECKSUM_ARM_CRC)
+      if (g_hardware.load(std::memory_order_relaxed)) {
+        _crc = crc32c_arm(_crc, p_data, p_length);
+        return *this;
+      }
+#endif
+      _crc = crc32_slicing(_crc, p_data, p_length, tables().crc32c);
+      return *this;
+    }
+
+    crc32 & crc32::update(const uint8_t * p_data, const size_t p_length) {
+#if defined(CHECKSUM_X86)
+      if ((p_length >= 64) && has_pclmul() && g_hardware.load(std::memory_order_relaxed)) {
+        _crc = crc32_pclmul(_crc, p_data, p_length);
+        return *this;
+      }
+#elif defined(CHECKSUM_ARM_CRC)
+      if (g_hardware.load(std::memory_order_relaxed)) {
+        _crc = crc32_arm(_crc, p_data, p_length);
+        return *this;
+      }
+#endif
+      _crc = crc32_slicing(_crc, p_data, p_length, tables().crc32);
+      return *this;
+    }
+
+    crc16_ccitt & crc16_ccitt::update(const uint8_t * p_data, const size_t p_length) {
+      const crc_tables & t = tables();
+      uint16_t crc = _crc;
+      size_t length = p_length;
+      while (length >= 2) {
+        const uint16_t x = crc ^ static_cast<uint16_t>((p_data[0] << 8) | p_data[1]);
+        crc = t.crc16[1][x >> 8] ^ t.crc16[0][x & 0xff];
+        p_data += 2;
+        length -= 2;
+      } // End of 'while' statement
+      if (length != 0) {
+        crc = static_cast<uint16_t>((crc << 8) ^ t.crc16[0][(crc >> 8) ^ *p_data]);
+      }
+      _crc = crc;
+      return *this;
+    }
+
+    crc8 & crc8::update(const uint8_t * p_data, const size_t p_length) {
+      const uint8_t * table = tables().crc8;
+      uint8_t crc = _crc;
+      for (size_t i = 0; i < p_length; i++) {
+        crc = table[crc ^ p_data[i]];
+      } // End of 'for' statement
+      _crc = crc;
+      return *this;
+    }
+
+    uint8_t xor8(const uint8_t * p_data, const size_t p_length, const uint8_t p_xor) {
+      size_t i = 0;
+      uint64_t word = 0;
+#if defined(__SSE2__) && defined(__x86_64__)
+      __m128i v = _mm_setzero_si128();
+      for ( ; i + 16 <= p_length; i += 16) {
+        v = _mm_xor_si128(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i)));
+      } // End of 'for' statement
+      word = static_cast<uint64_t>(_mm_cvtsi128_si64(v)) ^ static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v)));
+#endif
+      for ( ; i + 8 <= p_length; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p_data + i, sizeof(w));
+        word ^= w;
+      } // End of 'for' statement
+      word ^= word >> 32;
+      word ^= word >> 16;
+      word ^= word >> 8;
+      uint8_t result = p_xor ^ static_cast<uint8_t>(word);
+      for ( ; i < p_length; i++) {
+        result ^= p_data[i];
+      } // End of 'for' statement
+      return result;
+    }
+
+    uint8_t sum8(const uint8_t * p_data, const size_t p_length, const uint8_t p_sum) {
+      size_t i = 0;
+      uint64_t total = p_sum;
+#if defined(__SSE2__) && defined(__x86_64__)
+      __m128i v = _mm_setzero_si128();
+      const __m128i zero = _mm_setzero_si128();
+      for ( ; i + 16 <= p_length; i += 16) { // psadbw adds 8 bytes into each 64-bit lane
+        v = _mm_add_epi64(v, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + i)), zero));
+      } // End of 'for' statement
+      total += static_cast<uint64_t>(_mm_cvtsi128_si64(v)) + static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v)));
+#endif
+      // 16-bit lanes, flushed before they can overflow
+      const uint64_t mask = 0x00ff00ff00ff00ffULL;
+      while (i + 8 <= p_length) {
+        uint64_t lanes = 0;
+        for (uint32_t n = 0; (n < 128) && (i + 8 <= p_length); n++, i += 8) {
+          uint64_t w;
+          std::memcpy(&w, p_data + i, sizeof(w));
+          lanes += (w & mask) + ((w >> 8) & mask);
+        } // End of 'for' statement
+        lanes = (lanes & 0x0000ffff0000ffffULL) + ((lanes >> 16) & 0x0000ffff0000ffffULL);
+        total += (lanes & 0xffffffff) + (lanes >> 32);
+      } // End of 'while' statement
+      for ( ; i < p_length; i++) {
+        total += p_data[i];
+      } // End of 'for' statement
+      return static_cast<uint8_t>(total);
+    }
+
+    const int32_t verify_nmea(const char * p_sentence, const size_t p_length) {
+      if ((p_length < 4) || ((p_sentence[0] != '$') && (p_sentence[0] != '!'))) {
+        return -1;
+      }
+      const char * star = static_cast<const char *>(std::memchr(p_sentence, '*', p_length));
+      if (star == nullptr) { // The checksum field is optional in NMEA 0183
+        return 0;
+      } else if (star + 2 >= p_sentence + p_length) {
+        return -1;
+      }
+
+      uint8_t expected = 0;
+      for (int i = 1; i <= 2; i++) {
+        const char c = star[i];
+        uint8_t digit;
+        if ((c >= '0') && (c <= '9')) {
+          digit = c - '0';
+        } else if ((c >= 'A') && (c <= 'F')) {
+          digit = c - 'A' + 10;
+        } else if ((c >= 'a') && (c <= 'f')) {
+          digit = c - 'a' + 10;
+        } else {
+          return -1;
+        }
+        expected = static_cast<uint8_t>((expected << 4) | digit);
+      } // End of 'for' statement
+      const uint8_t * data = reinterpret_cast<const uint8_t *>(p_sentence) + 1;
+      return (xor8(data, static_cast<size_t>(star - p_sentence) - 1) == expected) ? 0 : -1;
+    }
+
+  } // End of namespace checksum
+
+} // End of namespace helpers
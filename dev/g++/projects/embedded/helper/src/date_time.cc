@@ -10,9 +10,13 @@
 #include <ctime>
 #include <array>
 #include <utility>
+#include <memory>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 
 #include "date_time.hh"
+#include "numeric.hh"
 
 namespace helpers {
 
@@ -33,6 +37,15 @@ namespace helpers {
     }
   };
 
+  /*!
+   * \brief Convert a matched group of digits, without the temporary string of std::stoi
+   */
+  static int submatch_to_int(const std::ssub_match & p_match) {
+    int value = 0;
+    parse_integer(&*p_match.first, &*p_match.first + p_match.length(), value);
+    return value;
+  }
+
   std::regex date_time::g_dt_regex("^(\\w{3})\\s+(\\w{3})\\s+(\\d{1,2})\\s+(\\d{2}):(\\d{2}):(\\d{2})\\s+(\\d{4})$");
 
   date_time::date_time() {
@@ -59,11 +72,11 @@ namespace helpers {
       _date_time.to_string.assign(match[index++]);
       _date_time.sday = match[index++];
       _date_time.date_time_tm.tm_mon = get_month(match[index++]);
-      _date_time.date_time_tm.tm_mday = std::stoi(match[index++]);
-      _date_time.date_time_tm.tm_hour = std::stoi(match[index++]);
-      _date_time.date_time_tm.tm_min = std::stoi(match[index++]);
-      _date_time.date_time_tm.tm_sec = std::stoi(match[index++]);
-      _date_time.date_time_tm.tm_year = std::stoi(match[index++]);
+      _date_time.date_time_tm.tm_mday = submatch_to_int(match[index++]);
+      _date_time.date_time_tm.tm_hour = submatch_to_int(match[index++]);
+      _date_time.date_time_tm.tm_min = submatch_to_int(match[index++]);
+      _date_time.date_time_tm.tm_sec = submatch_to_int(match[index++]);
+      _date_time.date_time_tm.tm_year = submatch_to_int(match[index++]);
       _date_time.date_time_tm.tm_isdst = -1; // Not used
     }
   } // End of method parse_date_time
@@ -76,4 +89,123 @@ namespace helpers {
     return 0;
   } // End of method get_month
 
+  /*!
+   * \brief Divisors of the nanoseconds for 0 to 9 sub-second digits
+   */
+  static const uint32_t g_subsecond_divisors[10] = { 1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+  /*!
+   * \brief English month abbreviations, %b and %h of strftime depend on the locale
+   */
+  static const char * const g_month_names[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+  timestamp_formatter::timestamp_formatter(const timestamp_format_t p_format, const uint32_t p_digits) : _pattern("%Y-%m-%dT%H:%M:%S"), _digits((p_digits > 9) ? 9 : p_digits), _utc(p_format == rfc3339), _zone((p_format == rfc3339) ? 0 : 1), _second(std::numeric_limits<time_t>::min()), _prefix_length(0), _suffix_length(0) {
+  }
+
+  timestamp_formatter::timestamp_formatter(const std::string & p_pattern, const uint32_t p_digits, const bool p_utc) : _pattern(p_pattern), _digits((p_digits > 9) ? 9 : p_digits), _utc(p_utc), _zone(-1), _second(std::numeric_limits<time_t>::min()), _prefix_length(0), _suffix_length(0) {
+  }
+
+  size_t timestamp_formatter::format(char * p_buffer, const size_t p_size, const uint64_t p_realtime) {
+    const time_t second = static_cast<time_t>(p_realtime / 1000000000ULL);
+    if (second != _second) { // Once per second
+      update(second);
+    }
+
+    const size_t length = _prefix_length + ((_digits == 0) ? 0 : 1 + _digits) + _suffix_length;
+    if (length >= p_size) {
+      return 0;
+    }
+    char * p = p_buffer;
+    std::memcpy(p, _prefix, _prefix_length);
+    p += _prefix_length;
+    if (_digits != 0) {
+      *p = '.';
+      uint32_t value = static_cast<uint32_t>(p_realtime % 1000000000ULL) / g_subsecond_divisors[_digits];
+      for (uint32_t i = _digits; i != 0; i--) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+      } // End of 'for' statement
+      p += 1 + _digits;
+    }
+    std::memcpy(p, _suffix, _suffix_length);
+    p[_suffix_length] = '\0';
+    return length;
+  } // End of method format
+
+  void timestamp_formatter::update(const time_t p_second) {
+    struct tm tm;
+    if (_utc) {
+      ::gmtime_r(&p_second, &tm);
+    } else {
+      ::localtime_r(&p_second, &tm);
+    }
+    // Replace the month abbreviations first, strftime would use the locale ones
+    std::string pattern;
+    pattern.reserve(_pattern.length());
+    for (size_t i = 0; i < _pattern.length(); i++) {
+      if ((_pattern[i] == '%') && (i + 1 < _pattern.length())) {
+        if ((_pattern[i + 1] == 'b') || (_pattern[i + 1] == 'h')) {
+          pattern += g_month_names[tm.tm_mon];
+        } else {
+          pattern.append(_pattern, i, 2); // Including "%%"
+        }
+        i += 1;
+      } else {
+        pattern += _pattern[i];
+      }
+    } // End of 'for' statement
+    _prefix_length = std::strftime(_prefix, sizeof(_prefix), pattern.c_str(), &tm);
+    if (_zone == 0) {
+      _suffix[0] = 'Z';
+      _suffix_length = 1;
+    } else if (_zone == 1) { // RFC 3339 offset: the strftime %z has no colon
+      const long offset = (tm.tm_gmtoff < 0) ? -tm.tm_gmtoff : tm.tm_gmtoff;
+      const long hours = offset / 3600;
+      const long minutes = (offset % 3600) / 60;
+      _suffix[0] = (tm.tm_gmtoff < 0) ? '-' : '+';
+      _suffix[1] = static_cast<char>('0' + (hours / 10) % 10);
+      _suffix[2] = static_cast<char>('0' + hours % 10);
+      _suffix[3] = ':';
+      _suffix[4] = static_cast<char>('0' + minutes / 10);
+      _suffix[5] = static_cast<char>('0' + minutes % 10);
+      _suffix_length = 6;
+    }
+    _second = p_second;
+  } // End of method update
+
+  uint64_t timestamp::monotonic_to_realtime(const uint64_t p_monotonic) {
+    static thread_local int64_t offset = 0;
+    static thread_local uint64_t measured = 0;
+    static thread_local bool valid = false;
+
+    const uint64_t now = monotonic(true);
+    if (!valid || (now - measured >= 1000000000ULL)) {
+      // Bracket the wall clock reading between two monotonic readings
+      const uint64_t before = monotonic();
+      const uint64_t wall = realtime();
+      const uint64_t after = monotonic();
+      offset = static_cast<int64_t>(wall - (before + (after - before) / 2));
+      measured = now;
+      valid = true;
+    }
+    return p_monotonic + offset;
+  } // End of method monotonic_to_realtime
+
+  size_t timestamp::format(char * p_buffer, const size_t p_size, const uint64_t p_realtime, const timestamp_format_t p_format, const uint32_t p_digits) {
+    static thread_local std::unique_ptr<timestamp_formatter> formatters[2][10];
+
+    const uint32_t format = (p_format == rfc3339) ? 1 : 0;
+    const uint32_t digits = (p_digits > 9) ? 9 : p_digits;
+    std::unique_ptr<timestamp_formatter> & formatter = formatters[format][digits];
+    if (!formatter) {
+      formatter.reset(new timestamp_formatter(p_format, digits));
+    }
+    return formatter->format(p_buffer, p_size, p_realtime);
+  } // End of method format
+
+  std::string timestamp::to_string(const uint64_t p_realtime, const timestamp_format_t p_format, const uint32_t p_digits) {
+    char buffer[64];
+    const size_t length = format(buffer, sizeof(buffer), p_realtime, p_format, p_digits);
+    return std::string(buffer, length);
+  } // End of method to_string
+
 } // End of namespace helpers
@@ -10,8 +10,10 @@
 #include <cstring>
 #include <cstdarg>
 #include <fstream>
+#include <sys/stat.h> // Used for stat
 
 #include "helper.hh"
+#include "mapped_file.hh"
 
 #define __LINE_LENGTH__ 93
 
@@ -90,6 +92,15 @@ namespace helpers {
   } // End of method helper::hexa_dump
 
   int helper::file_size(const std::string& p_file_name) {
+    struct stat st;
+    if (::stat(p_file_name.c_str(), &st) == -1) {
+      return -1;
+    }
+    if (S_ISREG(st.st_mode) && (st.st_size != 0)) {
+      return st.st_size;
+    }
+
+    // Non-regular or empty files (e.g. /proc, sysfs) do not report their size, use a stream as before
     std::ifstream is(p_file_name, std::ios::in | std::ios::binary | std::ios::ate);
     if (is.is_open()) {
       is.seekg(0, std::ios_base::end);
@@ -102,11 +113,19 @@ namespace helpers {
   }
 
   int helper::file_load(const std::string& p_file_name, std::vector<unsigned char>& p_buffer) {
-    std::ifstream is(p_file_name, std::ios::in | std::ios::binary | std::ios::ate);
+    struct stat st;
+    if ((::stat(p_file_name.c_str(), &st) == 0) && S_ISREG(st.st_mode) && (st.st_size != 0)) {
+      // Map the whole file and copy it once, instead of growing the buffer through a stream
+      mapped_file file(p_file_name, mapped_file::sequential, true);
+      if (file.is_open()) {
+        p_buffer.assign(file.data(), file.data() + file.size());
+        return p_buffer.size();
+      }
+    }
+
+    // Non-regular or empty files (e.g. /proc, sysfs) report a size of 0 but have a content, read them through a stream
+    std::ifstream is(p_file_name, std::ios::in | std::ios::binary);
     if (is.is_open()) {
-      is.seekg(0, is.end);
-      p_buffer.reserve(is.tellg());
-      is.seekg(0, is.beg);
       p_buffer.assign((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
       return p_buffer.size();
     }
@@ -0,0 +1,159 @@
+/*!
+ * \file      histogram.cpp
+ * \brief     Implementation file for the latency histograms.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "histogram.hh"
+
+namespace helpers {
+
+  /*!< Round-robin assignment of the shards to the threads */
+  static std::atomic<uint32_t> g_next_shard(0);
+
+  void log_linear_buckets::range(const size_t p_index, const uint32_t p_significant_bits, uint64_t & p_lowest, uint64_t & p_highest) {
+    const size_t exact = static_cast<size_t>(1) << p_significant_bits;
+    if (p_index < exact) {
+      p_lowest = p_highest = p_index;
+      return;
+    }
+    const size_t half = exact >> 1;
+    const size_t k = p_index - exact;
+    const uint32_t shift = static_cast<uint32_t>(k / half) + 1;
+    p_lowest = static_cast<uint64_t>(half + k % half) << shift;
+    p_highest = p_lowest + (static_cast<uint64_t>(1) << shift) - 1;
+  }
+
+  size_t log_linear_buckets::percentile(const uint64_t * p_counts, const size_t p_bucket_count, const uint64_t p_total, const double p_percentile) {
+    const double percentile = (p_percentile > 100.0) ? 100.0 : p_percentile;
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(p_total))));
+    uint64_t cumulated = 0;
+    for (size_t b = 0; b < p_bucket_count; b++) {
+      cumulated += p_counts[b];
+      if (cumulated >= target) {
+        return b;
+      }
+    } // End of 'for' statement
+    return p_bucket_count;
+  }
+
+  histogram::histogram(const uint64_t p_highest_value, const uint32_t p_significant_bits) :
+    _significant_bits((p_significant_bits < 2) ? 2 : ((p_significant_bits > 16) ? 16 : p_significant_bits)),
+    _highest_value((p_highest_value < (static_cast<uint64_t>(1) << _significant_bits)) ? (static_cast<uint64_t>(1) << _significant_bits) : p_highest_value),
+    _bucket_count(bucket_index(_highest_value) + 1),
+    _shards(new shard[shard_count]) {
+    for (uint32_t i = 0; i < shard_count; i++) {
+      _shards[i].counts.reset(new std::atomic<uint64_t>[_bucket_count]);
+    } // End of 'for' statement
+    reset();
+  }
+
+  void histogram::record(const uint64_t p_value, const uint64_t p_count) {
+    static thread_local uint32_t index = g_next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    shard & s = _shards[index];
+    s.counts[bucket_index(p_value)].fetch_add(p_count, std::memory_order_relaxed);
+    s.total.fetch_add(p_count, std::memory_order_relaxed);
+    s.sum.fetch_add(p_value * p_count, std::memory_order_relaxed);
+
+    uint64_t current = s.min.load(std::memory_order_relaxed);
+    while ((p_value < current) && !s.min.compare_exchange_weak(current, p_value, std::memory_order_relaxed)) {
+    } // End of 'while' statement
+    current = s.max.load(std::memory_order_relaxed);
+    while ((p_value > current) && !s.max.compare_exchange_weak(current, p_value, std::memory_order_relaxed)) {
+    } // End of 'while' statement
+  }
+
+  histogram::snapshot histogram::get_snapshot() const {
+    snapshot result;
+    result._histogram = this;
+    result._counts.assign(_bucket_count, 0);
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < shard_count; i++) {
+      const shard & s = _shards[i];
+      for (size_t b = 0; b < _bucket_count; b++) {
+        result._counts[b] += s.counts[b].load(std::memory_order_relaxed);
+      } // End of 'for' statement
+      result._total += s.total.load(std::memory_order_relaxed);
+      result._sum += static_cast<double>(s.sum.load(std::memory_order_relaxed));
+      min = std::min(min, s.min.load(std::memory_order_relaxed));
+      result._max = std::max(result._max, s.max.load(std::memory_order_relaxed));
+    } // End of 'for' statement
+    result._min = (result._total == 0) ? 0 : min;
+    return result;
+  }
+
+  void histogram::reset() {
+    for (uint32_t i = 0; i < shard_count; i++) {
+      shard & s = _shards[i];
+      for (size_t b = 0; b < _bucket_count; b++) {
+        s.counts[b].store(0, std::memory_order_relaxed);
+      } // End of 'for' statement
+      s.total.store(0, std::memory_order_relaxed);
+      s.sum.store(0, std::memory_order_relaxed);
+      s.min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+      s.max.store(0, std::memory_order_relaxed);
+    } // End of 'for' statement
+  }
+
+  uint64_t histogram::snapshot::percentile(const double p_percentile) const {
+    if (_total == 0) {
+      return 0;
+    } else if (p_percentile <= 0.0) {
+      return _min;
+    }
+
+    const size_t b = log_linear_buckets::percentile(_counts.data(), _counts.size(), _total, p_percentile);
+    if (b == _counts.size()) {
+      return _max;
+    }
+    uint64_t lowest, highest;
+    _histogram->bucket_range(b, lowest, highest);
+    return std::max(_min, std::min(_max, highest));
+  }
+
+  void histogram::snapshot::print_summary(std::ostream & p_os) const {
+    const std::ios_base::fmtflags flags = p_os.flags(); // Restored on return, the stream belongs to the caller
+    const std::streamsize precision = p_os.precision();
+    p_os << "count=" << _total
+         << " min=" << _min
+         << " mean=" << std::fixed << std::setprecision(1) << mean()
+         << " p50=" << percentile(50.0)
+         << " p90=" << percentile(90.0)
+         << " p99=" << percentile(99.0)
+         << " p99.9=" << percentile(99.9)
+         << " max=" << _max << std::endl;
+    p_os.flags(flags);
+    p_os.precision(precision);
+  }
+
+  void histogram::snapshot::print_distribution(std::ostream & p_os) const {
+    p_os << std::setw(16) << "value" << std::setw(12) << "percentile" << std::setw(16) << "count" << std::endl;
+    if (_total == 0) {
+      return;
+    }
+    const std::ios_base::fmtflags flags = p_os.flags();
+    const std::streamsize precision = p_os.precision();
+    uint64_t cumulated = 0;
+    for (size_t b = 0; b < _counts.size(); b++) {
+      if (_counts[b] == 0) {
+        continue;
+      }
+      cumulated += _counts[b];
+      uint64_t lowest, highest;
+      _histogram->bucket_range(b, lowest, highest);
+      p_os << std::setw(16) << std::max(_min, std::min(_max, highest))
+           << std::setw(12) << std::fixed << std::setprecision(4) << (100.0 * static_cast<double>(cumulated) / static_cast<double>(_total))
+           << std::setw(16) << cumulated << std::endl;
+    } // End of 'for' statement
+    p_os.flags(flags);
+    p_os.precision(precision);
+  }
+
+} // End of namespace helpers
@@ -0,0 +1,159 @@
+/*!
+ * \file      mapped_file.cpp
+ * \brief     Implementation file for the read-only memory-mapped files.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstring>
+
+#include <fcntl.h>    // Used for open
+#include <unistd.h>   // Used for close, sysconf
+#include <sys/mman.h> // Used for mmap, munmap, madvise
+#include <sys/stat.h> // Used for fstat
+
+#include "mapped_file.hh"
+
+namespace helpers {
+
+  mapped_file & mapped_file::operator = (mapped_file && p_file) {
+    if (this != &p_file) {
+      close();
+      _data = p_file._data;
+      _size = p_file._size;
+      _opened = p_file._opened;
+      p_file._data = nullptr;
+      p_file._size = 0;
+      p_file._opened = false;
+    }
+    return *this;
+  }
+
+  const int32_t mapped_file::open(const std::string & p_file_name, const access_t p_access, const bool p_populate) {
+    close();
+
+    int fd = ::open(p_file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      return -1;
+    }
+    struct stat st;
+    if ((::fstat(fd, &st) == -1) || !S_ISREG(st.st_mode)) {
+      ::close(fd);
+      return -1;
+    }
+    if (st.st_size != 0) { // An empty file cannot be mapped
+      void * data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE | (p_populate ? MAP_POPULATE : 0), fd, 0);
+      if (data == MAP_FAILED) {
+        ::close(fd);
+        return -1;
+      }
+      _data = static_cast<const uint8_t *>(data);
+      _size = st.st_size;
+    }
+    ::close(fd); // The mapping keeps a reference on the file
+    _opened = true;
+
+    advise(p_access);
+    return 0;
+  }
+
+  void mapped_file::close() {
+    if (_data != nullptr) {
+      ::munmap(const_cast<uint8_t *>(_data), _size);
+    }
+    _data = nullptr;
+    _size = 0;
+    _opened = false;
+  }
+
+  const int32_t mapped_file::advise(const access_t p_access, const size_t p_offset, const size_t p_length) const {
+    switch (p_access) {
+    case sequential:
+      return advise_range(p_offset, p_length, MADV_SEQUENTIAL);
+    case random_access:
+      return advise_range(p_offset, p_length, MADV_RANDOM);
+    default:
+      return advise_range(p_offset, p_length, MADV_NORMAL);
+    } // End of 'switch' statement
+  }
+
+  const int32_t mapped_file::prefetch(const size_t p_offset, const size_t p_length) const {
+    return advise_range(p_offset, p_length, MADV_WILLNEED);
+  }
+
+  const int32_t mapped_file::release(const size_t p_offset, const size_t p_length) const {
+    return advise_range(p_offset, p_length, MADV_DONTNEED);
+  }
+
+  const int32_t mapped_file::advise_range(const size_t p_offset, const size_t p_length, const int p_advice) const {
+    if ((_data == nullptr) || (p_offset >= _size)) {
+      return _opened ? 0 : -1;
+    }
+
+    // madvise() requires a page aligned address
+    static const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t offset = p_offset & ~(page_size - 1);
+    const size_t length = ((p_length < _size - p_offset) ? p_length : _size - p_offset) + (p_offset - offset);
+    return (::madvise(const_cast<uint8_t *>(_data) + offset, length, p_advice) == 0) ? 0 : -1;
+  }
+
+  mapped_file_reader::mapped_file_reader(const mapped_file & p_file, const size_t p_window, const bool p_release) :
+    _file(p_file), _position(0), _window((p_window == 0) ? 1 : p_window), _release(p_release), _prefetched(0), _released(0) {
+    advance(0);
+  }
+
+  size_t mapped_file_reader::read(byte_span & p_span, const size_t p_bytes) {
+    const size_t bytes = (p_bytes < remaining()) ? p_bytes : remaining();
+    p_span = byte_span(_file.data() + _position, bytes);
+    advance(bytes);
+    return bytes;
+  }
+
+  const int32_t mapped_file_reader::read_line(byte_span & p_line) {
+    if (eof()) {
+      return -1;
+    }
+
+    const uint8_t * begin = _file.data() + _position;
+    const uint8_t * end = static_cast<const uint8_t *>(std::memchr(begin, '\n', remaining()));
+    size_t length;
+    if (end == nullptr) { // Last line without end of line
+      length = remaining();
+      p_line = byte_span(begin, length);
+    } else {
+      length = end - begin + 1;
+      p_line = byte_span(begin, ((end != begin) && (*(end - 1) == '\r')) ? length - 2 : length - 1);
+    }
+    advance(length);
+    return 0;
+  }
+
+  void mapped_file_reader::seek(const size_t p_position) {
+    _position = (p_position < _file.size()) ? p_position : _file.size();
+    // Restart the read-ahead from the new position
+    _prefetched = _position;
+    if (_released > _position) {
+      _released = _position;
+    }
+    advance(0);
+  }
+
+  void mapped_file_reader::advance(const size_t p_bytes) {
+    _position += p_bytes;
+
+    // Keep one window read ahead, refreshed when half of it was consumed
+    if ((_prefetched < _file.size()) && (_position + _window / 2 >= _prefetched)) {
+      const size_t start = (_prefetched > _position) ? _prefetched : _position;
+      _prefetched = start + _window;
+      _file.prefetch(start, _window);
+    }
+    // Release what is more than one window behind
+    if (_release && (_position > _released + 2 * _window)) {
+      const size_t end = _position - _window;
+      _file.release(_released, end - _released);
+      _released = end;
+    }
+  }
+
+} // End of namespace helpers
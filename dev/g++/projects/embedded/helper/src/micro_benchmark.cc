@@ -0,0 +1,320 @@
+/*!
+ * \file      micro_benchmark.cpp
+ * \brief     Implementation file for the micro-benchmark harness.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "micro_benchmark.hh"
+#include "get_opt.hh"
+
+namespace helpers {
+
+  static const uint64_t g_perf_configs[perf_counters::counters_count] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+  static const char * g_perf_names[perf_counters::counters_count] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+
+  static inline uint64_t now_ns() {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+  }
+
+  static double median(std::vector<double> & p_values) {
+    std::sort(p_values.begin(), p_values.end());
+    const size_t middle = p_values.size() / 2;
+    return ((p_values.size() % 2) == 0) ? (p_values[middle - 1] + p_values[middle]) / 2.0 : p_values[middle];
+  }
+
+  perf_counters::perf_counters() : _leader(-1) {
+    for (uint32_t i = 0; i < counters_count; i++) {
+      struct perf_event_attr attributes;
+      std::memset(&attributes, 0x00, sizeof(attributes));
+      attributes.size = sizeof(attributes);
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.config = g_perf_configs[i];
+      attributes.disabled = (_leader == -1) ? 1 : 0; // The group is enabled through its leader
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      _fds[i] = static_cast<int>(::syscall(__NR_perf_event_open, &attributes, 0, -1, _leader, PERF_FLAG_FD_CLOEXEC));
+      if ((_fds[i] != -1) && (_leader == -1)) {
+        _leader = _fds[i];
+      }
+    } // End of 'for' statement
+  }
+
+  perf_counters::~perf_counters() {
+    for (uint32_t i = 0; i < counters_count; i++) {
+      if (_fds[i] != -1) {
+        ::close(_fds[i]);
+      }
+    } // End of 'for' statement
+  }
+
+  const char * perf_counters::name(const counter_t p_counter) {
+    return g_perf_names[p_counter];
+  }
+
+  const int32_t perf_counters::start() {
+    if (_leader == -1) {
+      return -1;
+    }
+    if ((::ioctl(_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) == -1) || (::ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1)) {
+      return -1;
+    }
+    return 0;
+  }
+
+  const int32_t perf_counters::stop(uint64_t (& p_values)[counters_count]) {
+    std::memset(p_values, 0x00, sizeof(p_values));
+    if ((_leader == -1) || (::ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) == -1)) {
+      return -1;
+    }
+    for (uint32_t i = 0; i < counters_count; i++) {
+      if ((_fds[i] != -1) && (::read(_fds[i], &p_values[i], sizeof(uint64_t)) != sizeof(uint64_t))) {
+        return -1;
+      }
+    } // End of 'for' statement
+    return 0;
+  }
+
+  micro_benchmark::micro_benchmark(const settings & p_settings) : _settings(p_settings), _counters() {
+    if (_settings.repetitions == 0) {
+      _settings.repetitions = 1;
+    }
+  }
+
+  const int32_t micro_benchmark::run(const std::string & p_name, const body_t & p_body, benchmark_result & p_result) {
+    p_result.name = p_name;
+    p_result.repetitions = _settings.repetitions;
+
+    // Calibrate the number of iterations to repetitions of min_time_ns at least
+    uint64_t iterations = _settings.iterations;
+    if (iterations == 0) {
+      iterations = 1;
+      while (true) {
+        const uint64_t start = now_ns();
+        p_body(iterations);
+        const uint64_t elapsed = now_ns() - start;
+        if ((elapsed >= _settings.min_time_ns) || (iterations >= (1ULL << 40))) {
+          break;
+        }
+        const uint64_t estimate = (elapsed == 0) ? iterations * 100 : static_cast<uint64_t>(1.2 * iterations * _settings.min_time_ns / elapsed);
+        iterations = std::max(iterations * 2, std::min(estimate, iterations * 100));
+      } // End of 'while' statement
+    }
+    p_result.iterations = iterations;
+
+    for (uint32_t i = 0; i < _settings.warmup; i++) {
+      p_body(iterations);
+    } // End of 'for' statement
+
+    std::vector<double> durations;
+    std::vector<double> counters[perf_counters::counters_count];
+    for (uint32_t r = 0; r < _settings.repetitions; r++) {
+      const bool counting = (_counters.start() == 0);
+      const uint64_t start = now_ns();
+      p_body(iterations);
+      const uint64_t elapsed = now_ns() - start;
+      uint64_t values[perf_counters::counters_count];
+      if (counting && (_counters.stop(values) == 0)) {
+        for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+          if (_counters.is_available(static_cast<perf_counters::counter_t>(c))) {
+            counters[c].push_back(static_cast<double>(values[c]) / iterations);
+          }
+        } // End of 'for' statement
+      }
+      durations.push_back(static_cast<double>(elapsed) / iterations);
+    } // End of 'for' statement
+
+    p_result.ns_min = *std::min_element(durations.cbegin(), durations.cend());
+    p_result.ns_max = *std::max_element(durations.cbegin(), durations.cend());
+    p_result.ns = median(durations);
+    for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+      p_result.counters[c] = counters[c].empty() ? -1.0 : median(counters[c]);
+    } // End of 'for' statement
+
+    return 0;
+  }
+
+  std::vector<std::pair<std::string, micro_benchmark::body_t> > & micro_benchmark::benchmarks() {
+    static std::vector<std::pair<std::string, body_t> > benchmarks; // Filled during the static initialisation
+    return benchmarks;
+  }
+
+  void micro_benchmark::register_benchmark(const std::string & p_name, const body_t & p_body) {
+    benchmarks().push_back(std::make_pair(p_name, p_body));
+  }
+
+  void micro_benchmark::to_json(const std::vector<benchmark_result> & p_results, std::ostream & p_os) {
+    p_os << "{\"benchmarks\":[" << std::endl;
+    for (std::vector<benchmark_result>::const_iterator it = p_results.cbegin(); it != p_results.cend(); ++it) {
+      p_os << "{\"name\":\"" << it->name << "\",\"iterations\":" << it->iterations << ",\"repetitions\":" << it->repetitions
+           << std::fixed << std::setprecision(3) << ",\"ns\":" << it->ns << ",\"ns_min\":" << it->ns_min << ",\"ns_max\":" << it->ns_max;
+      for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+        if (it->counters[c] >= 0.0) { // Not available otherwise
+          p_os << ",\"" << g_perf_names[c] << "\":" << it->counters[c];
+        }
+      } // End of 'for' statement
+      p_os << "}" << ((it + 1 == p_results.cend()) ? "" : ",") << std::endl;
+    } // End of 'for' statement
+    p_os << "]}" << std::endl;
+  }
+
+  /**
+   * \brief Returns the number following "p_key": in a JSON line, p_default if absent
+   */
+  static double json_number(const std::string & p_line, const std::string & p_key, const double p_default) {
+    const std::string key = "\"" + p_key + "\":";
+    const size_t position = p_line.find(key);
+    return (position == std::string::npos) ? p_default : std::strtod(p_line.c_str() + position + key.length(), nullptr);
+  }
+
+  const int32_t micro_benchmark::from_json(std::istream & p_is, std::vector<benchmark_result> & p_results) {
+    p_results.clear();
+    std::string line;
+    bool header = false;
+    while (std::getline(p_is, line)) {
+      if (line.find("{\"benchmarks\":[") == 0) {
+        header = true;
+        continue;
+      }
+      const size_t position = line.find("{\"name\":\"");
+      if (position == std::string::npos) {
+        continue;
+      }
+      const size_t end = line.find('"', position + 9);
+      if (end == std::string::npos) {
+        return -1;
+      }
+      benchmark_result result;
+      result.name = line.substr(position + 9, end - position - 9);
+      result.iterations = static_cast<uint64_t>(json_number(line, "iterations", 0.0));
+      result.repetitions = static_cast<uint32_t>(json_number(line, "repetitions", 0.0));
+      result.ns = json_number(line, "ns", -1.0);
+      result.ns_min = json_number(line, "ns_min", result.ns);
+      result.ns_max = json_number(line, "ns_max", result.ns);
+      for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+        result.counters[c] = json_number(line, g_perf_names[c], -1.0);
+      } // End of 'for' statement
+      if (result.ns < 0.0) {
+        return -1;
+      }
+      p_results.push_back(result);
+    } // End of 'while' statement
+    return header ? 0 : -1;
+  }
+
+  uint32_t micro_benchmark::compare(const std::vector<benchmark_result> & p_results, const std::vector<benchmark_result> & p_baseline, const double p_threshold, std::ostream & p_os) {
+    uint32_t regressions = 0;
+    p_os << std::left << std::setw(40) << "BENCHMARK" << std::right << std::setw(14) << "BASELINE ns" << std::setw(14) << "CURRENT ns" << std::setw(10) << "DELTA" << std::setw(12) << "CYCLES" << std::endl;
+    for (std::vector<benchmark_result>::const_iterator it = p_results.cbegin(); it != p_results.cend(); ++it) {
+      std::vector<benchmark_result>::const_iterator base = std::find_if(p_baseline.cbegin(), p_baseline.cend(), [it](const benchmark_result & p_result) { return p_result.name == it->name; });
+      p_os << std::left << std::setw(40) << it->name << std::right << std::fixed << std::setprecision(2);
+      if ((base == p_baseline.cend()) || (base->ns <= 0.0)) {
+        p_os << std::setw(14) << "-" << std::setw(14) << it->ns << std::setw(10) << "new" << std::endl;
+        continue;
+      }
+      const double delta = 100.0 * (it->ns - base->ns) / base->ns;
+      p_os << std::setw(14) << base->ns << std::setw(14) << it->ns << std::setw(9) << std::showpos << delta << std::noshowpos << "%";
+      if ((base->counters[perf_counters::cycles] > 0.0) && (it->counters[perf_counters::cycles] >= 0.0)) { // Less noisy than the durations
+        p_os << std::setw(11) << std::showpos << 100.0 * (it->counters[perf_counters::cycles] - base->counters[perf_counters::cycles]) / base->counters[perf_counters::cycles] << std::noshowpos << "%";
+      } else {
+        p_os << std::setw(12) << "-";
+      }
+      if (delta > p_threshold) {
+        p_os << "  REGRESSION";
+        regressions += 1;
+      }
+      p_os << std::endl;
+    } // End of 'for' statement
+    return regressions;
+  }
+
+  int micro_benchmark::main(int p_argc, char ** p_argv) {
+    std::string filter, output, baseline_file;
+    double threshold;
+    settings s;
+    try {
+      get_opt::get_opt opt(p_argc, const_cast<const char **>(p_argv));
+      opt >> get_opt::option('f', "filter", filter, "");
+      opt >> get_opt::option('w', "warmup", s.warmup, s.warmup);
+      opt >> get_opt::option('r', "repetitions", s.repetitions, s.repetitions);
+      opt >> get_opt::option('n', "iterations", s.iterations, s.iterations);
+      opt >> get_opt::option('o', "output", output, "");
+      opt >> get_opt::option('b', "baseline", baseline_file, "");
+      opt >> get_opt::option('t', "threshold", threshold, 5.0);
+    } catch (get_opt::get_opt_ex & e) {
+      std::cerr << "Usage: " << p_argv[0] << " [-f <filter>] [-w <warm-up repetitions>] [-r <repetitions>] [-n <iterations>] [-o <JSON file>|-] [-b <baseline JSON file>] [-t <threshold %>]" << std::endl;
+      return -1;
+    }
+
+    std::vector<benchmark_result> baseline;
+    if (!baseline_file.empty()) {
+      std::ifstream is(baseline_file);
+      if (!is.is_open() || (from_json(is, baseline) == -1)) {
+        std::cerr << p_argv[0] << ": cannot read baseline " << baseline_file << std::endl;
+        return -1;
+      }
+    }
+
+    micro_benchmark bench(s);
+    if (!bench.has_counters()) {
+      std::clog << "Hardware counters not available, durations only" << std::endl;
+    }
+    std::clog << std::left << std::setw(40) << "BENCHMARK" << std::right << std::setw(12) << "ITERATIONS" << std::setw(12) << "ns" << std::setw(12) << "min ns"
+              << std::setw(12) << "cycles" << std::setw(12) << "instr." << std::setw(12) << "cache miss" << std::setw(12) << "br. miss" << std::endl;
+    std::vector<benchmark_result> results;
+    for (std::vector<std::pair<std::string, body_t> >::const_iterator it = benchmarks().cbegin(); it != benchmarks().cend(); ++it) {
+      if (!filter.empty() && (it->first.find(filter) == std::string::npos)) {
+        continue;
+      }
+      benchmark_result result;
+      bench.run(it->first, it->second, result);
+      std::clog << std::left << std::setw(40) << result.name << std::right << std::setw(12) << result.iterations << std::fixed << std::setprecision(2)
+                << std::setw(12) << result.ns << std::setw(12) << result.ns_min;
+      for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+        if (result.counters[c] < 0.0) {
+          std::clog << std::setw(12) << "-";
+        } else {
+          std::clog << std::setw(12) << result.counters[c];
+        }
+      } // End of 'for' statement
+      std::clog << std::endl;
+      results.push_back(result);
+    } // End of 'for' statement
+
+    if (output == "-") {
+      to_json(results, std::cout);
+    } else if (!output.empty()) {
+      std::ofstream os(output);
+      to_json(results, os);
+      if (!os.good()) {
+        std::cerr << p_argv[0] << ": cannot write " << output << std::endl;
+        return -1;
+      }
+    }
+
+    if (!baseline_file.empty()) {
+      std::clog << std::endl;
+      const uint32_t regressions = compare(results, baseline, threshold, std::clog);
+      std::clog << regressions << " regression(s) above " << threshold << "%" << std::endl;
+      return (regressions == 0) ? 0 : 1;
+    }
+    return 0;
+  }
+
+} // End of namespace helpers
@@ -11,11 +11,10 @@
 #include <algorithm>
 
 #include "obstream.hh"
+#include "bit_stream.hh"
 
 namespace helpers {
   
-  uint8_t obstream::g_masks[] = { 0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f, 0xff };
-    
   obstream::obstream(const uint32_t p_capacity) : _bits_index(0), _buffer(p_capacity, 0x00), _state(std::ios_base::iostate::_S_goodbit) {
   } // End of default ctor
   
@@ -37,141 +36,72 @@ namespace helpers {
   } // End of dtor
   
   uint32_t obstream::write_bits(const std::vector<uint8_t> & p_buffer, const uint32_t p_bits_to_write) {
-    //std::clog << std::dec << ">>> write_bits: " << p_bits_to_write << std::endl;
-
     // Sanity check
-    if (p_bits_to_write == 0) { // No bits were write
-      //std::clog << "write_bits: No bits to write" << std::endl;
+    if ((p_bits_to_write == 0) || p_buffer.empty()) { // No bits were write
       return 0;
     } 
     
     // Calculate the number of bits to write
     uint32_t bits_to_write = (p_bits_to_write > (p_buffer.size() * (8 * sizeof(uint8_t)))) ? p_buffer.size() * (8 * sizeof(uint8_t)) : p_bits_to_write;
-    //std::clog << "bits_to_write= " << bits_to_write << std::endl;
-    
-    // Calculate the index of the next bits to write in bytes and bits
-    //std::clog << "_bits_index=" << _bits_index << std::endl;
-    uint32_t bits_index_in_bytes = _bits_index / (8 * sizeof(uint8_t));
-    uint8_t bits_index_in_bits = _bits_index % (8 * sizeof(uint8_t));
+    if (bits_to_write < (8 * sizeof(uint8_t))) { // Less than one byte, the bits are right-aligned
+      put(p_buffer[p_buffer.size() - 1], bits_to_write);
+      return bits_to_write;
+    }
 
-    // Calculate the number of bytes and bits to write
+    // The bits are left-aligned
     uint32_t bytes_to_write = bits_to_write / (8 * sizeof(uint8_t));
     uint8_t bits_remaining = bits_to_write % (8 * sizeof(uint8_t));
-    
-    //std::clog << "bits_index_in_bytes=" << bits_index_in_bytes << std::endl << "bits_index_in_bits=" << (uint32_t)bits_index_in_bits << std::endl << "bytes_to_write=" << bytes_to_write << std::endl << "bits_remaining=" << (uint32_t)bits_remaining << std::endl << "Capacity:" << _buffer.capacity() << std::endl;
-
-    // Allocate memory
-    if (_buffer.capacity() < (bits_index_in_bytes + bytes_to_write + 1)) {
-      _buffer.reserve((bits_index_in_bytes + bytes_to_write + 2));
-      //std::clog << "Increased capacity:" << _buffer.capacity() << std::endl;
-    }
-    
-    if (bytes_to_write != 0) {
-      if (bits_index_in_bits == 0) { // There is no left bits to write first
-        // Copy the bytes
-	//std::clog << "# bytes to copy(1)=" << bytes_to_write << std::endl;
-	std::copy(
-                  p_buffer.cbegin(),
-                  p_buffer.cend(),
-                  _buffer.begin() + bits_index_in_bytes
-                  );
-	//std::clog << std::dec << "_buffer size(1)=" << _buffer.size() << std::endl;	
-
-        // Update current bits index
-        _bits_index += bytes_to_write * (8 * sizeof(uint8_t));
-	//std::clog << std::dec << "_bits_index(1)=" << _bits_index << std::endl;	
-	// Re-alculate the index of the next bit to read in bytes and bits
-	bits_index_in_bytes = _bits_index / (8 * sizeof(uint8_t));
-	bits_index_in_bits = _bits_index % (8 * sizeof(uint8_t));
-	//std::clog << "bits_index_in_bytes(1)=" << (uint32_t)bits_index_in_bytes << std::endl << "bits_index_in_bits(3)=" << (uint32_t)bits_index_in_bits << std::endl;
-      } else { // Some bits shall be write first
-	//std::clog << "### Some bits shall be write first" << std::endl;
+    if ((_bits_index % (8 * sizeof(uint8_t))) == 0) { // There is no left bits to write first, copy the bytes
+      uint32_t bits_index_in_bytes = _bits_index / (8 * sizeof(uint8_t));
+      if (_buffer.size() < (bits_index_in_bytes + bytes_to_write + 1)) {
+        _buffer.resize(std::max(static_cast<size_t>(bits_index_in_bytes + bytes_to_write + 1), 2 * _buffer.size()), 0x00);
       }
+      std::copy(p_buffer.cbegin(), p_buffer.cbegin() + bytes_to_write, _buffer.begin() + bits_index_in_bytes);
+      _bits_index += bytes_to_write * (8 * sizeof(uint8_t));
+    } else { // Some bits shall be write first, write 7 bytes at a time
+      bit_reader reader(p_buffer.data(), bytes_to_write * (8 * sizeof(uint8_t)));
+      uint64_t value;
+      uint32_t bits;
+      while ((bits = reader.read(value, 56)) != 0) {
+        put(value, bits);
+      } // End of 'while' statement
     }
-    
     if (bits_remaining != 0) {
-      //std::clog << "g_masks[" << (uint32_t)bits_remaining << "](3)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)g_masks[bits_remaining - 1] << std::dec << std::endl << "Shift(3)=" << ((8 * sizeof(uint8_t)) - bits_index_in_bits - bits_remaining) << std::endl << "mask(3):" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)g_masks[bits_remaining - 1] << std::endl << "value(3):" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)p_buffer[p_buffer.size() - 1] << std::dec << std::endl;
-
-      uint8_t bits_to_shift = (8 * sizeof(uint8_t)) - bits_index_in_bits;
-      //std::clog << "bits_to_shift(3.1)=" << (uint32_t)bits_to_shift << std::endl;
-      if (bits_to_shift < bits_remaining) {
-	// Update first _bit_index
-	_bits_index += bits_remaining;
-	//std::clog << "_bits_index(3.1)=" << (uint32_t)_bits_index << std::endl;
-	// Write the left bits
-	_buffer[bits_index_in_bytes] |= (p_buffer[p_buffer.size() - 1] & g_masks[bits_remaining - 1]) >> (bits_remaining - bits_to_shift);
-	//std::clog << "_buffer[" << bits_index_in_bytes << "](3.1)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes] << std::dec << std::endl;
-	bits_remaining -= bits_to_shift;
-	//std::clog << "bits_remaining(3)=" << (uint32_t)bits_remaining << std::endl;
-	// Write the right bits
-	_buffer[bits_index_in_bytes + 1] = (p_buffer[p_buffer.size() - 1] & g_masks[bits_remaining - 1]) << ((8 * sizeof(uint8_t)) - bits_remaining);
-	//std::clog << "_buffer[" << bits_index_in_bytes + 1 << "](3.1)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes + 1] << std::dec << std::endl;
-      } else { // Write the right bits
-	_buffer[bits_index_in_bytes] |= (p_buffer[p_buffer.size() - 1] & g_masks[bits_remaining - 1]) << ((8 * sizeof(uint8_t)) - bits_index_in_bits - bits_remaining);
-	//std::clog << "_buffer[" << bits_index_in_bytes << "](3.2)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes] << std::dec << std::endl;
-	_bits_index += bits_remaining;
-	//std::clog << "_bits_index(3.2)=" << (uint32_t)_bits_index << std::endl;
-      }
+      put(p_buffer[bytes_to_write] >> ((8 * sizeof(uint8_t)) - bits_remaining), bits_remaining);
     }
 
-    //std::clog << "<<< write_bits " << bits_to_write << std::endl;
     return bits_to_write;
   } // End of method write_bits
   
   uint32_t obstream::write_bits(const uint8_t p_bits, const uint32_t p_bits_to_write) {
-    //std::clog << std::dec << ">>> write_bits(uint8_t): " << p_bits_to_write << std::endl;
-    
-    // Sanity check
-    if (p_bits_to_write == 0) { // No bits were write
-      //std::clog << "write_bits: No bits to write" << std::endl;
-      return 0;
-    }
-    
     // Calculate the number of bits to write
     uint32_t bits_to_write = (p_bits_to_write > (8 * sizeof(uint8_t))) ? 8 * sizeof(uint8_t) : p_bits_to_write;
-    
-    // Calculate the index of the next bits to write in bytes and bits
-    //std::clog << "_bits_index=" << _bits_index << std::endl;
-    uint32_t bits_index_in_bytes = _bits_index / (8 * sizeof(uint8_t));
-    uint8_t bits_index_in_bits = _bits_index % (8 * sizeof(uint8_t));
-    
-    //std::clog << "bits_to_write= " << bits_to_write << std::endl << "bits_index_in_bytes=" << bits_index_in_bytes << std::endl << "bits_index_in_bits=" << (uint32_t)bits_index_in_bits << std::endl << "Capacity:" << _buffer.capacity() << std::endl;
-    
-    // Allocate memory
-    if (_buffer.capacity() < (bits_index_in_bytes + 1)) {
-      _buffer.reserve((bits_index_in_bytes + 1));
-      //std::clog << "Increased capacity:" << _buffer.capacity() << std::endl;
-    }
-    
-    //std::clog << "g_masks[" << (uint32_t)bits_to_write << "]=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)g_masks[bits_to_write - 1] << std::dec << std::endl << "Shift=" << ((8 * sizeof(uint8_t)) - bits_index_in_bits - bits_to_write) << std::endl << "mask:" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)g_masks[bits_to_write - 1] << std::endl << "value:" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)p_bits << std::dec << std::endl;
-    uint8_t bits_to_shift = (8 * sizeof(uint8_t)) - bits_index_in_bits;
-    //std::clog << "bits_to_shift:" << (uint32_t)bits_to_shift << std::endl;
-    if (bits_to_shift < bits_to_write) {
-      // Update first _bit_index
-      _bits_index += bits_to_write;
-      //std::clog << "_bits_index(1)=" << (uint32_t)_bits_index << std::endl;
-      // Write the left bits
-      _buffer[bits_index_in_bytes] |= (p_bits & g_masks[bits_to_write - 1]) >> (bits_to_write - bits_to_shift);
-      //std::clog << "_buffer[" << bits_index_in_bytes << "](1)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes] << std::dec << std::endl;
-      bits_to_write -= bits_to_shift;
-      //std::clog << "bits_to_write(1)=" << (uint32_t)bits_to_write << std::endl;
-      // Write the right bits
-      _buffer[bits_index_in_bytes + 1] = (p_bits & g_masks[bits_to_write - 1]) << ((8 * sizeof(uint8_t)) - bits_to_write);
-      //std::clog << "_buffer[" << bits_index_in_bytes + 1 << "](1)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes + 1] << std::dec << std::endl;
-    } else { // Write the right bits
-      if ((bits_to_write == 8) && (bits_index_in_bits == 0)) { // Erase the previous value
-	_buffer[bits_index_in_bytes] = p_bits;
-      } else { // Need a mask to keep already set bits
-	_buffer[bits_index_in_bytes] |= (p_bits & g_masks[bits_to_write - 1]) << ((8 * sizeof(uint8_t)) - bits_index_in_bits - bits_to_write);
-      }
-      //std::clog << "_buffer[" << bits_index_in_bytes << "](2)=" << std::hex << std::setw(2) << std::setfill('0') << (uint32_t)_buffer[bits_index_in_bytes] << std::dec << std::endl;
-      _bits_index += bits_to_write;
-      //std::clog << "_bits_index=" << (uint32_t)_bits_index << std::endl;
-    }
-      
-    //std::clog << "<<< write_bits(uint8_t) " << bits_to_write << std::endl;
+    put(p_bits, bits_to_write);
     return bits_to_write;
   } // End of method write_bits
+
+  void obstream::put(const uint64_t p_value, const uint32_t p_bits_to_write) {
+    if (p_bits_to_write == 0) {
+      return;
+    } else if (p_bits_to_write > 56) { // Would span 9 bytes
+      put(p_value >> 32, p_bits_to_write - 32);
+      put(p_value, 32);
+      return;
+    }
+
+    uint32_t bits_index_in_bytes = _bits_index / (8 * sizeof(uint8_t));
+    uint32_t shift = 64 - (_bits_index % (8 * sizeof(uint8_t))) - p_bits_to_write;
+    // Allocate memory, with enough room for a 8-byte store
+    if (_buffer.size() < (bits_index_in_bytes + sizeof(uint64_t))) {
+      _buffer.resize(std::max(static_cast<size_t>(bits_index_in_bytes + sizeof(uint64_t)), 2 * _buffer.size()), 0x00);
+    }
+
+    // Merge the bits
+    uint64_t mask = ((static_cast<uint64_t>(1) << p_bits_to_write) - 1) << shift;
+    uint8_t * p = _buffer.data() + bits_index_in_bytes;
+    store_be64(p, (load_be64(p) & ~mask) | ((p_value << shift) & mask));
+    _bits_index += p_bits_to_write;
+  } // End of method put
   
   uint32_t obstream::seekp(const uint32_t p_position) {
     //std::clog << std::dec << ">>> seekp(1): " << p_position << std::endl;
@@ -0,0 +1,77 @@
+/**
+ * \file      ring_buffer.cpp
+ * \brief     Implementation file for the lock-free bounded ring buffers.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+#include <poll.h>           // Used for poll
+#include <unistd.h>         // Used for read, write, close, syscall
+#include <sys/eventfd.h>    // Used for eventfd
+#include <sys/syscall.h>    // Used for SYS_futex
+#include <linux/futex.h>    // Used for FUTEX_WAIT, FUTEX_WAKE
+
+#include "ring_buffer.hh"
+
+namespace helpers {
+
+  const int32_t ring_notifier::open(ring_event * p_event, const ring_wait_t p_mode, const bool p_shared) {
+    close();
+
+    _event = p_event;
+    _mode = p_mode;
+    _shared = p_shared;
+    if (_mode == ring_wait_t::eventfd) {
+      if ((_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1) {
+        _mode = ring_wait_t::futex;
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  void ring_notifier::close() {
+    if (_fd != -1) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+  void ring_notifier::wake() {
+    if (_fd != -1) {
+      if (_event->waiters.exchange(0, std::memory_order_relaxed) != 0) { // Once per arm()
+        const uint64_t value = 1;
+        while ((::write(_fd, &value, sizeof(value)) == -1) && (errno == EINTR));
+      }
+      return;
+    }
+
+    _event->sequence.fetch_add(1, std::memory_order_relaxed);
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_event->sequence), _shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+  }
+
+  void ring_notifier::sleep(const uint32_t p_sequence, const int32_t p_timeout) {
+    if (_fd != -1) {
+      struct pollfd fd = { _fd, POLLIN, 0 };
+      if (::poll(&fd, 1, p_timeout) > 0) {
+        uint64_t value;
+        while ((::read(_fd, &value, sizeof(value)) == -1) && (errno == EINTR)); // Reset the counter. EAGAIN if it was already reset, the caller checks its condition again
+      }
+      return;
+    }
+
+    struct timespec timeout;
+    if (p_timeout >= 0) {
+      timeout.tv_sec = p_timeout / 1000;
+      timeout.tv_nsec = (p_timeout % 1000) * 1000000L;
+    }
+    // Returns immediately if the sequence already changed
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_event->sequence), _shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, p_sequence, (p_timeout >= 0) ? &timeout : nullptr, nullptr, 0);
+  }
+
+} // End of namespace helpers
@@ -0,0 +1,148 @@
+/*!
+ * \file      runnable.cpp
+ * \brief     Implementation file for the runnable helper library.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <future>
+#include <functional>
+#include <algorithm>
+#include <system_error>
+#include <cstring>
+
+#include <alloca.h>
+#include <limits.h>     // Used for PTHREAD_STACK_MIN
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>   // Used for mlockall
+
+#include "runnable.hh"
+
+namespace helpers {
+
+  namespace thread {
+
+    /*!
+     * \brief Entry point of the threads started with settings
+     * \param[in] p_body The thread body, released once it returns
+     */
+    static void * start_routine(void * p_body) {
+      std::unique_ptr<std::function<void()> > body(static_cast<std::function<void()> *>(p_body));
+      (*body)();
+      return nullptr;
+    }
+
+    void runnable::start() {
+      _failures = 0;
+      if (_config.is_default()) {
+        _thread.reset(new std::thread(std::ref(*this)));
+        return;
+      }
+
+      std::promise<uint32_t> applied;
+      std::future<uint32_t> result = applied.get_future();
+      std::unique_ptr<std::function<void()> > body(new std::function<void()>([this, &applied]() {
+            applied.set_value(apply_config());
+            run();
+          }));
+      // std::thread has no attributes: the thread is created with its own ones, the defaults of the process are left unchanged
+      uint32_t failures = 0;
+      pthread_attr_t attributes;
+      int result_code = ::pthread_attr_init(&attributes);
+      if (result_code != 0) {
+        throw std::system_error(result_code, std::generic_category(), "runnable::start");
+      }
+      if (_config.stack_size != 0) {
+        const size_t stack_size = (_config.stack_size < static_cast<size_t>(PTHREAD_STACK_MIN)) ? static_cast<size_t>(PTHREAD_STACK_MIN) : _config.stack_size;
+        if (::pthread_attr_setstacksize(&attributes, stack_size) != 0) {
+          failures |= thread_config::stack;
+        }
+      }
+      result_code = ::pthread_create(&_handle, &attributes, start_routine, body.get());
+      ::pthread_attr_destroy(&attributes);
+      if (result_code != 0) {
+        throw std::system_error(result_code, std::generic_category(), "runnable::start");
+      }
+      body.release(); // Owned by the new thread
+      _has_handle = true;
+      _failures = failures | result.get();
+    }
+
+    void runnable::stop() {
+      _running = false;
+      if (_has_handle) {
+        ::pthread_join(_handle, nullptr);
+        _has_handle = false;
+      } else {
+        _thread->join();
+        _thread.reset(nullptr);
+      }
+    }
+
+    uint32_t runnable::apply_config() {
+      uint32_t failures = 0;
+
+      if ((_config.cpus != 0) || !_config.cpu_list.empty()) {
+        uint32_t count = 64; // Sized for the CPUs of the list, CPU_SETSIZE may be too small
+        for (std::vector<uint32_t>::const_iterator it = _config.cpu_list.begin(); it != _config.cpu_list.end(); ++it) {
+          count = std::max(count, *it + 1);
+        } // End of 'for' statement
+        cpu_set_t * cpus = CPU_ALLOC(count);
+        const size_t size = CPU_ALLOC_SIZE(count);
+        if (cpus == nullptr) {
+          failures |= thread_config::affinity;
+        } else {
+          CPU_ZERO_S(size, cpus);
+          for (uint32_t cpu = 0; cpu < 64; cpu++) {
+            if ((_config.cpus >> cpu) & 1) {
+              CPU_SET_S(cpu, size, cpus);
+            }
+          } // End of 'for' statement
+          for (std::vector<uint32_t>::const_iterator it = _config.cpu_list.begin(); it != _config.cpu_list.end(); ++it) {
+            CPU_SET_S(*it, size, cpus);
+          } // End of 'for' statement
+          if (::pthread_setaffinity_np(::pthread_self(), size, cpus) != 0) {
+            failures |= thread_config::affinity;
+          }
+          CPU_FREE(cpus);
+        }
+      }
+
+      if (_config.policy != SCHED_OTHER) {
+        struct sched_param parameters;
+        std::memset(&parameters, 0x00, sizeof(parameters));
+        parameters.sched_priority = _config.priority;
+        if (::pthread_setschedparam(::pthread_self(), _config.policy, &parameters) != 0) { // EPERM when not privileged: keep SCHED_OTHER
+          failures |= thread_config::scheduling;
+        }
+      }
+
+      if (!_config.name.empty()) {
+        if (::pthread_setname_np(::pthread_self(), _config.name.substr(0, 15).c_str()) != 0) {
+          failures |= thread_config::naming;
+        }
+      }
+
+      if (_config.lock_memory) {
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+          failures |= thread_config::memory_lock;
+        }
+      }
+
+      if (_config.prefault_stack != 0) {
+        // Touch one byte per page, the pages remain mapped (and locked with MCL_FUTURE) once this frame is released
+        volatile uint8_t * stack = static_cast<volatile uint8_t *>(::alloca(_config.prefault_stack));
+        const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        for (size_t i = 0; i < _config.prefault_stack; i += page_size) {
+          stack[i] = 0;
+        } // End of 'for' statement
+      }
+
+      return failures;
+    }
+
+  } // End of namespace thread
+
+} // End of namespace helpers
@@ -0,0 +1,250 @@
+/**
+ * \file      runtime.cpp
+ * \brief     Implementation file for the application runtime (event loop).
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cerrno>
+#include <ctime>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+
+#include "runtime.hh"
+
+namespace helpers {
+
+  runtime::runtime(const bool p_handle_signals) : _epoll(-1), _signal_fd(-1), _wakeup_fd(-1), _signals(), _saved_mask(), _stop(false), _sources(), _on_signal(), _on_key(), _saved_termios(), _terminal_set(false) {
+    ::sigemptyset(&_signals);
+    ::pthread_sigmask(SIG_SETMASK, nullptr, &_saved_mask);
+
+    _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll == -1) {
+      return;
+    }
+    _wakeup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((_wakeup_fd == -1) || (add_source(_wakeup_fd, EPOLLIN, nullptr, false) == -1)) {
+      ::close(_epoll);
+      _epoll = -1;
+      return;
+    }
+    if (p_handle_signals) {
+      ::sigaddset(&_signals, SIGINT);
+      ::sigaddset(&_signals, SIGTERM);
+      ::pthread_sigmask(SIG_BLOCK, &_signals, nullptr);
+      _signal_fd = ::signalfd(-1, &_signals, SFD_NONBLOCK | SFD_CLOEXEC);
+      if ((_signal_fd == -1) || (add_source(_signal_fd, EPOLLIN, [this](const uint32_t) { process_signals(); }, false) == -1)) {
+        ::close(_epoll);
+        _epoll = -1;
+      }
+    }
+  }
+
+  runtime::~runtime() {
+    restore_terminal();
+    for (auto it = _sources.cbegin(); it != _sources.cend(); ++it) {
+      if (it->second->owned) {
+        ::close(it->first);
+      }
+    } // End of 'for' statement
+    _sources.clear();
+    if (_signal_fd != -1) {
+      // Discard the pending signals, they would terminate the process once unblocked
+      struct signalfd_siginfo info;
+      while (::read(_signal_fd, &info, sizeof(info)) == sizeof(info));
+      ::close(_signal_fd);
+    }
+    if (!::sigisemptyset(&_signals)) {
+      ::pthread_sigmask(SIG_SETMASK, &_saved_mask, nullptr);
+    }
+    if (_wakeup_fd != -1) {
+      ::close(_wakeup_fd);
+    }
+    if (_epoll != -1) {
+      ::close(_epoll);
+    }
+  }
+
+  const int32_t runtime::run() {
+    if (_epoll == -1) {
+      return -1;
+    }
+
+    struct epoll_event events[16];
+    while (!_stop.load(std::memory_order_acquire)) {
+      const int count = ::epoll_wait(_epoll, events, sizeof(events) / sizeof(events[0]), -1);
+      if (count == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return -1;
+      }
+      for (int i = 0; (i < count) && !_stop.load(std::memory_order_acquire); i++) {
+        auto it = _sources.find(events[i].data.fd);
+        if ((it == _sources.end()) || !it->second->handler) { // Removed by a previous callback, or the wake-up event
+          continue;
+        }
+        std::shared_ptr<source> s(it->second); // Keep the handler alive if the callback removes its own source
+        s->handler(events[i].events);
+      } // End of 'for' statement
+    } // End of 'while' statement
+
+    // Re-arm for the next call
+    uint64_t value;
+    while ((::read(_wakeup_fd, &value, sizeof(value)) == -1) && (errno == EINTR));
+    _stop.store(false, std::memory_order_release);
+    return 0;
+  }
+
+  void runtime::stop() {
+    _stop.store(true, std::memory_order_release);
+    const uint64_t value = 1;
+    while ((::write(_wakeup_fd, &value, sizeof(value)) == -1) && (errno == EINTR));
+  }
+
+  const int32_t runtime::add_signal(const int32_t p_signal) {
+    if ((_signal_fd == -1) || (::sigaddset(&_signals, p_signal) == -1)) {
+      return -1;
+    }
+    ::pthread_sigmask(SIG_BLOCK, &_signals, nullptr);
+    return (::signalfd(_signal_fd, &_signals, 0) == -1) ? -1 : 0;
+  }
+
+  const int32_t runtime::add_timer(const std::chrono::nanoseconds & p_period, const timer_callback & p_callback) {
+    if ((_epoll == -1) || (p_period.count() <= 0)) {
+      return -1;
+    }
+
+    const int32_t fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd == -1) {
+      return -1;
+    }
+    // First deadline one period from now, the next ones are derived by the kernel from the previous deadline
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = static_cast<time_t>(p_period.count() / 1000000000);
+    spec.it_interval.tv_nsec = static_cast<long>(p_period.count() % 1000000000);
+    ::clock_gettime(CLOCK_MONOTONIC, &spec.it_value);
+    spec.it_value.tv_sec += spec.it_interval.tv_sec;
+    spec.it_value.tv_nsec += spec.it_interval.tv_nsec;
+    if (spec.it_value.tv_nsec >= 1000000000) {
+      spec.it_value.tv_sec += 1;
+      spec.it_value.tv_nsec -= 1000000000;
+    }
+    if (::timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+      ::close(fd);
+      return -1;
+    }
+
+    timer_callback callback(p_callback);
+    if (add_source(fd, EPOLLIN, [fd, callback](const uint32_t) {
+          uint64_t expirations;
+          if (::read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            callback(expirations);
+          }
+        }, true) == -1) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  const int32_t runtime::on_key(const key_callback & p_callback) {
+    if (!p_callback) {
+      _on_key = nullptr;
+      restore_terminal();
+      return (_sources.find(STDIN_FILENO) == _sources.end()) ? 0 : remove_fd(STDIN_FILENO);
+    }
+
+    _on_key = p_callback;
+    if (_sources.find(STDIN_FILENO) != _sources.end()) {
+      return 0;
+    }
+    if (!_terminal_set && ::isatty(STDIN_FILENO) && (::tcgetattr(STDIN_FILENO, &_saved_termios) == 0)) {
+      struct termios settings = _saved_termios;
+      settings.c_lflag &= ~(ICANON | ECHO);
+      settings.c_cc[VMIN] = 1;
+      settings.c_cc[VTIME] = 0;
+      _terminal_set = (::tcsetattr(STDIN_FILENO, TCSANOW, &settings) == 0);
+    }
+    return add_source(STDIN_FILENO, EPOLLIN, [this](const uint32_t p_events) { process_keys(p_events); }, false);
+  }
+
+  const int32_t runtime::add_fd(const int32_t p_fd, const uint32_t p_events, const fd_callback & p_callback) {
+    fd_callback callback(p_callback);
+    return add_source(p_fd, p_events, [p_fd, callback](const uint32_t p_events) { callback(p_fd, p_events); }, false);
+  }
+
+  const int32_t runtime::remove_fd(const int32_t p_fd) {
+    auto it = _sources.find(p_fd);
+    if ((it == _sources.end()) || (p_fd == _wakeup_fd) || (p_fd == _signal_fd)) {
+      return -1;
+    }
+
+    ::epoll_ctl(_epoll, EPOLL_CTL_DEL, p_fd, nullptr);
+    if (it->second->owned) {
+      ::close(p_fd);
+    }
+    _sources.erase(it);
+    return 0;
+  }
+
+  const int32_t runtime::add_source(const int32_t p_fd, const uint32_t p_events, const std::function<void(const uint32_t p_events)> & p_handler, const bool p_owned) {
+    if ((_epoll == -1) || (_sources.find(p_fd) != _sources.end())) {
+      return -1;
+    }
+
+    struct epoll_event event;
+    event.events = p_events;
+    event.data.u64 = 0;
+    event.data.fd = p_fd;
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, p_fd, &event) == -1) {
+      return -1;
+    }
+    std::shared_ptr<source> s(new source);
+    s->handler = p_handler;
+    s->owned = p_owned;
+    _sources.insert(std::make_pair(p_fd, s));
+    return 0;
+  }
+
+  void runtime::process_signals() {
+    struct signalfd_siginfo info;
+    while (::read(_signal_fd, &info, sizeof(info)) == sizeof(info)) {
+      const int32_t signal = static_cast<int32_t>(info.ssi_signo);
+      if (_on_signal) {
+        _on_signal(signal);
+      }
+      if ((signal == SIGINT) || (signal == SIGTERM)) {
+        stop();
+      }
+    } // End of 'while' statement
+  }
+
+  void runtime::process_keys(const uint32_t p_events) {
+    char keys[64];
+    const ssize_t count = ::read(STDIN_FILENO, keys, sizeof(keys));
+    if ((count == 0) || ((count == -1) && (errno != EAGAIN) && (errno != EINTR))) { // End of file or error
+      remove_fd(STDIN_FILENO);
+      return;
+    }
+    key_callback callback(_on_key); // The callback may remove itself
+    for (ssize_t i = 0; (i < count) && callback; i++) {
+      callback(keys[i]);
+    } // End of 'for' statement
+  }
+
+  void runtime::restore_terminal() {
+    if (_terminal_set) {
+      ::tcsetattr(STDIN_FILENO, TCSANOW, &_saved_termios);
+      _terminal_set = false;
+    }
+  }
+
+} // End of namespace helpers
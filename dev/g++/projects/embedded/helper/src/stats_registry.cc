@@ -0,0 +1,323 @@
+/*!
+ * \file      stats_registry.cpp
+ * \brief     Implementation file for the shared-memory statistics registry.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <new>
+#include <iostream>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>    // Used for O_* constants
+#include <signal.h>   // Used for kill
+#include <unistd.h>   // Used for ftruncate, close, getpid
+#include <sys/mman.h> // Used for shm_open, mmap
+#include <sys/stat.h> // Used for fstat
+
+#include "stats_registry.hh"
+
+namespace helpers {
+
+  /**
+   * \struct segment_header
+   * \brief The first bytes of a segment
+   */
+  struct segment_header {
+    uint32_t magic;                   /*!< segment_magic */
+    uint32_t version;                 /*!< segment_version */
+    int32_t pid;                      /*!< The process which created the segment */
+    uint32_t capacity;                /*!< The number of entries */
+    uint32_t histograms;              /*!< The number of histogram cells */
+    uint32_t used_histograms;         /*!< The number of histogram cells in use */
+    std::atomic<uint32_t> count;      /*!< The number of entries in use, published once the entry is complete */
+    uint32_t reserved;
+    uint64_t cells_offset;            /*!< The offset of the counter and gauge cells, one cache line per entry */
+    uint64_t histograms_offset;       /*!< The offset of the histogram cells */
+  };
+
+  /**
+   * \struct segment_entry
+   * \brief The description of a statistic
+   */
+  struct segment_entry {
+    char name[stats_registry::name_length + 1]; /*!< The name, NUL terminated */
+    uint32_t kind;                              /*!< The stats_kind */
+    uint32_t reserved;
+    uint64_t offset;                            /*!< The offset of the cells in the segment */
+  };
+
+  static const uint32_t segment_magic = 0x53544154; // 'STAT'
+  static const uint32_t segment_version = 1;
+  static const size_t line_size = 64;
+  static const size_t header_size = 128;
+  static const size_t histogram_size = (sizeof(stats_histogram_cells) + line_size - 1) & ~(line_size - 1);
+
+  /*!< The cells of the handles of a registry which could not register them */
+  static std::atomic<uint64_t> g_dummy_counter(0);
+  static std::atomic<int64_t> g_dummy_gauge(0);
+  static stats_histogram_cells g_dummy_histogram;
+
+  static std::string segment_name(const std::string & p_name) {
+    return (!p_name.empty() && (p_name[0] == '/')) ? p_name : "/" + p_name;
+  }
+
+  /**
+   * \brief Indicate if the segment of a name was created by a process which is still running
+   * \param[in] p_name The segment name
+   * \param[out] p_pid The process which created the segment, -1 if unknown
+   */
+  static bool is_in_use(const std::string & p_name, int32_t & p_pid) {
+    p_pid = -1;
+    int fd = ::shm_open(p_name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd == -1) {
+      return false;
+    }
+    struct stat st;
+    void * segment = MAP_FAILED;
+    if ((::fstat(fd, &st) == 0) && (static_cast<size_t>(st.st_size) >= header_size)) {
+      segment = ::mmap(nullptr, header_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (segment == MAP_FAILED) {
+      return false;
+    }
+    const segment_header * header = static_cast<const segment_header *>(segment);
+    if (header->magic == segment_magic) {
+      p_pid = header->pid;
+    }
+    ::munmap(segment, header_size);
+    return (p_pid > 0) && ((::kill(p_pid, 0) == 0) || (errno == EPERM)); // EPERM: running under another user
+  }
+
+  stats_counter::stats_counter() : _value(&g_dummy_counter) { }
+
+  stats_gauge::stats_gauge() : _value(&g_dummy_gauge) { }
+
+  stats_histogram::stats_histogram() : _cells(&g_dummy_histogram) { }
+
+  stats_registry::stats_registry(const std::string & p_name, const uint32_t p_capacity, const uint32_t p_histograms) : _name(segment_name(p_name)), _segment(nullptr), _size(0), _mutex() {
+    static_assert(sizeof(segment_header) <= header_size, "segment_header too large");
+    static_assert(sizeof(segment_entry) == line_size, "segment_entry shall fill a cache line");
+
+    const size_t cells_offset = header_size + p_capacity * sizeof(segment_entry);
+    const size_t histograms_offset = cells_offset + p_capacity * line_size;
+    const size_t size = histograms_offset + p_histograms * histogram_size;
+
+    int32_t pid;
+    if (is_in_use(_name, pid)) {
+      std::cerr << "stats_registry::stats_registry: " << _name << " is used by the process " << pid << std::endl;
+      return;
+    }
+    ::shm_unlink(_name.c_str()); // Left by a previous instance which did not terminate
+    int fd = ::shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd == -1) {
+      return;
+    }
+    if (::ftruncate(fd, size) == -1) { // Zero filled
+      ::close(fd);
+      ::shm_unlink(_name.c_str());
+      return;
+    }
+    void * segment = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps a reference on the segment
+    if (segment == MAP_FAILED) {
+      ::shm_unlink(_name.c_str());
+      return;
+    }
+
+    _segment = static_cast<uint8_t *>(segment);
+    _size = size;
+    segment_header * header = new (_segment) segment_header();
+    header->pid = static_cast<int32_t>(::getpid());
+    header->capacity = p_capacity;
+    header->histograms = p_histograms;
+    header->used_histograms = 0;
+    header->count.store(0, std::memory_order_relaxed);
+    header->cells_offset = cells_offset;
+    header->histograms_offset = histograms_offset;
+    header->version = segment_version;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = segment_magic;
+  }
+
+  stats_registry::~stats_registry() {
+    if (_segment != nullptr) {
+      ::munmap(_segment, _size);
+      ::shm_unlink(_name.c_str());
+    }
+  }
+
+  stats_counter stats_registry::counter(const std::string & p_name) {
+    void * cells = reserve(p_name, stats_counter_kind);
+    return (cells == nullptr) ? stats_counter() : stats_counter(static_cast<std::atomic<uint64_t> *>(cells));
+  }
+
+  stats_gauge stats_registry::gauge(const std::string & p_name) {
+    void * cells = reserve(p_name, stats_gauge_kind);
+    return (cells == nullptr) ? stats_gauge() : stats_gauge(static_cast<std::atomic<int64_t> *>(cells));
+  }
+
+  stats_histogram stats_registry::histogram(const std::string & p_name) {
+    void * cells = reserve(p_name, stats_histogram_kind);
+    return (cells == nullptr) ? stats_histogram() : stats_histogram(static_cast<stats_histogram_cells *>(cells));
+  }
+
+  void * stats_registry::reserve(const std::string & p_name, const stats_kind p_kind) {
+    if ((_segment == nullptr) || p_name.empty() || (p_name.length() > name_length)) {
+      return nullptr;
+    }
+    for (std::string::const_iterator it = p_name.cbegin(); it != p_name.cend(); ++it) { // Written as is in JSON strings
+      if ((static_cast<uint8_t>(*it) < 0x20) || (*it == '"') || (*it == '\\')) {
+        return nullptr;
+      }
+    } // End of 'for' statement
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    segment_header * header = reinterpret_cast<segment_header *>(_segment);
+    segment_entry * entries = reinterpret_cast<segment_entry *>(_segment + header_size);
+    const uint32_t count = header->count.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++) {
+      if (p_name == entries[i].name) {
+        return (entries[i].kind == static_cast<uint32_t>(p_kind)) ? _segment + entries[i].offset : nullptr;
+      }
+    } // End of 'for' statement
+    if (count == header->capacity) {
+      return nullptr;
+    }
+
+    segment_entry & entry = entries[count];
+    if (p_kind == stats_histogram_kind) {
+      if (header->used_histograms == header->histograms) {
+        return nullptr;
+      }
+      entry.offset = header->histograms_offset + header->used_histograms * histogram_size;
+      header->used_histograms += 1;
+      stats_histogram_cells * cells = new (_segment + entry.offset) stats_histogram_cells();
+      cells->min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    } else {
+      entry.offset = header->cells_offset + count * line_size;
+      if (p_kind == stats_counter_kind) {
+        new (_segment + entry.offset) std::atomic<uint64_t>(0);
+      } else {
+        new (_segment + entry.offset) std::atomic<int64_t>(0);
+      }
+    }
+    std::strncpy(entry.name, p_name.c_str(), name_length);
+    entry.kind = static_cast<uint32_t>(p_kind);
+    header->count.store(count + 1, std::memory_order_release); // Visible to the readers once complete
+    return _segment + entry.offset;
+  }
+
+  stats_reader::stats_reader(const std::string & p_name) : _segment(nullptr), _size(0) {
+    int fd = ::shm_open(segment_name(p_name).c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd == -1) {
+      return;
+    }
+    struct stat st;
+    if ((::fstat(fd, &st) == -1) || (static_cast<size_t>(st.st_size) < header_size)) {
+      ::close(fd);
+      return;
+    }
+    void * segment = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (segment == MAP_FAILED) {
+      return;
+    }
+
+    const segment_header * header = static_cast<const segment_header *>(segment);
+    if ((header->magic != segment_magic) || (header->version != segment_version)) {
+      ::munmap(segment, st.st_size);
+      return;
+    }
+    _segment = static_cast<const uint8_t *>(segment);
+    _size = st.st_size;
+  }
+
+  stats_reader::~stats_reader() {
+    if (_segment != nullptr) {
+      ::munmap(const_cast<uint8_t *>(_segment), _size);
+    }
+  }
+
+  int32_t stats_reader::pid() const {
+    return (_segment == nullptr) ? -1 : reinterpret_cast<const segment_header *>(_segment)->pid;
+  }
+
+  const int32_t stats_reader::read(std::vector<stats_value> & p_values) const {
+    p_values.clear();
+    if (_segment == nullptr) {
+      return -1;
+    }
+
+    // The segment is written by another process: the entries and their cells shall lie within the mapping
+    const segment_header * header = reinterpret_cast<const segment_header *>(_segment);
+    const segment_entry * entries = reinterpret_cast<const segment_entry *>(_segment + header_size);
+    const uint32_t count = header->count.load(std::memory_order_acquire);
+    if ((header->capacity > (_size - header_size) / sizeof(segment_entry)) || (count > header->capacity)) {
+      return -1;
+    }
+    std::vector<uint64_t> buckets(stats_histogram_cells::bucket_count);
+    for (uint32_t i = 0; i < count; i++) {
+      const segment_entry & entry = entries[i];
+      stats_value value = stats_value();
+      value.name.assign(entry.name, ::strnlen(entry.name, stats_registry::name_length));
+      value.kind = static_cast<stats_kind>(entry.kind);
+      if ((entry.offset < header_size) || (entry.offset > _size) || ((entry.offset % sizeof(uint64_t)) != 0)) {
+        return -1;
+      }
+      if (value.kind == stats_histogram_kind) {
+        if (sizeof(stats_histogram_cells) > _size - entry.offset) {
+          return -1;
+        }
+        const stats_histogram_cells * cells = reinterpret_cast<const stats_histogram_cells *>(_segment + entry.offset);
+        uint64_t total = 0;
+        for (size_t b = 0; b < buckets.size(); b++) {
+          buckets[b] = cells->buckets[b].load(std::memory_order_relaxed);
+          total += buckets[b];
+        } // End of 'for' statement
+        value.value = static_cast<int64_t>(total); // Consistent with the percentiles
+        value.sum = cells->sum.load(std::memory_order_relaxed);
+        value.max = cells->max.load(std::memory_order_relaxed);
+        value.min = (total == 0) ? 0 : std::min(cells->min.load(std::memory_order_relaxed), value.max);
+        const double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+        uint64_t * results[] = { &value.p50, &value.p90, &value.p99, &value.p999 };
+        for (uint32_t p = 0; (p < 4) && (total != 0); p++) {
+          const size_t b = log_linear_buckets::percentile(buckets.data(), buckets.size(), total, percentiles[p]);
+          *results[p] = (b == buckets.size()) ? value.max : std::max(value.min, std::min(value.max, stats_histogram_cells::bucket_highest(b)));
+        } // End of 'for' statement
+      } else if ((value.kind == stats_counter_kind) || (value.kind == stats_gauge_kind)) {
+        if (sizeof(int64_t) > _size - entry.offset) {
+          return -1;
+        }
+        value.value = reinterpret_cast<const std::atomic<int64_t> *>(_segment + entry.offset)->load(std::memory_order_relaxed);
+      } else {
+        return -1;
+      }
+      p_values.push_back(value);
+    } // End of 'for' statement
+
+    return 0;
+  }
+
+  void stats_reader::to_json(const std::vector<stats_value> & p_values, std::ostream & p_os) {
+    p_os << "{";
+    for (std::vector<stats_value>::const_iterator it = p_values.cbegin(); it != p_values.cend(); ++it) {
+      p_os << ((it == p_values.cbegin()) ? "" : ",") << "\"" << it->name << "\":";
+      if (it->kind == stats_counter_kind) {
+        p_os << static_cast<uint64_t>(it->value);
+      } else if (it->kind == stats_gauge_kind) {
+        p_os << it->value;
+      } else {
+        p_os << "{\"count\":" << it->value << ",\"sum\":" << it->sum << ",\"min\":" << it->min << ",\"max\":" << it->max
+             << ",\"p50\":" << it->p50 << ",\"p90\":" << it->p90 << ",\"p99\":" << it->p99 << ",\"p99.9\":" << it->p999 << "}";
+      }
+    } // End of 'for' statement
+    p_os << "}";
+  }
+
+} // End of namespace helpers
@@ -0,0 +1,224 @@
+/*!
+ * \file      thread_pool.cpp
+ * \brief     Implementation file for the work-stealing thread pool.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include "thread_pool.hh"
+
+namespace helpers {
+
+  namespace thread {
+
+    work_stealing_deque::work_stealing_deque(const size_t p_capacity) : _top(0), _bottom(0), _buffer(nullptr), _buffers() {
+      int64_t capacity = 2;
+      while (capacity < static_cast<int64_t>(p_capacity)) {
+        capacity <<= 1;
+      } // End of 'while' statement
+      _buffers.push_back(std::unique_ptr<buffer_t>(new buffer_t(capacity)));
+      _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    void work_stealing_deque::push(task_t * p_task) {
+      const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+      const int64_t top = _top.load(std::memory_order_acquire);
+      buffer_t * buffer = _buffer.load(std::memory_order_relaxed);
+      if (bottom - top > buffer->mask) { // Full, double the capacity
+        buffer_t * grown = new buffer_t(2 * (buffer->mask + 1));
+        for (int64_t i = top; i != bottom; i++) {
+          grown->put(i, buffer->get(i));
+        } // End of 'for' statement
+        _buffers.push_back(std::unique_ptr<buffer_t>(grown));
+        _buffer.store(grown, std::memory_order_release);
+        buffer = grown;
+      }
+      buffer->put(bottom, p_task);
+      _bottom.store(bottom + 1, std::memory_order_release); // Publish the task to the thieves
+    }
+
+    task_t * work_stealing_deque::pop() {
+      const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+      buffer_t * buffer = _buffer.load(std::memory_order_relaxed);
+      _bottom.store(bottom, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t top = _top.load(std::memory_order_relaxed);
+
+      if (top > bottom) { // Empty
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      task_t * task = buffer->get(bottom);
+      if (top == bottom) { // Last task, race against the thieves
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          task = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+      return task;
+    }
+
+    task_t * work_stealing_deque::steal() {
+      int64_t top = _top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int64_t bottom = _bottom.load(std::memory_order_acquire);
+      if (top >= bottom) { // Empty
+        return nullptr;
+      }
+
+      buffer_t * buffer = _buffer.load(std::memory_order_acquire);
+      task_t * task = buffer->get(top);
+      if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+      }
+      return task;
+    }
+
+    thread_local thread_pool::worker * thread_pool::_current = nullptr;
+    std::unique_ptr<thread_pool> thread_pool::g_instance(nullptr);
+
+    void thread_pool::worker::run() {
+      _running = true;
+      _current = this;
+      _pool.worker_loop(*this);
+      _current = nullptr;
+    }
+
+    thread_pool::thread_pool(const uint32_t p_workers, const bool p_pin) : _workers(), _injected(), _injected_size(0), _mutex(), _condition(), _queued(0), _sleeping(0), _stopping(false) {
+      const uint32_t cpus = (std::thread::hardware_concurrency() == 0) ? 1 : std::thread::hardware_concurrency();
+      const uint32_t workers = (p_workers == 0) ? cpus : p_workers;
+      // All the workers exist before the first one starts stealing
+      for (uint32_t i = 0; i < workers; i++) {
+        _workers.push_back(std::unique_ptr<worker>(new worker(*this, i)));
+      } // End of 'for' statement
+      for (uint32_t i = 0; i < workers; i++) {
+        if (p_pin) { // Pinned by the worker itself, before it runs any task
+          thread_config config;
+          config.cpu_list.push_back(i % cpus);
+          _workers[i]->configure(config);
+        }
+        _workers[i]->start();
+      } // End of 'for' statement
+    }
+
+    thread_pool::~thread_pool() {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+      }
+      _condition.notify_all();
+      for (std::vector<std::unique_ptr<worker> >::iterator it = _workers.begin(); it != _workers.end(); ++it) {
+        (*it)->stop();
+      } // End of 'for' statement
+      for (std::deque<task_t *>::iterator it = _injected.begin(); it != _injected.end(); ++it) { // Posted during the destruction
+        delete *it;
+      } // End of 'for' statement
+    }
+
+    thread_pool & thread_pool::get_instance() {
+      static std::once_flag once;
+      std::call_once(once, []() { g_instance.reset(new thread_pool()); });
+      return *g_instance;
+    }
+
+    void thread_pool::post(const task_t & p_task) {
+      enqueue(new task_t(p_task));
+    }
+
+    const bool thread_pool::run_pending_task() {
+      task_t * task = take((current_worker() != -1) ? _current : nullptr);
+      if (task == nullptr) {
+        return false;
+      }
+      execute(task);
+      return true;
+    }
+
+    void thread_pool::enqueue(task_t * p_task) {
+      if (current_worker() != -1) { // Submitted by a task, no lock
+        _current->deque().push(p_task);
+      } else {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _injected.push_back(p_task);
+        _injected_size.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      // Paired with the sleep sequence of worker_loop: either the worker sees the new task, or this thread sees the sleeper
+      _queued.fetch_add(1);
+      if (_sleeping.load() != 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _condition.notify_one();
+      }
+    }
+
+    task_t * thread_pool::take(worker * p_worker) {
+      task_t * task = nullptr;
+      if ((p_worker != nullptr) && ((task = p_worker->deque().pop()) != nullptr)) {
+        _queued.fetch_sub(1);
+        return task;
+      }
+      if (_queued.load(std::memory_order_relaxed) <= 0) {
+        return nullptr;
+      }
+
+      if (_injected_size.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_injected.empty()) {
+          task = _injected.front();
+          _injected.pop_front();
+          _injected_size.fetch_sub(1, std::memory_order_relaxed);
+        }
+      }
+      if (task == nullptr) { // Steal from the other workers, starting at a random one
+        const uint32_t workers = size();
+        uint32_t victim = (p_worker != nullptr) ? p_worker->next_victim() : 0;
+        for (uint32_t i = 0; (i < workers) && (task == nullptr); i++, victim++) {
+          worker * w = _workers[victim % workers].get();
+          if (w != p_worker) {
+            task = w->deque().steal();
+          }
+        } // End of 'for' statement
+      }
+      if (task != nullptr) {
+        _queued.fetch_sub(1);
+      }
+      return task;
+    }
+
+    void thread_pool::execute(task_t * p_task) {
+      try {
+        (*p_task)();
+      } catch (...) {
+        // Posted tasks have nobody to report to, submitted tasks store the exception into their future
+      }
+      delete p_task;
+    }
+
+    void thread_pool::worker_loop(worker & p_worker) {
+      while (true) {
+        task_t * task = take(&p_worker);
+        for (uint32_t spin = 0; (spin < 64) && (task == nullptr) && (_queued.load(std::memory_order_relaxed) > 0); spin++) { // Lost a race, retry shortly
+          std::this_thread::yield();
+          task = take(&p_worker);
+        } // End of 'for' statement
+        if (task != nullptr) {
+          execute(task);
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _sleeping.fetch_add(1);
+        while (!_stopping && (_queued.load() <= 0)) {
+          _condition.wait(lock);
+        } // End of 'while' statement
+        _sleeping.fetch_sub(1);
+        if (_stopping && (_queued.load() <= 0)) {
+          break;
+        }
+      } // End of 'while' statement
+    }
+
+  } // End of namespace thread
+
+} // End of namespace helpers
@@ -0,0 +1,132 @@
+/**
+ * \file      tokenizer.cpp
+ * \brief     Implementation file for the zero-allocation string tokenizer.
+ * \author    garciay.yann@gmail.com
+ * \copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * \license   This project is released under the MIT License
+ * \version   0.1
+ */
+#include <cstring>
+
+#include "tokenizer.hh"
+
+#if defined(__x86_64__)
+#include <emmintrin.h> // SSE2 is part of the x86-64 baseline
+#define TOKENIZER_SSE2
+#endif
+
+namespace helpers {
+
+  tokenizer::tokenizer(const string_ref & p_input, const char * p_delimiters, const char p_quote, const bool p_skip_empty) : _position(p_input.begin()), _end(p_input.end()), _done(false), _quote(p_quote), _skip_empty(p_skip_empty), _count(0), _delimiters(), _set() {
+    const size_t count = std::strlen(p_delimiters);
+    for (size_t i = 0; i < count; i++) {
+      const uint8_t c = static_cast<uint8_t>(p_delimiters[i]);
+      _set[c >> 6] |= static_cast<uint64_t>(1) << (c & 0x3f);
+      if (i < sizeof(_delimiters)) {
+        _delimiters[i] = p_delimiters[i];
+      }
+    } // End of 'for' statement
+    _count = (count <= sizeof(_delimiters)) ? static_cast<uint8_t>(count) : 0;
+  }
+
+  const char * tokenizer::find_delimiter(const char * p_first, const char * p_last) const {
+    if (_count == 1) {
+      const void * p = std::memchr(p_first, _delimiters[0], p_last - p_first);
+      return (p == nullptr) ? p_last : static_cast<const char *>(p);
+    }
+
+#if defined(TOKENIZER_SSE2)
+    if (_count != 0) { // Unused slots repeat the first delimiter
+      const __m128i d0 = _mm_set1_epi8(_delimiters[0]);
+      const __m128i d1 = _mm_set1_epi8(_delimiters[(_count > 1) ? 1 : 0]);
+      const __m128i d2 = _mm_set1_epi8(_delimiters[(_count > 2) ? 2 : 0]);
+      const __m128i d3 = _mm_set1_epi8(_delimiters[(_count > 3) ? 3 : 0]);
+      for ( ; p_last - p_first >= 16; p_first += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_first));
+        const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, d0), _mm_cmpeq_epi8(v, d1)), _mm_or_si128(_mm_cmpeq_epi8(v, d2), _mm_cmpeq_epi8(v, d3)));
+        const int mask = _mm_movemask_epi8(m);
+        if (mask != 0) {
+          return p_first + __builtin_ctz(mask);
+        }
+      } // End of 'for' statement
+    }
+#endif
+
+    for ( ; p_first != p_last; p_first++) {
+      const uint8_t c = static_cast<uint8_t>(*p_first);
+      if ((_set[c >> 6] >> (c & 0x3f)) & 1) {
+        break;
+      }
+    } // End of 'for' statement
+    return p_first;
+  }
+
+  bool tokenizer::next(string_ref & p_field) {
+    while (!_done) {
+      const char * first = _position;
+      const char * last;
+      const char * delimiter;
+      if ((_quote != '\0') && (first != _end) && (*first == _quote)) { // Quoted field
+        first += 1;
+        last = first;
+        while (true) {
+          const void * q = std::memchr(last, _quote, _end - last);
+          if (q == nullptr) { // Unterminated, up to the end of the input
+            last = _end;
+            break;
+          }
+          last = static_cast<const char *>(q);
+          if ((last + 1 != _end) && (*(last + 1) == _quote)) { // Doubled quote
+            last += 2;
+            continue;
+          }
+          break;
+        } // End of 'while' statement
+        delimiter = find_delimiter((last == _end) ? _end : last + 1, _end);
+        if ((last != _end) && (delimiter != last + 1)) { // Characters after the closing quote: the whole field is returned verbatim, quotes included
+          first -= 1;
+          last = delimiter;
+        }
+      } else {
+        delimiter = find_delimiter(first, _end);
+        last = delimiter;
+      }
+
+      if (delimiter == _end) {
+        _done = true;
+      } else {
+        _position = delimiter + 1;
+      }
+      if (_skip_empty && (first == last)) {
+        continue;
+      }
+      p_field = string_ref(first, last - first);
+      return true;
+    } // End of 'while' statement
+    return false;
+  }
+
+  size_t tokenizer::split(string_ref * p_fields, const size_t p_max) {
+    size_t count = 0;
+    while ((count < p_max) && next(p_fields[count])) {
+      count += 1;
+    } // End of 'while' statement
+    return count;
+  }
+
+  string_ref tokenizer::unquote(const string_ref & p_field, const char p_quote, std::string & p_buffer) {
+    size_t position = p_field.find(p_quote);
+    if (position == string_ref::npos) {
+      return p_field;
+    }
+
+    p_buffer.assign(p_field.data(), position);
+    while (position < p_field.size()) {
+      const char c = p_field[position];
+      p_buffer.push_back(c);
+      position += ((c == p_quote) && (position + 1 < p_field.size()) && (p_field[position + 1] == p_quote)) ? 2 : 1;
+    } // End of 'while' statement
+    return string_ref(p_buffer);
+  }
+
+} // End of namespace helpers
@@ -0,0 +1,72 @@
+/**
+ * @file      testlib.cpp
+ * @brief     Helper heap allocations test suite.
+ * @author    garciay.yann@gmail.com
+ * @copyright Copyright (c) 2015-2017 ygarcia. All rights reserved
+ * @license   This project is released under the MIT License
+ * @version   0.1
+ * @remark    The global operator new is replaced to count the heap allocations: this test suite has its own test program,
+ *            so that the replacement does not affect the other test suites
+ */
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <string>
+
+#include <gtest.h>
+#define ASSERT_TRUE_MSG(exp1, msg) ASSERT_TRUE(exp1) << msg
+
+#include "tokenizer.hh"
+
+/**
+ * @brief Number of heap allocations done by the test program
+ */
+static std::atomic<uint64_t> g_allocations(0);
+
+void * operator new(size_t p_size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void * p = std::malloc((p_size == 0) ? 1 : p_size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p_pointer) noexcept {
+  std::free(p_pointer);
+}
+
+void operator delete(void * p_pointer, size_t) noexcept {
+  std::free(p_pointer);
+}
+
+/**
+ * @class Heap allocations test suite implementation
+ */
+class allocations_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for @see helpers::tokenizer::split, the fields borrow the input
+ */
+TEST(allocations_test_suite, tokenizer_1) {
+  const std::string line("2017-05-15T04:36:00Z,sensor_12,21.5,,48.25;1013");
+  string_ref fields[8];
+  const uint64_t allocations = g_allocations.load();
+  tokenizer csv(line, ",;");
+  ASSERT_TRUE_MSG(csv.split(fields, 8) == 6, "test_tokenizer_1 failed, wrong number of fields");
+  ASSERT_TRUE_MSG(g_allocations.load() == allocations, "test_tokenizer_1 failed, no allocation expected");
+}
+
+/**
+ * @brief Main test program
+ * @param[in] p_argc Number of argumrnt
+ * @param[in] p_argv List of the arguments
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,10 +8,22 @@
  */
 #include <cstdlib>
 #include <cstring>
+#include <cmath>
 #include <iostream>
 #include <algorithm>
 #include <chrono>
 #include <thread>
+#include <numeric>
+#include <sstream>
+#include <unistd.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sys/wait.h>
 
 #include <gtest.h>
 #define ASSERT_TRUE_MSG(exp1, msg) ASSERT_TRUE(exp1) << msg
@@ -19,11 +31,24 @@
 #include "helper.hh"
 #include "converter.hh"
 #include "date_time.hh"
+#include "bit_stream.hh"
+#include "bit_codec.hh"
+#include "byte_buffer.hh"
+#include "checksum.hh"
+#include "tokenizer.hh"
 #include "ibstream.hh"
 #include "obstream.hh"
 #include "keyboard.hh"
 #include "get_opt.hh"
 #include "runnable.hh"
+#include "mapped_file.hh"
+#include "thread_pool.hh"
+#include "ring_buffer.hh"
+#include "object_pool.hh"
+#include "runtime.hh"
+#include "histogram.hh"
+#include "stats_registry.hh"
+#include "micro_benchmark.hh"
 
 using namespace std;
 
@@ -97,6 +122,98 @@ TEST(runnable_test_suite, test_runnable) {
   ASSERT_TRUE(t.get_counter() == 10);
 }
 
+/**
+ * @brief Periodic sampling thread recording its wake-up latencies
+ */
+class sampler_ : public runnable {
+  std::vector<int64_t> _latencies;
+  int32_t _policy;
+  size_t _stack_size;
+public:
+  sampler_(const thread_config & p_config) : runnable(p_config), _latencies(), _policy(-1), _stack_size(0) { };
+  void run() {
+    _policy = ::sched_getscheduler(0);
+    pthread_attr_t attributes;
+    if (::pthread_getattr_np(::pthread_self(), &attributes) == 0) {
+      ::pthread_attr_getstacksize(&attributes, &_stack_size);
+      ::pthread_attr_destroy(&attributes);
+    }
+    struct timespec deadline;
+    ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+    for (uint32_t i = 0; i < 500; i++) { // 1 ms period
+      deadline.tv_nsec += 1000000;
+      if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000;
+      }
+      while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR);
+      struct timespec now;
+      ::clock_gettime(CLOCK_MONOTONIC, &now);
+      _latencies.push_back((now.tv_sec - deadline.tv_sec) * 1000000000LL + (now.tv_nsec - deadline.tv_nsec));
+    } // End of 'for' statement
+  };
+
+  inline std::vector<int64_t> & latencies() { return _latencies; };
+  inline int32_t policy() const { return _policy; };
+  inline size_t stack_size() const { return _stack_size; };
+}; // End of class sampler_
+
+/**
+ * @brief Test case for @see runnable::configure: settings applied, or reported as failed without root privileges
+ */
+TEST(runnable_test_suite, test_runnable_config) {
+  cpu_set_t allowed; // The first CPU allowed to the test program, CPU 0 may be excluded by its cpuset
+  ASSERT_TRUE_MSG(::sched_getaffinity(0, sizeof(allowed), &allowed) == 0, "test_runnable_config failed, cannot get the affinity");
+  uint32_t cpu = 0;
+  while ((cpu < CPU_SETSIZE) && !CPU_ISSET(cpu, &allowed)) {
+    cpu += 1;
+  } // End of 'while' statement
+  thread_config config;
+  config.cpu_list.push_back(cpu);
+  config.name = "sampler_thread_name";
+  config.stack_size = 512 * 1024;
+  config.prefault_stack = 64 * 1024;
+  sampler_ s(config);
+  s.start();
+  char name[16] = { 0 };
+  ASSERT_TRUE_MSG(::pthread_getname_np(s.native_handle(), name, sizeof(name)) == 0, "test_runnable_config failed, cannot get the name");
+  s.stop();
+  ASSERT_TRUE_MSG(s.failures() == 0, "test_runnable_config failed, settings not applied");
+  ASSERT_TRUE_MSG(std::string(name) == "sampler_thread_", "test_runnable_config failed, wrong name");
+  ASSERT_TRUE_MSG((s.stack_size() >= 512 * 1024) && (s.stack_size() < 1024 * 1024), "test_runnable_config failed, wrong stack size");
+  ASSERT_TRUE_MSG(s.policy() == SCHED_OTHER, "test_runnable_config failed, wrong policy");
+}
+
+/**
+ * @brief Wake-up jitter of a 1 ms sampling thread, with the default settings and with SCHED_FIFO, pinning and memory locking
+ */
+TEST(runnable_test_suite, test_runnable_jitter) {
+  thread_config rt;
+  rt.policy = SCHED_FIFO;
+  rt.priority = 80;
+  rt.cpus = 0x01;
+  rt.name = "sampler";
+  rt.lock_memory = true;
+  rt.prefault_stack = 64 * 1024;
+  const thread_config configs[] = { thread_config(), rt };
+  for (uint32_t i = 0; i < 2; i++) {
+    sampler_ s(configs[i]);
+    s.start();
+    s.stop(); // Joins once the 500 periods are done
+    ::munlockall();
+    std::vector<int64_t> & latencies = s.latencies();
+    ASSERT_TRUE_MSG(latencies.size() == 500, "test_runnable_jitter failed, wrong samples count");
+    std::sort(latencies.begin(), latencies.end());
+    std::clog << ((i == 0) ? "SCHED_OTHER" : "SCHED_FIFO ") << ((s.failures() & thread_config::scheduling) ? " (not permitted, SCHED_OTHER)" : "")
+              << ": wake-up latency p50 " << latencies[250] / 1000 << " us, p99 " << latencies[495] / 1000 << " us, max " << latencies.back() / 1000 << " us" << std::endl;
+    if ((i == 1) && !(s.failures() & thread_config::scheduling)) {
+      ASSERT_TRUE_MSG(s.policy() == SCHED_FIFO, "test_runnable_jitter failed, wrong policy");
+    } else {
+      ASSERT_TRUE_MSG(s.policy() == SCHED_OTHER, "test_runnable_jitter failed, wrong fallback policy");
+    }
+  } // End of 'for' statement
+}
+
 /**
  * @class helpers::get_opt test suite implementation
  */
@@ -360,6 +477,14 @@ TEST(helper_test_suite, file_load_3) {
   ASSERT_TRUE(buffer[3] == 0x46); // F
 }
 
+TEST(helper_test_suite, file_load_4) {
+  std::string name("/proc/self/status"); // Size reported as 0
+  std::vector<unsigned char> buffer;
+  ASSERT_TRUE(helper::get_instance().file_load(name, buffer) > 0);
+  std::string str(buffer.begin(), buffer.end());
+  ASSERT_TRUE(str.find("Pid:") != std::string::npos);
+}
+
 /**
  * @class helpers::date_time test suite implementation
  */
@@ -404,6 +529,76 @@ TEST(date_time_test_suite, parse_date_time) {
   //clog << ">>> test_date_time_1 done" << endl;
   }*/
 
+/**
+ * @brief Test case for the standard timestamp formats
+ * @see helpers::timestamp::format
+ * @see helpers::timestamp_formatter::format
+ */
+TEST(date_time_test_suite, timestamp_1) {
+  // 2017-10-11T14:09:44.123456789Z
+  const uint64_t t = 1507730984ULL * 1000000000ULL + 123456789ULL;
+  ASSERT_TRUE_MSG(timestamp::to_string(t) == "2017-10-11T14:09:44.123456Z", "test_timestamp_1 failed, wrong RFC 3339 timestamp");
+  ASSERT_TRUE_MSG(timestamp::to_string(t, rfc3339, 9) == "2017-10-11T14:09:44.123456789Z", "test_timestamp_1 failed, wrong nanoseconds");
+  ASSERT_TRUE_MSG(timestamp::to_string(t + 1000000000ULL, rfc3339, 3) == "2017-10-11T14:09:45.123Z", "test_timestamp_1 failed, wrong next second");
+  ASSERT_TRUE_MSG(timestamp::to_string(t - 123456789ULL, rfc3339, 0) == "2017-10-11T14:09:44Z", "test_timestamp_1 failed, wrong seconds only");
+  char buffer[32];
+  ASSERT_TRUE_MSG(timestamp::format(buffer, 27, t) == 0, "test_timestamp_1 failed, the buffer is too small");
+  ASSERT_TRUE_MSG((timestamp::format(buffer, 28, t) == 27) && (std::strlen(buffer) == 27), "test_timestamp_1 failed, wrong length");
+
+  // Local time: same digits as strftime, with the UTC offset of the time zone
+  const time_t second = 1507730984;
+  struct tm tm;
+  ::localtime_r(&second, &tm);
+  char expected[64];
+  std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S.123", &tm);
+  const std::string iso = timestamp::to_string(t, iso8601, 3);
+  ASSERT_TRUE_MSG(iso.substr(0, 23) == expected, "test_timestamp_1 failed, wrong ISO 8601 timestamp");
+  ASSERT_TRUE_MSG((iso.size() == 29) && ((iso[23] == '+') || (iso[23] == '-')) && (iso[26] == ':'), "test_timestamp_1 failed, wrong UTC offset");
+
+  helpers::timestamp_formatter formatter("%Y/%b/%d %H:%M:%S", 6, true);
+  ASSERT_TRUE_MSG((formatter.format(buffer, sizeof(buffer), t) == 27) && (std::string(buffer) == "2017/Oct/11 14:09:44.123456"), "test_timestamp_1 failed, wrong custom format");
+  helpers::timestamp_formatter months("%h %%b", 0, true); // English month names whatever the locale, "%%" kept
+  ASSERT_TRUE_MSG((months.format(buffer, sizeof(buffer), t) == 6) && (std::string(buffer) == "Oct %b"), "test_timestamp_1 failed, wrong month name");
+}
+
+/**
+ * @brief Test case for the clocks
+ * @see helpers::timestamp::monotonic_to_realtime
+ */
+TEST(date_time_test_suite, timestamp_2) {
+  const uint64_t monotonic = timestamp::monotonic();
+  const uint64_t realtime = timestamp::realtime();
+  const int64_t difference = static_cast<int64_t>(timestamp::monotonic_to_realtime(monotonic) - realtime);
+  ASSERT_TRUE_MSG((difference > -1000000) && (difference < 1000000), "test_timestamp_2 failed, wrong monotonic to wall clock mapping");
+  const int64_t coarse = static_cast<int64_t>(timestamp::realtime(true) - timestamp::realtime());
+  ASSERT_TRUE_MSG((coarse > -100000000) && (coarse < 100000000), "test_timestamp_2 failed, wrong coarse clock");
+
+  // Per-thread caches
+  std::atomic<bool> ok(true);
+  vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.push_back(std::thread([&ok, i]() {
+          char buffer[40];
+          for (uint64_t s = 0; s < 1000; s++) {
+            const uint64_t t = (1500000000ULL + s * 7 + i) * 1000000000ULL + s;
+            const time_t second = static_cast<time_t>(t / 1000000000ULL);
+            struct tm tm;
+            ::gmtime_r(&second, &tm);
+            char expected[40];
+            std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%S", &tm);
+            timestamp::format(buffer, sizeof(buffer), t, rfc3339, 9);
+            if (std::string(buffer).substr(0, 19) != expected) {
+              ok = false;
+            }
+          }
+        }));
+  } // End of 'for' statement
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(ok, "test_timestamp_2 failed, wrong concurrent formatting");
+}
+
 /**
  * @class helpers::ibstream test suite implementation
  */
@@ -753,6 +948,65 @@ TEST(ibstream_test_suite, ibstream_13) {
   //clog << ">>> test_ibstream_13 done" << endl;
 }
 
+/**
+ * @brief Test case for unaligned multi-byte reads
+ * @see helpers::ibstream::read_bits
+ * @see helpers::ibstream::read
+ */
+TEST(ibstream_test_suite, ibstream_14) {
+  vector<unsigned char> input_buffer = { 0xca, 0xfe, 0xde, 0xca, 0x70 }; // 32 + 4 bits length
+  helpers::ibstream codec(input_buffer, 32 + 4);
+  vector<unsigned char> output_buffer;
+  codec.read_bits(output_buffer, 4);
+  codec.read_bits(output_buffer, 20);
+  ASSERT_TRUE_MSG(codec.tellg() == 24, "test_ibstream_14 failed, wrong index position");
+  ASSERT_TRUE_MSG(output_buffer.size() == 3, "test_ibstream_14 failed, wrong length");
+  ASSERT_TRUE_MSG(output_buffer[0] == 0xaf, "test_ibstream_14 failed, 0xaf expected");
+  ASSERT_TRUE_MSG(output_buffer[1] == 0xed, "test_ibstream_14 failed, 0xed expected");
+  ASSERT_TRUE_MSG(output_buffer[2] == 0xe0, "test_ibstream_14 failed, 0xe0 expected");
+  codec.seekg(4);
+  uint16_t value;
+  ASSERT_TRUE_MSG(codec.read<uint16_t>(value, 12) == 12, "test_ibstream_14 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0xafe, "test_ibstream_14 failed, 0xafe expected");
+  uint64_t long_value;
+  ASSERT_TRUE_MSG(codec.read<uint64_t>(long_value) == 20, "test_ibstream_14 failed, wrong returned code");
+  ASSERT_TRUE_MSG(long_value == 0xdeca7, "test_ibstream_14 failed, 0xdeca7 expected");
+  ASSERT_TRUE_MSG(codec.gremaining() == 0, "test_ibstream_14 failed, wrong remaining length");
+}
+
+/**
+ * @brief Test case for the borrowing mode
+ * @see helpers::ibstream::read_span
+ * @see helpers::ibstream::copy
+ */
+TEST(ibstream_test_suite, ibstream_15) {
+  vector<unsigned char> input_buffer = { 0xca, 0xfe, 0xde, 0xca, 0x70 }; // 32 + 4 bits length
+  helpers::ibstream codec(input_buffer.data(), 32 + 4);
+  ASSERT_TRUE_MSG(codec.is_view(), "test_ibstream_15 failed, the stream shall borrow its data");
+  ASSERT_TRUE_MSG(codec.rdbuf() == input_buffer.data(), "test_ibstream_15 failed, the data shall not be copied");
+  uint8_t value;
+  codec.read<uint8_t>(value);
+  helpers::byte_span span;
+  ASSERT_TRUE_MSG(codec.read_span(span, 2) == 16, "test_ibstream_15 failed, wrong returned code");
+  ASSERT_TRUE_MSG(span.data() == input_buffer.data() + 1, "test_ibstream_15 failed, the span shall borrow the input data");
+  ASSERT_TRUE_MSG((span.size() == 2) && (span[0] == 0xfe) && (span[1] == 0xde), "test_ibstream_15 failed, wrong span");
+  ASSERT_TRUE_MSG(span.subspan(1).to_vector() == vector<unsigned char>(1, 0xde), "test_ibstream_15 failed, wrong subspan");
+  ASSERT_TRUE_MSG(codec.read_span(span, 2) == 0, "test_ibstream_15 failed, not enough bytes");
+  codec.ignore(4);
+  ASSERT_TRUE_MSG(codec.read_span(span, 1) == 0, "test_ibstream_15 failed, position not aligned");
+
+  helpers::ibstream copy(codec);
+  codec.copy();
+  ASSERT_TRUE_MSG(!codec.is_view(), "test_ibstream_15 failed, the stream shall own its data");
+  input_buffer[3] = 0x00;
+  ASSERT_TRUE_MSG(copy.rdbuf() == input_buffer.data(), "test_ibstream_15 failed, the copy shall borrow the same data");
+  codec.read<uint8_t>(value);
+  ASSERT_TRUE_MSG(value == 0xa7, "test_ibstream_15 failed, 0xa7 expected");
+  helpers::ibstream owner(input_buffer, 32 + 4);
+  helpers::ibstream copy2(owner);
+  ASSERT_TRUE_MSG((copy2.rdbuf() != owner.rdbuf()) && (copy2 == owner), "test_ibstream_15 failed, the copy shall own its data");
+}
+
 /**
  * @class helpers::obstream test suite implementation
  */
@@ -1100,6 +1354,1386 @@ TEST(obstream_test_suite, obstream_12) {
   //clog << ">>> test_obstream_12 done" << endl;
 }
 
+/**
+ * @brief Test case for unaligned fields
+ * @see helpers::obstream::write
+ * @see helpers::obstream::write_bits
+ */
+TEST(obstream_test_suite, obstream_13) {
+  helpers::obstream codec(2);
+  codec.write<uint8_t>(0x0c, 4);
+  codec.write<uint16_t>(0xafe, 12);
+  vector<unsigned char> input_buffer = { 0xde, 0xca, 0x70 };
+  codec.write_bits(input_buffer, 20);
+  codec.write<uint64_t>(0xfedcba9876543210, 64);
+  ASSERT_TRUE_MSG(codec.gcount() == 100, "test_obstream_13 failed, wrong length");
+  helpers::ibstream reader(codec.to_bytes(), codec.gcount());
+  uint64_t value;
+  reader.read<uint64_t>(value, 36);
+  ASSERT_TRUE_MSG(value == 0xcafedeca7, "test_obstream_13 failed, 0xcafedeca7 expected");
+  reader.read<uint64_t>(value);
+  ASSERT_TRUE_MSG(value == 0xfedcba9876543210, "test_obstream_13 failed, 0xfedcba9876543210 expected");
+  codec.seekp(4);
+  codec.write<uint16_t>(0x123, 12);
+  ASSERT_TRUE_MSG(codec.to_bytes()[0] == 0xc1, "test_obstream_13 failed, 0xc1 expected");
+  ASSERT_TRUE_MSG(codec.to_bytes()[1] == 0x23, "test_obstream_13 failed, 0x23 expected");
+  ASSERT_TRUE_MSG(codec.to_bytes()[2] == 0xde, "test_obstream_13 failed, 0xde expected");
+}
+
+/**
+ * @class helpers::bit_reader/helpers::bit_writer test suite implementation
+ */
+class bit_stream_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for MSB-first reads
+ * @see helpers::bit_reader::read
+ * @see helpers::bit_reader::peek
+ * @see helpers::bit_reader::skip
+ * @see helpers::bit_reader::seek
+ */
+TEST(bit_stream_test_suite, bit_reader_1) {
+  vector<unsigned char> input_buffer = converter::get_instance().hexa_to_bytes("0123456789abcdeffedcba9876543210");
+  helpers::bit_reader reader(input_buffer.data(), 8 * input_buffer.size());
+  uint64_t value;
+  ASSERT_TRUE_MSG(reader.read(value, 4) == 4, "test_bit_reader_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0x0, "test_bit_reader_1 failed, 0x0 expected");
+  ASSERT_TRUE_MSG(reader.read(value, 64) == 64, "test_bit_reader_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0x123456789abcdeff, "test_bit_reader_1 failed, 0x123456789abcdeff expected");
+  ASSERT_TRUE_MSG(reader.peek(value, 12) == 12, "test_bit_reader_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0xedc, "test_bit_reader_1 failed, 0xedc expected");
+  ASSERT_TRUE_MSG(reader.position() == 68, "test_bit_reader_1 failed, wrong position");
+  ASSERT_TRUE_MSG(reader.skip(20) == 20, "test_bit_reader_1 failed, wrong returned code");
+  reader.read(value, 8);
+  ASSERT_TRUE_MSG(value == 0x98, "test_bit_reader_1 failed, 0x98 expected");
+  ASSERT_TRUE_MSG(reader.read(value, 64) == 32, "test_bit_reader_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0x76543210, "test_bit_reader_1 failed, 0x76543210 expected");
+  ASSERT_TRUE_MSG(reader.remaining() == 0, "test_bit_reader_1 failed, wrong remaining length");
+  ASSERT_TRUE_MSG(reader.seek(3) == 0, "test_bit_reader_1 failed, wrong returned code");
+  vector<unsigned char> output_buffer(9, 0x00);
+  ASSERT_TRUE_MSG(reader.read_bytes(output_buffer.data(), 66) == 66, "test_bit_reader_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(converter::get_instance().bytes_to_hexa(output_buffer) == "091a2b3c4d5e6f7fc0", "test_bit_reader_1 failed, wrong bytes");
+  ASSERT_TRUE_MSG(reader.seek(8 * input_buffer.size() + 1) == -1, "test_bit_reader_1 failed, wrong returned code");
+}
+
+/**
+ * @brief Test case for unaligned read_bytes of whole 7-byte chunks into an exactly sized buffer
+ * @see helpers::bit_reader::read_bytes
+ */
+TEST(bit_stream_test_suite, bit_reader_3) {
+  vector<unsigned char> input_buffer = converter::get_instance().hexa_to_bytes("0123456789abcdeffedcba98765432100123456789");
+  const uint32_t sizes[] = { 56, 112 };
+  for (uint32_t s = 0; s < 2; s++) {
+    for (uint32_t order = 0; order < 2; order++) {
+      bit_order o = (order == 0) ? bit_order::msb_first : bit_order::lsb_first;
+      helpers::bit_reader reader(input_buffer.data(), 8 * input_buffer.size(), o);
+      helpers::bit_reader expected(input_buffer.data(), 8 * input_buffer.size(), o);
+      reader.seek(5);
+      expected.seek(5);
+      vector<unsigned char> output_buffer(sizes[s] / 8 + 1, 0xa5); // The last byte is a guard
+      ASSERT_TRUE_MSG(reader.read_bytes(output_buffer.data(), sizes[s]) == sizes[s], "test_bit_reader_3 failed, wrong returned code");
+      ASSERT_TRUE_MSG(output_buffer[sizes[s] / 8] == 0xa5, "test_bit_reader_3 failed, buffer overflow");
+      for (uint32_t i = 0; i < sizes[s] / 8; i++) {
+        uint64_t value;
+        expected.read(value, 8);
+        ASSERT_TRUE_MSG(output_buffer[i] == value, "test_bit_reader_3 failed, wrong byte " << i);
+      } // End of 'for' statement
+    } // End of 'for' statement
+  } // End of 'for' statement
+}
+
+/**
+ * @brief Test case for LSB-first reads
+ * @see helpers::bit_reader::read
+ */
+TEST(bit_stream_test_suite, bit_reader_2) {
+  vector<unsigned char> input_buffer = { 0xca, 0xfe, 0xde, 0xca, 0x70 };
+  helpers::bit_reader reader(input_buffer.data(), 36, bit_order::lsb_first);
+  uint64_t value;
+  reader.read(value, 4);
+  ASSERT_TRUE_MSG(value == 0xa, "test_bit_reader_2 failed, 0xa expected");
+  reader.read(value, 12);
+  ASSERT_TRUE_MSG(value == 0xfec, "test_bit_reader_2 failed, 0xfec expected");
+  ASSERT_TRUE_MSG(reader.read(value, 32) == 20, "test_bit_reader_2 failed, wrong returned code");
+  ASSERT_TRUE_MSG(value == 0x0cade, "test_bit_reader_2 failed, 0x0cade expected");
+}
+
+/**
+ * @brief Test case for bit_writer/bit_reader round trip in both bit orders
+ * @see helpers::bit_writer::write
+ * @see helpers::bit_writer::write_bytes
+ * @see helpers::bit_writer::flush
+ */
+TEST(bit_stream_test_suite, bit_writer_1) {
+  const bit_order orders[] = { bit_order::msb_first, bit_order::lsb_first };
+  for (uint32_t o = 0; o < 2; o++) {
+    helpers::bit_writer writer(4, orders[o]);
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (uint32_t i = 0; i < 1000; i++) {
+      seed = seed * 6364136223846793005 + 1442695040888963407;
+      writer.write(seed, 1 + (i % 64));
+    } // End of 'for' statement
+    vector<unsigned char> input_buffer = { 0xca, 0xfe, 0x70 };
+    writer.write_bytes(input_buffer.data(), 20);
+    uint32_t size = writer.position();
+    const vector<unsigned char> & output_buffer = writer.flush();
+    ASSERT_TRUE_MSG(output_buffer.size() == (size + 7) / 8, "test_bit_writer_1 failed, wrong length");
+
+    helpers::bit_reader reader(output_buffer.data(), size, orders[o]);
+    seed = 0x9e3779b97f4a7c15;
+    uint64_t value;
+    for (uint32_t i = 0; i < 1000; i++) {
+      seed = seed * 6364136223846793005 + 1442695040888963407;
+      uint32_t bits = 1 + (i % 64);
+      reader.read(value, bits);
+      ASSERT_TRUE_MSG(value == ((bits == 64) ? seed : (seed & ((static_cast<uint64_t>(1) << bits) - 1))), "test_bit_writer_1 failed, wrong value");
+    } // End of 'for' statement
+    vector<unsigned char> bytes(3, 0x00);
+    reader.read_bytes(bytes.data(), 20);
+    ASSERT_TRUE_MSG(bytes[0] == 0xca, "test_bit_writer_1 failed, 0xca expected");
+    ASSERT_TRUE_MSG(bytes[1] == 0xfe, "test_bit_writer_1 failed, 0xfe expected");
+    ASSERT_TRUE_MSG(bytes[2] == ((orders[o] == bit_order::msb_first) ? 0x70 : 0x00), "test_bit_writer_1 failed, wrong last byte");
+    ASSERT_TRUE_MSG(reader.remaining() == 0, "test_bit_writer_1 failed, wrong remaining length");
+  } // End of 'for' statement
+}
+
+/**
+ * @brief GeoNetworking basic header layout
+ */
+struct gn_basic_header {
+  uint8_t version;
+  uint8_t next_header;
+  uint8_t lifetime_multiplier;
+  uint8_t lifetime_base;
+  uint8_t remaining_hop_limit;
+};
+typedef bit_codec<gn_basic_header,
+                  bit_field<gn_basic_header, uint8_t, &gn_basic_header::version, 4>,
+                  bit_field<gn_basic_header, uint8_t, &gn_basic_header::next_header, 4>,
+                  bit_reserved<8>,
+                  bit_field<gn_basic_header, uint8_t, &gn_basic_header::lifetime_multiplier, 6>,
+                  bit_field<gn_basic_header, uint8_t, &gn_basic_header::lifetime_base, 2>,
+                  bit_field<gn_basic_header, uint8_t, &gn_basic_header::remaining_hop_limit, 8> > gn_basic_header_codec;
+
+/**
+ * @brief Test case for fixed-width layouts
+ * @see helpers::bit_codec::decode
+ * @see helpers::bit_codec::encode
+ */
+TEST(bit_stream_test_suite, bit_codec_1) {
+  vector<unsigned char> input_buffer = converter::get_instance().hexa_to_bytes("01231b01");
+  gn_basic_header header;
+  ASSERT_TRUE_MSG(gn_basic_header_codec::min_bits == 32, "test_bit_codec_1 failed, wrong minimal size");
+  ASSERT_TRUE_MSG(gn_basic_header_codec::decode(input_buffer.data(), 32, header) == 0, "test_bit_codec_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG((header.version == 0) && (header.next_header == 1), "test_bit_codec_1 failed, wrong version/next header");
+  ASSERT_TRUE_MSG((header.lifetime_multiplier == 6) && (header.lifetime_base == 3), "test_bit_codec_1 failed, wrong lifetime");
+  ASSERT_TRUE_MSG(header.remaining_hop_limit == 1, "test_bit_codec_1 failed, wrong remaining hop limit");
+  ASSERT_TRUE_MSG(converter::get_instance().bytes_to_hexa(gn_basic_header_codec::encode(header)) == "01001b01", "test_bit_codec_1 failed, wrong encoding");
+  ASSERT_TRUE_MSG(gn_basic_header_codec::decode(input_buffer.data(), 31, header) == -1, "test_bit_codec_1 failed, truncated input expected");
+}
+
+/**
+ * @brief Layout with signed, little endian, variable-width and array fields
+ */
+struct codec_message {
+  int8_t offset;
+  uint16_t port;
+  uint8_t width;
+  uint32_t value;
+  vector<uint8_t> payload;
+  vector<uint16_t> samples;
+};
+typedef bit_codec<codec_message,
+                  bit_field<codec_message, int8_t, &codec_message::offset, 5>,
+                  bit_reserved<3>,
+                  bit_field<codec_message, uint16_t, &codec_message::port, 16, byte_order::little_endian>,
+                  bit_field<codec_message, uint8_t, &codec_message::width, 5>,
+                  bit_field_var<codec_message, uint32_t, &codec_message::value, uint8_t, &codec_message::width>,
+                  bit_array<codec_message, uint8_t, &codec_message::payload, 8>,
+                  bit_array<codec_message, uint16_t, &codec_message::samples, 4, 12> > codec_message_codec;
+
+/**
+ * @brief Test case for variable-width layouts
+ * @see helpers::bit_codec::decode
+ * @see helpers::bit_codec::encode
+ */
+TEST(bit_stream_test_suite, bit_codec_2) {
+  codec_message message;
+  message.offset = -3;
+  message.port = 0x1234;
+  message.width = 19;
+  message.value = 0x5abcd;
+  message.payload = { 0xca, 0xfe, 0xde };
+  message.samples = { 0xabc, 0x123 };
+  vector<unsigned char> output_buffer = codec_message_codec::encode(message);
+  ASSERT_TRUE_MSG(codec_message_codec::min_bits == 5 + 3 + 16 + 5 + 8 + 4, "test_bit_codec_2 failed, wrong minimal size");
+  ASSERT_TRUE_MSG(output_buffer.size() == (5 + 3 + 16 + 5 + 19 + 8 + 24 + 4 + 24 + 7) / 8, "test_bit_codec_2 failed, wrong length");
+  ASSERT_TRUE_MSG((output_buffer[0] == 0xe8) && (output_buffer[1] == 0x34) && (output_buffer[2] == 0x12), "test_bit_codec_2 failed, wrong header");
+
+  codec_message decoded;
+  ASSERT_TRUE_MSG(codec_message_codec::decode(output_buffer.data(), 8 * output_buffer.size(), decoded) == 0, "test_bit_codec_2 failed, wrong returned code");
+  ASSERT_TRUE_MSG((decoded.offset == -3) && (decoded.port == 0x1234), "test_bit_codec_2 failed, wrong offset/port");
+  ASSERT_TRUE_MSG((decoded.width == 19) && (decoded.value == 0x5abcd), "test_bit_codec_2 failed, wrong variable-width value");
+  ASSERT_TRUE_MSG(decoded.payload == message.payload, "test_bit_codec_2 failed, wrong payload");
+  ASSERT_TRUE_MSG(decoded.samples == message.samples, "test_bit_codec_2 failed, wrong samples");
+  ASSERT_TRUE_MSG(codec_message_codec::decode(output_buffer.data(), 8 * output_buffer.size() - 8, decoded) == -1, "test_bit_codec_2 failed, truncated input expected");
+
+  // Fields not fitting into their width
+  message.width = 33;
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, invalid width expected");
+  bit_writer writer(16);
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message, writer) == -1, "test_bit_codec_2 failed, wrong returned code");
+  message.width = 19;
+  message.samples.assign(16, 0x001); // 4-bit element count
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, too many elements expected");
+  message.samples.resize(15);
+  ASSERT_TRUE_MSG(!codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, 15 elements expected to fit");
+  message.samples[3] = 0x1000; // 12-bit elements
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, too large element expected");
+  message.samples[3] = 0x0fff;
+  const int8_t offsets[] = { -16, 15, -17, 16 }; // 5-bit signed field
+  for (uint32_t i = 0; i < 4; i++) {
+    message.offset = offsets[i];
+    ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty() == (i >= 2), "test_bit_codec_2 failed, wrong signed range");
+  } // End of 'for' statement
+  message.offset = -3;
+  message.value = 0x80000; // 19-bit variable-width field
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, too large variable-width value expected");
+  message.value = 0x7ffff;
+  ASSERT_TRUE_MSG(!codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, 0x7ffff expected to fit");
+  message.width = 32; // 5-bit width field
+  ASSERT_TRUE_MSG(codec_message_codec::encode(message).empty(), "test_bit_codec_2 failed, too large fixed-width value expected");
+}
+
+/**
+ * @class helpers::mapped_file test suite implementation
+ */
+class mapped_file_test_suite : public ::testing::Test {
+protected:
+  std::string _file_name;
+  virtual void SetUp() {
+    char file_name[] = "/tmp/test_mapped_file_XXXXXX";
+    int fd = ::mkstemp(file_name);
+    ASSERT_TRUE(fd != -1);
+    const char content[] = "$GPGGA,123519\r\n$GPRMC,123520\n\nlast";
+    ASSERT_TRUE(::write(fd, content, sizeof(content) - 1) == sizeof(content) - 1);
+    ::close(fd);
+    _file_name = file_name;
+  };
+  virtual void TearDown() { ::unlink(_file_name.c_str()); };
+};
+
+/**
+ * @brief Test case for the mapping of a file
+ * @see helpers::mapped_file::open
+ * @see helpers::mapped_file::span
+ */
+TEST_F(mapped_file_test_suite, mapped_file_1) {
+  helpers::mapped_file file(_file_name, mapped_file::random_access, true);
+  ASSERT_TRUE_MSG(file.is_open(), "test_mapped_file_1 failed, file not mapped");
+  vector<unsigned char> buffer;
+  ASSERT_TRUE_MSG(helper::get_instance().file_load(_file_name, buffer) == static_cast<int>(file.size()), "test_mapped_file_1 failed, wrong file size");
+  ASSERT_TRUE_MSG(file.span().to_vector() == buffer, "test_mapped_file_1 failed, wrong content");
+  ASSERT_TRUE_MSG(helper::get_instance().file_size(_file_name) == static_cast<int>(file.size()), "test_mapped_file_1 failed, wrong file size");
+  ASSERT_TRUE_MSG(file.advise(mapped_file::sequential) == 0, "test_mapped_file_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(file.prefetch(3, 10) == 0, "test_mapped_file_1 failed, wrong returned code");
+
+  // The bit streams read the mapping in place
+  helpers::ibstream ibs(file.span(), 8 * file.size());
+  ASSERT_TRUE_MSG(ibs.is_view() && (ibs.rdbuf() == file.data()), "test_mapped_file_1 failed, the stream shall borrow the mapping");
+  helpers::bit_reader reader(file.data(), 8 * file.size());
+  uint64_t value;
+  reader.read(value, 16);
+  ASSERT_TRUE_MSG(value == 0x2447, "test_mapped_file_1 failed, 0x2447 expected");
+
+  helpers::mapped_file moved(std::move(file));
+  ASSERT_TRUE_MSG(!file.is_open() && moved.is_open() && (moved.size() == buffer.size()), "test_mapped_file_1 failed, wrong move");
+  moved.close();
+  ASSERT_TRUE_MSG(!moved.is_open() && (moved.data() == nullptr), "test_mapped_file_1 failed, wrong close");
+  ASSERT_TRUE_MSG(file.open("/tmp/not_existing_mapped_file") == -1, "test_mapped_file_1 failed, wrong returned code");
+  ASSERT_TRUE_MSG(file.open("/tmp") == -1, "test_mapped_file_1 failed, a directory cannot be mapped");
+}
+
+/**
+ * @brief Test case for the sequential reader
+ * @see helpers::mapped_file_reader::read_line
+ * @see helpers::mapped_file_reader::read
+ * @see helpers::mapped_file_reader::seek
+ */
+TEST_F(mapped_file_test_suite, mapped_file_2) {
+  helpers::mapped_file file(_file_name);
+  helpers::mapped_file_reader reader(file, 1);
+  helpers::byte_span line;
+  ASSERT_TRUE_MSG(reader.read_line(line) == 0, "test_mapped_file_2 failed, wrong returned code");
+  ASSERT_TRUE_MSG(std::string(line.begin(), line.end()) == "$GPGGA,123519", "test_mapped_file_2 failed, wrong first line");
+  ASSERT_TRUE_MSG(line.data() == file.data(), "test_mapped_file_2 failed, the line shall borrow the mapping");
+  reader.read_line(line);
+  ASSERT_TRUE_MSG(std::string(line.begin(), line.end()) == "$GPRMC,123520", "test_mapped_file_2 failed, wrong second line");
+  ASSERT_TRUE_MSG((reader.read_line(line) == 0) && line.empty(), "test_mapped_file_2 failed, empty line expected");
+  reader.read_line(line);
+  ASSERT_TRUE_MSG(std::string(line.begin(), line.end()) == "last", "test_mapped_file_2 failed, wrong last line");
+  ASSERT_TRUE_MSG(reader.eof() && (reader.read_line(line) == -1), "test_mapped_file_2 failed, end of file expected");
+
+  reader.seek(1);
+  helpers::byte_span block;
+  ASSERT_TRUE_MSG(reader.read(block, 5) == 5, "test_mapped_file_2 failed, wrong returned code");
+  ASSERT_TRUE_MSG(std::string(block.begin(), block.end()) == "GPGGA", "test_mapped_file_2 failed, wrong block");
+  ASSERT_TRUE_MSG(reader.read(block, 1000) == file.size() - 6, "test_mapped_file_2 failed, the block shall be truncated");
+  ASSERT_TRUE_MSG(reader.remaining() == 0, "test_mapped_file_2 failed, wrong remaining length");
+
+  // Empty file
+  helpers::mapped_file empty;
+  ASSERT_TRUE_MSG(empty.open("/dev/null") == -1, "test_mapped_file_2 failed, only regular files can be mapped");
+  ::truncate(_file_name.c_str(), 0);
+  ASSERT_TRUE_MSG((empty.open(_file_name) == 0) && (empty.size() == 0) && empty.span().empty(), "test_mapped_file_2 failed, wrong empty file");
+  helpers::mapped_file_reader empty_reader(empty);
+  ASSERT_TRUE_MSG(empty_reader.eof() && (empty_reader.read_line(line) == -1), "test_mapped_file_2 failed, end of file expected");
+}
+
+/**
+ * @class helpers::thread_pool test suite implementation
+ */
+class thread_pool_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for the owner/thief sides of the deque
+ * @see helpers::thread::work_stealing_deque
+ */
+TEST(thread_pool_test_suite, work_stealing_deque_1) {
+  helpers::thread::work_stealing_deque deque(2);
+  vector<task_t> tasks(100);
+  ASSERT_TRUE_MSG(deque.empty() && (deque.pop() == nullptr) && (deque.steal() == nullptr), "test_work_stealing_deque_1 failed, empty deque expected");
+  for (size_t i = 0; i < tasks.size(); i++) { // Grows from 2 to 128 slots
+    deque.push(&tasks[i]);
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(deque.pop() == &tasks[99], "test_work_stealing_deque_1 failed, the owner shall get the newest task");
+  ASSERT_TRUE_MSG(deque.steal() == &tasks[0], "test_work_stealing_deque_1 failed, a thief shall get the oldest task");
+
+  // Concurrent thieves: each task is taken exactly once
+  std::atomic<uint32_t> taken(2);
+  std::atomic<bool> done(false);
+  vector<std::thread> thieves;
+  for (int i = 0; i < 3; i++) {
+    thieves.push_back(std::thread([&]() {
+          while (!done || !deque.empty()) {
+            if (deque.steal() != nullptr) {
+              taken += 1;
+            }
+          }
+        }));
+  } // End of 'for' statement
+  uint32_t pushed = 100;
+  for (int round = 0; round < 10000; round++) {
+    deque.push(&tasks[round % 100]);
+    pushed += 1;
+    if ((round % 3 == 0) && (deque.pop() != nullptr)) {
+      taken += 1;
+    }
+  } // End of 'for' statement
+  done = true;
+  for (vector<std::thread>::iterator it = thieves.begin(); it != thieves.end(); ++it) {
+    it->join();
+  } // End of 'for' statement
+  while (deque.pop() != nullptr) {
+    taken += 1;
+  } // End of 'while' statement
+  ASSERT_TRUE_MSG(taken == pushed, "test_work_stealing_deque_1 failed, tasks lost or duplicated");
+}
+
+/**
+ * @brief Test case for submit and post
+ * @see helpers::thread::thread_pool::submit
+ * @see helpers::thread::thread_pool::post
+ * @see helpers::thread::thread_pool::wait
+ */
+TEST(thread_pool_test_suite, thread_pool_1) {
+  helpers::thread::thread_pool pool(4);
+  ASSERT_TRUE_MSG((pool.size() == 4) && (pool.current_worker() == -1), "test_thread_pool_1 failed, wrong pool");
+  std::future<int> answer = pool.submit([]() { return 42; });
+  std::future<int32_t> worker = pool.submit([&pool]() { return pool.current_worker(); });
+  std::future<void> failure = pool.submit([]() { throw std::runtime_error("failure"); });
+  ASSERT_TRUE_MSG(answer.get() == 42, "test_thread_pool_1 failed, 42 expected");
+  const int32_t index = worker.get();
+  ASSERT_TRUE_MSG((index >= 0) && (index < 4), "test_thread_pool_1 failed, wrong worker index");
+  ASSERT_THROW(failure.get(), std::runtime_error);
+
+  // Tasks spawning and waiting for tasks
+  std::future<uint64_t> sum = pool.submit([&pool]() {
+      vector<std::future<uint64_t> > parts;
+      for (uint64_t i = 0; i < 16; i++) {
+        parts.push_back(pool.submit([i]() { return i * 1000; }));
+      }
+      uint64_t total = 0;
+      for (size_t i = 0; i < parts.size(); i++) {
+        pool.wait(parts[i]);
+        total += parts[i].get();
+      }
+      return total;
+    });
+  ASSERT_TRUE_MSG(sum.get() == 120000, "test_thread_pool_1 failed, 120000 expected");
+
+  std::atomic<uint32_t> counter(0);
+  {
+    helpers::thread::thread_pool local(2);
+    for (int i = 0; i < 1000; i++) {
+      local.post([&counter]() { counter += 1; });
+    } // End of 'for' statement
+  } // The dtor executes the queued tasks
+  ASSERT_TRUE_MSG(counter == 1000, "test_thread_pool_1 failed, 1000 tasks expected");
+  ASSERT_TRUE_MSG(&helpers::thread::thread_pool::get_instance() == &helpers::thread::thread_pool::get_instance(), "test_thread_pool_1 failed, wrong shared pool");
+}
+
+/**
+ * @brief Test case for parallel_for
+ * @see helpers::thread::thread_pool::parallel_for
+ */
+TEST(thread_pool_test_suite, thread_pool_2) {
+  helpers::thread::thread_pool pool(4, true);
+  vector<uint32_t> values(100000, 0);
+  pool.parallel_for(0, values.size(), [&values](const size_t p_index) { values[p_index] += static_cast<uint32_t>(p_index); });
+  bool ok = true;
+  for (size_t i = 0; i < values.size(); i++) {
+    ok &= (values[i] == i);
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(ok, "test_thread_pool_2 failed, each index shall be processed once");
+
+  // Nested ranges
+  std::atomic<uint64_t> total(0);
+  pool.parallel_for(0, 64, [&](const size_t p_row) {
+      pool.parallel_for(0, 1000, [&](const size_t p_column) { total += p_row * p_column; }, 100);
+    }, 1);
+  ASSERT_TRUE_MSG(total == 2016ULL * 499500ULL, "test_thread_pool_2 failed, wrong nested total");
+
+  std::atomic<uint32_t> processed(0);
+  ASSERT_THROW(pool.parallel_for(0, 1000, [&](const size_t p_index) {
+        processed += 1;
+        if (p_index == 10) {
+          throw std::out_of_range("index");
+        }
+      }, 1), std::out_of_range);
+  ASSERT_TRUE_MSG(processed < 1000, "test_thread_pool_2 failed, the remaining chunks shall be skipped");
+  pool.parallel_for(10, 10, [](const size_t) { throw std::logic_error("empty range"); });
+}
+
+/**
+ * @class helpers::spsc_ring and helpers::mpmc_ring test suite implementation
+ */
+class ring_buffer_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for the single-threaded behaviour of the rings
+ * @see helpers::spsc_ring
+ * @see helpers::mpmc_ring
+ */
+TEST(ring_buffer_test_suite, ring_buffer_1) {
+  helpers::spsc_ring<uint32_t> spsc(6);
+  ASSERT_TRUE_MSG((spsc.capacity() == 8) && spsc.empty(), "test_ring_buffer_1 failed, wrong capacity");
+  uint32_t values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  uint32_t output[10] = { 0 };
+  ASSERT_TRUE_MSG(spsc.push(values, 5) == 5, "test_ring_buffer_1 failed, wrong push count");
+  ASSERT_TRUE_MSG((spsc.pop(output, 3) == 3) && (output[2] == 2), "test_ring_buffer_1 failed, wrong pop");
+  ASSERT_TRUE_MSG(spsc.push(values, 10) == 6, "test_ring_buffer_1 failed, the ring shall be full"); // Wraps around
+  ASSERT_TRUE_MSG(!spsc.try_push(values[0]) && (spsc.size() == 8), "test_ring_buffer_1 failed, full ring expected");
+  ASSERT_TRUE_MSG(spsc.pop(output, 10) == 8, "test_ring_buffer_1 failed, wrong pop count");
+  ASSERT_TRUE_MSG((output[0] == 3) && (output[1] == 4) && (output[2] == 0) && (output[7] == 5), "test_ring_buffer_1 failed, wrong order");
+  uint32_t value;
+  ASSERT_TRUE_MSG(!spsc.try_pop(value) && (spsc.pop_wait(value, 10) == -1), "test_ring_buffer_1 failed, empty ring expected");
+  ASSERT_THROW(helpers::spsc_ring<uint32_t> invalid(0), std::invalid_argument);
+
+  helpers::mpmc_ring<uint64_t> mpmc(4, ring_wait_t::futex);
+  for (uint64_t i = 0; i < 4; i++) {
+    ASSERT_TRUE_MSG(mpmc.try_push(i * 10), "test_ring_buffer_1 failed, wrong push");
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(!mpmc.try_push(40) && (mpmc.push_wait(40, 10) == -1), "test_ring_buffer_1 failed, full ring expected");
+  uint64_t output64[4];
+  ASSERT_TRUE_MSG((mpmc.pop(output64, 3) == 3) && (output64[2] == 20), "test_ring_buffer_1 failed, wrong pop");
+  const uint64_t values64[3] = { 40, 50, 60 };
+  ASSERT_TRUE_MSG((mpmc.push(values64, 3) == 3) && (mpmc.size() == 4), "test_ring_buffer_1 failed, wrong batch push");
+  ASSERT_TRUE_MSG((mpmc.pop(output64, 4) == 4) && (output64[0] == 30) && (output64[3] == 60), "test_ring_buffer_1 failed, wrong order");
+  ASSERT_TRUE_MSG(mpmc.empty(), "test_ring_buffer_1 failed, empty ring expected");
+}
+
+/**
+ * @brief Test case for producer/consumer threads with the different wait modes
+ * @see helpers::spsc_ring::push_wait
+ * @see helpers::mpmc_ring::pop_wait
+ */
+TEST(ring_buffer_test_suite, ring_buffer_2) {
+  const uint32_t count = 200000;
+  const ring_wait_t modes[] = { ring_wait_t::spin, ring_wait_t::futex, ring_wait_t::eventfd };
+  for (size_t m = 0; m < sizeof(modes) / sizeof(ring_wait_t); m++) {
+    helpers::spsc_ring<uint32_t> ring(64, modes[m]);
+    std::thread producer([&ring, count]() {
+        for (uint32_t i = 0; i < count; i++) {
+          ring.push_wait(i);
+        }
+      });
+    bool ordered = true;
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t value;
+      ring.pop_wait(value);
+      ordered &= (value == i);
+    } // End of 'for' statement
+    producer.join();
+    ASSERT_TRUE_MSG(ordered, "test_ring_buffer_2 failed, values lost or reordered");
+  } // End of 'for' statement
+
+  // A consumer in a poll() loop
+  helpers::spsc_ring<uint32_t> ring(16, ring_wait_t::eventfd);
+  ASSERT_TRUE_MSG(ring.get_fd() != -1, "test_ring_buffer_2 failed, eventfd expected");
+  uint32_t value;
+  ASSERT_TRUE_MSG(!ring.try_pop(value), "test_ring_buffer_2 failed, empty ring expected"); // Arms the eventfd
+  std::thread producer([&ring]() { this_thread::sleep_for(chrono::milliseconds(10)); ring.try_push(42); ring.try_push(43); });
+  struct pollfd fd = { ring.get_fd(), POLLIN, 0 };
+  ASSERT_TRUE_MSG(::poll(&fd, 1, 1000) == 1, "test_ring_buffer_2 failed, the eventfd shall be signaled");
+  producer.join();
+  uint32_t values[4];
+  ASSERT_TRUE_MSG((ring.pop(values, 4) == 2) && (values[0] == 42) && (values[1] == 43), "test_ring_buffer_2 failed, wrong values");
+
+  // Multiple producers and consumers
+  helpers::mpmc_ring<uint32_t> mpmc(128, ring_wait_t::futex);
+  std::atomic<uint64_t> total(0);
+  vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&mpmc, t, count]() {
+          for (uint32_t i = t; i < count; i += 4) {
+            mpmc.push_wait(i);
+          }
+        }));
+    threads.push_back(std::thread([&mpmc, &total, count]() {
+          uint64_t sum = 0;
+          uint32_t batch[8];
+          for (uint32_t popped = 0; popped < count / 4; ) {
+            const uint32_t n = mpmc.pop(batch, (count / 4 - popped < 8) ? count / 4 - popped : 8);
+            for (uint32_t i = 0; i < n; i++) {
+              sum += batch[i];
+            }
+            popped += n;
+            if (n == 0) {
+              mpmc.pop_wait(batch[0]);
+              sum += batch[0];
+              popped += 1;
+            }
+          }
+          total += sum;
+        }));
+  } // End of 'for' statement
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(total == static_cast<uint64_t>(count) * (count - 1) / 2, "test_ring_buffer_2 failed, wrong total");
+}
+
+/**
+ * @brief Test case for a ring placed in memory shared with a child process
+ * @see helpers::spsc_ring::memory_size
+ */
+TEST(ring_buffer_test_suite, ring_buffer_3) {
+  const size_t size = helpers::mpmc_ring<uint64_t>::memory_size(32);
+  void * memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  ASSERT_TRUE(memory != MAP_FAILED);
+  helpers::mpmc_ring<uint64_t> ring(memory, 32, true);
+  ASSERT_THROW(helpers::mpmc_ring<uint64_t> wrong(memory, 64, false), std::invalid_argument);
+
+  pid_t child = ::fork();
+  if (child == 0) { // Producer process
+    helpers::mpmc_ring<uint64_t> producer(memory, 32, false);
+    for (uint64_t i = 1; i <= 10000; i++) {
+      producer.push_wait(i);
+    }
+    ::_exit(0);
+  }
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < 10000; i++) {
+    uint64_t value = 0;
+    if (ring.pop_wait(value, 5000) == -1) {
+      break;
+    }
+    sum += value;
+  } // End of 'for' statement
+  int status;
+  ::waitpid(child, &status, 0);
+  ::munmap(memory, size);
+  ASSERT_TRUE_MSG(sum == 10000ULL * 10001ULL / 2, "test_ring_buffer_3 failed, wrong total");
+}
+
+/**
+ * @class helpers::byte_buffer test suite implementation
+ */
+class byte_buffer_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for the inline and shared storages
+ * @see helpers::byte_buffer::slice
+ * @see helpers::byte_buffer::mutable_data
+ * @see helpers::byte_buffer::resize
+ */
+TEST(byte_buffer_test_suite, byte_buffer_1) {
+  const vector<uint8_t> small = { 0xca, 0xfe, 0xde, 0xca };
+  helpers::byte_buffer buffer(small);
+  ASSERT_TRUE_MSG(buffer.is_inline() && (buffer.size() == 4) && (buffer[1] == 0xfe), "test_byte_buffer_1 failed, small payloads shall be inline");
+  helpers::byte_buffer copy(buffer);
+  copy.mutable_data()[0] = 0x00;
+  ASSERT_TRUE_MSG((buffer[0] == 0xca) && (copy[0] == 0x00), "test_byte_buffer_1 failed, inline copies shall be independent");
+
+  vector<uint8_t> large(1500);
+  std::iota(large.begin(), large.end(), 0);
+  const uint8_t * storage = large.data();
+  helpers::byte_buffer packet(std::move(large));
+  ASSERT_TRUE_MSG(!packet.is_inline() && (packet.data() == storage) && large.empty(), "test_byte_buffer_1 failed, the vector storage shall be adopted");
+  helpers::byte_buffer shared(packet);
+  ASSERT_TRUE_MSG((shared.data() == packet.data()) && packet.is_shared(), "test_byte_buffer_1 failed, copies shall share the slab");
+  helpers::byte_buffer payload = packet.slice(100, 1000);
+  ASSERT_TRUE_MSG((payload.data() == storage + 100) && (payload.size() == 1000) && (payload[0] == 100), "test_byte_buffer_1 failed, slices shall share the slab");
+  helpers::byte_buffer header = packet.slice(0, 8);
+  ASSERT_TRUE_MSG(header.is_inline() && (header[7] == 7), "test_byte_buffer_1 failed, small slices shall be inline");
+  ASSERT_TRUE_MSG(packet.slice(2000).empty() && (packet.slice(1400).size() == 100), "test_byte_buffer_1 failed, slices shall be clamped");
+
+  // Explicit copy-on-write
+  shared.mutable_data()[0] = 0xff;
+  ASSERT_TRUE_MSG((shared.data() != storage) && (shared[0] == 0xff) && (packet[0] == 0x00), "test_byte_buffer_1 failed, writes shall not be visible to the other owners");
+  ASSERT_TRUE_MSG((shared == shared) && (shared != packet) && (shared.slice(1) == packet.slice(1)), "test_byte_buffer_1 failed, wrong comparison");
+  payload.resize(10);
+  ASSERT_TRUE_MSG((payload.data() == storage + 100) && (payload.size() == 10), "test_byte_buffer_1 failed, shrinking shall not copy");
+  payload.append(small.data(), small.size());
+  ASSERT_TRUE_MSG((payload.size() == 14) && payload.is_inline() && (payload[9] == 109) && (payload[13] == 0xca), "test_byte_buffer_1 failed, wrong append");
+
+  // Back to a vector
+  packet = helpers::byte_buffer();
+  vector<uint8_t> bytes = shared.release_vector();
+  ASSERT_TRUE_MSG(shared.empty() && (bytes.size() == 1500) && (bytes[0] == 0xff) && (bytes[1499] == (1499 & 0xff)), "test_byte_buffer_1 failed, wrong released vector");
+  helpers::byte_buffer grown(100);
+  ASSERT_TRUE_MSG((grown.size() == 100) && (grown[99] == 0x00), "test_byte_buffer_1 failed, wrong sized ctor");
+}
+
+/**
+ * @brief Test case for the bit streams and the concurrent owners
+ * @see helpers::ibstream::open
+ * @see helpers::obstream::release
+ */
+TEST(byte_buffer_test_suite, byte_buffer_2) {
+  helpers::obstream encoder(64);
+  for (uint32_t i = 0; i < 64; i++) {
+    encoder.write<uint32_t>(i);
+  } // End of 'for' statement
+  const uint32_t bits = encoder.gcount();
+  helpers::byte_buffer message = encoder.release();
+  ASSERT_TRUE_MSG((message.size() == 256) && (encoder.gcount() == 0), "test_byte_buffer_2 failed, wrong released buffer");
+
+  helpers::ibstream decoder(message, bits);
+  ASSERT_TRUE_MSG(!decoder.is_view() && (decoder.rdbuf() == message.data()), "test_byte_buffer_2 failed, the stream shall share the buffer");
+  helpers::ibstream copy(decoder);
+  ASSERT_TRUE_MSG(copy.rdbuf() == message.data(), "test_byte_buffer_2 failed, the copy shall share the buffer");
+  uint32_t value;
+  decoder.seekg(32 * 63);
+  decoder.read<uint32_t>(value);
+  ASSERT_TRUE_MSG(value == 63, "test_byte_buffer_2 failed, 63 expected");
+  message.clear();
+  copy.seekg(32 * 10);
+  copy.read<uint32_t>(value);
+  ASSERT_TRUE_MSG(value == 10, "test_byte_buffer_2 failed, the stream shall keep the buffer alive");
+
+  // The reference count is shared between threads
+  helpers::byte_buffer packet(std::vector<uint8_t>(1024, 0x5a));
+  std::atomic<uint32_t> errors(0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < 4; i++) {
+    threads.push_back(std::thread([packet, &errors]() {
+          for (uint32_t j = 0; j < 10000; j++) {
+            helpers::byte_buffer copy(packet);
+            helpers::byte_buffer slice = copy.slice(j % 512, 512);
+            if ((slice.size() != 512) || (slice[0] != 0x5a)) {
+              errors.fetch_add(1);
+            }
+          } // End of 'for' statement
+        }));
+  } // End of 'for' statement
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG((errors == 0) && !packet.is_shared(), "test_byte_buffer_2 failed, wrong reference count");
+}
+
+/**
+ * @class helpers::checksum test suite implementation
+ */
+class checksum_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+
+  /**
+   * @brief Bit-at-a-time reflected CRC-32, the reference implementation
+   */
+  static uint32_t reference(const uint32_t p_polynomial, const uint8_t * p_data, const size_t p_length) {
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < p_length; i++) {
+      crc ^= p_data[i];
+      for (int j = 0; j < 8; j++) {
+        crc = (crc >> 1) ^ ((crc & 1) ? p_polynomial : 0);
+      } // End of 'for' statement
+    } // End of 'for' statement
+    return ~crc;
+  };
+};
+
+/**
+ * @brief Test case for the check values of the CRC catalogue and the streaming interface
+ * @see helpers::checksum::crc32c
+ * @see helpers::checksum::crc32
+ * @see helpers::checksum::crc16_ccitt
+ * @see helpers::checksum::crc8
+ */
+TEST_F(checksum_test_suite, checksum_1) {
+  const std::string check("123456789");
+  const byte_span data(reinterpret_cast<const uint8_t *>(check.data()), check.size());
+  ASSERT_TRUE_MSG(checksum::crc32c::compute(data) == 0xe3069283, "test_checksum_1 failed, wrong CRC-32C");
+  ASSERT_TRUE_MSG(checksum::crc32::compute(data) == 0xcbf43926, "test_checksum_1 failed, wrong CRC-32");
+  ASSERT_TRUE_MSG(checksum::crc16_ccitt::compute(data) == 0x29b1, "test_checksum_1 failed, wrong CRC-16/CCITT");
+  ASSERT_TRUE_MSG(checksum::crc16_ccitt(0x0000).update(data).value() == 0x31c3, "test_checksum_1 failed, wrong CRC-16/XMODEM");
+  ASSERT_TRUE_MSG(checksum::crc8::compute(data) == 0xf4, "test_checksum_1 failed, wrong CRC-8");
+  ASSERT_TRUE_MSG((checksum::crc32c::compute(byte_span()) == 0) && (checksum::crc32::compute(byte_span()) == 0), "test_checksum_1 failed, wrong empty CRC");
+
+  // All the lengths and alignments, in one or several chunks
+  std::vector<uint8_t> buffer(4096 + 16);
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = static_cast<uint8_t>(i * 131 + (i >> 7));
+  } // End of 'for' statement
+  const size_t lengths[] = { 1, 7, 15, 16, 63, 64, 65, 127, 128, 200, 1000, 4096 };
+  for (int hardware = 1; hardware >= 0; hardware--) { // Then the slicing-by-8 code path
+    checksum::use_hardware(hardware == 1);
+    for (size_t offset = 0; offset < 8; offset++) {
+      for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        const uint8_t * p = buffer.data() + offset;
+        const size_t n = lengths[l];
+        ASSERT_TRUE_MSG(checksum::crc32c::compute(byte_span(p, n)) == reference(0x82f63b78, p, n), "test_checksum_1 failed, wrong CRC-32C");
+        ASSERT_TRUE_MSG(checksum::crc32::compute(byte_span(p, n)) == reference(0xedb88320, p, n), "test_checksum_1 failed, wrong CRC-32");
+        checksum::crc32 crc;
+        checksum::crc32c crcc;
+        checksum::crc16_ccitt crc16;
+        for (size_t i = 0; i < n; i += 33) {
+          const size_t chunk = (n - i < 33) ? n - i : 33;
+          crc.update(p + i, chunk);
+          crcc.update(p + i, chunk);
+          crc16.update(p + i, chunk);
+        } // End of 'for' statement
+        ASSERT_TRUE_MSG((crc.value() == reference(0xedb88320, p, n)) && (crcc.value() == reference(0x82f63b78, p, n)), "test_checksum_1 failed, wrong streaming CRC-32");
+        ASSERT_TRUE_MSG(crc16.value() == checksum::crc16_ccitt::compute(byte_span(p, n)), "test_checksum_1 failed, wrong streaming CRC-16");
+        ASSERT_TRUE_MSG(checksum::crc32(checksum::crc32::compute(byte_span(p, n / 2))).update(p + n / 2, n - n / 2).value() == reference(0xedb88320, p, n), "test_checksum_1 failed, wrong resumed CRC-32");
+      } // End of 'for' statement
+    } // End of 'for' statement
+  } // End of 'for' statement
+  checksum::use_hardware(true);
+}
+
+/**
+ * @brief Test case for the byte checksums
+ * @see helpers::checksum::xor8
+ * @see helpers::checksum::sum8
+ * @see helpers::checksum::verify_nmea
+ */
+TEST_F(checksum_test_suite, checksum_2) {
+  std::vector<uint8_t> buffer(5000);
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = static_cast<uint8_t>(i * 7 + 3);
+  } // End of 'for' statement
+  const size_t lengths[] = { 0, 1, 8, 15, 16, 17, 100, 1031, 5000 };
+  for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+    uint8_t x = 0;
+    uint8_t s = 0;
+    for (size_t i = 0; i < lengths[l]; i++) {
+      x ^= buffer[i];
+      s += buffer[i];
+    } // End of 'for' statement
+    ASSERT_TRUE_MSG(checksum::xor8(buffer.data(), lengths[l]) == x, "test_checksum_2 failed, wrong XOR");
+    ASSERT_TRUE_MSG(checksum::sum8(buffer.data(), lengths[l]) == s, "test_checksum_2 failed, wrong sum");
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(checksum::sum8(buffer.data() + 10, 90, checksum::sum8(buffer.data(), 10)) == checksum::sum8(buffer.data(), 100), "test_checksum_2 failed, wrong resumed sum");
+  ASSERT_TRUE_MSG(checksum::xor8(buffer.data() + 10, 90, checksum::xor8(buffer.data(), 10)) == checksum::xor8(buffer.data(), 100), "test_checksum_2 failed, wrong resumed XOR");
+
+  ASSERT_TRUE_MSG(checksum::verify_nmea("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n") == 0, "test_checksum_2 failed, valid sentence");
+  ASSERT_TRUE_MSG(checksum::verify_nmea(std::string("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6a")) == 0, "test_checksum_2 failed, lower case digits");
+  ASSERT_TRUE_MSG(checksum::verify_nmea("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48") == -1, "test_checksum_2 failed, wrong checksum");
+  ASSERT_TRUE_MSG(checksum::verify_nmea("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4") == -1, "test_checksum_2 failed, truncated checksum");
+  ASSERT_TRUE_MSG(checksum::verify_nmea("GPGGA,123519*47") == -1, "test_checksum_2 failed, no start delimiter");
+  ASSERT_TRUE_MSG(checksum::verify_nmea("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,\r\n") == 0, "test_checksum_2 failed, no checksum");
+}
+
+/**
+ * @class helpers::tokenizer test suite implementation
+ */
+class tokenizer_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for the delimiters
+ * @see helpers::tokenizer::next
+ * @see helpers::tokenizer::split
+ */
+TEST(tokenizer_test_suite, tokenizer_1) {
+  const std::string line("2017-05-15T04:36:00Z,sensor_12,21.5,,48.25;1013");
+  string_ref fields[8];
+  tokenizer csv(line, ",;");
+  ASSERT_TRUE_MSG(csv.split(fields, 8) == 6, "test_tokenizer_1 failed, wrong number of fields");
+  ASSERT_TRUE_MSG((fields[1] == "sensor_12") && (fields[2] == "21.5") && fields[3].empty() && (fields[5] == "1013"), "test_tokenizer_1 failed, wrong fields");
+  ASSERT_TRUE_MSG(fields[0].data() == line.data(), "test_tokenizer_1 failed, the fields shall borrow the input");
+  ASSERT_TRUE_MSG(!csv.next(fields[0]) && csv.remaining().empty(), "test_tokenizer_1 failed, no more fields expected");
+
+  // One delimiter, long line, range-based for loop
+  std::string long_line;
+  for (int i = 0; i < 100; i++) {
+    long_line += std::to_string(i) + ((i % 7 == 0) ? "  " : " ");
+  } // End of 'for' statement
+  size_t n = 0;
+  for (string_ref field : tokenizer(long_line, " ", '\0', true)) {
+    ASSERT_TRUE_MSG(field == std::to_string(n), "test_tokenizer_1 failed, wrong field");
+    n += 1;
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(n == 100, "test_tokenizer_1 failed, the empty fields shall be skipped");
+
+  // Character sets larger than the SIMD path, empty fields at the boundaries
+  tokenizer t(",a|b:c;d-e,", ",|:;-");
+  ASSERT_TRUE_MSG(t.split(fields, 3) == 3, "test_tokenizer_1 failed, 3 fields expected");
+  ASSERT_TRUE_MSG(fields[0].empty() && (fields[2] == "b") && (t.remaining() == "c;d-e,"), "test_tokenizer_1 failed, wrong remaining part");
+  ASSERT_TRUE_MSG((t.split(fields, 8) == 4) && (fields[2] == "e") && fields[3].empty(), "test_tokenizer_1 failed, wrong last fields");
+  ASSERT_TRUE_MSG(tokenizer("", ",").split(fields, 8) == 1, "test_tokenizer_1 failed, one empty field expected");
+  ASSERT_TRUE_MSG(tokenizer(" ", " ", '\0', true).split(fields, 8) == 0, "test_tokenizer_1 failed, no field expected");
+}
+
+/**
+ * @brief Test case for the quoted fields and the string_ref helpers
+ * @see helpers::tokenizer::unquote
+ * @see helpers::string_ref::trim
+ */
+TEST(tokenizer_test_suite, tokenizer_2) {
+  const std::string line("id,\"Paris, France\",\"say \"\"hi\"\"\",,\"\"");
+  string_ref fields[8];
+  ASSERT_TRUE_MSG(tokenizer(line, ",", '"').split(fields, 8) == 5, "test_tokenizer_2 failed, 5 fields expected");
+  ASSERT_TRUE_MSG((fields[0] == "id") && (fields[1] == "Paris, France") && fields[3].empty() && fields[4].empty(), "test_tokenizer_2 failed, wrong fields");
+  std::string buffer;
+  ASSERT_TRUE_MSG(tokenizer::unquote(fields[2], '"', buffer) == "say \"hi\"", "test_tokenizer_2 failed, wrong unquoted field");
+  ASSERT_TRUE_MSG(tokenizer::unquote(fields[1], '"', buffer).data() == fields[1].data(), "test_tokenizer_2 failed, no copy expected");
+  ASSERT_TRUE_MSG((tokenizer("\"open,end", ",", '"').split(fields, 8) == 1) && (fields[0] == "open,end"), "test_tokenizer_2 failed, wrong unterminated field");
+  ASSERT_TRUE_MSG((tokenizer("\"ab\"cd,e", ",", '"').split(fields, 8) == 2) && (fields[0] == "\"ab\"cd") && (fields[1] == "e"), "test_tokenizer_2 failed, the characters after the closing quote shall be kept");
+
+  const string_ref header("  Basic dXNlcjpwYXNz \t");
+  ASSERT_TRUE_MSG(header.trim() == "Basic dXNlcjpwYXNz", "test_tokenizer_2 failed, wrong trim");
+  ASSERT_TRUE_MSG(header.trim().starts_with("Basic ") && header.trim().ends_with("YXNz"), "test_tokenizer_2 failed, wrong prefix/suffix");
+  ASSERT_TRUE_MSG((header.find('B') == 2) && (header.find('#') == string_ref::npos) && (header.substr(8, 4) == "dXNl"), "test_tokenizer_2 failed, wrong find/substr");
+  ASSERT_TRUE_MSG(header.substr(100).empty() && (header.substr(2, 5).to_string() == "Basic"), "test_tokenizer_2 failed, wrong clamped substr");
+}
+
+class runtime_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Periodic timers: tick count, period accuracy and removal from the callback
+ */
+TEST(runtime_test_suite, runtime_1) {
+  runtime rt(false);
+  ASSERT_TRUE_MSG(rt.is_open(), "test_runtime_1 failed, runtime not open");
+  ASSERT_TRUE_MSG(rt.add_timer(std::chrono::nanoseconds(0), [](const uint64_t) { }) == -1, "test_runtime_1 failed, null period accepted");
+
+  uint64_t ticks = 0;
+  uint32_t calls = 0;
+  int32_t fast = rt.add_timer(std::chrono::milliseconds(2), [&](const uint64_t p_expirations) {
+      calls += 1;
+      if (calls == 3) {
+        ASSERT_TRUE_MSG(rt.remove_timer(fast) == 0, "test_runtime_1 failed, cannot remove timer");
+      }
+    });
+  ASSERT_TRUE_MSG(fast != -1, "test_runtime_1 failed, cannot create timer");
+  ASSERT_TRUE_MSG(rt.add_timer(std::chrono::milliseconds(10), [&](const uint64_t p_expirations) {
+        ticks += p_expirations;
+        if (ticks >= 20) {
+          rt.stop();
+        }
+      }) != -1, "test_runtime_1 failed, cannot create timer");
+
+  std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+  ASSERT_TRUE_MSG(rt.run() == 0, "test_runtime_1 failed, run failure");
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::clog << "20 ticks of 10 ms in " << elapsed * 1e3 << " ms" << std::endl;
+  ASSERT_TRUE_MSG(ticks == 20, "test_runtime_1 failed, wrong tick count");
+  ASSERT_TRUE_MSG(calls == 3, "test_runtime_1 failed, removed timer still running");
+  ASSERT_TRUE_MSG((elapsed >= 0.199) && (elapsed < 0.3), "test_runtime_1 failed, wrong period");
+}
+
+/**
+ * @brief Stop requests, user file descriptors and signals
+ */
+TEST(runtime_test_suite, runtime_2) {
+  runtime rt;
+  ASSERT_TRUE_MSG(rt.is_open(), "test_runtime_2 failed, runtime not open");
+
+  // Stop before run, and from another thread
+  rt.stop();
+  ASSERT_TRUE_MSG(rt.run() == 0, "test_runtime_2 failed, run failure");
+  std::thread t([&rt]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); rt.stop(); });
+  ASSERT_TRUE_MSG(rt.run() == 0, "test_runtime_2 failed, run failure");
+  t.join();
+
+  // User file descriptor
+  int fds[2];
+  ASSERT_TRUE(::pipe(fds) == 0);
+  std::string received;
+  ASSERT_TRUE_MSG(rt.add_fd(fds[0], EPOLLIN, [&](const int32_t p_fd, const uint32_t p_events) {
+        char buffer[16];
+        const ssize_t count = ::read(p_fd, buffer, sizeof(buffer));
+        received.append(buffer, (count > 0) ? count : 0);
+        if (received.length() == 5) {
+          rt.stop();
+        }
+      }) == 0, "test_runtime_2 failed, cannot add fd");
+  ASSERT_TRUE_MSG(rt.add_fd(fds[0], EPOLLIN, [](const int32_t, const uint32_t) { }) == -1, "test_runtime_2 failed, fd added twice");
+  t = std::thread([&fds]() { ::write(fds[1], "hel", 3); std::this_thread::sleep_for(std::chrono::milliseconds(5)); ::write(fds[1], "lo", 2); });
+  ASSERT_TRUE_MSG(rt.run() == 0, "test_runtime_2 failed, run failure");
+  t.join();
+  ASSERT_TRUE_MSG(received == "hello", "test_runtime_2 failed, wrong data");
+  ASSERT_TRUE_MSG((rt.remove_fd(fds[0]) == 0) && (rt.remove_fd(fds[0]) == -1), "test_runtime_2 failed, wrong fd removal");
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  // Signals, raise() targets the calling thread where they are blocked
+  std::vector<int32_t> signals;
+  rt.on_signal([&signals](const int32_t p_signal) { signals.push_back(p_signal); });
+  ASSERT_TRUE_MSG(rt.add_signal(SIGUSR1) == 0, "test_runtime_2 failed, cannot add signal");
+  ::raise(SIGUSR1);
+  ::raise(SIGTERM);
+  ASSERT_TRUE_MSG(rt.run() == 0, "test_runtime_2 failed, run failure");
+  ASSERT_TRUE_MSG((signals.size() == 2) && (signals[0] == SIGUSR1) && (signals[1] == SIGTERM), "test_runtime_2 failed, wrong signals");
+}
+
+class object_pool_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Pooled object counting its constructions and destructions
+ */
+struct pooled_ {
+  static std::atomic<int32_t> g_alive;
+  uint64_t _id;
+  std::string _name;
+  pooled_(const uint64_t p_id, const std::string & p_name) : _id(p_id), _name(p_name) { if (p_name == "throw") { throw std::runtime_error("pooled_"); } g_alive++; };
+  ~pooled_() { g_alive--; };
+}; // End of struct pooled_
+std::atomic<int32_t> pooled_::g_alive(0);
+
+/**
+ * @brief Test case for @see object_pool::acquire, object_pool::release and object_pool::make_unique
+ */
+TEST(object_pool_test_suite, object_pool_1) {
+  object_pool<pooled_> pool(4);
+  pooled_ * p = pool.acquire(1, "one");
+  ASSERT_TRUE_MSG((p->_id == 1) && (p->_name == "one") && (pooled_::g_alive == 1), "test_object_pool_1 failed, wrong object");
+  ASSERT_TRUE_MSG((pool.in_use() == 1) && (pool.capacity() == 4), "test_object_pool_1 failed, wrong counters");
+  pool.release(p);
+  ASSERT_TRUE_MSG((pooled_::g_alive == 0) && (pool.in_use() == 0), "test_object_pool_1 failed, object not destroyed");
+  ASSERT_TRUE_MSG(pool.acquire(2, "two") == p, "test_object_pool_1 failed, storage not reused");
+  pool.release(p);
+
+  { // unique_ptr integration
+    std::vector<object_pool<pooled_>::unique_ptr> objects;
+    for (uint64_t i = 0; i < 10; i++) {
+      objects.push_back(pool.make_unique(i, std::to_string(i)));
+    } // End of 'for' statement
+    ASSERT_TRUE_MSG((pooled_::g_alive == 10) && (pool.in_use() == 10) && (pool.capacity() == 12), "test_object_pool_1 failed, wrong slab growth");
+    ASSERT_TRUE_MSG(objects[7]->_name == "7", "test_object_pool_1 failed, wrong object");
+  }
+  ASSERT_TRUE_MSG((pooled_::g_alive == 0) && (pool.in_use() == 0), "test_object_pool_1 failed, objects not released");
+
+  // The storage is given back when the constructor throws
+  bool thrown = false;
+  try {
+    pool.acquire(3, "throw");
+  } catch (std::runtime_error & e) {
+    thrown = true;
+  }
+  ASSERT_TRUE_MSG(thrown && (pool.in_use() == 0) && (pool.capacity() == 12), "test_object_pool_1 failed, storage lost on exception");
+  pool.release(nullptr);
+}
+
+/**
+ * @brief Test case for @see object_pool debug mode, and objects exchanged between threads
+ */
+TEST(object_pool_test_suite, object_pool_2) {
+  object_pool<pooled_> debug(8, true);
+  pooled_ * p = debug.acquire(1, "one");
+  debug.release(p);
+  ASSERT_TRUE_MSG(debug.violations() == 0, "test_object_pool_2 failed, unexpected violation");
+  debug.release(p); // Double release, not destroyed twice
+  ASSERT_TRUE_MSG((debug.violations() == 1) && (pooled_::g_alive == 0), "test_object_pool_2 failed, double release not detected");
+  pooled_ local(2, "local");
+  debug.release(&local); // Foreign object
+  ASSERT_TRUE_MSG(debug.violations() == 2, "test_object_pool_2 failed, foreign release not detected");
+  reinterpret_cast<uint8_t *>(p)[0] = 0x55; // Write after release, detected on next acquire
+  pooled_ * q = debug.acquire(3, "three");
+  ASSERT_TRUE_MSG((q == p) && (debug.violations() == 3), "test_object_pool_2 failed, write after release not detected");
+  debug.release(q);
+
+  // Producer/consumer: objects acquired by one thread and released by another one
+  object_pool<pooled_> pool(16);
+  mpmc_ring<pooled_ *> ring(64);
+  const uint32_t count = 100000;
+  std::thread producer([&]() {
+      for (uint32_t i = 0; i < count; i++) {
+        pooled_ * object = pool.acquire(i, "x");
+        while (!ring.try_push(object)) {
+          std::this_thread::yield();
+        } // End of 'while' statement
+      } // End of 'for' statement
+    });
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    pooled_ * object;
+    while (!ring.try_pop(object)) {
+      std::this_thread::yield();
+    } // End of 'while' statement
+    sum += object->_id;
+    pool.release(object);
+  } // End of 'for' statement
+  producer.join();
+  ASSERT_TRUE_MSG((sum == static_cast<uint64_t>(count) * (count - 1) / 2) && (pool.in_use() == 0) && (pooled_::g_alive == 1), "test_object_pool_2 failed, wrong transfer");
+  ASSERT_TRUE_MSG(pool.capacity() <= 256, "test_object_pool_2 failed, released objects not recycled");
+}
+
+/**
+ * @brief Access to the cache index of the calling thread
+ */
+struct cache_probe_ : public object_pool_base {
+  static uint32_t index() { return cache_index(); };
+}; // End of struct cache_probe_
+
+/**
+ * @brief thread_local object constructed before the first pool call of its thread, so destroyed after the thread cache index is given back
+ */
+struct late_release_ {
+  object_pool<pooled_> * _pool;
+  pooled_ * _object;
+  uint32_t * _index;
+  late_release_() : _pool(nullptr), _object(nullptr), _index(nullptr) { };
+  ~late_release_() {
+    if (_pool != nullptr) {
+      *_index = cache_probe_::index();
+      _pool->release(_object);
+      _pool->release(_pool->acquire(5, "late"));
+    }
+  };
+}; // End of struct late_release_
+
+/**
+ * @brief Test case for @see object_pool used by a thread_local destructor run after the cache index of the thread is given back
+ */
+TEST(object_pool_test_suite, object_pool_3) {
+  object_pool<pooled_> pool(8);
+  uint32_t index = 0;
+  std::thread t([&pool, &index]() {
+      static thread_local late_release_ late;
+      late._pool = &pool;
+      late._index = &index;
+      late._object = pool.acquire(4, "four");
+    });
+  t.join();
+  ASSERT_TRUE_MSG(index == object_pool_base::max_caches, "test_object_pool_3 failed, cache index used after the thread exit");
+  ASSERT_TRUE_MSG((pool.in_use() == 0) && (pooled_::g_alive == 0), "test_object_pool_3 failed, objects not released");
+}
+
+class histogram_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for @see histogram::record, histogram::snapshot::percentile and the bucket precision
+ */
+TEST(histogram_test_suite, histogram_1) {
+  histogram h(3600000000000ULL, 8);
+  ASSERT_TRUE_MSG(h.count() == 0 && h.percentile(99.0) == 0, "test_histogram_1 failed, not empty");
+  // Each bucket counts the values of its range, relative width below 2^-7
+  for (uint64_t v = 1; v < 3600000000000ULL; v = v * 3 + 1) {
+    uint64_t lowest, highest;
+    h.bucket_range(h.bucket_index(v), lowest, highest);
+    ASSERT_TRUE_MSG((lowest <= v) && (v <= highest) && ((highest - lowest) <= v / 128), "test_histogram_1 failed, wrong bucket");
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(h.bucket_index(1ULL << 62) == h.bucket_count() - 1, "test_histogram_1 failed, value not clamped");
+
+  for (uint64_t v = 1; v <= 100000; v++) { // 1 us to 100 us, uniform
+    h.record(v * 1000);
+  } // End of 'for' statement
+  histogram::snapshot s = h.get_snapshot();
+  ASSERT_TRUE_MSG((s.count() == 100000) && (s.min() == 1000) && (s.max() == 100000000), "test_histogram_1 failed, wrong counters");
+  ASSERT_TRUE_MSG(std::fabs(s.mean() - 50000500.0) < 1.0, "test_histogram_1 failed, wrong mean");
+  const double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+  for (uint32_t i = 0; i < 4; i++) {
+    const double expected = percentiles[i] * 1000000.0;
+    ASSERT_TRUE_MSG(std::fabs(static_cast<double>(s.percentile(percentiles[i])) - expected) <= expected / 128, "test_histogram_1 failed, wrong percentile");
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG((s.percentile(0.0) == 1000) && (s.percentile(100.0) == 100000000), "test_histogram_1 failed, wrong bounds");
+
+  std::ostringstream os;
+  s.print_summary(os);
+  ASSERT_TRUE_MSG(os.str().find("count=100000 min=1000") == 0, "test_histogram_1 failed, wrong summary");
+  os.str("");
+  s.print_distribution(os);
+  ASSERT_TRUE_MSG(os.str().find("100.0000") != std::string::npos, "test_histogram_1 failed, wrong distribution");
+  os.str("");
+  os << 2.5 << " " << 1.0 / 3.0;
+  ASSERT_TRUE_MSG(os.str() == "2.5 0.333333", "test_histogram_1 failed, stream format not restored");
+
+  h.reset();
+  ASSERT_TRUE_MSG((h.count() == 0) && (h.get_snapshot().max() == 0), "test_histogram_1 failed, not reset");
+}
+
+/**
+ * @brief Test case for @see histogram recorded by several threads, and scope_timer
+ */
+TEST(histogram_test_suite, histogram_2) {
+  histogram h;
+  const uint32_t threads = 6;
+  const uint64_t count = 50000;
+  std::vector<std::thread> workers;
+  for (uint32_t t = 0; t < threads; t++) {
+    workers.push_back(std::thread([&h, t, count]() {
+          for (uint64_t i = 0; i < count; i++) {
+            h.record(t * 1000 + 1 + i % 10);
+          } // End of 'for' statement
+        }));
+  } // End of 'for' statement
+  for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it) {
+    it->join();
+  } // End of 'for' statement
+  histogram::snapshot s = h.get_snapshot();
+  ASSERT_TRUE_MSG((s.count() == threads * count) && (s.min() == 1) && (s.max() == (threads - 1) * 1000 + 10), "test_histogram_2 failed, wrong merge");
+  ASSERT_TRUE_MSG(std::fabs(s.mean() - (2500.0 + 5.5)) < 0.001, "test_histogram_2 failed, wrong mean");
+
+  histogram timings;
+  for (uint32_t i = 0; i < 5; i++) {
+    scope_timer t(timings);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG((timings.count() == 5) && (timings.get_snapshot().min() >= 2000000), "test_histogram_2 failed, wrong scope_timer");
+}
+
+class stats_registry_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for @see stats_registry registration and @see stats_reader
+ */
+TEST(stats_registry_test_suite, stats_registry_1) {
+  stats_registry stats("test_stats_1", 4, 1);
+  ASSERT_TRUE_MSG(stats.is_open(), "test_stats_registry_1 failed, segment not created");
+  stats_counter frames = stats.counter("rx.frames");
+  stats_gauge depth = stats.gauge("rx.depth");
+  stats_histogram latency = stats.histogram("rx.latency_ns");
+  frames.add(41);
+  stats.counter("rx.frames").increment(); // Same cell
+  depth.set(-7);
+  for (uint64_t v = 1; v <= 1000; v++) {
+    latency.record(v * 1000);
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG((frames.value() == 42) && (depth.value() == -7) && (latency.count() == 1000), "test_stats_registry_1 failed, wrong values");
+
+  // Invalid names, wrong kind and full registry: process-local cells
+  stats_counter c = stats.counter("rx.depth");
+  c.increment();
+  stats.histogram("second").record(1);
+  stats.counter("bad\"name").increment();
+  stats.counter("last").increment();
+  stats.counter("full").increment();
+  ASSERT_TRUE_MSG(depth.value() == -7, "test_stats_registry_1 failed, cell shared between kinds");
+
+  stats_reader reader("test_stats_1");
+  ASSERT_TRUE_MSG(reader.is_open() && (reader.pid() == ::getpid()), "test_stats_registry_1 failed, segment not opened");
+  std::vector<stats_value> values;
+  ASSERT_TRUE_MSG((reader.read(values) == 0) && (values.size() == 4), "test_stats_registry_1 failed, wrong entries");
+  ASSERT_TRUE_MSG((values[0].name == "rx.frames") && (values[0].kind == stats_counter_kind) && (values[0].value == 42), "test_stats_registry_1 failed, wrong counter");
+  ASSERT_TRUE_MSG((values[1].name == "rx.depth") && (values[1].kind == stats_gauge_kind) && (values[1].value == -7), "test_stats_registry_1 failed, wrong gauge");
+  ASSERT_TRUE_MSG((values[2].kind == stats_histogram_kind) && (values[2].value == 1000) && (values[2].min == 1000) && (values[2].max == 1000000), "test_stats_registry_1 failed, wrong histogram");
+  ASSERT_TRUE_MSG((values[2].p50 >= 500000) && (values[2].p50 <= 500000 + 500000 / 16) && (values[2].p999 == 1000000), "test_stats_registry_1 failed, wrong percentiles");
+  ASSERT_TRUE_MSG((values[3].name == "last") && (values[3].value == 1), "test_stats_registry_1 failed, wrong last entry");
+
+  std::ostringstream os;
+  stats_reader::to_json(values, os);
+  ASSERT_TRUE_MSG(os.str().find("{\"rx.frames\":42,\"rx.depth\":-7,\"rx.latency_ns\":{\"count\":1000,") == 0, "test_stats_registry_1 failed, wrong JSON");
+
+  ASSERT_TRUE_MSG(!stats_reader("test_stats_none").is_open(), "test_stats_registry_1 failed, unexpected segment");
+}
+
+/**
+ * @brief Test case for @see stats_registry updated by another process
+ */
+TEST(stats_registry_test_suite, stats_registry_2) {
+  stats_registry stats("test_stats_2");
+  stats_counter counter = stats.counter("child.loops");
+  stats_histogram histogram = stats.histogram("child.values");
+  const uint64_t count = 100000;
+  pid_t pid = ::fork();
+  if (pid == 0) { // Child: the segment is shared with the parent
+    for (uint64_t i = 0; i < count; i++) {
+      counter.increment();
+      histogram.record(i);
+    } // End of 'for' statement
+    ::_exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  std::vector<stats_value> values;
+  stats_reader reader("test_stats_2");
+  ASSERT_TRUE_MSG((reader.read(values) == 0) && (values.size() == 2), "test_stats_registry_2 failed, wrong entries");
+  ASSERT_TRUE_MSG((values[0].value == static_cast<int64_t>(count)) && (values[1].value == static_cast<int64_t>(count)), "test_stats_registry_2 failed, updates lost");
+  ASSERT_TRUE_MSG((values[1].max == count - 1) && (values[1].sum == count * (count - 1) / 2), "test_stats_registry_2 failed, wrong histogram");
+
+  // Hot path cost
+  const uint32_t loops = 10000000;
+  std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < loops; i++) {
+    counter.increment();
+  } // End of 'for' statement
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::clog << "stats_counter::increment x" << loops << ": " << elapsed * 1e9 / loops << " ns" << std::endl;
+  ASSERT_TRUE(counter.value() == count + loops);
+}
+
+/**
+ * @brief Test case for @see stats_registry segments left or in use by another process, and for @see stats_reader::read on corrupted segments
+ */
+TEST(stats_registry_test_suite, stats_registry_3) {
+  pid_t pid = ::fork();
+  if (pid == 0) { // Child: terminates without removing its segment
+    stats_registry left("test_stats_3");
+    left.counter("child.loops").increment();
+    ::_exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  stats_reader left("test_stats_3");
+  ASSERT_TRUE_MSG(left.is_open() && (left.pid() == pid), "test_stats_registry_3 failed, segment not left by the child");
+  stats_registry stats("test_stats_3", 2, 1);
+  ASSERT_TRUE_MSG(stats.is_open(), "test_stats_registry_3 failed, segment of a terminated process not replaced");
+  stats.counter("rx.frames").increment();
+  ASSERT_TRUE_MSG(!stats_registry("test_stats_3").is_open(), "test_stats_registry_3 failed, segment of a running process replaced");
+
+  // Corrupted header and entry, see segment_header and segment_entry
+  int fd = ::shm_open("/test_stats_3", O_RDWR, 0);
+  ASSERT_TRUE_MSG(fd != -1, "test_stats_registry_3 failed, cannot open the segment");
+  uint8_t * segment = static_cast<uint8_t *>(::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+  ::close(fd);
+  ASSERT_TRUE_MSG(segment != MAP_FAILED, "test_stats_registry_3 failed, cannot map the segment");
+  stats_reader reader("test_stats_3");
+  std::vector<stats_value> values;
+  ASSERT_TRUE_MSG((reader.read(values) == 0) && (values.size() == 1) && (values[0].value == 1), "test_stats_registry_3 failed, wrong entries");
+  const uint32_t capacity = 0x10000000, count = 3;
+  const uint64_t offset = 0xfffffffffffffff8ULL;
+  uint8_t saved[8];
+  const size_t fields[] = { 12, 24, 128 + 56 }; // capacity, count, offset of the first entry
+  const void * corrupted[] = { &capacity, &count, &offset };
+  const size_t sizes[] = { sizeof(capacity), sizeof(count), sizeof(offset) };
+  for (uint32_t i = 0; i < 3; i++) {
+    std::memcpy(saved, segment + fields[i], sizes[i]);
+    std::memcpy(segment + fields[i], corrupted[i], sizes[i]);
+    ASSERT_TRUE_MSG(reader.read(values) == -1, "test_stats_registry_3 failed, corrupted segment read");
+    std::memcpy(segment + fields[i], saved, sizes[i]);
+  } // End of 'for' statement
+  ASSERT_TRUE_MSG(reader.read(values) == 0, "test_stats_registry_3 failed, restored segment not read");
+  ::munmap(segment, 4096);
+}
+
+class micro_benchmark_test_suite : public ::testing::Test {
+protected:
+  virtual void SetUp() { };
+  virtual void TearDown() { };
+};
+
+/**
+ * @brief Test case for @see micro_benchmark::run, calibration, warm-up and repetitions
+ */
+TEST(micro_benchmark_test_suite, micro_benchmark_1) {
+  micro_benchmark::settings s;
+  s.warmup = 3;
+  s.repetitions = 5;
+  s.min_time_ns = 1000000; // 1 ms
+  micro_benchmark bench(s);
+  uint64_t calls = 0, total = 0;
+  benchmark_result result;
+  ASSERT_TRUE_MSG(bench.run("sleep", [&calls, &total](const uint64_t p_iterations) {
+        calls += 1;
+        total += p_iterations;
+        for (uint64_t i = 0; i < p_iterations; i++) {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        } // End of 'for' statement
+      }, result) == 0, "test_micro_benchmark_1 failed, run failure");
+  ASSERT_TRUE_MSG((result.name == "sleep") && (result.repetitions == 5) && (result.iterations >= 2), "test_micro_benchmark_1 failed, wrong calibration");
+  ASSERT_TRUE_MSG((result.iterations * result.ns >= 1000000) && (result.ns >= 100000) && (result.ns_min <= result.ns) && (result.ns <= result.ns_max), "test_micro_benchmark_1 failed, wrong durations");
+  ASSERT_TRUE_MSG(total >= 8 * result.iterations, "test_micro_benchmark_1 failed, warm-up not run");
+  for (uint32_t c = 0; c < perf_counters::counters_count; c++) {
+    ASSERT_TRUE_MSG((result.counters[c] >= 0.0) == (bench.has_counters() && perf_counters().is_available(static_cast<perf_counters::counter_t>(c))), "test_micro_benchmark_1 failed, wrong counters");
+  } // End of 'for' statement
+
+  s.iterations = 1000; // No calibration
+  micro_benchmark fixed(s);
+  calls = 0;
+  fixed.run("fixed", [&calls](const uint64_t p_iterations) { calls += p_iterations; }, result);
+  ASSERT_TRUE_MSG((result.iterations == 1000) && (calls == 8000), "test_micro_benchmark_1 failed, wrong fixed iterations");
+  std::clog << "Hardware counters " << (bench.has_counters() ? "available" : "not available") << std::endl;
+}
+
+/**
+ * @brief Test case for @see micro_benchmark::to_json, micro_benchmark::from_json and micro_benchmark::compare
+ */
+TEST(micro_benchmark_test_suite, micro_benchmark_2) {
+  std::vector<benchmark_result> results(2), baseline, current;
+  results[0] = { "converter.swap", 1000, 10, 2.5, 2.0, 3.0, { 8.0, 12.0, -1.0, 0.01 } };
+  results[1] = { "sha.sha256", 100, 10, 1500.0, 1400.0, 1600.0, { -1.0, -1.0, -1.0, -1.0 } };
+  std::stringstream ss;
+  micro_benchmark::to_json(results, ss);
+  ASSERT_TRUE_MSG(ss.str().find("\"cache_misses\"") == std::string::npos, "test_micro_benchmark_2 failed, unavailable counter written");
+  ASSERT_TRUE_MSG((micro_benchmark::from_json(ss, baseline) == 0) && (baseline.size() == 2), "test_micro_benchmark_2 failed, cannot read JSON");
+  ASSERT_TRUE_MSG((baseline[0].name == "converter.swap") && (baseline[0].iterations == 1000) && (baseline[0].ns == 2.5) && (baseline[0].counters[perf_counters::instructions] == 12.0), "test_micro_benchmark_2 failed, wrong values");
+  ASSERT_TRUE_MSG((baseline[0].counters[perf_counters::cache_misses] == -1.0) && (baseline[1].ns_max == 1600.0) && (baseline[1].counters[perf_counters::cycles] == -1.0), "test_micro_benchmark_2 failed, wrong values");
+  std::istringstream bad("not a result file");
+  ASSERT_TRUE_MSG(micro_benchmark::from_json(bad, current) == -1, "test_micro_benchmark_2 failed, invalid file accepted");
+
+  current = results;
+  current[0].ns = 2.6;     // +4%
+  current[1].ns = 1800.0;  // +20%
+  current.push_back(results[0]);
+  current[2].name = "logger.info";
+  std::ostringstream report;
+  ASSERT_TRUE_MSG(micro_benchmark::compare(current, baseline, 5.0, report) == 1, "test_micro_benchmark_2 failed, wrong regressions");
+  ASSERT_TRUE_MSG((report.str().find("+20.00%") != std::string::npos) && (report.str().find("REGRESSION") != std::string::npos) && (report.str().find("new") != std::string::npos), "test_micro_benchmark_2 failed, wrong report");
+  ASSERT_TRUE_MSG(micro_benchmark::compare(current, baseline, 25.0, report) == 0, "test_micro_benchmark_2 failed, wrong threshold");
+}
+
 /**
  * @brief Main test program
  * @param[in] p_argc Number of argumrnt
@@ -43,6 +43,12 @@ namespace http_server {
                  );
     ~http_request();
 
+    /**
+     * \brief Allocate the instances from a pool: a request object is created for each HTTP request
+     */
+    static void * operator new(size_t p_size);
+    static void operator delete(void * p_request, size_t p_size);
+
     void set_body(const char* p_body);
     const std::string& get_authorization_header();
     const std::string& get_redirect_uri_header();
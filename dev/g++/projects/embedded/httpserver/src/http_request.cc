@@ -12,9 +12,30 @@
 //#include "logger_factory.hh"
 #include "helper.hh"
 #include "converter.hh"
+#include "object_pool.hh"
 
 namespace http_server {
 
+  /**
+   * \brief Returns the pool of the requests. It is never destroyed, requests may be deleted by static destructors
+   */
+  static object_pool<http_request> & request_pool() {
+    static object_pool<http_request> * pool = new object_pool<http_request>(16);
+    return *pool;
+  }
+
+  void * http_request::operator new(size_t p_size) {
+    return (p_size == sizeof(http_request)) ? request_pool().allocate() : ::operator new(p_size); // Derived classes are not pooled
+  }
+
+  void http_request::operator delete(void * p_request, size_t p_size) {
+    if (p_size == sizeof(http_request)) {
+      request_pool().deallocate(p_request);
+    } else {
+      ::operator delete(p_request);
+    }
+  }
+
   http_request::http_request(
                              struct MHD_Connection* p_connection,
                              const std::string& p_url,
@@ -11,6 +11,7 @@
 
 //#include "logger_factory.hh"
 #include "helper.hh"
+#include "string_ref.hh"
 #include "converter.hh"
 
 namespace http_server {
@@ -253,19 +254,17 @@ namespace http_server {
   }
 
   int32_t http_server::is_authenticated(struct MHD_Connection* p_connection, const std::string& p_username, const std::string& p_password) {
-    _logger.info(">>> http_server::is_authenticated: %s/%s.", p_username.c_str(), p_password.c_str());
+    _logger.info(">>> http_server::is_authenticated: %s.", p_username.c_str()); // Never log the credentials
 
     static std::string base("Basic ");
 
     const std::string& header = _request->get_authorization_header();
-    _logger.info("http_server::is_authenticated: Authorization: %s.", header.c_str());
     if (header.empty()) {
       _logger.info("http_server::is_authenticated: No Authorization header.");
       return -1;
     }
-    std::string s = header.substr(0, 6);
-    _logger.info("http_server::is_authenticated: s:%s.", s.c_str());
-    if (base.compare(s) != 0) {
+    const string_ref credentials(header);
+    if (!credentials.starts_with(base)) {
       _logger.warning("http_server::is_authenticated: Invalid Authorization header.");
       return -1;
     }
@@ -276,9 +275,8 @@ namespace http_server {
       return -1;
     }
 
-    s = header.substr(6);
-    _logger.info("http_server::is_authenticated: s:%s/%s.", s.c_str(), str.c_str());
-    if (s.compare(str) != 0) {
+    if (credentials.substr(base.length()) != str) {
+      _logger.warning("http_server::is_authenticated: Invalid credentials.");
       return -1;
     }
 
@@ -15,12 +15,16 @@
 #include <string>
 #include <cstdint>
 #include <ctime>
-#include <sys/time.h>
 #include <vector>
+#include <memory>
 
 #include "logger_levels.hh"
 #include "logger_time_formats.hh"
 
+namespace helpers {
+  class timestamp_formatter;
+} // End of namespace helpers
+
 /*! \namespace logger
  *  \brief logger namespace
  */
@@ -41,16 +45,10 @@ namespace logger {
     uint8_t _time_format;
     /*!< Date/time value convertion */
     std::string _timestamp;
-    /*!< Start date/time value used by gettimeofday() (required for very long time execution) */
-    struct timeval _start_time_val;
-    /*!< Start date/time value (required for very long time execution */
-    struct tm *_start_time;
-    /*!< Current date/time value used by gettimeofday() */
-    struct timeval _time_val;
-    /*!< Start date/time value (required for very long time execution */
-    struct tm * _tm;
-    /*!< Local time convertion */
-    time_t _time;
+    /*!< Start time of the seconds format, monotonic clock in nanoseconds */
+    uint64_t _start_time;
+    /*!< Date/time formatting, the formatted seconds are cached */
+    std::unique_ptr<helpers::timestamp_formatter> _formatter;
     
   public: /*! \publicsection */
     /*!
@@ -62,12 +60,12 @@ namespace logger {
      * \param[in] p_logger_time_format  The timestamp format to use. Default: logger_time_formats_t::datetime
      * @throws std::runtime_error in case of IO error
      */
-    logger(const std::string & p_logger_name, const std::string & p_file_name, const uint8_t p_logger_level_filter = logger_levels_t::error, const logger_time_formats_t p_logger_time_format = logger_time_formats_t::datetime) : _name(p_logger_name), _os(p_file_name, std::ofstream::out | std::ofstream::trunc), _levels(p_logger_level_filter), _time_format(p_logger_time_format), _timestamp(), _start_time(NULL), _tm(NULL) { if (!_os.is_open()) throw std::runtime_error("logger::logger: Failed to open log file"); };
+    logger(const std::string & p_logger_name, const std::string & p_file_name, const uint8_t p_logger_level_filter = logger_levels_t::error, const logger_time_formats_t p_logger_time_format = logger_time_formats_t::datetime);
 
     /*!
      * \brief Destructor
      */
-    virtual ~logger() { _os << std::endl; _os.close(); };
+    virtual ~logger();
 
     /*!
      * \fn bool is_set(const logger_levels_t p_logger_level);
@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include "logger.hh"
+#include "date_time.hh"
 
 namespace logger {
 
@@ -23,60 +24,43 @@ namespace logger {
      return p_logger; 
      }*/
   
+  logger::logger(const std::string & p_logger_name, const std::string & p_file_name, const uint8_t p_logger_level_filter, const logger_time_formats_t p_logger_time_format) : _name(p_logger_name), _os(p_file_name, std::ofstream::out | std::ofstream::trunc), _levels(p_logger_level_filter), _time_format(p_logger_time_format), _timestamp(), _start_time(helpers::timestamp::monotonic()), _formatter(new helpers::timestamp_formatter((p_logger_time_format == logger_time_formats_t::time) ? "%H:%M:%S" : "%Y/%b/%d %H:%M:%S")) {
+    if (!_os.is_open()) throw std::runtime_error("logger::logger: Failed to open log file");
+  }
+
+  logger::~logger() {
+    _os << std::endl;
+    _os.close();
+  }
+
   void logger::set_start_time() {
-    ::gettimeofday(&_start_time_val, NULL);
-    _time = _start_time_val.tv_sec;
-    _start_time = ::localtime(&_time);
+    _start_time = helpers::timestamp::monotonic();
   }
   
   const std::string & logger::get_timestamp() {
-    static const char mon_name[][4] = {
-      "Jan", "Feb", "Mar", "Apr", "May", "Jun",
-      "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
-    };
-    static char _buffer[32];
-    ::gettimeofday(&_time_val, NULL);
-    _time = _time_val.tv_sec;
-    _tm = ::localtime(&_time);
-    if (_time_format == logger_time_formats_t::seconds) {
-      struct timeval diff = {0};
-      if (_time_val.tv_usec < _start_time_val.tv_usec) {
-        diff.tv_sec = _tm->tm_sec - _start_time->tm_sec - 1;
-        diff.tv_usec = _time_val.tv_usec + (1000000L - _start_time_val.tv_usec);
-      } else {
-        diff.tv_sec = _tm->tm_sec - _start_time->tm_sec;
-        diff.tv_usec = _time_val.tv_usec - _start_time_val.tv_usec;
-      }
-      ::sprintf(
-                _buffer,
-                "%ld.%06ld",
-                diff.tv_sec,
-                diff.tv_usec
-                );
-    } else if (_time_format == logger_time_formats_t::time) {
-      ::sprintf(
-                _buffer,
-                "%02d:%02d:%02d.%06ld",
-                _tm->tm_hour,
-                _tm->tm_min,
-                _tm->tm_sec,
-                _time_val.tv_usec
-                );
-    } else {
-      ::sprintf(
-                _buffer,
-                "%4d/%.3s/%02d %02d:%02d:%02d.%06ld",
-                _tm->tm_year + 1900,
-                mon_name[_tm->tm_mon],
-                _tm->tm_mday,
-                _tm->tm_hour,
-                _tm->tm_min,
-                _tm->tm_sec,
-                _time_val.tv_usec
-                );
+    char buffer[64];
+    size_t length;
+    if (_time_format == logger_time_formats_t::seconds) { // Elapsed time since the start time, e.g. 12.000345
+      const uint64_t elapsed = (helpers::timestamp::monotonic() - _start_time) / 1000;
+      uint64_t seconds = elapsed / 1000000;
+      uint32_t microseconds = static_cast<uint32_t>(elapsed % 1000000);
+      char * p = buffer + sizeof(buffer) - 7;
+      for (int i = 6; i > 0; i--) {
+        p[i] = static_cast<char>('0' + microseconds % 10);
+        microseconds /= 10;
+      } // End of 'for' statement
+      *p = '.';
+      do {
+        *--p = static_cast<char>('0' + seconds % 10);
+        seconds /= 10;
+      } while (seconds != 0);
+      length = buffer + sizeof(buffer) - p;
+      _timestamp.assign(p, length);
+      return _timestamp;
     }
-    _timestamp.assign(_buffer);
-    
+
+    length = _formatter->format(buffer, sizeof(buffer), helpers::timestamp::realtime());
+    _timestamp.assign(buffer, length);
     return _timestamp;
   }
   
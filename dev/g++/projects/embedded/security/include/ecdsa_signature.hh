@@ -11,6 +11,7 @@
 #include <vector>
 #include <cstdint>
 
+#include "byte_span.hh"
 #include "keys_pair.hh"
 
 namespace security {
@@ -34,8 +35,8 @@ namespace security {
      */
     virtual ~ecdsa_signature();
 
-    int sign(const std::vector<uint8_t> p_message, std::vector<uint8_t> p_signature);
-    bool verify_sign(const std::vector<uint8_t> p_message, const std::vector<uint8_t> p_signature);
+    int sign(const byte_span& p_message, std::vector<uint8_t>& p_signature);
+    bool verify_sign(const byte_span& p_message, const byte_span& p_signature);
 
 
     std::string to_string();
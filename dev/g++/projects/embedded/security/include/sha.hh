@@ -10,6 +10,9 @@
 
 #include <memory>
 #include <cstdint>
+#include <vector>
+
+#include "byte_span.hh"
 
 #include "sha_algorithms.hh"
 
@@ -46,7 +49,13 @@ namespace security {
      */
     virtual ~sha();
 
-    int32_t hash(const std::vector<uint8_t> p_data, std::vector<uint8_t>& p_hash) const;
+    /*!
+     * \brief Compute the message digest
+     * \param[in] p_data The data to hash: a std::vector or a byte_buffer, it is not copied
+     * \param[out] p_hash The message digest
+     * \return 0 on success, -1 otherwise
+     */
+    int32_t hash(const byte_span& p_data, std::vector<uint8_t>& p_hash) const;
     
   }; // End of class sha
 
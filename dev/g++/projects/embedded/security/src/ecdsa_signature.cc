@@ -8,11 +8,11 @@ namespace security {
   ecdsa_signature::~ecdsa_signature() {
   }
 
-  int ecdsa_signature::sign(const std::vector<uint8_t> p_message, std::vector<uint8_t> p_signature) {
+  int ecdsa_signature::sign(const byte_span& p_message, std::vector<uint8_t>& p_signature) {
     return -1;
   }
   
-  bool ecdsa_signature::verify_sign(const std::vector<uint8_t> p_message, const std::vector<uint8_t> p_signature) {
+  bool ecdsa_signature::verify_sign(const byte_span& p_message, const byte_span& p_signature) {
     return false;
   }
 
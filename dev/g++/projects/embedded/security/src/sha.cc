@@ -46,7 +46,7 @@ namespace security {
     } // End of 'switch' statement
   } // End of shared_ptr_deleter
 
-  int32_t sha::hash(const std::vector<uint8_t> p_data, std::vector<uint8_t>& p_hash) const {
+  int32_t sha::hash(const byte_span& p_data, std::vector<uint8_t>& p_hash) const {
     // Sanity check
     if (_sha.get() == nullptr) {
       return -1;
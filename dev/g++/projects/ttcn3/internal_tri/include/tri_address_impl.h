@@ -26,7 +26,7 @@ namespace internal {
         virtual ~tri_address_impl() { _ibs.close(); };
 	
 	inline const uint8_t * get_encoded_data() const { return _ibs.rdbuf(); };
-	inline void set_encoded_data(const uint8_t * p_data, const uint32_t p_length) { _ibs.open(std::vector<uint8_t>(p_data, p_data + static_cast<size_t>(p_length / 8 + (p_length % 8 != 0) ? 1 : 0)), p_length); };
+	inline void set_encoded_data(const uint8_t * p_data, const uint32_t p_length) { _ibs.open(p_data, p_length); _ibs.copy(); };
 	inline uint32_t get_bits_data_len() const { return _ibs.gcount(); };
 	inline bool operator== (const tri_address & p_tri_address) const { return _ibs.is_equal(p_tri_address.get_encoded_data(), p_tri_address.get_bits_data_len()); };
 	inline std::unique_ptr<tri_address> clone_address () const { std::unique_ptr<tri_address> a(new tri_address_impl(*this)); return a; };
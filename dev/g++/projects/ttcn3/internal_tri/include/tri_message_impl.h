@@ -21,12 +21,26 @@ namespace internal {
 	ibstream _ibs;
       public:
         tri_message_impl() : _ibs() { };
-        tri_message_impl(const tri_message & p_tri_message) : _ibs() { set_data(p_tri_message.get_data(), p_tri_message.get_bits_data_len()); };
+        tri_message_impl(const tri_message & p_tri_message) : _ibs() {
+          const tri_message_impl * message = dynamic_cast<const tri_message_impl *>(&p_tri_message);
+          if (message != NULL) { // Share the payload
+            _ibs = message->_ibs;
+          } else {
+            set_data(p_tri_message.get_data(), p_tri_message.get_bits_data_len());
+          }
+        };
         tri_message_impl(const uint8_t * p_data, const uint32_t p_length) : _ibs() { set_data(p_data, p_length); };
+        /**
+         * \brief Build a message sharing the payload p_data, e.g. a received datagram, without copying it
+         * \param[in] p_data The payload
+         * \param[in] p_length The payload length in bits
+         */
+        tri_message_impl(const byte_buffer & p_data, const uint32_t p_length) : _ibs(p_data, p_length) { };
         virtual ~tri_message_impl() { _ibs.close(); };
 	
 	inline const uint8_t * get_data() const { return _ibs.rdbuf(); };
-	inline void set_data(const uint8_t * p_data, const uint32_t p_length) { _ibs.open(std::vector<uint8_t>(p_data, p_data + static_cast<size_t>(p_length / 8 + (p_length % 8 != 0) ? 1 : 0)), p_length); };
+	inline void set_data(const uint8_t * p_data, const uint32_t p_length) { _ibs.open(p_data, p_length); _ibs.copy(); };
+	inline void set_data(const byte_buffer & p_data, const uint32_t p_length) { _ibs.open(p_data, p_length); };
 	inline uint32_t get_bits_data_len() const { return _ibs.gcount(); };
 	inline bool operator== (const tri_message & p_tri_message) const { return _ibs.is_equal(p_tri_message.get_data(), p_tri_message.get_bits_data_len()); };
 	inline std::unique_ptr<tri_message> clone_message() const { std::unique_ptr<tri_message> a(new tri_message_impl(*this)); return a; };
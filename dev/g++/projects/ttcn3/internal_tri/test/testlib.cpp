@@ -49,6 +49,7 @@ public:
     TEST_ADD(ttcn3_tri_test_suite::test_tri_address_2);
     TEST_ADD(ttcn3_tri_test_suite::test_tri_message_1);
     TEST_ADD(ttcn3_tri_test_suite::test_tri_message_2);
+    TEST_ADD(ttcn3_tri_test_suite::test_tri_message_3);
   }
 	
 private:
@@ -371,6 +372,22 @@ private:
     TEST_ASSERT(p.get_data() != NULL);    
   }
   
+  /**
+   * @brief Test case for @see _tri_message sharing a byte_buffer
+   */
+  void test_tri_message_3() {
+    byte_buffer data(std::vector<uint8_t>(64, 0xca)); // Larger than the inline storage
+    tri_message_impl p(data, 512);
+    TEST_ASSERT(p.get_bits_data_len() == 512);
+    TEST_ASSERT(p.get_data() == data.data()); // Not copied
+    
+    std::unique_ptr<tri_message> c = p.clone_message();
+    TEST_ASSERT(c->get_data() == p.get_data());
+    tri_message_impl q(*c);
+    TEST_ASSERT(q.get_data() == p.get_data());
+    TEST_ASSERT(p == q);
+  }
+  
 };
 
 /**